@@ -170,6 +170,12 @@ static void plot_tooltip(const UnitTimes *ut) {
         svg("%s:\n", ut->name);
         svg("Activating: %"PRI_USEC".%.3"PRI_USEC"\n", ut->activating / USEC_PER_SEC, ut->activating % USEC_PER_SEC);
         svg("Activated: %"PRI_USEC".%.3"PRI_USEC"\n", ut->activated / USEC_PER_SEC, ut->activated % USEC_PER_SEC);
+        if (ut->cpu_usage_nsec != UINT64_MAX)
+                svg("CPU: %s\n", FORMAT_TIMESPAN(ut->cpu_usage_nsec / NSEC_PER_USEC, USEC_PER_MSEC));
+        if (ut->io_read_bytes != UINT64_MAX)
+                svg("IO read: %s\n", FORMAT_BYTES(ut->io_read_bytes));
+        if (ut->io_write_bytes != UINT64_MAX)
+                svg("IO written: %s\n", FORMAT_BYTES(ut->io_write_bytes));
 
         UnitDependency i;
         FOREACH_ARGUMENT(i, UNIT_AFTER, UNIT_BEFORE, UNIT_REQUIRES, UNIT_REQUISITE, UNIT_WANTS, UNIT_CONFLICTS, UNIT_UPHOLDS)
@@ -437,11 +443,21 @@ static int show_table(Table *table, const char *word) {
         return 0;
 }
 
+static int table_add_size_or_empty(Table *table, uint64_t size) {
+        assert(table);
+
+        if (size == UINT64_MAX)
+                return table_add_cell(table, NULL, TABLE_EMPTY, NULL);
+
+        return table_add_cell(table, NULL, TABLE_SIZE, &size);
+}
+
 static int produce_plot_as_text(UnitTimes *times, const BootTimes *boot) {
         _cleanup_(table_unrefp) Table *table = NULL;
         int r;
 
-        table = table_new("name", "activated", "activating", "time", "deactivated", "deactivating");
+        table = table_new("name", "activated", "activating", "time", "deactivated", "deactivating",
+                          "cpu", "io-read", "io-write");
         if (!table)
                 return log_oom();
 
@@ -458,6 +474,21 @@ static int produce_plot_as_text(UnitTimes *times, const BootTimes *boot) {
                                 TABLE_TIMESPAN_MSEC, times->deactivating);
                 if (r < 0)
                         return table_log_add_error(r);
+
+                if (times->cpu_usage_nsec != UINT64_MAX)
+                        r = table_add_cell(table, NULL, TABLE_TIMESPAN_MSEC, &(usec_t) { times->cpu_usage_nsec / NSEC_PER_USEC });
+                else
+                        r = table_add_cell(table, NULL, TABLE_EMPTY, NULL);
+                if (r < 0)
+                        return table_log_add_error(r);
+
+                r = table_add_size_or_empty(table, times->io_read_bytes);
+                if (r < 0)
+                        return table_log_add_error(r);
+
+                r = table_add_size_or_empty(table, times->io_write_bytes);
+                if (r < 0)
+                        return table_log_add_error(r);
         }
 
         return show_table(table, "Units");
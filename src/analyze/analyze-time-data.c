@@ -273,6 +273,9 @@ int acquire_time_data(sd_bus *bus, bool require_finished, UnitTimes **out) {
                 { "ActiveEnterTimestampMonotonic",   "t",  NULL, offsetof(UnitTimes, activated)            },
                 { "ActiveExitTimestampMonotonic",    "t",  NULL, offsetof(UnitTimes, deactivating)         },
                 { "InactiveEnterTimestampMonotonic", "t",  NULL, offsetof(UnitTimes, deactivated)          },
+                { "CPUUsageNSec",                    "t",  NULL, offsetof(UnitTimes, cpu_usage_nsec)       },
+                { "IOReadBytes",                     "t",  NULL, offsetof(UnitTimes, io_read_bytes)        },
+                { "IOWriteBytes",                    "t",  NULL, offsetof(UnitTimes, io_write_bytes)       },
                 { "After",                           "as", NULL, offsetof(UnitTimes, deps[UNIT_AFTER])     },
                 { "Before",                          "as", NULL, offsetof(UnitTimes, deps[UNIT_BEFORE])    },
                 { "Requires",                        "as", NULL, offsetof(UnitTimes, deps[UNIT_REQUIRES])  },
@@ -312,6 +315,9 @@ int acquire_time_data(sd_bus *bus, bool require_finished, UnitTimes **out) {
                  * them if the entry is being reused. */
                 t = &unit_times[c];
 
+                /* Not all unit types have a cgroup, and hence not all expose these properties. */
+                t->cpu_usage_nsec = t->io_read_bytes = t->io_write_bytes = UINT64_MAX;
+
                 assert_cc(sizeof(usec_t) == sizeof(uint64_t));
 
                 r = bus_map_all_properties(
@@ -49,6 +49,10 @@ typedef struct UnitTimes {
         usec_t deactivated;
         usec_t deactivating;
         usec_t time;
+        /* Resource usage accumulated by the unit's cgroup so far, UINT64_MAX if not known */
+        uint64_t cpu_usage_nsec;
+        uint64_t io_read_bytes;
+        uint64_t io_write_bytes;
         char **deps[_UNIT_DEPENDENCY_MAX];
 } UnitTimes;
 
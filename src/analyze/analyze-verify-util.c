@@ -12,6 +12,7 @@
 #include "manager.h"
 #include "pager.h"
 #include "path-util.h"
+#include "set.h"
 #include "string-table.h"
 #include "strv.h"
 #include "unit-name.h"
@@ -215,14 +216,24 @@ static int verify_executables(Unit *u, const char *root) {
         return r;
 }
 
-static int verify_documentation(Unit *u, bool check_man) {
+static int verify_documentation(Unit *u, bool check_man, Set **man_pages_found) {
         int r = 0, k;
 
+        assert(man_pages_found);
+
         STRV_FOREACH(p, u->documentation) {
                 log_unit_debug(u, "Found documentation item: %s", *p);
 
                 if (check_man && startswith(*p, "man:")) {
+                        /* Many units refer to the same man pages, and each check forks off man, hence
+                         * remember the ones we already found. Failures are rare, so just check those
+                         * again, so that they are reported for each unit. */
+                        if (set_contains(*man_pages_found, *p + 4))
+                                continue;
+
                         k = show_man_page(*p + 4, true);
+                        if (k == 0 && set_put_strdup(man_pages_found, *p + 4) < 0)
+                                log_oom_debug();
                         if (k != 0) {
                                 if (k < 0)
                                         log_unit_error_errno(u, k, "Can't show %s: %m", *p + 4);
@@ -241,7 +252,7 @@ static int verify_documentation(Unit *u, bool check_man) {
         return r;
 }
 
-static int verify_unit(Unit *u, bool check_man, const char *root) {
+static int verify_unit(Unit *u, bool check_man, Set **man_pages_found, const char *root) {
         _cleanup_(sd_bus_error_free) sd_bus_error error = SD_BUS_ERROR_NULL;
         int r;
 
@@ -257,7 +268,7 @@ static int verify_unit(Unit *u, bool check_man, const char *root) {
 
         RET_GATHER(r, verify_socket(u));
         RET_GATHER(r, verify_executables(u, root));
-        RET_GATHER(r, verify_documentation(u, check_man));
+        RET_GATHER(r, verify_documentation(u, check_man, man_pages_found));
 
         return r;
 }
@@ -285,6 +296,7 @@ int verify_units(
 
         _cleanup_(manager_freep) Manager *m = NULL;
         _cleanup_(set_destroy_ignore_pointer_max) Set *s = NULL;
+        _cleanup_set_free_ Set *man_pages_found = NULL;
         _unused_ _cleanup_(clear_log_syntax_callback) dummy_t dummy;
         Unit *units[strv_length(filenames)];
         int r, k, count = 0;
@@ -338,7 +350,7 @@ int verify_units(
         }
 
         FOREACH_ARRAY(i, units, count)
-                RET_GATHER(r, verify_unit(*i, check_man, root));
+                RET_GATHER(r, verify_unit(*i, check_man, &man_pages_found, root));
 
         if (s == POINTER_MAX)
                 return log_oom();
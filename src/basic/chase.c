@@ -1,6 +1,7 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 
 #include <linux/magic.h>
+#include <threads.h>
 
 #include "alloc-util.h"
 #include "chase.h"
@@ -9,6 +10,7 @@
 #include "fs-util.h"
 #include "glyph-util.h"
 #include "log.h"
+#include "missing_syscall.h"
 #include "path-util.h"
 #include "string-util.h"
 #include "user-util.h"
@@ -79,6 +81,8 @@ static int chaseat_needs_absolute(int dir_fd, const char *path) {
         return dir_fd_is_root(dir_fd);
 }
 
+static thread_local bool openat2_unavailable = false;
+
 int chaseat(int dir_fd, const char *path, ChaseFlags flags, char **ret_path, int *ret_fd) {
         _cleanup_free_ char *buffer = NULL, *done = NULL;
         _cleanup_close_ int fd = -EBADF, root_fd = -EBADF;
@@ -204,6 +208,34 @@ int chaseat(int dir_fd, const char *path, ChaseFlags flags, char **ret_path, int
                 return 0;
         }
 
+        if (!(flags &
+              (CHASE_NONEXISTENT|CHASE_NO_AUTOFS|CHASE_SAFE|CHASE_STEP|CHASE_PROHIBIT_SYMLINKS|
+               CHASE_MKDIR_0755|CHASE_PARENT|CHASE_MUST_BE_DIRECTORY|CHASE_MUST_BE_REGULAR)) &&
+            FLAGS_SET(flags, CHASE_AT_RESOLVE_IN_ROOT) && !ret_path && ret_fd && !openat2_unavailable) {
+
+                /* Same as above, but with a root directory. openat2()'s RESOLVE_IN_ROOT implements the same
+                 * semantics as our own component-wise resolution below, with the exception of magic links,
+                 * which we would resolve as regular symlinks. Hence refuse those in the kernel, and fall back
+                 * to the slow path for them, as well as if openat2() is not available or fails for any other
+                 * reason than the path not existing. */
+                struct open_how how = {
+                        .flags = O_PATH|O_CLOEXEC|(FLAGS_SET(flags, CHASE_NOFOLLOW) ? O_NOFOLLOW : 0),
+                        .resolve = RESOLVE_IN_ROOT|RESOLVE_NO_MAGICLINKS,
+                };
+
+                r = RET_NERRNO(openat2(dir_fd, path, &how, sizeof(how)));
+                if (r >= 0) {
+                        *ret_fd = r;
+                        return 0;
+                }
+                if (r == -ENOENT)
+                        return r;
+                /* Only remember that openat2() is not available if the kernel lacks it, or if it is blocked
+                 * by a seccomp filter. EACCES and friends just refer to this one path. */
+                if (IN_SET(r, -ENOSYS, -EPERM))
+                        openat2_unavailable = true;
+        }
+
         buffer = strdup(path);
         if (!buffer)
                 return -ENOMEM;
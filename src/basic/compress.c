@@ -1,5 +1,6 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 
+#include <fcntl.h>
 #include <inttypes.h>
 #include <malloc.h>
 #include <stdlib.h>
@@ -28,6 +29,8 @@
 #include "fileio.h"
 #include "io-util.h"
 #include "macro.h"
+#include "memory-util.h"
+#include "process-util.h"
 #include "sparse-endian.h"
 #include "string-table.h"
 #include "string-util.h"
@@ -60,12 +63,13 @@ DEFINE_TRIVIAL_CLEANUP_FUNC_FULL(LZ4F_decompressionContext_t, sym_LZ4F_freeDecom
 static void *zstd_dl = NULL;
 
 static DLSYM_PROTOTYPE(ZSTD_CCtx_setParameter) = NULL;
-static DLSYM_PROTOTYPE(ZSTD_compress) = NULL;
+static DLSYM_PROTOTYPE(ZSTD_compressCCtx) = NULL;
 static DLSYM_PROTOTYPE(ZSTD_compressStream2) = NULL;
 static DLSYM_PROTOTYPE(ZSTD_createCCtx) = NULL;
 static DLSYM_PROTOTYPE(ZSTD_createDCtx) = NULL;
 static DLSYM_PROTOTYPE(ZSTD_CStreamInSize) = NULL;
 static DLSYM_PROTOTYPE(ZSTD_CStreamOutSize) = NULL;
+static DLSYM_PROTOTYPE(ZSTD_DCtx_reset) = NULL;
 static DLSYM_PROTOTYPE(ZSTD_decompressStream) = NULL;
 static DLSYM_PROTOTYPE(ZSTD_DStreamInSize) = NULL;
 static DLSYM_PROTOTYPE(ZSTD_DStreamOutSize) = NULL;
@@ -79,6 +83,51 @@ static DLSYM_PROTOTYPE(ZSTD_isError) = NULL;
 DEFINE_TRIVIAL_CLEANUP_FUNC_FULL(ZSTD_CCtx*, sym_ZSTD_freeCCtx, NULL);
 DEFINE_TRIVIAL_CLEANUP_FUNC_FULL(ZSTD_DCtx*, sym_ZSTD_freeDCtx, NULL);
 
+/* Setting up a compression or decompression context is expensive compared to (de)compressing a single
+ * journal field, which typically is only a few hundred bytes. Hence keep one of each around for the main
+ * thread, which is where journald and journalctl do all their work. Other threads allocate them per call. */
+static ZSTD_CCtx *cached_cctx = NULL;
+static ZSTD_DCtx *cached_dctx = NULL;
+
+static ZSTD_CCtx* zstd_acquire_cctx(void) {
+        if (cached_cctx && is_main_thread())
+                return TAKE_PTR(cached_cctx);
+
+        return sym_ZSTD_createCCtx();
+}
+
+static void zstd_release_cctx(ZSTD_CCtx *cctx) {
+        if (!cctx)
+                return;
+
+        if (!cached_cctx && is_main_thread())
+                cached_cctx = cctx;
+        else
+                sym_ZSTD_freeCCtx(cctx);
+}
+
+DEFINE_TRIVIAL_CLEANUP_FUNC_FULL(ZSTD_CCtx*, zstd_release_cctx, NULL);
+
+static ZSTD_DCtx* zstd_acquire_dctx(void) {
+        if (cached_dctx && is_main_thread())
+                return TAKE_PTR(cached_dctx);
+
+        return sym_ZSTD_createDCtx();
+}
+
+static void zstd_release_dctx(ZSTD_DCtx *dctx) {
+        if (!dctx)
+                return;
+
+        /* We might have stopped in the middle of a frame, make sure the next user starts fresh. */
+        if (!cached_dctx && is_main_thread() && !sym_ZSTD_isError(sym_ZSTD_DCtx_reset(dctx, ZSTD_reset_session_only)))
+                cached_dctx = dctx;
+        else
+                sym_ZSTD_freeDCtx(dctx);
+}
+
+DEFINE_TRIVIAL_CLEANUP_FUNC_FULL(ZSTD_DCtx*, zstd_release_dctx, NULL);
+
 static int zstd_ret_to_errno(size_t ret) {
         switch (sym_ZSTD_getErrorCode(ret)) {
         case ZSTD_error_dstSize_tooSmall:
@@ -145,6 +194,58 @@ bool compression_supported(Compression c) {
         return BIT_SET(supported, c);
 }
 
+#if HAVE_COMPRESSION
+static bool decompress_can_write_sparse(int fd) {
+        struct stat st;
+        off_t offset;
+        int flags;
+
+        /* Holes may only be left where nothing has been written before, i.e. when appending to a regular
+         * file. Decompressed core files in particular tend to consist mostly of zero pages. With O_APPEND
+         * the kernel ignores our seeks and writes always go to the end, hence no holes in that case. */
+
+        if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode))
+                return false;
+
+        flags = fcntl(fd, F_GETFL);
+        if (flags < 0 || FLAGS_SET(flags, O_APPEND))
+                return false;
+
+        offset = lseek(fd, 0, SEEK_CUR);
+        return offset >= 0 && offset >= st.st_size;
+}
+
+static int decompress_write(int fd, const void *p, size_t n, bool sparse, usec_t timeout) {
+        ssize_t k;
+
+        if (!sparse)
+                return loop_write_full(fd, p, n, timeout);
+
+        k = sparse_write(fd, p, n, page_size());
+        if (k < 0)
+                return (int) k;
+
+        return 0;
+}
+
+static int decompress_finalize(int fd, bool sparse) {
+        off_t offset;
+
+        if (!sparse)
+                return 0;
+
+        /* sparse_write() seeks over trailing zeros, make sure the file size covers them. */
+        offset = lseek(fd, 0, SEEK_CUR);
+        if (offset < 0)
+                return -errno;
+
+        if (ftruncate(fd, offset) < 0)
+                return -errno;
+
+        return 0;
+}
+#endif
+
 #if HAVE_XZ
 int dlopen_lzma(void) {
         ELF_NOTE_DLOPEN("lzma",
@@ -290,9 +391,10 @@ int dlopen_zstd(void) {
                         &zstd_dl,
                         "libzstd.so.1", LOG_DEBUG,
                         DLSYM_ARG(ZSTD_getErrorCode),
-                        DLSYM_ARG(ZSTD_compress),
+                        DLSYM_ARG(ZSTD_compressCCtx),
                         DLSYM_ARG(ZSTD_getFrameContentSize),
                         DLSYM_ARG(ZSTD_decompressStream),
+                        DLSYM_ARG(ZSTD_DCtx_reset),
                         DLSYM_ARG(ZSTD_getErrorName),
                         DLSYM_ARG(ZSTD_DStreamOutSize),
                         DLSYM_ARG(ZSTD_CStreamInSize),
@@ -326,7 +428,11 @@ int compress_blob_zstd(
         if (r < 0)
                 return r;
 
-        k = sym_ZSTD_compress(dst, dst_alloc_size, src, src_size, level < 0 ? 0 : level);
+        _cleanup_(zstd_release_cctxp) ZSTD_CCtx *cctx = zstd_acquire_cctx();
+        if (!cctx)
+                return -ENOMEM;
+
+        k = sym_ZSTD_compressCCtx(cctx, dst, dst_alloc_size, src, src_size, level < 0 ? 0 : level);
         if (sym_ZSTD_isError(k))
                 return zstd_ret_to_errno(k);
 
@@ -477,7 +583,7 @@ int decompress_blob_zstd(
         if (!(greedy_realloc(dst, MAX(sym_ZSTD_DStreamOutSize(), size), 1)))
                 return -ENOMEM;
 
-        _cleanup_(sym_ZSTD_freeDCtxp) ZSTD_DCtx *dctx = sym_ZSTD_createDCtx();
+        _cleanup_(zstd_release_dctxp) ZSTD_DCtx *dctx = zstd_acquire_dctx();
         if (!dctx)
                 return -ENOMEM;
 
@@ -696,7 +802,7 @@ int decompress_startswith_zstd(
         if (size < prefix_len + 1)
                 return 0; /* Decompressed text too short to match the prefix and extra */
 
-        _cleanup_(sym_ZSTD_freeDCtxp) ZSTD_DCtx *dctx = sym_ZSTD_createDCtx();
+        _cleanup_(zstd_release_dctxp) ZSTD_DCtx *dctx = zstd_acquire_dctx();
         if (!dctx)
                 return -ENOMEM;
 
@@ -943,12 +1049,15 @@ int decompress_stream_xz(int fdf, int fdt, uint64_t max_bytes) {
 
         uint8_t buf[BUFSIZ], out[BUFSIZ];
         lzma_action action = LZMA_RUN;
+        bool sparse;
         int r;
 
         r = dlopen_lzma();
         if (r < 0)
                 return r;
 
+        sparse = decompress_can_write_sparse(fdt);
+
         ret = sym_lzma_stream_decoder(&s, UINT64_MAX, 0);
         if (ret != LZMA_OK)
                 return log_debug_errno(SYNTHETIC_ERRNO(ENOMEM),
@@ -993,7 +1102,7 @@ int decompress_stream_xz(int fdf, int fdt, uint64_t max_bytes) {
                                 max_bytes -= n;
                         }
 
-                        k = loop_write(fdt, out, n);
+                        k = decompress_write(fdt, out, n, sparse, /* timeout = */ 0);
                         if (k < 0)
                                 return k;
 
@@ -1002,7 +1111,7 @@ int decompress_stream_xz(int fdf, int fdt, uint64_t max_bytes) {
                                           s.total_in, s.total_out,
                                           (double) s.total_out / s.total_in * 100);
 
-                                return 0;
+                                return decompress_finalize(fdt, sparse);
                         }
                 }
         }
@@ -1019,6 +1128,7 @@ int decompress_stream_lz4(int in, int out, uint64_t max_bytes) {
         _cleanup_free_ char *buf = NULL;
         char *src;
         struct stat st;
+        bool sparse;
         int r;
         size_t total_in = 0, total_out = 0;
 
@@ -1026,6 +1136,8 @@ int decompress_stream_lz4(int in, int out, uint64_t max_bytes) {
         if (r < 0)
                 return r;
 
+        sparse = decompress_can_write_sparse(out);
+
         c = sym_LZ4F_createDecompressionContext(&ctx, LZ4F_VERSION);
         if (sym_LZ4F_isError(c))
                 return -ENOMEM;
@@ -1063,7 +1175,7 @@ int decompress_stream_lz4(int in, int out, uint64_t max_bytes) {
                         goto cleanup;
                 }
 
-                r = loop_write(out, buf, produced);
+                r = decompress_write(out, buf, produced, sparse, /* timeout = */ 0);
                 if (r < 0)
                         goto cleanup;
         }
@@ -1071,7 +1183,7 @@ int decompress_stream_lz4(int in, int out, uint64_t max_bytes) {
         log_debug("LZ4 decompression finished (%zu -> %zu bytes, %.1f%%)",
                   total_in, total_out,
                   total_in > 0 ? (double) total_out / total_in * 100 : 0.0);
-        r = 0;
+        r = decompress_finalize(out, sparse);
  cleanup:
         munmap(src, st.st_size);
         return r;
@@ -1201,11 +1313,15 @@ int decompress_stream_zstd(int fdf, int fdt, uint64_t max_bytes) {
         size_t in_allocsize, out_allocsize;
         size_t last_result = 0;
         uint64_t left = max_bytes, in_bytes = 0;
+        bool sparse;
         int r;
 
         r = dlopen_zstd();
         if (r < 0)
                 return r;
+
+        sparse = decompress_can_write_sparse(fdt);
+
         /* Create the context and buffers */
         in_allocsize = sym_ZSTD_DStreamInSize();
         out_allocsize = sym_ZSTD_DStreamOutSize();
@@ -1251,7 +1367,6 @@ int decompress_stream_zstd(int fdf, int fdt, uint64_t max_bytes) {
                                 .size = out_allocsize,
                                 .pos = 0
                         };
-                        ssize_t wrote;
                         /* The return code is zero if the frame is complete, but
                          * there may be multiple frames concatenated together.
                          * Zstd will automatically reset the context when a
@@ -1269,9 +1384,9 @@ int decompress_stream_zstd(int fdf, int fdt, uint64_t max_bytes) {
                         if (left < output.pos)
                                 return -EFBIG;
 
-                        wrote = loop_write_full(fdt, output.dst, output.pos, USEC_INFINITY);
-                        if (wrote < 0)
-                                return wrote;
+                        r = decompress_write(fdt, output.dst, output.pos, sparse, USEC_INFINITY);
+                        if (r < 0)
+                                return r;
 
                         left -= output.pos;
                 }
@@ -1296,7 +1411,8 @@ int decompress_stream_zstd(int fdf, int fdt, uint64_t max_bytes) {
                 in_bytes,
                 max_bytes - left,
                 (double) (max_bytes - left) / in_bytes * 100);
-        return 0;
+
+        return decompress_finalize(fdt, sparse);
 #else
         return log_debug_errno(SYNTHETIC_ERRNO(EPROTONOSUPPORT),
                                "Cannot decompress file. Compiled without ZSTD support.");
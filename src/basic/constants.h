@@ -84,6 +84,8 @@
 #define VARLINK_ADDR_PATH_MANAGED_OOM_SYSTEM "/run/systemd/io.systemd.ManagedOOM"
 /* Path where systemd-oomd listens for varlink connections from user managers to report changes in ManagedOOM settings. */
 #define VARLINK_ADDR_PATH_MANAGED_OOM_USER "/run/systemd/oom/io.systemd.ManagedOOM"
+/* Path where PID1 listens for varlink connections querying unit state. */
+#define VARLINK_ADDR_PATH_UNIT_SYSTEM "/run/systemd/io.systemd.Unit"
 
 /* Recommended baseline - see README for details */
 #define KERNEL_BASELINE_VERSION "5.7"
@@ -627,6 +627,29 @@ char** strv_env_clean_with_callback(char **e, void (*invalid_callback)(const cha
         return e;
 }
 
+char** strv_env_drop_invalid(char **e) {
+        size_t k = 0;
+
+        /* Like strv_env_clean(), but only drops invalid assignments, and doesn't look for duplicates. Use
+         * this on lists that are known to contain each variable only once, for example because they were
+         * generated by strv_env_merge(). This saves the duplicate search, which compares each entry with
+         * all entries after it. */
+
+        STRV_FOREACH(p, e) {
+                if (!env_assignment_is_valid(*p)) {
+                        free(*p);
+                        continue;
+                }
+
+                e[k++] = *p;
+        }
+
+        if (e)
+                e[k] = NULL;
+
+        return e;
+}
+
 static int strv_extend_with_length(char ***l, const char *s, size_t n) {
         char *c;
 
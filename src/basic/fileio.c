@@ -1594,13 +1594,13 @@ int read_line_full(FILE *f, size_t limit, ReadLineFlags flags, char **ret) {
         return (int) count;
 }
 
-int read_stripped_line(FILE *f, size_t limit, char **ret) {
+int read_stripped_line_full(FILE *f, size_t limit, ReadLineFlags flags, char **ret) {
         _cleanup_free_ char *s = NULL;
         int r, k;
 
         assert(f);
 
-        r = read_line(f, limit, ret ? &s : NULL);
+        r = read_line_full(f, limit, flags, ret ? &s : NULL);
         if (r < 0)
                 return r;
 
@@ -99,6 +99,13 @@ DEFINE_HASH_OPS_FULL(
                 void, trivial_hash_func, trivial_compare_func, free,
                 void, free);
 
+void pointer_hash_func(const void *p, struct siphash *state) {
+        siphash24_compress_typesafe(p, state);
+}
+
+DEFINE_HASH_OPS(pointer_hash_ops,
+                void, pointer_hash_func, trivial_compare_func);
+
 void uint64_hash_func(const uint64_t *p, struct siphash *state) {
         siphash24_compress_typesafe(*p, state);
 }
@@ -95,6 +95,12 @@ extern const struct hash_ops trivial_hash_ops_free;
 extern const struct hash_ops trivial_hash_ops_value_free;
 extern const struct hash_ops trivial_hash_ops_free_free;
 
+/* Like trivial_hash_ops, but only for maps keyed by pointers to objects we allocated ourselves, never by
+ * integers cast to pointers (PIDs, UIDs, …), which may be chosen by others. Such maps are hashed with a cheaper
+ * function than siphash24, see base_bucket_hash(). */
+void pointer_hash_func(const void *p, struct siphash *state);
+extern const struct hash_ops pointer_hash_ops;
+
 /* 32-bit values we can always just embed in the pointer itself, but in order to support 32-bit archs we need store 64-bit
  * values indirectly, since they don't fit in a pointer. */
 void uint64_hash_func(const uint64_t *p, struct siphash *state);
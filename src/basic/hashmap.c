@@ -24,6 +24,7 @@
 #include "sort-util.h"
 #include "string-util.h"
 #include "strv.h"
+#include "unaligned.h"
 
 #if ENABLE_DEBUG_HASHMAP
 #include "list.h"
@@ -341,10 +342,32 @@ static uint8_t* hash_key(HashmapBase *h) {
                                : shared_hash_key;
 }
 
+static uint64_t pointer_hash(const void *p, const uint8_t key[static HASH_KEY_SIZE]) {
+        uint64_t x;
+
+        /* Maps with pointer_hash_ops are keyed by addresses of objects we allocated ourselves, which
+         * nobody else can choose, hence going through a full siphash24 round for each lookup is overkill.
+         * Use the splitmix64 finalizer instead, which distributes such keys well, and mix in the map's
+         * random hash key so that the bucket layout is not predictable from the outside either. Maps keyed
+         * by integers, which may be controlled by peers, use trivial_hash_ops and hence siphash24. */
+
+        x = (uint64_t) (uintptr_t) p ^ unaligned_read_ne64(key);
+        x ^= x >> 30;
+        x *= UINT64_C(0xbf58476d1ce4e5b9);
+        x ^= x >> 27;
+        x *= UINT64_C(0x94d049bb133111eb);
+        x ^= x >> 31;
+
+        return x ^ unaligned_read_ne64(key + 8);
+}
+
 static unsigned base_bucket_hash(HashmapBase *h, const void *p) {
         struct siphash state;
         uint64_t hash;
 
+        if (h->hash_ops->hash == pointer_hash_func)
+                return (unsigned) (pointer_hash(p, hash_key(h)) % n_buckets(h));
+
         siphash24_init(&state, hash_key(h));
 
         h->hash_ops->hash(p, &state);
@@ -1245,7 +1268,9 @@ static unsigned base_bucket_scan(HashmapBase *h, unsigned idx, const void *key)
                         return IDX_NIL;
                 if (dib == distance) {
                         e = bucket_at(h, idx);
-                        if (h->hash_ops->compare(e->key, key) == 0)
+                        /* Callers frequently look up the very pointer that is stored as key (e.g. unit
+                         * names), in which case we can skip calling out to the comparison function. */
+                        if (e->key == key || h->hash_ops->compare(e->key, key) == 0)
                                 return idx;
                 }
 
@@ -1373,7 +1398,7 @@ void* _hashmap_get(HashmapBase *h, const void *key) {
         struct hashmap_base_entry *e;
         unsigned hash, idx;
 
-        if (!h)
+        if (!h || n_entries(h) == 0)
                 return NULL;
 
         hash = bucket_hash(h, key);
@@ -1389,7 +1414,7 @@ void* hashmap_get2(Hashmap *h, const void *key, void **key2) {
         struct plain_hashmap_entry *e;
         unsigned hash, idx;
 
-        if (!h)
+        if (!h || n_entries(HASHMAP_BASE(h)) == 0)
                 return NULL;
 
         hash = bucket_hash(h, key);
@@ -1407,7 +1432,7 @@ void* hashmap_get2(Hashmap *h, const void *key, void **key2) {
 bool _hashmap_contains(HashmapBase *h, const void *key) {
         unsigned hash;
 
-        if (!h)
+        if (!h || n_entries(h) == 0)
                 return false;
 
         hash = bucket_hash(h, key);
@@ -1419,7 +1444,7 @@ void* _hashmap_remove(HashmapBase *h, const void *key) {
         unsigned hash, idx;
         void *data;
 
-        if (!h)
+        if (!h || n_entries(h) == 0)
                 return NULL;
 
         hash = bucket_hash(h, key);
@@ -1439,7 +1464,7 @@ void* hashmap_remove2(Hashmap *h, const void *key, void **rkey) {
         unsigned hash, idx;
         void *data;
 
-        if (!h) {
+        if (!h || n_entries(HASHMAP_BASE(h)) == 0) {
                 if (rkey)
                         *rkey = NULL;
                 return NULL;
@@ -1556,7 +1581,7 @@ void* _hashmap_remove_value(HashmapBase *h, const void *key, void *value) {
         struct hashmap_base_entry *e;
         unsigned hash, idx;
 
-        if (!h)
+        if (!h || n_entries(h) == 0)
                 return NULL;
 
         hash = bucket_hash(h, key);
@@ -249,15 +249,26 @@ int fd_wait_for_event(int fd, int event, usec_t timeout) {
 static size_t nul_length(const uint8_t *p, size_t sz) {
         size_t n = 0;
 
-        while (sz > 0) {
-                if (*p != 0)
-                        break;
+        /* Compare byte-wise until we are aligned, then a word at a time, and the remainder byte-wise
+         * again. This is called on every block of (possibly many GB of) data we write sparsely. */
 
+        while (n < sz && (uintptr_t) (p + n) % sizeof(size_t) != 0) {
+                if (p[n] != 0)
+                        return n;
                 n++;
-                p++;
-                sz--;
         }
 
+        for (; sz - n >= sizeof(size_t); n += sizeof(size_t)) {
+                size_t w;
+
+                memcpy(&w, p + n, sizeof(w));
+                if (w != 0)
+                        break;
+        }
+
+        while (n < sz && p[n] == 0)
+                n++;
+
         return n;
 }
 
@@ -293,8 +304,11 @@ ssize_t sparse_write(int fd, const void *p, size_t sz, size_t run_length) {
                         w = q;
                 } else if (n > 0)
                         q += n;
-                else
-                        q++;
+                else {
+                        /* Not a NUL byte, skip ahead to the next one */
+                        const uint8_t *z = memchr(q, 0, e - q);
+                        q = z ?: e;
+                }
         }
 
         if (q > w) {
@@ -430,6 +430,24 @@ static bool check_console_fd_is_tty(void) {
         return console_fd_is_tty;
 }
 
+static pid_t log_gettid(void) {
+        static thread_local pid_t cached_tid = 0, cached_pid = 0;
+        pid_t pid;
+
+        /* gettid() is a syscall every time, and we include the TID in every log message, both on the
+         * console and in the journal. Cache it per thread, and refresh the cache after fork(), where the
+         * calling thread continues with a new TID. getpid_cached() is invalidated on fork(), hence use it
+         * to detect that case cheaply. */
+
+        pid = getpid_cached();
+        if (cached_pid != pid) {
+                cached_tid = gettid();
+                cached_pid = pid;
+        }
+
+        return cached_tid;
+}
+
 static int write_to_console(
                 int level,
                 int error,
@@ -469,7 +487,7 @@ static int write_to_console(
         }
 
         if (show_tid) {
-                xsprintf(tid_string, "(" PID_FMT ") ", gettid());
+                xsprintf(tid_string, "(" PID_FMT ") ", log_gettid());
                 iovec[n++] = IOVEC_MAKE_STRING(tid_string);
         }
 
@@ -668,7 +686,7 @@ static int log_do_header(
                      "SYSLOG_IDENTIFIER=%.256s\n",
                      LOG_PRI(level),
                      LOG_FAC(level),
-                     gettid(),
+                     log_gettid(),
                      isempty(file) ? "" : "CODE_FILE=",
                      isempty(file) ? "" : file,
                      isempty(file) ? "" : "\n",
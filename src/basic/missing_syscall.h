@@ -4,6 +4,7 @@
 /* Missing glibc definitions to access certain kernel APIs */
 
 #include <errno.h>
+#include <linux/openat2.h>
 #include <linux/time_types.h>
 #include <signal.h>
 #include <sys/syscall.h>
@@ -202,6 +203,17 @@ static inline int missing_close_range(unsigned first_fd, unsigned end_fd, unsign
 
 /* ======================================================================= */
 
+#if !HAVE_OPENAT2
+/* since kernel v5.6 (fddb5d430ad9fa91b49b1d34d0202ffe2fa0e179) */
+static inline int missing_openat2(int dirfd, const char *pathname, struct open_how *how, size_t size) {
+        return syscall(__NR_openat2, dirfd, pathname, how, size);
+}
+
+#  define openat2 missing_openat2
+#endif
+
+/* ======================================================================= */
+
 #if !HAVE_SCHED_SETATTR
 /* since kernel 3.14 (e6cfc0295c7d51b008999a8b13a44fb43f8685ea) */
 static inline ssize_t missing_sched_setattr(pid_t pid, struct sched_attr *attr, unsigned int flags) {
@@ -76,6 +76,12 @@ static void fallback_random_bytes(void *p, size_t n) {
 void random_bytes(void *p, size_t n) {
         static bool have_grndinsecure = true;
 
+        /* Note that we deliberately don't buffer or expand random data in userspace here. Recent libcs
+         * service getrandom() from the vDSO on kernels that support it, which keeps per-thread state that
+         * is wiped on fork() and reseeded by the kernel. That's already everything a userspace CSPRNG
+         * would give us, without the syscall, and with none of the pitfalls. GRND_INSECURE is supported
+         * on that path too. */
+
         assert(p || n == 0);
 
         if (n == 0)
@@ -211,6 +211,23 @@ int recurse_dir(
                 } else
                         p = de->entries[i]->d_name;
 
+                if (de->entries[i]->d_type == DT_UNKNOWN &&
+                    !FLAGS_SET(flags, RECURSE_DIR_INODE_FD) &&
+                    (statx_mask != 0 || FLAGS_SET(flags, RECURSE_DIR_ENSURE_TYPE))) {
+
+                        /* Some file systems don't report the inode type in the directory entries. If we need
+                         * to statx() the entry anyway, do so first, so that we don't have to try opening
+                         * every single non-directory as a directory before. If this fails, or it's a
+                         * directory, we continue below as if we didn't do this, the code there will handle
+                         * errors and races properly. */
+                        if (statx(dir_fd, de->entries[i]->d_name, AT_SYMLINK_NOFOLLOW, statx_mask | STATX_TYPE, &sx) >= 0 &&
+                            FLAGS_SET(sx.stx_mask, STATX_TYPE) &&
+                            !S_ISDIR(sx.stx_mode)) {
+                                de->entries[i]->d_type = IFTODT(sx.stx_mode);
+                                sx_valid = true;
+                        }
+                }
+
                 if (IN_SET(de->entries[i]->d_type, DT_UNKNOWN, DT_DIR)) {
                         subdir_fd = openat(dir_fd, de->entries[i]->d_name, O_DIRECTORY|O_NOFOLLOW|O_CLOEXEC);
                         if (subdir_fd < 0) {
@@ -305,7 +322,7 @@ int recurse_dir(
                                         inode_fd = safe_close(inode_fd);
                                 }
 
-                        } else if (statx_mask != 0 || (de->entries[i]->d_type == DT_UNKNOWN && (flags & RECURSE_DIR_ENSURE_TYPE))) {
+                        } else if (!sx_valid && (statx_mask != 0 || (de->entries[i]->d_type == DT_UNKNOWN && (flags & RECURSE_DIR_ENSURE_TYPE)))) {
 
                                 if (statx(dir_fd, de->entries[i]->d_name, AT_SYMLINK_NOFOLLOW, statx_mask | STATX_TYPE, &sx) < 0) {
                                         if (errno == ENOENT) /* Vanished by now? Go for next file immediately */
@@ -216,9 +216,17 @@ int null_or_empty_path_with_root(const char *fn, const char *root) {
         if (path_equal(path_startswith(fn, root ?: "/"), "dev/null"))
                 return true;
 
-        r = chase_and_stat(fn, root, CHASE_PREFIX_ROOT, NULL, &st);
-        if (r < 0)
-                return r;
+        /* Without a root directory the kernel can resolve the path for us, which is a lot cheaper than
+         * chase() opening each path component in turn. This matters, since this is called for every unit
+         * file when building the unit name map. */
+        if (empty_or_root(root)) {
+                if (stat(fn, &st) < 0)
+                        return -errno;
+        } else {
+                r = chase_and_stat(fn, root, CHASE_PREFIX_ROOT, NULL, &st);
+                if (r < 0)
+                        return r;
+        }
 
         return null_or_empty(&st);
 }
@@ -130,20 +130,55 @@ bool utf8_is_printable_newline(const char* str, size_t length, bool allow_newlin
         return true;
 }
 
+static size_t ascii_span_words(const char *str, size_t len) {
+        size_t i = 0;
+
+        /* Returns the length of the prefix of the first len bytes of str that consists only of ASCII
+         * characters other than NUL, looking at a word at a time. The result is a multiple of the word size,
+         * the remainder is left to the caller to check byte by byte. */
+
+        for (; len - i >= sizeof(uint64_t); i += sizeof(uint64_t)) {
+                uint64_t w;
+
+                memcpy(&w, str + i, sizeof(w));
+
+                if (w & UINT64_C(0x8080808080808080))
+                        break; /* non-ASCII byte */
+
+                /* With the high bits all clear, this sets a high bit iff there's a zero byte. */
+                if ((w - UINT64_C(0x0101010101010101)) & UINT64_C(0x8080808080808080))
+                        break;
+        }
+
+        return i;
+}
+
 char* utf8_is_valid_n(const char *str, size_t len_bytes) {
         /* Check if the string is composed of valid utf8 characters. If length len_bytes is given, stop after
          * len_bytes. Otherwise, stop at NUL. */
 
         assert(str);
 
-        for (size_t i = 0; len_bytes != SIZE_MAX ? i < len_bytes : str[i] != '\0'; ) {
+        /* Determine the length first if we aren't told, so that we can skip over ASCII a word at a time. */
+        if (len_bytes == SIZE_MAX)
+                len_bytes = strlen(str);
+
+        for (size_t i = 0; i < len_bytes; ) {
                 int len;
 
+                i += ascii_span_words(str + i, len_bytes - i);
+                if (i >= len_bytes)
+                        break;
+
                 if (_unlikely_(str[i] == '\0'))
                         return NULL; /* embedded NUL */
 
-                len = utf8_encoded_valid_unichar(str + i,
-                                                 len_bytes != SIZE_MAX ? len_bytes - i : SIZE_MAX);
+                if ((unsigned char) str[i] < 0x80) {
+                        i++;
+                        continue;
+                }
+
+                len = utf8_encoded_valid_unichar(str + i, len_bytes - i);
                 if (_unlikely_(len < 0))
                         return NULL; /* invalid character */
 
@@ -183,13 +218,15 @@ int utf8_char_console_width(const char *str) {
         char32_t c;
         int r;
 
+        /* Fast path for ASCII, which is what most strings we show in tables are made of. No need to decode
+         * anything or look the character up in the table of wide characters then. */
+        if ((unsigned char) *str < 0x80)
+                return *str == '\t' ? 8 : 1; /* Assume a tab width of 8 */
+
         r = utf8_encoded_to_unichar(str, &c);
         if (r < 0)
                 return r;
 
-        if (c == '\t')
-                return 8; /* Assume a tab width of 8 */
-
         /* TODO: we should detect combining characters */
 
         return unichar_iswide(c) ? 2 : 1;
@@ -277,7 +314,10 @@ char* ascii_is_valid_n(const char *str, size_t len) {
 
         assert(str);
 
-        for (size_t i = 0; len != SIZE_MAX ? i < len : str[i] != '\0'; i++)
+        if (len == SIZE_MAX)
+                len = strlen(str);
+
+        for (size_t i = ascii_span_words(str, len); i < len; i++)
                 if ((unsigned char) str[i] >= 128 || str[i] == '\0')
                         return NULL;
 
@@ -2324,6 +2324,16 @@ static void config_load_xbootldr(
         config_load_type1_entries(config, new_device, root_dir, NULL);
 }
 
+static void initrd_handles_freep(EFI_FILE ***handles) {
+        if (!*handles)
+                return;
+
+        for (EFI_FILE **h = *handles; *h; h++)
+                (*h)->Close(*h);
+
+        free(*handles);
+}
+
 static EFI_STATUS initrd_prepare(
                 EFI_FILE *root,
                 const BootEntry *entry,
@@ -2352,8 +2362,17 @@ static EFI_STATUS initrd_prepare(
         _cleanup_free_ char16_t *options = NULL;
 
         EFI_STATUS err;
-        size_t size = 0, padded_size = 0;
+        size_t size = 0, padded_size = 0, n_initrds = 0;
 
+        STRV_FOREACH(i, entry->initrd)
+                n_initrds++;
+
+        /* Keep the handles and sizes around for the second pass, so that we only need to open each file
+         * and query its size once. On slow firmware FAT drivers each of these calls is noticeable. */
+        _cleanup_(initrd_handles_freep) EFI_FILE **handles = xnew0(EFI_FILE*, n_initrds + 1);
+        _cleanup_free_ size_t *file_sizes = xnew(size_t, n_initrds);
+
+        size_t k = 0;
         STRV_FOREACH(i, entry->initrd) {
                 _cleanup_free_ char16_t *o = options;
                 if (o)
@@ -2361,17 +2380,19 @@ static EFI_STATUS initrd_prepare(
                 else
                         options = xasprintf("initrd=%ls", *i);
 
-                _cleanup_file_close_ EFI_FILE *handle = NULL;
-                err = root->Open(root, &handle, *i, EFI_FILE_MODE_READ, 0);
+                err = root->Open(root, &handles[k], *i, EFI_FILE_MODE_READ, 0);
                 if (err != EFI_SUCCESS)
                         return err;
 
                 _cleanup_free_ EFI_FILE_INFO *info = NULL;
-                err = get_file_info(handle, &info, NULL);
+                err = get_file_info(handles[k], &info, NULL);
                 if (err != EFI_SUCCESS)
                         return err;
 
-                size_t inc = info->FileSize;
+                if (info->FileSize > SIZE_MAX)
+                        return EFI_BAD_BUFFER_SIZE;
+
+                size_t inc = file_sizes[k++] = info->FileSize;
 
                 if (!INC_SAFE(&padded_size, ALIGN4(inc)))
                         return EFI_OUT_OF_RESOURCES;
@@ -2381,27 +2402,17 @@ static EFI_STATUS initrd_prepare(
         _cleanup_pages_ Pages pages = xmalloc_initrd_pages(padded_size);
         uint8_t *p = PHYSICAL_ADDRESS_TO_POINTER(pages.addr);
 
-        STRV_FOREACH(i, entry->initrd) {
-                _cleanup_file_close_ EFI_FILE *handle = NULL;
-                err = root->Open(root, &handle, *i, EFI_FILE_MODE_READ, 0);
-                if (err != EFI_SUCCESS)
-                        return err;
-
-                _cleanup_free_ EFI_FILE_INFO *info = NULL;
-                err = get_file_info(handle, &info, NULL);
-                if (err != EFI_SUCCESS)
-                        return err;
-
-                if (info->FileSize == 0) /* Automatically skip over empty files */
+        for (k = 0; k < n_initrds; k++) {
+                if (file_sizes[k] == 0) /* Automatically skip over empty files */
                         continue;
 
-                size_t read_size = info->FileSize;
-                err = chunked_read(handle, &read_size, p);
+                size_t read_size = file_sizes[k];
+                err = chunked_read(handles[k], &read_size, p);
                 if (err != EFI_SUCCESS)
                         return err;
 
                 /* Make sure the actual read size is what we expected. */
-                assert(read_size == info->FileSize);
+                assert(read_size == file_sizes[k]);
                 p += read_size;
 
                 size_t pad;
@@ -2413,7 +2424,7 @@ static EFI_STATUS initrd_prepare(
                 /* Exclude the trailing pad from size calculations. This would change the
                  * calculated hash, see https://github.com/systemd/systemd/issues/35439
                  * and https://bugzilla.suse.com/show_bug.cgi?id=1233752. */
-                if (*(i + 1))
+                if (k + 1 < n_initrds)
                         p += pad;
         }
 
@@ -134,7 +134,7 @@ static EFI_STATUS cc_measure_to_mr_and_ipl_event_log(
                         event);
 }
 
-static EFI_CC_MEASUREMENT_PROTOCOL *cc_interface_check(void) {
+static EFI_CC_MEASUREMENT_PROTOCOL *cc_interface_check_uncached(void) {
         EFI_CC_BOOT_SERVICE_CAPABILITY capability = {
                 .Size = sizeof(capability),
         };
@@ -155,7 +155,7 @@ static EFI_CC_MEASUREMENT_PROTOCOL *cc_interface_check(void) {
         return cc;
 }
 
-static EFI_TCG2_PROTOCOL *tcg2_interface_check(void) {
+static EFI_TCG2_PROTOCOL *tcg2_interface_check_uncached(void) {
         EFI_TCG2_BOOT_SERVICE_CAPABILITY capability = {
                 .Size = sizeof(capability),
         };
@@ -184,6 +184,34 @@ static EFI_TCG2_PROTOCOL *tcg2_interface_check(void) {
         return tcg;
 }
 
+/* The stub measures every section, addon, credential and sysext it processes, and each measurement looked up
+ * the protocols again and queried their capabilities. Neither changes while boot services are active, hence
+ * do this only once. */
+
+static EFI_CC_MEASUREMENT_PROTOCOL *cc_interface_check(void) {
+        static EFI_CC_MEASUREMENT_PROTOCOL *cache = NULL;
+        static bool cached = false;
+
+        if (!cached) {
+                cache = cc_interface_check_uncached();
+                cached = true;
+        }
+
+        return cache;
+}
+
+static EFI_TCG2_PROTOCOL *tcg2_interface_check(void) {
+        static EFI_TCG2_PROTOCOL *cache = NULL;
+        static bool cached = false;
+
+        if (!cached) {
+                cache = tcg2_interface_check_uncached();
+                cached = true;
+        }
+
+        return cache;
+}
+
 bool tpm_present(void) {
         return tcg2_interface_check();
 }
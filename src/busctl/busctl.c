@@ -33,6 +33,7 @@
 #include "pretty-print.h"
 #include "runtime-scope.h"
 #include "set.h"
+#include "signal-util.h"
 #include "sort-util.h"
 #include "strv.h"
 #include "terminal-util.h"
@@ -1255,6 +1256,12 @@ static int message_json(sd_bus_message *m, FILE *f) {
         return 0;
 }
 
+static volatile sig_atomic_t monitor_exit_requested = false;
+
+static void monitor_signal_handler(int sig) {
+        monitor_exit_requested = true;
+}
+
 static int monitor(int argc, char **argv, int (*dump)(sd_bus_message *m, FILE *f)) {
         _cleanup_(sd_bus_flush_close_unrefp) sd_bus *bus = NULL;
         _cleanup_(sd_bus_message_unrefp) sd_bus_message *message = NULL;
@@ -1339,9 +1346,24 @@ static int monitor(int argc, char **argv, int (*dump)(sd_bus_message *m, FILE *f
 
         (void) sd_notify(/* unset_environment=false */ false, "READY=1");
 
+        /* Output is only flushed once the queue is drained, see below. During a message storm that may not
+         * happen for a while, hence catch SIGINT/SIGTERM and return normally, so that the buffered tail of
+         * the output is written out before we exit. */
+        static const struct sigaction sa = {
+                .sa_handler = monitor_signal_handler,
+                .sa_flags = SA_RESTART,
+        };
+        assert_se(sigaction_many(&sa, SIGINT, SIGTERM) >= 0);
+
         for (;;) {
                 _cleanup_(sd_bus_message_unrefp) sd_bus_message *m = NULL;
 
+                if (monitor_exit_requested) {
+                        if (!arg_quiet && !sd_json_format_enabled(arg_json_format_flags))
+                                log_info("Received signal, exiting.");
+                        return 0;
+                }
+
                 r = sd_bus_process(bus, &m);
                 if (r < 0)
                         return log_error_errno(r, "Failed to process bus: %m");
@@ -1364,8 +1386,9 @@ static int monitor(int argc, char **argv, int (*dump)(sd_bus_message *m, FILE *f
                                 continue;
                         }
 
+                        /* Don't flush after each message, only once the queue is drained, see below. During
+                         * message storms this turns one write() per message into one per batch. */
                         dump(m, stdout);
-                        fflush(stdout);
 
                         if (arg_limit_messages != UINT64_MAX) {
                                 arg_limit_messages--;
@@ -1389,12 +1412,16 @@ static int monitor(int argc, char **argv, int (*dump)(sd_bus_message *m, FILE *f
                 if (r > 0)
                         continue;
 
+                fflush(stdout);
+
                 r = sd_bus_wait(bus, arg_timeout > 0 ? usec_sub_unsigned(end, now(CLOCK_MONOTONIC)) : UINT64_MAX);
                 if (r == 0 && arg_timeout > 0 && now(CLOCK_MONOTONIC) >= end) {
                         if (!arg_quiet && !sd_json_format_enabled(arg_json_format_flags))
                                 log_info("Timed out waiting for messages, exiting.");
                         return 0;
                 }
+                if (r == -EINTR)
+                        continue; /* Interrupted by a signal, checked above. */
                 if (r < 0)
                         return log_error_errno(r, "Failed to wait for bus: %m");
         }
@@ -441,7 +441,7 @@ static int process(
 }
 
 static int refresh_one(
-                const char *controller,
+                char * const *controllers,
                 const char *path,
                 Hashmap *a,
                 Hashmap *b,
@@ -453,18 +453,25 @@ static int refresh_one(
         Group *ours = NULL;
         int r;
 
-        assert(controller);
+        assert(!strv_isempty((char**) controllers));
         assert(path);
         assert(a);
 
         if (depth > arg_depth)
                 return 0;
 
-        r = process(controller, path, a, b, iteration, &ours);
-        if (r < 0)
-                return r;
+        STRV_FOREACH(c, controllers) {
+                Group *g = NULL;
+
+                r = process(*c, path, a, b, iteration, &g);
+                if (r < 0)
+                        return r;
+                if (g)
+                        ours = g;
+        }
 
-        r = cg_enumerate_subgroups(controller, path, &d);
+        /* All controllers passed here share the same hierarchy, hence enumerating via the first is enough. */
+        r = cg_enumerate_subgroups(controllers[0], path, &d);
         if (r == -ENOENT)
                 return 0;
         if (r < 0)
@@ -486,15 +493,16 @@ static int refresh_one(
 
                 path_simplify(p);
 
-                r = refresh_one(controller, p, a, b, iteration, depth + 1, &child);
+                r = refresh_one(controllers, p, a, b, iteration, depth + 1, &child);
                 if (r < 0)
                         return r;
 
                 if (arg_recursive &&
                     IN_SET(arg_count, COUNT_ALL_PROCESSES, COUNT_USERSPACE_PROCESSES) &&
+                    ours &&
                     child &&
                     child->n_tasks_valid &&
-                    streq(controller, SYSTEMD_CGROUP_CONTROLLER)) {
+                    strv_contains((char**) controllers, SYSTEMD_CGROUP_CONTROLLER)) {
 
                         /* Recursively sum up processes */
 
@@ -516,8 +524,19 @@ static int refresh_one(
 static int refresh(const char *root, Hashmap *a, Hashmap *b, unsigned iteration) {
         int r;
 
+        r = cg_all_unified();
+        if (r < 0)
+                return r;
+        if (r > 0) {
+                /* On the unified hierarchy all controllers live in the same tree, hence walk it only once
+                 * rather than once per controller. */
+                r = refresh_one(STRV_MAKE(SYSTEMD_CGROUP_CONTROLLER, "cpu", "memory", "io", "pids"),
+                                root, a, b, iteration, 0, NULL);
+                return r < 0 ? r : 0;
+        }
+
         FOREACH_STRING(c, SYSTEMD_CGROUP_CONTROLLER, "cpu", "cpuacct", "memory", "io", "blkio", "pids") {
-                r = refresh_one(c, root, a, b, iteration, 0, NULL);
+                r = refresh_one(STRV_MAKE(c), root, a, b, iteration, 0, NULL);
                 if (r < 0)
                         return r;
         }
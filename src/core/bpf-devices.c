@@ -8,15 +8,198 @@
 #include "devnum-util.h"
 #include "fd-util.h"
 #include "fileio.h"
+#include "hash-funcs.h"
 #include "missing_bpf.h"
 #include "nulstr-util.h"
 #include "parse-util.h"
 #include "path-util.h"
+#include "set.h"
+#include "siphash24.h"
+#include "static-destruct.h"
 #include "stdio-util.h"
 #include "string-util.h"
 
 #define PASS_JUMP_OFF 4096
 
+/* Upper limit on the number of distinct programs we remember, see below. */
+#define SHARED_PROGRAMS_MAX 1024U
+
+/* Device policies typically are identical across many units (think: thousands of instances of the same
+ * template), and loading a program into the kernel (i.e. running the verifier on it) is by far the most
+ * expensive part of applying them. Hence, remember the kernel IDs of programs we loaded, keyed by their
+ * instructions, so that further units with the same policy can just reference the existing program
+ * instead of loading a copy of it. We do not keep the programs pinned: the kernel drops them once the
+ * last unit referencing them is gone, and we then notice that the ID is stale on the next lookup. */
+typedef struct SharedProgram {
+        uint32_t prog_type;
+        size_t n_instructions;
+        struct bpf_insn *instructions;
+
+        uint32_t id;
+        uint8_t tag[BPF_TAG_SIZE];
+} SharedProgram;
+
+static SharedProgram* shared_program_free(SharedProgram *s) {
+        if (!s)
+                return NULL;
+
+        free(s->instructions);
+        return mfree(s);
+}
+
+DEFINE_TRIVIAL_CLEANUP_FUNC(SharedProgram*, shared_program_free);
+
+static void shared_program_hash_func(const SharedProgram *s, struct siphash *state) {
+        assert(s);
+
+        siphash24_compress_typesafe(s->prog_type, state);
+        siphash24_compress_typesafe(s->n_instructions, state);
+        siphash24_compress(s->instructions, s->n_instructions * sizeof(struct bpf_insn), state);
+}
+
+static int shared_program_compare_func(const SharedProgram *a, const SharedProgram *b) {
+        int r;
+
+        assert(a);
+        assert(b);
+
+        r = CMP(a->prog_type, b->prog_type);
+        if (r != 0)
+                return r;
+
+        r = CMP(a->n_instructions, b->n_instructions);
+        if (r != 0)
+                return r;
+
+        return memcmp(a->instructions, b->instructions, a->n_instructions * sizeof(struct bpf_insn));
+}
+
+DEFINE_PRIVATE_HASH_OPS_WITH_KEY_DESTRUCTOR(
+                shared_program_hash_ops,
+                SharedProgram,
+                shared_program_hash_func,
+                shared_program_compare_func,
+                shared_program_free);
+
+static Set *shared_programs = NULL;
+
+STATIC_DESTRUCTOR_REGISTER(shared_programs, set_freep);
+
+static int shared_program_acquire(BPFProgram *prog) {
+        SharedProgram key, *s;
+
+        assert(prog);
+
+        key = (SharedProgram) {
+                .prog_type = prog->prog_type,
+                .n_instructions = prog->n_instructions,
+                .instructions = prog->instructions,
+        };
+
+        s = set_get(shared_programs, &key);
+        if (!s)
+                return -ENOENT;
+
+        _cleanup_close_ int fd = bpf_program_get_fd_by_id(s->id);
+        if (fd >= 0) {
+                struct bpf_prog_info info = {};
+
+                /* Program IDs are recycled eventually, hence make sure this is still our program. */
+                if (bpf_program_get_info_by_fd(fd, &info, sizeof(info)) >= 0 &&
+                    info.type == s->prog_type &&
+                    memcmp(info.tag, s->tag, sizeof(s->tag)) == 0) {
+                        prog->kernel_fd = TAKE_FD(fd);
+                        return 0;
+                }
+        }
+
+        /* The program is gone, forget about it. */
+        shared_program_free(set_remove(shared_programs, s));
+        return -ENOENT;
+}
+
+static int shared_program_add(BPFProgram *prog) {
+        _cleanup_(shared_program_freep) SharedProgram *s = NULL;
+        struct bpf_prog_info info = {};
+        int r;
+
+        assert(prog);
+        assert(prog->kernel_fd >= 0);
+
+        /* Don't let the cache grow without bounds if policies are all different. */
+        if (set_size(shared_programs) >= SHARED_PROGRAMS_MAX)
+                set_clear(shared_programs);
+
+        r = bpf_program_get_info_by_fd(prog->kernel_fd, &info, sizeof(info));
+        if (r < 0)
+                return r;
+
+        s = new(SharedProgram, 1);
+        if (!s)
+                return -ENOMEM;
+
+        *s = (SharedProgram) {
+                .prog_type = prog->prog_type,
+                .n_instructions = prog->n_instructions,
+                .id = info.id,
+        };
+        memcpy(s->tag, info.tag, sizeof(s->tag));
+
+        s->instructions = newdup(struct bpf_insn, prog->instructions, prog->n_instructions);
+        if (!s->instructions)
+                return -ENOMEM;
+
+        r = set_ensure_put(&shared_programs, &shared_program_hash_ops, s);
+        if (r < 0)
+                return r;
+
+        TAKE_PTR(s);
+        return 0;
+}
+
+static int bpf_prog_load_shared(BPFProgram *prog) {
+        int r;
+
+        assert(prog);
+
+        if (prog->kernel_fd >= 0)
+                return 0;
+
+        if (shared_program_acquire(prog) >= 0) {
+                log_debug("Reusing already loaded device control BPF program.");
+                return 0;
+        }
+
+        r = bpf_program_load_kernel(prog, NULL, 0);
+        if (r < 0)
+                return r;
+
+        r = shared_program_add(prog);
+        if (r < 0)
+                log_debug_errno(r, "Failed to remember loaded device control BPF program, ignoring: %m");
+
+        return 0;
+}
+
+static bool bpf_program_attached_same(BPFProgram *installed, BPFProgram *prog, const char *controller_path) {
+        uint32_t a, b;
+
+        assert(prog);
+        assert(controller_path);
+
+        if (!installed || !installed->attached_path || !path_equal(installed->attached_path, controller_path))
+                return false;
+
+        if (installed->kernel_fd < 0 || prog->kernel_fd < 0)
+                return false;
+
+        if (bpf_program_get_id_by_fd(installed->kernel_fd, &a) < 0 ||
+            bpf_program_get_id_by_fd(prog->kernel_fd, &b) < 0)
+                return false;
+
+        return a == b;
+}
+
 /* Ensure the high level flags we use and the low-level BPF flags exposed on the kernel are defined the same way */
 assert_cc((unsigned) BPF_DEVCG_ACC_MKNOD == (unsigned) CGROUP_DEVICE_MKNOD);
 assert_cc((unsigned) BPF_DEVCG_ACC_READ  == (unsigned) CGROUP_DEVICE_READ);
@@ -237,6 +420,20 @@ int bpf_devices_apply_policy(
         if (r < 0)
                 return log_error_errno(r, "Failed to determine cgroup path: %m");
 
+        r = bpf_prog_load_shared(*prog);
+        if (r < 0)
+                return log_error_errno(r, "Loading device control BPF program failed: %m");
+
+        /* If the policy didn't change we got a reference to the very program that is already attached to
+         * this cgroup. The kernel refuses to attach the same program twice with BPF_F_ALLOW_MULTI, hence
+         * keep the existing attachment in that case. */
+        if (prog_installed && bpf_program_attached_same(*prog_installed, *prog, controller_path)) {
+                log_debug("Device control BPF program for cgroup %s is unchanged, keeping it attached.",
+                          empty_to_root(cgroup_path));
+                *prog = bpf_program_free(*prog);
+                return 0;
+        }
+
         r = bpf_program_cgroup_attach(*prog, BPF_CGROUP_DEVICE, controller_path, BPF_F_ALLOW_MULTI);
         if (r < 0)
                 return log_error_errno(r, "Attaching device control BPF program to cgroup %s failed: %m",
@@ -18,7 +18,9 @@
 #include "alloc-util.h"
 #include "bpf-firewall.h"
 #include "bpf-program.h"
+#include "cpu-set-util.h"
 #include "fd-util.h"
+#include "fileio.h"
 #include "in-addr-prefix-util.h"
 #include "memory-util.h"
 #include "missing_syscall.h"
@@ -511,7 +513,7 @@ static int bpf_firewall_prepare_accounting_maps(Unit *u, bool enabled, CGroupRun
         if (enabled) {
                 if (crt->ip_accounting_ingress_map_fd < 0) {
                         const char *name = strjoina("I_", u->id);
-                        r = bpf_map_new(name, BPF_MAP_TYPE_ARRAY, sizeof(int), sizeof(uint64_t), 2, 0);
+                        r = bpf_map_new(name, BPF_MAP_TYPE_PERCPU_ARRAY, sizeof(int), sizeof(uint64_t), 2, 0);
                         if (r < 0)
                                 return r;
 
@@ -520,7 +522,7 @@ static int bpf_firewall_prepare_accounting_maps(Unit *u, bool enabled, CGroupRun
 
                 if (crt->ip_accounting_egress_map_fd < 0) {
                         const char *name = strjoina("E_", u->id);
-                        r = bpf_map_new(name, BPF_MAP_TYPE_ARRAY, sizeof(int), sizeof(uint64_t), 2, 0);
+                        r = bpf_map_new(name, BPF_MAP_TYPE_PERCPU_ARRAY, sizeof(int), sizeof(uint64_t), 2, 0);
                         if (r < 0)
                                 return r;
 
@@ -787,23 +789,81 @@ int bpf_firewall_install(Unit *u) {
         return 0;
 }
 
+static int bpf_num_possible_cpus(void) {
+        static int cached = 0;
+        _cleanup_(cpu_set_reset) CPUSet possible = {};
+        _cleanup_free_ char *line = NULL;
+        int r;
+
+        /* The accounting maps are per-CPU arrays, and the kernel copies one value for each possible CPU
+         * in or out of them. Hence, we need to know how many that are, which is not necessarily the same
+         * as the number of online or configured CPUs. */
+
+        if (cached > 0)
+                return cached;
+
+        r = read_one_line_file("/sys/devices/system/cpu/possible", &line);
+        if (r < 0)
+                return r;
+
+        /* The file contains a list of ranges such as "0-7" or "0,2-3". We only care about the highest CPU
+         * index. */
+        r = parse_cpu_set(line, &possible);
+        if (r < 0)
+                return r;
+
+        for (size_t i = possible.allocated * 8; i > 0; i--)
+                if (CPU_ISSET_S(i - 1, possible.allocated, possible.set))
+                        return cached = (int) i;
+
+        return -EINVAL;
+}
+
+static int bpf_firewall_read_accounting_key(int map_fd, uint64_t key, uint64_t *ret) {
+        _cleanup_free_ uint64_t *values = NULL;
+        uint64_t sum = 0;
+        int n, r;
+
+        assert(map_fd >= 0);
+        assert(ret);
+
+        n = bpf_num_possible_cpus();
+        if (n < 0)
+                return n;
+
+        /* Zero-initialize, so that this also does the right thing for plain array maps that have been
+         * created by an older version of us and were passed across daemon-reexec: for those the kernel
+         * only copies out a single value. */
+        values = new0(uint64_t, n);
+        if (!values)
+                return -ENOMEM;
+
+        r = bpf_map_lookup_element(map_fd, &key, values);
+        if (r < 0)
+                return r;
+
+        FOREACH_ARRAY(v, values, n)
+                sum += *v;
+
+        *ret = sum;
+        return 0;
+}
+
 int bpf_firewall_read_accounting(int map_fd, uint64_t *ret_bytes, uint64_t *ret_packets) {
-        uint64_t key, packets;
+        uint64_t packets;
         int r;
 
         if (map_fd < 0)
                 return -EBADF;
 
         if (ret_packets) {
-                key = MAP_KEY_PACKETS;
-                r = bpf_map_lookup_element(map_fd, &key, &packets);
+                r = bpf_firewall_read_accounting_key(map_fd, MAP_KEY_PACKETS, &packets);
                 if (r < 0)
                         return r;
         }
 
         if (ret_bytes) {
-                key = MAP_KEY_BYTES;
-                r = bpf_map_lookup_element(map_fd, &key, ret_bytes);
+                r = bpf_firewall_read_accounting_key(map_fd, MAP_KEY_BYTES, ret_bytes);
                 if (r < 0)
                         return r;
         }
@@ -815,19 +875,28 @@ int bpf_firewall_read_accounting(int map_fd, uint64_t *ret_bytes, uint64_t *ret_
 }
 
 int bpf_firewall_reset_accounting(int map_fd) {
-        uint64_t key, value = 0;
-        int r;
+        _cleanup_free_ uint64_t *values = NULL;
+        uint64_t key;
+        int n, r;
 
         if (map_fd < 0)
                 return -EBADF;
 
+        n = bpf_num_possible_cpus();
+        if (n < 0)
+                return n;
+
+        values = new0(uint64_t, n);
+        if (!values)
+                return -ENOMEM;
+
         key = MAP_KEY_PACKETS;
-        r = bpf_map_update_element(map_fd, &key, &value);
+        r = bpf_map_update_element(map_fd, &key, values);
         if (r < 0)
                 return r;
 
         key = MAP_KEY_BYTES;
-        return bpf_map_update_element(map_fd, &key, &value);
+        return bpf_map_update_element(map_fd, &key, values);
 }
 
 static int bpf_firewall_unsupported_reason = 0;
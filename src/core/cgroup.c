@@ -39,6 +39,7 @@
 #include "stdio-util.h"
 #include "string-table.h"
 #include "string-util.h"
+#include "unit-trace.h"
 #include "virt.h"
 
 #if BPF_FRAMEWORK
@@ -3431,6 +3432,8 @@ static int unit_realize_cgroup_now(Unit *u, ManagerState state) {
 
         /* Now, reset the invalidation mask */
         crt->cgroup_invalidated_mask = 0;
+
+        UNIT_TRACE_POINT(cgroup_realize, u, crt->cgroup_path, (unsigned) target_mask);
         return 0;
 }
 
@@ -4170,26 +4173,31 @@ static int unit_check_cgroup_events(Unit *u) {
 }
 
 static int on_cgroup_inotify_event(sd_event_source *s, int fd, uint32_t revents, void *userdata) {
+        _cleanup_set_free_ Set *units = NULL;
         Manager *m = ASSERT_PTR(userdata);
+        Unit *u;
+        int r = 0;
 
         assert(s);
         assert(fd >= 0);
 
+        /* A cgroup usually generates a bunch of cgroup.events notifications in a row (e.g. when its last
+         * process exits while it is being frozen), hence collect the units first, and then read
+         * cgroup.events only once for each of them. */
+
         for (;;) {
                 union inotify_event_buffer buffer;
                 ssize_t l;
 
                 l = read(fd, &buffer, sizeof(buffer));
                 if (l < 0) {
-                        if (ERRNO_IS_TRANSIENT(errno))
-                                return 0;
+                        if (!ERRNO_IS_TRANSIENT(errno))
+                                r = log_error_errno(errno, "Failed to read control group inotify events: %m");
 
-                        return log_error_errno(errno, "Failed to read control group inotify events: %m");
+                        break;
                 }
 
                 FOREACH_INOTIFY_EVENT_WARN(e, buffer, l) {
-                        Unit *u;
-
                         if (e->wd < 0)
                                 /* Queue overflow has no watch descriptor */
                                 continue;
@@ -4202,7 +4210,8 @@ static int on_cgroup_inotify_event(sd_event_source *s, int fd, uint32_t revents,
                          * because it was queued before the removal. Let's ignore this here safely. */
 
                         u = hashmap_get(m->cgroup_control_inotify_wd_unit, INT_TO_PTR(e->wd));
-                        if (u)
+                        if (u && set_ensure_put(&units, NULL, u) < 0)
+                                /* Can't remember it for later, check it right away then */
                                 unit_check_cgroup_events(u);
 
                         u = hashmap_get(m->cgroup_memory_inotify_wd_unit, INT_TO_PTR(e->wd));
@@ -4210,6 +4219,11 @@ static int on_cgroup_inotify_event(sd_event_source *s, int fd, uint32_t revents,
                                 unit_add_to_cgroup_oom_queue(u);
                 }
         }
+
+        SET_FOREACH(u, units)
+                unit_check_cgroup_events(u);
+
+        return r;
 }
 
 static int cg_bpf_mask_supported(CGroupMask *ret) {
@@ -4968,11 +4982,16 @@ int unit_get_io_accounting(
                 uint64_t *ret) {
 
         uint64_t raw[_CGROUP_IO_ACCOUNTING_METRIC_MAX];
+        usec_t ts = 0;
         int r;
 
         /*
          * Retrieve an IO counter, subtracting the value of the counter value at the time the unit was started.
          * If ret == NULL and metric == _<...>_INVALID, no return value is expected (refresh the caches only).
+         *
+         * All counters are parsed from io.stat in one go, and e.g. a GetAll() D-Bus call asks for each of
+         * them in turn, hence if we already read io.stat during the current event loop iteration we simply
+         * return the values we got then.
          */
 
         assert(u);
@@ -4986,6 +5005,12 @@ int unit_get_io_accounting(
         if (!crt)
                 return -ENODATA;
 
+        if (metric >= 0 &&
+            sd_event_now(u->manager->event, CLOCK_MONOTONIC, &ts) == 0 &&
+            crt->io_accounting_timestamp == ts &&
+            crt->io_accounting_last[metric] != UINT64_MAX)
+                goto done;
+
         r = unit_get_io_accounting_raw(u, crt, raw);
         if (r == -ENODATA && metric >= 0 && crt->io_accounting_last[metric] != UINT64_MAX)
                 goto done;
@@ -5000,6 +5025,8 @@ int unit_get_io_accounting(
                         crt->io_accounting_last[i] = 0;
         }
 
+        crt->io_accounting_timestamp = ts;
+
 done:
         if (ret)
                 *ret = crt->io_accounting_last[metric];
@@ -5032,6 +5059,7 @@ static int unit_reset_io_accounting(Unit *unit, CGroupRuntime *crt) {
         zero(crt->io_accounting_base);
         FOREACH_ELEMENT(i, crt->io_accounting_last)
                 *i = UINT64_MAX;
+        crt->io_accounting_timestamp = 0;
 
         if (unit) {
                 r = unit_get_io_accounting_raw(unit, crt, crt->io_accounting_base);
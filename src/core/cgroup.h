@@ -314,6 +314,7 @@ typedef struct CGroupRuntime {
         /* Where the io.stat data was at the time the unit was started */
         uint64_t io_accounting_base[_CGROUP_IO_ACCOUNTING_METRIC_MAX];
         uint64_t io_accounting_last[_CGROUP_IO_ACCOUNTING_METRIC_MAX]; /* the most recently read value */
+        usec_t io_accounting_timestamp; /* event loop iteration timestamp of the most recent read */
 
         /* Counterparts in the cgroup filesystem */
         char *cgroup_path;
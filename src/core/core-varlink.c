@@ -10,6 +10,7 @@
 #include "varlink-internal.h"
 #include "varlink-io.systemd.UserDatabase.h"
 #include "varlink-io.systemd.ManagedOOM.h"
+#include "varlink-io.systemd.Unit.h"
 #include "varlink-io.systemd.service.h"
 #include "varlink-util.h"
 
@@ -357,6 +358,84 @@ static int vl_method_subscribe_managed_oom_cgroups(
         return sd_varlink_notify(m->managed_oom_varlink, v);
 }
 
+static int build_unit_json(Unit *u, sd_json_variant **ret) {
+        Unit *following;
+
+        assert(u);
+        assert(ret);
+
+        following = unit_following(u);
+
+        return sd_json_buildo(
+                        ret,
+                        SD_JSON_BUILD_PAIR_STRING("id", u->id),
+                        SD_JSON_BUILD_PAIR_STRING("description", unit_description(u)),
+                        SD_JSON_BUILD_PAIR_STRING("loadState", unit_load_state_to_string(u->load_state)),
+                        SD_JSON_BUILD_PAIR_STRING("activeState", unit_active_state_to_string(unit_active_state(u))),
+                        SD_JSON_BUILD_PAIR_STRING("freezerState", freezer_state_to_string(u->freezer_state)),
+                        SD_JSON_BUILD_PAIR_STRING("subState", unit_sub_state_to_string(u)),
+                        SD_JSON_BUILD_PAIR_CONDITION(!!following, "following", SD_JSON_BUILD_STRING(following ? following->id : NULL)),
+                        SD_JSON_BUILD_PAIR_CONDITION(!!u->job, "jobId", SD_JSON_BUILD_UNSIGNED(u->job ? u->job->id : 0)),
+                        SD_JSON_BUILD_PAIR_CONDITION(!!u->job, "jobType", SD_JSON_BUILD_STRING(u->job ? job_type_to_string(u->job->type) : NULL)));
+}
+
+static int vl_method_list_units(sd_varlink *link, sd_json_variant *parameters, sd_varlink_method_flags_t flags, void *userdata) {
+
+        static const sd_json_dispatch_field dispatch_table[] = {
+                { "name", SD_JSON_VARIANT_STRING, sd_json_dispatch_const_string, 0, 0 },
+                {}
+        };
+
+        _cleanup_(sd_json_variant_unrefp) sd_json_variant *v = NULL;
+        Manager *m = ASSERT_PTR(userdata);
+        const char *name = NULL, *k;
+        Unit *u;
+        int r;
+
+        assert(parameters);
+
+        r = sd_varlink_dispatch(link, parameters, dispatch_table, &name);
+        if (r != 0)
+                return r;
+
+        if (name) {
+                u = manager_get_unit(m, name);
+                if (!u)
+                        return sd_varlink_error(link, "io.systemd.Unit.NoSuchUnit", NULL);
+
+                r = build_unit_json(u, &v);
+                if (r < 0)
+                        return r;
+
+                return sd_varlink_reply(link, v);
+        }
+
+        if (!FLAGS_SET(flags, SD_VARLINK_METHOD_MORE))
+                return sd_varlink_error(link, SD_VARLINK_ERROR_EXPECTED_MORE, NULL);
+
+        HASHMAP_FOREACH_KEY(u, k, m->units) {
+                /* Skip aliases, every unit is reported exactly once under its primary name. */
+                if (k != u->id)
+                        continue;
+
+                if (v) {
+                        r = sd_varlink_notify(link, v);
+                        if (r < 0)
+                                return r;
+
+                        v = sd_json_variant_unref(v);
+                }
+
+                r = build_unit_json(u, &v);
+                if (r < 0)
+                        return r;
+        }
+
+        /* There's always at least one unit loaded (the root slice), hence v is never NULL here. */
+        assert(v);
+        return sd_varlink_reply(link, v);
+}
+
 static int vl_method_get_user_record(sd_varlink *link, sd_json_variant *parameters, sd_varlink_method_flags_t flags, void *userdata) {
 
         static const sd_json_dispatch_field dispatch_table[] = {
@@ -601,6 +680,7 @@ int manager_setup_varlink_server(Manager *m) {
                         s,
                         &vl_interface_io_systemd_UserDatabase,
                         &vl_interface_io_systemd_ManagedOOM,
+                        &vl_interface_io_systemd_Unit,
                         &vl_interface_io_systemd_service);
         if (r < 0)
                 return log_debug_errno(r, "Failed to add interfaces to varlink server: %m");
@@ -611,8 +691,10 @@ int manager_setup_varlink_server(Manager *m) {
                         "io.systemd.UserDatabase.GetGroupRecord", vl_method_get_group_record,
                         "io.systemd.UserDatabase.GetMemberships", vl_method_get_memberships,
                         "io.systemd.ManagedOOM.SubscribeManagedOOMCGroups", vl_method_subscribe_managed_oom_cgroups,
+                        "io.systemd.Unit.List", vl_method_list_units,
                         "io.systemd.service.Ping", varlink_method_ping,
-                        "io.systemd.service.GetEnvironment", varlink_method_get_environment);
+                        "io.systemd.service.GetEnvironment", varlink_method_get_environment,
+                        "io.systemd.service.GetMemoryStatistics", varlink_method_get_memory_statistics);
         if (r < 0)
                 return log_debug_errno(r, "Failed to register varlink methods: %m");
 
@@ -644,7 +726,10 @@ static int manager_varlink_init_system(Manager *m) {
         if (!MANAGER_IS_TEST_RUN(m)) {
                 (void) mkdir_label("/run/systemd/userdb", 0755);
 
-                FOREACH_STRING(address, "/run/systemd/userdb/io.systemd.DynamicUser", VARLINK_ADDR_PATH_MANAGED_OOM_SYSTEM) {
+                FOREACH_STRING(address,
+                               "/run/systemd/userdb/io.systemd.DynamicUser",
+                               VARLINK_ADDR_PATH_MANAGED_OOM_SYSTEM,
+                               VARLINK_ADDR_PATH_UNIT_SYSTEM) {
                         if (!fresh) {
                                 /* We might have got sockets through deserialization. Do not bind to them twice. */
 
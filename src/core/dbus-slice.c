@@ -1,12 +1,17 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 
+#include "bus-get-properties.h"
 #include "dbus-cgroup.h"
 #include "dbus-slice.h"
+#include "dbus-util.h"
+#include "job.h"
 #include "slice.h"
+#include "string-util.h"
 #include "unit.h"
 
 const sd_bus_vtable bus_slice_vtable[] = {
         SD_BUS_VTABLE_START(0),
+        SD_BUS_PROPERTY("JobConcurrencyMax", "u", bus_property_get_unsigned, offsetof(Slice, job_concurrency_max), 0),
         SD_BUS_VTABLE_END
 };
 
@@ -22,6 +27,9 @@ int bus_slice_set_property(
         assert(name);
         assert(u);
 
+        if (streq(name, "JobConcurrencyMax"))
+                return bus_set_transient_unsigned(u, name, &s->job_concurrency_max, message, flags, error);
+
         return bus_cgroup_set_property(u, &s->cgroup_context, name, message, flags, error);
 }
 
@@ -30,5 +38,8 @@ int bus_slice_commit_properties(Unit *u) {
 
         (void) unit_realize_cgroup(u);
 
+        /* JobConcurrencyMax= might have been raised, let held back start jobs run */
+        job_release_held_by_slice(u);
+
         return 0;
 }
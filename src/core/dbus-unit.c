@@ -1695,18 +1695,18 @@ const sd_bus_vtable bus_unit_cgroup_vtable[] = {
         SD_BUS_VTABLE_END
 };
 
+typedef struct UnitSignalData {
+        Unit *unit;
+        const char *path; /* Calculated once, rather than for each bus we send the signal on */
+} UnitSignalData;
+
 static int send_new_signal(sd_bus *bus, void *userdata) {
         _cleanup_(sd_bus_message_unrefp) sd_bus_message *m = NULL;
-        _cleanup_free_ char *p = NULL;
-        Unit *u = ASSERT_PTR(userdata);
+        UnitSignalData *d = ASSERT_PTR(userdata);
         int r;
 
         assert(bus);
 
-        p = unit_dbus_path(u);
-        if (!p)
-                return -ENOMEM;
-
         r = sd_bus_message_new_signal(
                         bus,
                         &m,
@@ -1716,7 +1716,7 @@ static int send_new_signal(sd_bus *bus, void *userdata) {
         if (r < 0)
                 return r;
 
-        r = sd_bus_message_append(m, "so", u->id, p);
+        r = sd_bus_message_append(m, "so", d->unit->id, d->path);
         if (r < 0)
                 return r;
 
@@ -1724,34 +1724,30 @@ static int send_new_signal(sd_bus *bus, void *userdata) {
 }
 
 static int send_changed_signal(sd_bus *bus, void *userdata) {
-        _cleanup_free_ char *p = NULL;
-        Unit *u = ASSERT_PTR(userdata);
+        UnitSignalData *d = ASSERT_PTR(userdata);
         int r;
 
         assert(bus);
 
-        p = unit_dbus_path(u);
-        if (!p)
-                return -ENOMEM;
-
         /* Send a properties changed signal. First for the specific
          * type, then for the generic unit. The clients may rely on
          * this order to get atomic behavior if needed. */
 
         r = sd_bus_emit_properties_changed_strv(
-                        bus, p,
-                        unit_dbus_interface_from_type(u->type),
+                        bus, d->path,
+                        unit_dbus_interface_from_type(d->unit->type),
                         NULL);
         if (r < 0)
                 return r;
 
         return sd_bus_emit_properties_changed_strv(
-                        bus, p,
+                        bus, d->path,
                         "org.freedesktop.systemd1.Unit",
                         NULL);
 }
 
 void bus_unit_send_change_signal(Unit *u) {
+        _cleanup_free_ char *p = NULL;
         int r;
         assert(u);
 
@@ -1766,7 +1762,13 @@ void bus_unit_send_change_signal(Unit *u) {
         if (!u->id)
                 return;
 
-        r = bus_foreach_bus(u->manager, u->bus_track, u->sent_dbus_new_signal ? send_changed_signal : send_new_signal, u);
+        p = unit_dbus_path(u);
+        if (!p)
+                r = -ENOMEM;
+        else
+                r = bus_foreach_bus(u->manager, u->bus_track,
+                                    u->sent_dbus_new_signal ? send_changed_signal : send_new_signal,
+                                    &(UnitSignalData) { .unit = u, .path = p });
         if (r < 0)
                 log_unit_debug_errno(u, r, "Failed to send unit change signal for %s: %m", u->id);
 
@@ -1825,16 +1827,11 @@ int bus_unit_send_pending_freezer_message(Unit *u, bool cancelled) {
 
 static int send_removed_signal(sd_bus *bus, void *userdata) {
         _cleanup_(sd_bus_message_unrefp) sd_bus_message *m = NULL;
-        _cleanup_free_ char *p = NULL;
-        Unit *u = ASSERT_PTR(userdata);
+        UnitSignalData *d = ASSERT_PTR(userdata);
         int r;
 
         assert(bus);
 
-        p = unit_dbus_path(u);
-        if (!p)
-                return -ENOMEM;
-
         r = sd_bus_message_new_signal(
                         bus,
                         &m,
@@ -1844,7 +1841,7 @@ static int send_removed_signal(sd_bus *bus, void *userdata) {
         if (r < 0)
                 return r;
 
-        r = sd_bus_message_append(m, "so", u->id, p);
+        r = sd_bus_message_append(m, "so", d->unit->id, d->path);
         if (r < 0)
                 return r;
 
@@ -1852,6 +1849,7 @@ static int send_removed_signal(sd_bus *bus, void *userdata) {
 }
 
 void bus_unit_send_removed_signal(Unit *u) {
+        _cleanup_free_ char *p = NULL;
         int r;
         assert(u);
 
@@ -1861,7 +1859,12 @@ void bus_unit_send_removed_signal(Unit *u) {
         if (!u->id)
                 return;
 
-        r = bus_foreach_bus(u->manager, u->bus_track, send_removed_signal, u);
+        p = unit_dbus_path(u);
+        if (!p)
+                r = -ENOMEM;
+        else
+                r = bus_foreach_bus(u->manager, u->bus_track, send_removed_signal,
+                                    &(UnitSignalData) { .unit = u, .path = p });
         if (r < 0)
                 log_unit_debug_errno(u, r, "Failed to send unit remove signal for %s: %m", u->id);
 }
@@ -834,37 +834,38 @@ static int acquire_credentials(
 
         /* Next, look for system credentials and credentials in the credentials store. Note that these do not
          * override any credentials found earlier. */
-        ExecImportCredential *ic;
-        ORDERED_SET_FOREACH(ic, context->import_credentials) {
-                _cleanup_free_ char **search_path = NULL;
+        if (!ordered_set_isempty(context->import_credentials)) {
+                _cleanup_strv_free_ char **search_path_trusted = NULL, **search_path_encrypted = NULL;
 
-                r = credential_search_path(params, CREDENTIAL_SEARCH_PATH_TRUSTED, &search_path);
+                /* The search paths are the same for all imports, hence determine them only once. */
+                r = credential_search_path(params, CREDENTIAL_SEARCH_PATH_TRUSTED, &search_path_trusted);
                 if (r < 0)
                         return r;
 
-                args.encrypted = false;
-
-                r = load_credential_glob(&args,
-                                         ic,
-                                         search_path,
-                                         READ_FULL_FILE_SECURE|READ_FULL_FILE_FAIL_WHEN_LARGER);
+                r = credential_search_path(params, CREDENTIAL_SEARCH_PATH_ENCRYPTED, &search_path_encrypted);
                 if (r < 0)
                         return r;
 
-                search_path = strv_free(search_path);
+                ExecImportCredential *ic;
+                ORDERED_SET_FOREACH(ic, context->import_credentials) {
+                        args.encrypted = false;
 
-                r = credential_search_path(params, CREDENTIAL_SEARCH_PATH_ENCRYPTED, &search_path);
-                if (r < 0)
-                        return r;
+                        r = load_credential_glob(&args,
+                                                 ic,
+                                                 search_path_trusted,
+                                                 READ_FULL_FILE_SECURE|READ_FULL_FILE_FAIL_WHEN_LARGER);
+                        if (r < 0)
+                                return r;
 
-                args.encrypted = true;
+                        args.encrypted = true;
 
-                r = load_credential_glob(&args,
-                                         ic,
-                                         search_path,
-                                         READ_FULL_FILE_SECURE|READ_FULL_FILE_FAIL_WHEN_LARGER|READ_FULL_FILE_UNBASE64);
-                if (r < 0)
-                        return r;
+                        r = load_credential_glob(&args,
+                                                 ic,
+                                                 search_path_encrypted,
+                                                 READ_FULL_FILE_SECURE|READ_FULL_FILE_FAIL_WHEN_LARGER|READ_FULL_FILE_UNBASE64);
+                        if (r < 0)
+                                return r;
+                }
         }
 
         /* Finally, we add in literally specified credentials. If the credentials already exist, we'll not
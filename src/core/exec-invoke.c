@@ -5282,7 +5282,8 @@ int exec_invoke(
                 *exit_status = EXIT_MEMORY;
                 return log_oom();
         }
-        accum_env = strv_env_clean(accum_env);
+        /* strv_env_merge() already made sure that each variable is listed only once */
+        accum_env = strv_env_drop_invalid(accum_env);
 
         (void) umask(context->umask);
 
@@ -70,6 +70,7 @@
 #include "tmpfile-util.h"
 #include "umask-util.h"
 #include "unit-serialize.h"
+#include "unit-trace.h"
 #include "user-util.h"
 #include "utmp-wtmp.h"
 
@@ -479,7 +480,7 @@ int exec_spawn(
                 const CGroupContext *cgroup_context,
                 PidRef *ret) {
 
-        _cleanup_free_ char *subcgroup_path = NULL, *max_log_levels = NULL, *executor_path = NULL;
+        _cleanup_free_ char *subcgroup_path = NULL, *max_log_levels = NULL;
         _cleanup_fdset_free_ FDSet *fdset = NULL;
         _cleanup_fclose_ FILE *f = NULL;
         int r;
@@ -487,6 +488,7 @@ int exec_spawn(
         assert(unit);
         assert(unit->manager);
         assert(unit->manager->executor_fd >= 0);
+        assert(unit->manager->executor_path);
         assert(command);
         assert(context);
         assert(params);
@@ -557,10 +559,6 @@ int exec_spawn(
         if (r < 0)
                 return log_unit_error_errno(unit, r, "Failed to convert max log levels to string: %m");
 
-        r = fd_get_path(unit->manager->executor_fd, &executor_path);
-        if (r < 0)
-                return log_unit_error_errno(unit, r, "Failed to get executor path from fd: %m");
-
         char serialization_fd_number[DECIMAL_STR_MAX(int)];
         xsprintf(serialization_fd_number, "%i", fileno(f));
 
@@ -577,10 +575,12 @@ int exec_spawn(
          * handoff timestamp. */
         dual_timestamp_now(&start_timestamp);
 
+        UNIT_TRACE_POINT(exec_spawn_begin, unit, command->path);
+
         /* The executor binary is pinned, to avoid compatibility problems during upgrades. */
         r = posix_spawn_wrapper(
                         FORMAT_PROC_FD_PATH(unit->manager->executor_fd),
-                        STRV_MAKE(executor_path,
+                        STRV_MAKE(unit->manager->executor_path,
                                   "--deserialize", serialization_fd_number,
                                   "--log-level", max_log_levels,
                                   "--log-target", log_target_to_string(manager_get_executor_log_target(unit->manager))),
@@ -607,6 +607,7 @@ int exec_spawn(
 
         log_unit_debug(unit, "Forked %s as " PID_FMT " (%s CLONE_INTO_CGROUP)",
                        command->path, pidref.pid, r > 0 ? "via" : "without");
+        UNIT_TRACE_POINT(exec_spawn_end, unit, command->path, pidref.pid);
 
         exec_status_start(&command->exec_status, pidref.pid, &start_timestamp);
 
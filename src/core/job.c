@@ -19,6 +19,7 @@
 #include "parse-util.h"
 #include "serialize.h"
 #include "set.h"
+#include "slice.h"
 #include "sort-util.h"
 #include "special.h"
 #include "stdio-util.h"
@@ -26,6 +27,7 @@
 #include "string-util.h"
 #include "strv.h"
 #include "terminal-util.h"
+#include "unit-trace.h"
 #include "unit.h"
 #include "virt.h"
 
@@ -132,6 +134,41 @@ Job* job_free(Job *j) {
         return mfree(j);
 }
 
+static void job_count_in_slice(Job *j, bool running) {
+        Unit *slice;
+        Slice *s;
+
+        assert(j);
+
+        /* Keeps track of the number of running start jobs in each slice, for JobConcurrencyMax=. The job
+         * type might change while the job is running, hence remember whether it was counted. */
+
+        slice = UNIT_GET_SLICE(j->unit);
+
+        if (running) {
+                if (!slice || !IN_SET(j->type, JOB_START, JOB_RESTART))
+                        return;
+
+                SLICE(slice)->n_running_start_jobs++;
+                j->counted_in_slice = true;
+                return;
+        }
+
+        if (!j->counted_in_slice)
+                return;
+
+        j->counted_in_slice = false;
+
+        if (!slice)
+                return;
+
+        s = SLICE(slice);
+        if (s->n_running_start_jobs > 0)
+                s->n_running_start_jobs--;
+
+        job_release_held_by_slice(slice);
+}
+
 static void job_set_state(Job *j, JobState state) {
         assert(j);
         assert(j->manager);
@@ -146,9 +183,10 @@ static void job_set_state(Job *j, JobState state) {
         if (!j->installed)
                 return;
 
-        if (j->state == JOB_RUNNING)
+        if (j->state == JOB_RUNNING) {
                 j->manager->n_running_jobs++;
-        else {
+                job_count_in_slice(j, true);
+        } else {
                 assert(j->state == JOB_WAITING);
                 assert(j->manager->n_running_jobs > 0);
 
@@ -156,6 +194,47 @@ static void job_set_state(Job *j, JobState state) {
 
                 if (j->manager->n_running_jobs <= 0)
                         j->manager->jobs_in_progress_event_source = sd_event_source_disable_unref(j->manager->jobs_in_progress_event_source);
+
+                job_count_in_slice(j, false);
+        }
+}
+
+static void job_unhold(Job *j) {
+        Slice *s;
+
+        assert(j);
+
+        if (!j->held_by_slice)
+                return;
+
+        s = SLICE(j->held_by_slice);
+
+        if (s->held_jobs_tail == j)
+                s->held_jobs_tail = j->slice_held_prev;
+        LIST_REMOVE(slice_held, s->held_jobs, j);
+
+        j->held_by_slice = NULL;
+}
+
+void job_release_held_by_slice(Unit *slice) {
+        Slice *s = SLICE(ASSERT_PTR(slice));
+        unsigned n_free;
+
+        /* Puts as many of the start jobs held back in the slice on the run queue as there are free slots,
+         * oldest first. If they turn out not to be runnable after all, they are held back again. */
+
+        if (s->job_concurrency_max == 0)
+                n_free = UINT_MAX;
+        else if (s->n_running_start_jobs < s->job_concurrency_max)
+                n_free = s->job_concurrency_max - s->n_running_start_jobs;
+        else
+                return;
+
+        for (; n_free > 0 && s->held_jobs_tail; n_free--) {
+                Job *j = s->held_jobs_tail;
+
+                job_unhold(j);
+                job_add_to_run_queue(j);
         }
 }
 
@@ -166,6 +245,7 @@ void job_uninstall(Job *j) {
         assert(j->installed);
 
         job_set_state(j, JOB_WAITING);
+        job_unhold(j);
 
         pj = j->type == JOB_NOP ? &j->unit->nop_job : &j->unit->job;
         assert(*pj == j);
@@ -282,6 +362,7 @@ Job* job_install(Job *j) {
         log_unit_debug(j->unit,
                        "Installed new job %s/%s as %u",
                        j->unit->id, job_type_to_string(j->type), (unsigned) j->id);
+        UNIT_TRACE_POINT(job_install, j->unit, j->id, job_type_to_string(j->type));
 
         job_add_to_gc_queue(j);
 
@@ -322,8 +403,10 @@ int job_install_deserialized(Job *j) {
         *pj = j;
         j->installed = true;
 
-        if (j->state == JOB_RUNNING)
+        if (j->state == JOB_RUNNING) {
                 j->manager->n_running_jobs++;
+                job_count_in_slice(j, true);
+        }
 
         log_unit_debug(j->unit,
                        "Reinstalled deserialized job %s/%s as %u",
@@ -523,6 +606,57 @@ int job_type_merge_and_collapse(JobType *a, JobType b, Unit *u) {
         return 0;
 }
 
+static bool job_is_held_back_by_slice(Job *j) {
+        Unit *slice;
+        Slice *s;
+
+        assert(j);
+
+        /* Checks whether the slice of the job's unit already has as many start jobs running as
+         * JobConcurrencyMax= permits. If so, the job is queued in the slice, to be put on the run queue
+         * again once a slot is free. */
+
+        if (!IN_SET(j->type, JOB_START, JOB_RESTART))
+                return false;
+
+        slice = UNIT_GET_SLICE(j->unit);
+        if (!slice)
+                return false;
+
+        s = SLICE(slice);
+        if (s->job_concurrency_max == 0 || s->n_running_start_jobs < s->job_concurrency_max)
+                return false;
+
+        log_unit_debug(j->unit,
+                       "starting held back, %u start jobs already running in %s",
+                       s->n_running_start_jobs, slice->id);
+
+        if (j->held_by_slice != slice) {
+                job_unhold(j);
+
+                LIST_PREPEND(slice_held, s->held_jobs, j);
+                if (!s->held_jobs_tail)
+                        s->held_jobs_tail = j;
+                j->held_by_slice = slice;
+        }
+
+        return true;
+}
+
+static void job_pass_on_slice_slot(Job *j) {
+        Unit *slice;
+
+        assert(j);
+
+        /* The job might have been put on the run queue because a slot in its slice became free, but it still
+         * has to wait for other jobs. Let the next job held back in the slice have the slot instead, so that
+         * it isn't left unused. */
+
+        slice = UNIT_GET_SLICE(j->unit);
+        if (slice && SLICE(slice)->held_jobs)
+                job_release_held_by_slice(slice);
+}
+
 static bool job_is_runnable(Job *j) {
         Unit *other;
 
@@ -551,6 +685,7 @@ static bool job_is_runnable(Job *j) {
                         log_unit_debug(j->unit,
                                        "starting held back, waiting for: %s",
                                        other->id);
+                        job_pass_on_slice_slot(j);
                         return false;
                 }
 
@@ -559,9 +694,15 @@ static bool job_is_runnable(Job *j) {
                         log_unit_debug(j->unit,
                                        "stopping held back, waiting for: %s",
                                        other->id);
+                        job_pass_on_slice_slot(j);
                         return false;
                 }
 
+        /* Only check JobConcurrencyMax= once the ordering dependencies are fulfilled, so that the jobs held
+         * back in the slice can run as soon as a slot becomes free, and don't wait for each other. */
+        if (job_is_held_back_by_slice(j))
+                return false;
+
         return true;
 }
 
@@ -923,10 +1064,14 @@ int job_run_and_invalidate(Job *j) {
         if (!job_is_runnable(j))
                 return -EAGAIN;
 
+        job_unhold(j);
+
         job_start_timer(j, true);
         job_set_state(j, JOB_RUNNING);
         job_add_to_dbus_queue(j);
 
+        UNIT_TRACE_POINT(job_start, j->unit, j->id, job_type_to_string(j->type));
+
         switch (j->type) {
 
                 case JOB_VERIFY_ACTIVE: {
@@ -1017,6 +1162,7 @@ int job_finish_and_invalidate(Job *j, JobResult result, bool recursive, bool alr
 
         log_unit_debug(u, "Job %" PRIu32 " %s/%s finished, result=%s",
                        j->id, u->id, job_type_to_string(t), job_result_to_string(result));
+        UNIT_TRACE_POINT(job_finish, u, j->id, job_type_to_string(t), job_result_to_string(result));
 
         /* If this job did nothing to the respective unit we don't log the status message */
         if (!already)
@@ -107,6 +107,7 @@ struct Job {
         LIST_FIELDS(Job, transaction);
         LIST_FIELDS(Job, dbus_queue);
         LIST_FIELDS(Job, gc_queue);
+        LIST_FIELDS(Job, slice_held);
 
         LIST_HEAD(JobDependency, subject_list);
         LIST_HEAD(JobDependency, object_list);
@@ -141,6 +142,9 @@ struct Job {
         /* If the job had a specific trigger that needs to be advertised (eg: a path unit), store it. */
         ActivationDetails *activation_details;
 
+        /* The slice unit this job is held back by due to JobConcurrencyMax=, if any */
+        Unit *held_by_slice;
+
         bool installed:1;
         bool in_run_queue:1;
 
@@ -155,6 +159,8 @@ struct Job {
         bool ref_by_private_bus:1;
 
         bool in_gc_queue:1;
+
+        bool counted_in_slice:1;
 };
 
 Job* job_new(Unit *unit, JobType type);
@@ -203,6 +209,7 @@ JobType job_type_collapse(JobType t, Unit *u);
 int job_type_merge_and_collapse(JobType *a, JobType b, Unit *u);
 
 void job_add_to_run_queue(Job *j);
+void job_release_held_by_slice(Unit *slice);
 void job_add_to_dbus_queue(Job *j);
 
 int job_start_timer(Job *j, bool job_running);
@@ -6192,14 +6192,20 @@ int unit_load_fragment(Unit *u) {
                 return 0;
         }
 
-        /* Possibly rebuild the fragment map to catch new units */
-        r = unit_file_build_name_map(&u->manager->lookup_paths,
-                                     &u->manager->unit_cache_timestamp_hash,
-                                     &u->manager->unit_id_map,
-                                     &u->manager->unit_name_map,
-                                     &u->manager->unit_path_cache);
-        if (r < 0)
-                return log_error_errno(r, "Failed to rebuild name map: %m");
+        /* Possibly rebuild the fragment map to catch new units. Checking whether the cache is still
+         * up-to-date means stat()ing every unit directory, hence while dispatching the load queue do this
+         * only once rather than for every unit, which matters for the many units loaded at startup. */
+        if (!u->manager->unit_cache_validated) {
+                r = unit_file_build_name_map(&u->manager->lookup_paths,
+                                             &u->manager->unit_cache_timestamp_hash,
+                                             &u->manager->unit_id_map,
+                                             &u->manager->unit_name_map,
+                                             &u->manager->unit_path_cache);
+                if (r < 0)
+                        return log_error_errno(r, "Failed to rebuild name map: %m");
+
+                u->manager->unit_cache_validated = u->manager->dispatching_load_queue;
+        }
 
         r = unit_file_find_fragment(u->manager->unit_id_map,
                                     u->manager->unit_name_map,
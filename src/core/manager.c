@@ -119,6 +119,12 @@
 /* How many units and jobs to process of the bus queue before returning to the event loop. */
 #define MANAGER_BUS_MESSAGE_BUDGET 100U
 
+/* How many units to check in one go when garbage collecting, before giving the event loop a chance to run. */
+#define MANAGER_GC_UNIT_BUDGET 1000U
+
+/* How many notification messages to process per wakeup of the notify socket before returning to the event loop. */
+#define MANAGER_NOTIFY_MESSAGE_BUDGET 32U
+
 #define DEFAULT_TASKS_MAX ((CGroupTasksMax) { 15U, 100U }) /* 15% */
 
 static int manager_dispatch_notify_fd(sd_event_source *source, int fd, uint32_t revents, void *userdata);
@@ -760,6 +766,7 @@ static void manager_free_unit_name_maps(Manager *m) {
         m->unit_name_map = hashmap_free(m->unit_name_map);
         m->unit_path_cache = set_free(m->unit_path_cache);
         m->unit_cache_timestamp_hash = 0;
+        m->unit_cache_validated = false;
 }
 
 static int manager_setup_run_queue(Manager *m) {
@@ -1052,12 +1059,12 @@ int manager_new(RuntimeScope runtime_scope, ManagerTestRunFlags test_run_flags,
                 if (m->executor_fd < 0)
                         return log_debug_errno(m->executor_fd, "Failed to pin executor binary: %m");
 
-                if (DEBUG_LOGGING) {
-                        _cleanup_free_ char *executor_path = NULL;
+                /* Resolve the path once here, rather than on every spawn, we only use it for argv[0]. */
+                r = fd_get_path(m->executor_fd, &m->executor_path);
+                if (r < 0)
+                        return log_debug_errno(r, "Failed to get path of executor binary: %m");
 
-                        (void) fd_get_path(m->executor_fd, &executor_path);
-                        log_debug("Using systemd-executor binary from '%s'.", strna(executor_path));
-                }
+                log_debug("Using systemd-executor binary from '%s'.", m->executor_path);
         }
 
         /* Note that we do not set up the notify fd here. We do that after deserialization,
@@ -1482,7 +1489,8 @@ static unsigned manager_dispatch_gc_unit_queue(Manager *m) {
 
         gc_marker = m->gc_marker;
 
-        while ((u = LIST_POP(gc_queue, m->gc_unit_queue))) {
+        /* Don't process more than a batch at a time, see manager_loop(). */
+        while (n < MANAGER_GC_UNIT_BUDGET && (u = LIST_POP(gc_queue, m->gc_unit_queue))) {
                 assert(u->in_gc_queue);
 
                 unit_gc_sweep(u, gc_marker);
@@ -1827,6 +1835,7 @@ Manager* manager_free(Manager *m) {
 #endif
 
         safe_close(m->executor_fd);
+        free(m->executor_path);
 
         return mfree(m);
 }
@@ -2384,6 +2393,7 @@ unsigned manager_dispatch_load_queue(Manager *m) {
                 return 0;
 
         m->dispatching_load_queue = true;
+        m->unit_cache_validated = false;
 
         /* Dispatches the load queue. Takes a unit from the queue and
          * tries to load its data until the queue is empty */
@@ -2396,6 +2406,7 @@ unsigned manager_dispatch_load_queue(Manager *m) {
         }
 
         m->dispatching_load_queue = false;
+        m->unit_cache_validated = false;
 
         /* Dispatch the units waiting for their target dependencies to be added now, as all targets that we know about
          * should be loaded and have aliases resolved */
@@ -2810,35 +2821,27 @@ static int manager_get_units_for_pidref(Manager *m, const PidRef *pidref, Unit *
         return (int) n;
 }
 
-static int manager_dispatch_notify_fd(sd_event_source *source, int fd, uint32_t revents, void *userdata) {
-        Manager *m = ASSERT_PTR(userdata);
+static int manager_process_notify_message(Manager *m) {
         _cleanup_(pidref_done) PidRef pidref = PIDREF_NULL;
         struct ucred ucred;
         _cleanup_(fdset_free_asyncp) FDSet *fds = NULL;
         int r;
 
-        assert(m->notify_fd == fd);
+        assert(m);
 
-        if (revents != EPOLLIN) {
-                log_warning("Got unexpected poll event for notify fd.");
-                return 0;
-        }
+        /* Returns > 0 if a message was processed, 0 if there was none queued or it was invalid. */
 
         _cleanup_strv_free_ char **tags = NULL;
         r = notify_recv_with_fds_strv(m->notify_fd, &tags, &ucred, &pidref, &fds);
         if (r == -EAGAIN)
                 return 0;
         if (r < 0)
-                /* If this is any other, real error, then stop processing this socket. This of course means
-                 * we won't take notification messages anymore, but that's still better than busy looping:
-                 * being woken up over and over again, but being unable to actually read the message from the
-                 * socket. */
                 return r;
 
         /* Possibly a barrier fd, let's see. */
         if (manager_process_barrier_fd(tags, fds)) {
                 log_debug("Received barrier notification message from PID " PID_FMT ".", pidref.pid);
-                return 0;
+                return 1;
         }
 
         /* Increase the generation counter used for filtering out duplicate unit invocations. */
@@ -2850,7 +2853,7 @@ static int manager_dispatch_notify_fd(sd_event_source *source, int fd, uint32_t
         int n_array = manager_get_units_for_pidref(m, &pidref, &array);
         if (n_array < 0) {
                 log_warning_errno(n_array, "Failed to determine units for PID " PID_FMT ", ignoring: %m", pidref.pid);
-                return 0;
+                return 1;
         }
         if (n_array == 0)
                 log_debug("Cannot find unit for notify message of PID "PID_FMT", ignoring.", pidref.pid);
@@ -2863,6 +2866,35 @@ static int manager_dispatch_notify_fd(sd_event_source *source, int fd, uint32_t
         if (!fdset_isempty(fds))
                 log_warning("Got extra auxiliary fds with notification message, closing them.");
 
+        return 1;
+}
+
+static int manager_dispatch_notify_fd(sd_event_source *source, int fd, uint32_t revents, void *userdata) {
+        Manager *m = ASSERT_PTR(userdata);
+        int r;
+
+        assert(m->notify_fd == fd);
+
+        if (revents != EPOLLIN) {
+                log_warning("Got unexpected poll event for notify fd.");
+                return 0;
+        }
+
+        /* Services with a watchdog or frequent STATUS= updates keep sending us messages, process a bunch of
+         * them per wakeup instead of going through the event loop for each one. But not too many, so that
+         * other event sources still get their turn. */
+        for (unsigned i = 0; i < MANAGER_NOTIFY_MESSAGE_BUDGET; i++) {
+                r = manager_process_notify_message(m);
+                if (r < 0)
+                        /* If this is any other, real error, then stop processing this socket. This of course
+                         * means we won't take notification messages anymore, but that's still better than
+                         * busy looping: being woken up over and over again, but being unable to actually read
+                         * the message from the socket. */
+                        return r;
+                if (r == 0)
+                        break;
+        }
+
         return 0;
 }
 
@@ -3332,6 +3364,7 @@ static int manager_dispatch_jobs_in_progress(sd_event_source *source, usec_t use
 
 int manager_loop(Manager *m) {
         RateLimit rl = { .interval = 1*USEC_PER_SEC, .burst = 50000 };
+        bool gc_interrupted = false;
         int r;
 
         assert(m);
@@ -3360,11 +3393,27 @@ int manager_loop(Manager *m) {
                 if (manager_dispatch_gc_job_queue(m) > 0)
                         continue;
 
-                if (manager_dispatch_gc_unit_queue(m) > 0)
+                if (manager_dispatch_cleanup_queue(m) > 0)
                         continue;
 
-                if (manager_dispatch_cleanup_queue(m) > 0)
+                if (gc_interrupted) {
+                        /* The GC queue had more units in it than we check in one go (e.g. after lots of
+                         * transient units were stopped at once). Everything collected so far has been
+                         * cleaned up by now, and the remaining units in the GC queue are just candidates,
+                         * hence it's safe to dispatch a pending event here, so that we don't stop responding
+                         * to clients while working through it all. */
+                        gc_interrupted = false;
+
+                        r = sd_event_run(m->event, 0);
+                        if (r < 0)
+                                return log_error_errno(r, "Failed to run event loop: %m");
                         continue;
+                }
+
+                if (manager_dispatch_gc_unit_queue(m) > 0) {
+                        gc_interrupted = m->gc_unit_queue;
+                        continue;
+                }
 
                 if (manager_dispatch_cgroup_realize_queue(m) > 0)
                         continue;
@@ -3653,10 +3702,13 @@ int manager_reload(Manager *m) {
         _unused_ _cleanup_(manager_reloading_stopp) Manager *reloading = NULL;
         _cleanup_fdset_free_ FDSet *fds = NULL;
         _cleanup_fclose_ FILE *f = NULL;
+        usec_t ts_start, ts_serialized, ts_generated, ts_done;
         int r;
 
         assert(m);
 
+        ts_start = now(CLOCK_MONOTONIC);
+
         r = manager_open_serialization(m, &f);
         if (r < 0)
                 return log_error_errno(r, "Failed to create serialization file: %m");
@@ -3679,6 +3731,8 @@ int manager_reload(Manager *m) {
         /* 💀 This is the point of no return, from here on there is no way back. 💀 */
         reloading = NULL;
 
+        ts_serialized = now(CLOCK_MONOTONIC);
+
         bus_manager_send_reloading(m, true);
 
         /* Start by flushing out all jobs and units, all generated units, all runtime environments, all dynamic users
@@ -3695,6 +3749,8 @@ int manager_reload(Manager *m) {
         (void) manager_run_environment_generators(m);
         (void) manager_run_generators(m);
 
+        ts_generated = now(CLOCK_MONOTONIC);
+
         /* We flushed out generated files, for which we don't watch mtime, so we should flush the old map. */
         manager_free_unit_name_maps(m);
         m->unit_file_state_outdated = false;
@@ -3735,6 +3791,14 @@ int manager_reload(Manager *m) {
 
         manager_ready(m);
 
+        /* The reload blocks everything else we do, hence let's make it easy to see where the time went */
+        ts_done = now(CLOCK_MONOTONIC);
+        log_debug("Reload took %s (serialization %s, generators %s, loading and deserialization %s).",
+                  FORMAT_TIMESPAN(usec_sub_unsigned(ts_done, ts_start), USEC_PER_MSEC),
+                  FORMAT_TIMESPAN(usec_sub_unsigned(ts_serialized, ts_start), USEC_PER_MSEC),
+                  FORMAT_TIMESPAN(usec_sub_unsigned(ts_generated, ts_serialized), USEC_PER_MSEC),
+                  FORMAT_TIMESPAN(usec_sub_unsigned(ts_done, ts_generated), USEC_PER_MSEC));
+
         m->send_reloading_done = true;
         return 0;
 }
@@ -299,6 +299,9 @@ struct Manager {
         Hashmap *unit_name_map;
         Set *unit_path_cache;
         uint64_t unit_cache_timestamp_hash;
+        /* Set once the unit cache has been validated against the disk during the current load queue
+         * dispatch, so that we don't stat() all unit directories again for every single unit loaded. */
+        bool unit_cache_validated;
 
         /* We don't have support for atomically enabling/disabling units, and unit_file_state might become
          * outdated if such operations failed half-way. Therefore, we set this flag if changes to unit files
@@ -511,6 +514,7 @@ struct Manager {
         /* Pin the systemd-executor binary, so that it never changes until re-exec, ensuring we don't have
          * serialization/deserialization compatibility issues during upgrades. */
         int executor_fd;
+        char *executor_path;
 
         unsigned soft_reboots_count;
 
@@ -1936,7 +1936,7 @@ static int mount_setup_unit(
         return 0;
 }
 
-static int mount_load_proc_self_mountinfo(Manager *m, bool set_flags) {
+static int mount_load_proc_self_mountinfo(Manager *m, bool set_flags, Set **ret_devices) {
         _cleanup_(mnt_free_tablep) struct libmnt_table *table = NULL;
         _cleanup_(mnt_free_iterp) struct libmnt_iter *iter = NULL;
         _cleanup_set_free_ Set *devices = NULL;
@@ -1975,6 +1975,11 @@ static int mount_load_proc_self_mountinfo(Manager *m, bool set_flags) {
                 (void) mount_setup_unit(m, device, path, options, fstype, set_flags);
         }
 
+        /* Note, if we hit OOM above, some devices may be missing in the set. Hence, the set can only be
+         * used as a hint by the caller. */
+        if (ret_devices)
+                *ret_devices = TAKE_PTR(devices);
+
         return 0;
 }
 
@@ -2150,7 +2155,7 @@ static void mount_enumerate(Manager *m) {
                 (void) sd_event_source_set_description(m->mount_event_source, "mount-monitor-dispatch");
         }
 
-        r = mount_load_proc_self_mountinfo(m, false);
+        r = mount_load_proc_self_mountinfo(m, /* set_flags = */ false, /* ret_devices = */ NULL);
         if (r < 0)
                 goto fail;
 
@@ -2194,7 +2199,10 @@ static int mount_process_proc_self_mountinfo(Manager *m) {
         if (r <= 0)
                 return r;
 
-        r = mount_load_proc_self_mountinfo(m, true);
+        /* The set of devices currently listed in /proc/self/mountinfo is collected while parsing it anyway,
+         * so use it to determine which of the devices that vanished from mount units are still mounted
+         * elsewhere, rather than re-collecting the devices of all mounted units below. */
+        r = mount_load_proc_self_mountinfo(m, /* set_flags = */ true, &around);
         if (r < 0) {
                 /* Reset flags, just in case, for later calls */
                 LIST_FOREACH(units_by_type, u, m->units_by_type[UNIT_MOUNT])
@@ -2273,13 +2281,6 @@ static int mount_process_proc_self_mountinfo(Manager *m) {
                         }
                 }
 
-                if (mount_is_mounted(mount) &&
-                    mount->from_proc_self_mountinfo &&
-                    mount->parameters_proc_self_mountinfo.what)
-                        /* Track devices currently used */
-                        if (set_put_strdup_full(&around, &path_hash_ops_free, mount->parameters_proc_self_mountinfo.what) < 0)
-                                log_oom();
-
                 /* Reset the flags for later calls */
                 mount->proc_flags = 0;
         }
@@ -617,6 +617,39 @@ static void path_enter_waiting(Path *p, bool initial, bool from_trigger_notify)
         path_set_state(p, PATH_WAITING);
 }
 
+static void path_rewatch_spec(Path *p, PathSpec *s) {
+        _cleanup_free_ char *trigger_path = NULL;
+        int r;
+
+        assert(p);
+        assert(s);
+        assert(p->state == PATH_WAITING);
+
+        /* Called when an inotify event on a single spec did not trigger us directly. Only the watches of
+         * that spec might have become stale (e.g. because a path component was created or moved), the
+         * watches of all other specs are still intact, hence don't tear down and rebuild all of them, which
+         * gets expensive for units with many specs and busy directories. */
+
+        if (path_check_good(p, false, false, &trigger_path)) {
+                log_unit_debug(UNIT(p), "Got triggered by '%s'.", trigger_path);
+                path_enter_running(p, trigger_path);
+                return;
+        }
+
+        r = path_spec_watch(s, path_dispatch_io);
+        if (r < 0) {
+                log_unit_warning_errno(UNIT(p), r, "Failed to update inotify watches for '%s': %m", s->path);
+                path_enter_dead(p, PATH_FAILURE_RESOURCES);
+                return;
+        }
+
+        /* As in path_enter_waiting(), the path might have changed while we were re-adding the watches */
+        if (path_spec_check_good(s, false, false, &trigger_path)) {
+                log_unit_debug(UNIT(p), "Got triggered by '%s'.", trigger_path);
+                path_enter_running(p, trigger_path);
+        }
+}
+
 static void path_mkdir(Path *p) {
         assert(p);
 
@@ -792,6 +825,8 @@ static int path_dispatch_io(sd_event_source *source, int fd, uint32_t revents, v
 
         if (changed)
                 path_enter_running(p, found->path);
+        else if (p->state == PATH_WAITING)
+                path_rewatch_spec(p, found);
         else
                 path_enter_waiting(p, false, false);
 
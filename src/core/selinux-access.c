@@ -20,19 +20,44 @@
 #include "format-util.h"
 #include "log.h"
 #include "path-util.h"
+#include "process-util.h"
 #include "selinux-util.h"
 #include "stdio-util.h"
-#include "strv.h"
 
 static bool initialized = false;
 
 struct audit_info {
         sd_bus_creds *creds;
         const char *path;
-        const char *cmdline;
+        char *cmdline;
+        bool cmdline_queried;
         const char *function;
 };
 
+static void audit_info_done(struct audit_info *audit) {
+        assert(audit);
+
+        audit->cmdline = mfree(audit->cmdline);
+}
+
+static const char* audit_info_get_cmdline(struct audit_info *audit) {
+        pid_t pid;
+
+        assert(audit);
+
+        /* The command line is only needed for logging, i.e. for denials and debug output. Hence don't read it
+         * from /proc on every access check, but only when we actually need it. */
+
+        if (!audit->cmdline_queried) {
+                audit->cmdline_queried = true;
+
+                if (sd_bus_creds_get_pid(audit->creds, &pid) >= 0)
+                        (void) pid_get_cmdline(pid, SIZE_MAX, 0, &audit->cmdline);
+        }
+
+        return audit->cmdline;
+}
+
 /*
    Any time an access gets denied this callback will be called
    with the audit data.  We then need to just copy the audit data into the msgbuf.
@@ -43,7 +68,8 @@ static int audit_callback(
                 char *msgbuf,
                 size_t msgbufsize) {
 
-        const struct audit_info *audit = auditdata;
+        struct audit_info *audit = ASSERT_PTR(auditdata);
+        const char *cmdline = audit_info_get_cmdline(audit);
         uid_t uid = 0, login_uid = 0;
         gid_t gid = 0;
         char login_uid_buf[DECIMAL_STR_MAX(uid_t) + 1] = "n/a";
@@ -61,7 +87,7 @@ static int audit_callback(
                         "auid=%s uid=%s gid=%s%s%s%s%s%s%s%s%s%s",
                         login_uid_buf, uid_buf, gid_buf,
                         audit->path ? " path=\"" : "", strempty(audit->path), audit->path ? "\"" : "",
-                        audit->cmdline ? " cmdline=\"" : "", strempty(audit->cmdline), audit->cmdline ? "\"" : "",
+                        cmdline ? " cmdline=\"" : "", strempty(cmdline), cmdline ? "\"" : "",
                         audit->function ? " function=\"" : "", strempty(audit->function), audit->function ? "\"" : "");
 
         return 0;
@@ -182,9 +208,7 @@ int mac_selinux_access_check_internal(
 
         _cleanup_(sd_bus_creds_unrefp) sd_bus_creds *creds = NULL;
         const char *tclass, *scon, *acon;
-        _cleanup_free_ char *cl = NULL;
         _cleanup_freecon_ char *fcon = NULL;
-        char **cmdline = NULL;
         bool enforce;
         int r = 0;
 
@@ -202,7 +226,7 @@ int mac_selinux_access_check_internal(
         r = sd_bus_query_sender_creds(
                         message,
                         SD_BUS_CREDS_PID|SD_BUS_CREDS_EUID|SD_BUS_CREDS_EGID|
-                        SD_BUS_CREDS_CMDLINE|SD_BUS_CREDS_AUDIT_LOGIN_UID|
+                        SD_BUS_CREDS_AUDIT_LOGIN_UID|
                         SD_BUS_CREDS_SELINUX_CONTEXT|
                         SD_BUS_CREDS_AUGMENT /* get more bits from /proc */,
                         &creds);
@@ -245,13 +269,9 @@ int mac_selinux_access_check_internal(
                 tclass = "system";
         }
 
-        (void) sd_bus_creds_get_cmdline(creds, &cmdline);
-        cl = strv_join(cmdline, " ");
-
-        struct audit_info audit_info = {
+        _cleanup_(audit_info_done) struct audit_info audit_info = {
                 .creds = creds,
                 .path = unit_path,
-                .cmdline = cl,
                 .function = function,
         };
 
@@ -265,7 +285,8 @@ int mac_selinux_access_check_internal(
 
         log_full_errno_zerook(LOG_DEBUG, r,
                               "SELinux access check scon=%s tcon=%s tclass=%s perm=%s state=%s function=%s path=%s cmdline=%s: %m",
-                              scon, acon, tclass, permission, enforce ? "enforcing" : "permissive", function, strna(unit_path), empty_to_na(cl));
+                              scon, acon, tclass, permission, enforce ? "enforcing" : "permissive", function, strna(unit_path),
+                              empty_to_na(DEBUG_LOGGING ? audit_info_get_cmdline(&audit_info) : NULL));
         return enforce ? r : 0;
 }
 
@@ -27,6 +27,20 @@ static void slice_init(Unit *u) {
         u->ignore_on_isolate = true;
 }
 
+static void slice_done(Unit *u) {
+        Slice *s = ASSERT_PTR(SLICE(u));
+
+        /* Detach the start jobs we hold back, they reference us */
+        while (s->held_jobs) {
+                Job *j = s->held_jobs;
+
+                LIST_REMOVE(slice_held, s->held_jobs, j);
+                j->held_by_slice = NULL;
+        }
+
+        s->held_jobs_tail = NULL;
+}
+
 static void slice_set_state(Slice *s, SliceState state) {
         SliceState old_state;
 
@@ -213,6 +227,11 @@ static void slice_dump(Unit *u, FILE *f, const char *prefix) {
                 "%sSlice State: %s\n",
                 prefix, slice_state_to_string(s->state));
 
+        if (s->job_concurrency_max > 0)
+                fprintf(f,
+                        "%sJob Concurrency Max: %u\n",
+                        prefix, s->job_concurrency_max);
+
         cgroup_context_dump(u, f, prefix);
 }
 
@@ -400,6 +419,7 @@ const UnitVTable slice_vtable = {
         .can_set_managed_oom = true,
 
         .init = slice_init,
+        .done = slice_done,
         .load = slice_load,
 
         .coldplug = slice_coldplug,
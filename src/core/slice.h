@@ -13,6 +13,14 @@ struct Slice {
         CGroupContext cgroup_context;
 
         CGroupRuntime *cgroup_runtime;
+
+        /* How many start jobs of units in this slice may run at the same time, 0 means no limit */
+        unsigned job_concurrency_max;
+        unsigned n_running_start_jobs;
+
+        /* Start jobs held back due to job_concurrency_max, newest first */
+        LIST_HEAD(Job, held_jobs);
+        Job *held_jobs_tail;
 };
 
 extern const UnitVTable slice_vtable;
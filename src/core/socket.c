@@ -2310,6 +2310,17 @@ static void socket_enter_start_pre(Socket *s) {
                 socket_enter_start_open(s);
 }
 
+static bool socket_trigger_limit_hit(Socket *s) {
+        assert(s);
+
+        if (ratelimit_below(&s->trigger_limit))
+                return false;
+
+        log_unit_warning(UNIT(s), "Trigger limit hit, refusing further activation.");
+        socket_enter_stop_pre(s, SOCKET_FAILURE_TRIGGER_LIMIT_HIT);
+        return true;
+}
+
 static void socket_enter_running(Socket *s, int cfd_in) {
         /* Note that this call takes possession of the connection fd passed. It either has to assign it
          * somewhere or close it. */
@@ -2331,16 +2342,13 @@ static void socket_enter_running(Socket *s, int cfd_in) {
                 return;
         }
 
-        if (!ratelimit_below(&s->trigger_limit)) {
-                log_unit_warning(UNIT(s), "Trigger limit hit, refusing further activation.");
-                socket_enter_stop_pre(s, SOCKET_FAILURE_TRIGGER_LIMIT_HIT);
-                goto refuse;
-        }
-
         if (cfd < 0) { /* Accept=no case */
                 bool pending = false;
                 Unit *other;
 
+                if (socket_trigger_limit_hit(s))
+                        goto refuse;
+
                 /* If there's already a start pending don't bother to do anything */
                 UNIT_FOREACH_DEPENDENCY(other, UNIT(s), UNIT_ATOM_TRIGGERS)
                         if (unit_active_or_pending(other)) {
@@ -2394,6 +2402,13 @@ static void socket_enter_running(Socket *s, int cfd_in) {
                         }
                 }
 
+                /* Only count connections towards the trigger limit that we actually activate a service
+                 * for. Connections dropped because of MaxConnections=/MaxConnectionsPerSource= have been
+                 * accepted and closed already, hence can't result in a busy loop, and shouldn't make the
+                 * whole socket unit fail under legitimate load. */
+                if (socket_trigger_limit_hit(s))
+                        goto refuse;
+
                 r = socket_load_service_unit(s, cfd, &service);
                 if (ERRNO_IS_NEG_DISCONNECT(r))
                         return;
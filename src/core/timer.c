@@ -819,6 +819,16 @@ static void timer_reset_failed(Unit *u) {
         t->result = TIMER_SUCCESS;
 }
 
+static bool timer_has_calendar(Timer *t) {
+        assert(t);
+
+        LIST_FOREACH(value, v, t->values)
+                if (v->base == TIMER_CALENDAR && !v->disabled)
+                        return true;
+
+        return false;
+}
+
 static void timer_time_change(Unit *u) {
         Timer *t = ASSERT_PTR(TIMER(u));
         usec_t ts;
@@ -837,7 +847,11 @@ static void timer_time_change(Unit *u) {
         if (t->on_clock_change) {
                 log_unit_debug(u, "Time change, triggering activation.");
                 timer_enter_running(t);
-        } else {
+        } else if (!timer_has_calendar(t))
+                /* Monotonic timers are not affected by changes to the wallclock, hence don't bother
+                 * recalculating them. This matters on systems with many timers. */
+                return;
+        else {
                 log_unit_debug(u, "Time change, recalculating next elapse.");
                 timer_enter_waiting(t, true);
         }
@@ -852,7 +866,10 @@ static void timer_timezone_change(Unit *u) {
         if (t->on_timezone_change) {
                 log_unit_debug(u, "Timezone change, triggering activation.");
                 timer_enter_running(t);
-        } else {
+        } else if (!timer_has_calendar(t))
+                /* Only calendar timers depend on the timezone */
+                return;
+        else {
                 log_unit_debug(u, "Timezone change, recalculating next elapse.");
                 timer_enter_waiting(t, false);
         }
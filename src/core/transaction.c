@@ -507,7 +507,11 @@ static void transaction_collect_garbage(Transaction *tr) {
 
         assert(tr);
 
-        /* Drop jobs that are not required by any other job */
+        /* Drop jobs that are not required by any other job.
+         *
+         * Deleting a job that nothing depends on never deletes any other job, and only replaces or removes
+         * the current hashmap entry, hence we can continue iterating afterwards instead of starting over
+         * for each deleted job. We only need another pass for jobs that became unreferenced as a result. */
 
         do {
                 Job *j;
@@ -522,7 +526,7 @@ static void transaction_collect_garbage(Transaction *tr) {
                                 log_trace("Garbage collecting job %s/%s", j->unit->id, job_type_to_string(j->type));
                                 transaction_delete_job(tr, j, true);
                                 again = true;
-                                break;
+                                continue;
                         }
 
                         log_trace("Keeping job %s/%s because of %s/%s",
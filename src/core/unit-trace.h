@@ -0,0 +1,26 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+#pragma once
+
+#if HAVE_SYS_SDT_H
+#define SDT_USE_VARIADIC
+#include <sys/sdt.h>
+
+#include "errno-util.h"
+#include "unit.h"
+
+/* Each trace point can have different number of additional arguments. Note that when the macro is used only
+ * additional arguments are listed in the macro invocation!
+ *
+ * Default arguments for each trace point are as follows:
+ *   - arg0 - unit name
+ *   - arg1 - invocation ID of the unit, formatted as string (empty if none is assigned yet)
+ */
+#define UNIT_TRACE_POINT(name, unit, ...)                                                                  \
+        do {                                                                                               \
+                PROTECT_ERRNO;                                                                             \
+                const Unit *_u = (unit);                                                                   \
+                STAP_PROBEV(systemd, name, _u->id, _u->invocation_id_string __VA_OPT__(,) __VA_ARGS__);    \
+        } while (false)
+#else
+#define UNIT_TRACE_POINT(name, unit, ...) ((void) 0)
+#endif
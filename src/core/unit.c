@@ -60,6 +60,7 @@
 #include "tmpfile-util.h"
 #include "umask-util.h"
 #include "unit-name.h"
+#include "unit-trace.h"
 #include "unit.h"
 #include "user-util.h"
 #include "virt.h"
@@ -2618,6 +2619,8 @@ void unit_notify(Unit *u, UnitActiveState os, UnitActiveState ns, bool reload_su
 
         Manager *m = ASSERT_PTR(u->manager);
 
+        UNIT_TRACE_POINT(state_change, u, unit_active_state_to_string(os), unit_active_state_to_string(ns));
+
         /* Let's enqueue the change signal early. In case this unit has a job associated we want that this unit is in
          * the bus queue, so that any job change signal queued will force out the unit change signal first. */
         unit_add_to_dbus_queue(u);
@@ -3014,7 +3017,7 @@ static Hashmap *unit_get_dependency_hashmap_per_type(Unit *u, UnitDependency d)
         if (!deps) {
                 _cleanup_hashmap_free_ Hashmap *h = NULL;
 
-                h = hashmap_new(NULL);
+                h = hashmap_new(&pointer_hash_ops);
                 if (!h)
                         return NULL;
 
@@ -5547,6 +5550,8 @@ static void unit_update_dependency_mask(Hashmap *deps, Unit *other, UnitDependen
 
 void unit_remove_dependencies(Unit *u, UnitDependencyMask mask) {
         Hashmap *deps;
+        void *dt;
+
         assert(u);
 
         /* Removes all dependencies u has on other units marked for ownership by 'mask'. */
@@ -5554,50 +5559,46 @@ void unit_remove_dependencies(Unit *u, UnitDependencyMask mask) {
         if (mask == 0)
                 return;
 
-        HASHMAP_FOREACH(deps, u->dependencies) {
-                bool done;
-
-                do {
-                        UnitDependencyInfo di;
-                        Unit *other;
-
-                        done = true;
-
-                        HASHMAP_FOREACH_KEY(di.data, other, deps) {
-                                Hashmap *other_deps;
+        HASHMAP_FOREACH_KEY(deps, dt, u->dependencies) {
+                UnitDependencyInfo di;
+                Unit *other;
 
-                                if (FLAGS_SET(~mask, di.origin_mask))
-                                        continue;
+                /* Updating or removing the current entry is safe while iterating, hence there's no need to
+                 * start over after each dependency we drop. */
+                HASHMAP_FOREACH_KEY(di.data, other, deps) {
+                        Hashmap *other_deps;
 
-                                di.origin_mask &= ~mask;
-                                unit_update_dependency_mask(deps, other, di);
+                        if (FLAGS_SET(~mask, di.origin_mask))
+                                continue;
 
-                                /* We updated the dependency from our unit to the other unit now. But most
-                                 * dependencies imply a reverse dependency. Hence, let's delete that one
-                                 * too. For that we go through all dependency types on the other unit and
-                                 * delete all those which point to us and have the right mask set. */
+                        di.origin_mask &= ~mask;
+                        unit_update_dependency_mask(deps, other, di);
 
-                                HASHMAP_FOREACH(other_deps, other->dependencies) {
-                                        UnitDependencyInfo dj;
+                        /* We updated the dependency from our unit to the other unit now. But most
+                         * dependencies imply a reverse dependency. Hence, let's delete that one
+                         * too. For that we go through all dependency types on the other unit and
+                         * delete all those which point to us and have the right mask set. */
 
-                                        dj.data = hashmap_get(other_deps, u);
-                                        if (FLAGS_SET(~mask, dj.destination_mask))
-                                                continue;
+                        HASHMAP_FOREACH(other_deps, other->dependencies) {
+                                UnitDependencyInfo dj;
 
-                                        dj.destination_mask &= ~mask;
-                                        unit_update_dependency_mask(other_deps, u, dj);
-                                }
+                                dj.data = hashmap_get(other_deps, u);
+                                if (FLAGS_SET(~mask, dj.destination_mask))
+                                        continue;
 
-                                unit_add_to_gc_queue(other);
+                                dj.destination_mask &= ~mask;
+                                unit_update_dependency_mask(other_deps, u, dj);
+                        }
 
-                                /* The unit 'other' may not be wanted by the unit 'u'. */
-                                unit_submit_to_stop_when_unneeded_queue(other);
+                        unit_add_to_gc_queue(other);
 
-                                done = false;
-                                break;
-                        }
+                        /* The unit 'other' may not be wanted by the unit 'u'. */
+                        unit_submit_to_stop_when_unneeded_queue(other);
+                }
 
-                } while (!done);
+                /* Don't keep empty per-type hashmaps around, they are not exactly small. */
+                if (hashmap_isempty(deps))
+                        hashmap_free(hashmap_remove(u->dependencies, dt));
         }
 }
 
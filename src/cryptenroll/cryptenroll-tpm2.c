@@ -173,6 +173,7 @@ int load_volume_key_tpm2(
                 size_t *ret_vks) {
 
         _cleanup_(iovec_done_erase) struct iovec decrypted_key = {};
+        _cleanup_(tpm2_context_unrefp) Tpm2Context *tpm2_context = NULL;
         _cleanup_(erase_and_freep) char *passphrase = NULL;
         ssize_t passphrase_size;
         int r;
@@ -233,6 +234,7 @@ int load_volume_key_tpm2(
                 r = acquire_tpm2_key(
                                 cd_node,
                                 device,
+                                &tpm2_context,
                                 hash_pcr_mask,
                                 pcr_bank,
                                 &pubkey,
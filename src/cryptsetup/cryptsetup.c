@@ -1844,6 +1844,7 @@ static int attach_luks_or_plain_or_bitlk_by_tpm2(
 
         _cleanup_(sd_device_monitor_unrefp) sd_device_monitor *monitor = NULL;
         _cleanup_(iovec_done_erase) struct iovec decrypted_key = {};
+        _cleanup_(tpm2_context_unrefp) Tpm2Context *tpm2_context = NULL;
         _cleanup_(sd_event_unrefp) sd_event *event = NULL;
         _cleanup_free_ char *friendly = NULL;
         int keyslot = arg_key_slot, r;
@@ -1863,6 +1864,7 @@ static int attach_luks_or_plain_or_bitlk_by_tpm2(
                         r = acquire_tpm2_key(
                                         name,
                                         arg_tpm2_device,
+                                        &tpm2_context,
                                         arg_tpm2_pcr_mask == UINT32_MAX ? TPM2_PCR_MASK_DEFAULT_LEGACY : arg_tpm2_pcr_mask,
                                         UINT16_MAX,
                                         /* pubkey= */ NULL,
@@ -1968,6 +1970,7 @@ static int attach_luks_or_plain_or_bitlk_by_tpm2(
                                 r = acquire_tpm2_key(
                                                 name,
                                                 arg_tpm2_device,
+                                                &tpm2_context,
                                                 hash_pcr_mask,
                                                 pcr_bank,
                                                 &pubkey,
@@ -26,6 +26,14 @@
 #include "sha256-fundamental.h"
 #include "unaligned-fundamental.h"
 
+#if defined(__x86_64__) && !SD_BOOT
+#  include <cpuid.h>
+#  include <immintrin.h>
+#  define HAVE_SHA_NI 1
+#else
+#  define HAVE_SHA_NI 0
+#endif
+
 #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
 # define SWAP(n)                                                        \
         __builtin_bswap32(n)
@@ -171,7 +179,7 @@ void sha256_process_bytes(const void *buffer, size_t len, struct sha256_ctx *ctx
 
 /* Process LEN bytes of BUFFER, accumulating context into CTX.
    It is assumed that LEN % 64 == 0.  */
-static void sha256_process_block(const void *buffer, size_t len, struct sha256_ctx *ctx) {
+static void sha256_process_block_generic(const void *buffer, size_t len, struct sha256_ctx *ctx) {
         const uint32_t *words = ASSERT_PTR(buffer);
         size_t nwords = len / sizeof(uint32_t);
 
@@ -264,6 +272,91 @@ static void sha256_process_block(const void *buffer, size_t len, struct sha256_c
         ctx->H[7] = h;
 }
 
+#if HAVE_SHA_NI
+/* Same as sha256_process_block_generic(), but using the SHA extensions of x86 CPUs. The state is kept in
+ * the ABEF/CDGH layout the sha256rnds2 instruction operates on, and converted back when done. */
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha256_process_block_shani(const void *buffer, size_t len, struct sha256_ctx *ctx) {
+        const uint8_t *data = ASSERT_PTR(buffer);
+        const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+        __m128i state0, state1, tmp;
+
+        assert(ctx);
+
+        ctx->total64 += len;
+
+        tmp = _mm_loadu_si128((const __m128i*) &ctx->H[0]);
+        state1 = _mm_loadu_si128((const __m128i*) &ctx->H[4]);
+
+        tmp = _mm_shuffle_epi32(tmp, 0xB1);             /* CDAB */
+        state1 = _mm_shuffle_epi32(state1, 0x1B);       /* EFGH */
+        state0 = _mm_alignr_epi8(tmp, state1, 8);       /* ABEF */
+        state1 = _mm_blend_epi16(state1, tmp, 0xF0);    /* CDGH */
+
+        for (; len >= 64; len -= 64, data += 64) {
+                __m128i abef_save = state0, cdgh_save = state1, msg[4];
+
+                for (size_t i = 0; i < 4; i++)
+                        msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (data + i * 16)), mask);
+
+                /* 16 iterations of 4 rounds each. msg[i & 3] holds W[4i..4i+3], and once it has been
+                 * consumed it is replaced by W[4i+16..4i+19] (FIPS 180-2:6.2.2 step 2). */
+                for (size_t i = 0; i < 16; i++) {
+                        __m128i m = _mm_add_epi32(msg[i & 3], _mm_loadu_si128((const __m128i*) &K[i * 4]));
+
+                        state1 = _mm_sha256rnds2_epu32(state1, state0, m);
+                        m = _mm_shuffle_epi32(m, 0x0E);
+                        state0 = _mm_sha256rnds2_epu32(state0, state1, m);
+
+                        if (i >= 12)
+                                continue;
+
+                        m = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+                        m = _mm_add_epi32(m, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+                        msg[i & 3] = _mm_sha256msg2_epu32(m, msg[(i + 3) & 3]);
+                }
+
+                state0 = _mm_add_epi32(state0, abef_save);
+                state1 = _mm_add_epi32(state1, cdgh_save);
+        }
+
+        tmp = _mm_shuffle_epi32(state0, 0x1B);          /* FEBA */
+        state1 = _mm_shuffle_epi32(state1, 0xB1);       /* DCHG */
+        state0 = _mm_blend_epi16(tmp, state1, 0xF0);    /* DCBA */
+        state1 = _mm_alignr_epi8(state1, tmp, 8);       /* HGFE */
+
+        _mm_storeu_si128((__m128i*) &ctx->H[0], state0);
+        _mm_storeu_si128((__m128i*) &ctx->H[4], state1);
+}
+
+static bool sha256_have_shani(void) {
+        static int cache = -1;
+        unsigned eax, ebx, ecx, edx;
+
+        if (cache >= 0)
+                return cache;
+
+        /* SHA (CPUID.7.0:EBX[29]), SSSE3 (CPUID.1:ECX[9]) and SSE4.1 (CPUID.1:ECX[19]) */
+        cache = __get_cpuid(1, &eax, &ebx, &ecx, &edx) &&
+                FLAGS_SET(ecx, (1U << 9) | (1U << 19)) &&
+                __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+                FLAGS_SET(ebx, 1U << 29);
+
+        return cache;
+}
+#endif
+
+static void sha256_process_block(const void *buffer, size_t len, struct sha256_ctx *ctx) {
+#if HAVE_SHA_NI
+        if (sha256_have_shani()) {
+                sha256_process_block_shani(buffer, len, ctx);
+                return;
+        }
+#endif
+
+        sha256_process_block_generic(buffer, len, ctx);
+}
+
 uint8_t* sha256_direct(const void *buffer, size_t sz, uint8_t result[static SHA256_DIGEST_SIZE]) {
         struct sha256_ctx ctx;
         sha256_init_ctx(&ctx);
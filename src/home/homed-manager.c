@@ -1075,7 +1075,8 @@ static int manager_bind_varlink(Manager *m) {
                         "io.systemd.UserDatabase.GetMemberships", vl_method_get_memberships,
                         "io.systemd.service.Ping",                varlink_method_ping,
                         "io.systemd.service.SetLogLevel",         varlink_method_set_log_level,
-                        "io.systemd.service.GetEnvironment",      varlink_method_get_environment);
+                        "io.systemd.service.GetEnvironment",      varlink_method_get_environment,
+                        "io.systemd.service.GetMemoryStatistics", varlink_method_get_memory_statistics);
         if (r < 0)
                 return log_error_errno(r, "Failed to register varlink methods: %m");
 
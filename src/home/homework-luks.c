@@ -217,6 +217,13 @@ static int run_fsck(const char *node, const char *fstype) {
         assert(node);
         assert(fstype);
 
+        /* The fsck helpers of btrfs and xfs are no-ops in preen mode, both file systems recover themselves
+         * during mount. Don't bother forking off fsck for them, this is in the login path after all. */
+        if (STR_IN_SET(fstype, "btrfs", "xfs")) {
+                log_debug("File system %s does not need a check before mounting, skipping fsck.", fstype);
+                return 0;
+        }
+
         r = fsck_exists_for_fstype(fstype);
         if (r < 0)
                 return log_error_errno(r, "Failed to check if fsck for file system %s exists: %m", fstype);
@@ -1856,10 +1856,11 @@ static int connect_varlink(Context *c) {
 
         r = sd_varlink_server_bind_method_many(
                         c->varlink_server,
-                        "io.systemd.Hostname.Describe",      vl_method_describe,
-                        "io.systemd.service.Ping",           varlink_method_ping,
-                        "io.systemd.service.SetLogLevel",    varlink_method_set_log_level,
-                        "io.systemd.service.GetEnvironment", varlink_method_get_environment);
+                        "io.systemd.Hostname.Describe",           vl_method_describe,
+                        "io.systemd.service.Ping",                varlink_method_ping,
+                        "io.systemd.service.SetLogLevel",         varlink_method_set_log_level,
+                        "io.systemd.service.GetEnvironment",      varlink_method_get_environment,
+                        "io.systemd.service.GetMemoryStatistics", varlink_method_get_memory_statistics);
         if (r < 0)
                 return log_error_errno(r, "Failed to bind Varlink method calls: %m");
 
@@ -53,7 +53,21 @@ int import_uncompress_detect(ImportCompress *c, const void *data, size_t size) {
         if (memcmp(data, xz_signature, sizeof(xz_signature)) == 0) {
                 lzma_ret xzr;
 
+#if LZMA_VERSION >= 50040002
+                /* Use the multi-threaded decoder where available. This speeds things up substantially for
+                 * images compressed with multiple blocks (as "xz -T" does), and transparently falls back to
+                 * single-threaded decoding otherwise, or if the memory limit would be exceeded. */
+                const lzma_mt mt = {
+                        .flags = LZMA_TELL_UNSUPPORTED_CHECK | LZMA_CONCATENATED,
+                        .threads = MAX(lzma_cputhreads(), 1U),
+                        .memlimit_threading = lzma_physmem() / 4,
+                        .memlimit_stop = UINT64_MAX,
+                };
+
+                xzr = lzma_stream_decoder_mt(&c->xz, &mt);
+#else
                 xzr = lzma_stream_decoder(&c->xz, UINT64_MAX, LZMA_TELL_UNSUPPORTED_CHECK | LZMA_CONCATENATED);
+#endif
                 if (xzr != LZMA_OK)
                         return -EIO;
 
@@ -195,6 +209,45 @@ int import_uncompress(ImportCompress *c, const void *data, size_t size, ImportCo
         return 1;
 }
 
+int import_uncompress_finish(ImportCompress *c, ImportCompressCallback callback, void *userdata) {
+        int r;
+
+        assert(c);
+        assert(!c->encoding);
+        assert(callback);
+
+        /* Called once all compressed data has been passed to import_uncompress(), to flush out whatever the
+         * decoder still holds internally. This matters for the multi-threaded xz decoder in particular,
+         * which might still be busy decoding the last blocks at this point. */
+
+        if (c->type != IMPORT_COMPRESS_XZ)
+                return 0;
+
+        c->xz.next_in = NULL;
+        c->xz.avail_in = 0;
+
+        for (;;) {
+                uint8_t buffer[16 * 1024];
+                lzma_ret lzr;
+
+                c->xz.next_out = buffer;
+                c->xz.avail_out = sizeof(buffer);
+
+                lzr = lzma_code(&c->xz, LZMA_FINISH);
+                if (!IN_SET(lzr, LZMA_OK, LZMA_STREAM_END))
+                        return -EIO;
+
+                if (c->xz.avail_out < sizeof(buffer)) {
+                        r = callback(buffer, sizeof(buffer) - c->xz.avail_out, userdata);
+                        if (r < 0)
+                                return r;
+                }
+
+                if (lzr == LZMA_STREAM_END)
+                        return 0;
+        }
+}
+
 int import_compress_init(ImportCompress *c, ImportCompressType t) {
         int r;
 
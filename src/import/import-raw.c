@@ -460,8 +460,15 @@ static int raw_import_process(RawImport *i) {
         i->written_compressed += i->buffer_size;
         i->buffer_size = 0;
 
-        if (l == 0) /* EOF */
+        if (l == 0) { /* EOF */
+                r = import_uncompress_finish(&i->compress, raw_import_write, i);
+                if (r < 0) {
+                        log_error_errno(r, "Failed to decode and write: %m");
+                        goto finish;
+                }
+
                 goto complete;
+        }
 
         raw_import_report_progress(i);
 
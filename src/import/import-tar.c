@@ -322,6 +322,12 @@ static int tar_import_process(TarImport *i) {
         i->buffer_size = 0;
 
         if (l == 0) { /* EOF */
+                r = import_uncompress_finish(&i->compress, tar_import_write, i);
+                if (r < 0) {
+                        log_error_errno(r, "Failed to decode and write: %m");
+                        goto finish;
+                }
+
                 r = tar_import_finish(i);
                 goto finish;
         }
@@ -1979,11 +1979,12 @@ static int manager_connect_varlink(Manager *m) {
 
         r = sd_varlink_server_bind_method_many(
                         m->varlink_server,
-                        "io.systemd.Import.ListTransfers",   vl_method_list_transfers,
-                        "io.systemd.Import.Pull",            vl_method_pull,
-                        "io.systemd.service.Ping",           varlink_method_ping,
-                        "io.systemd.service.SetLogLevel",    varlink_method_set_log_level,
-                        "io.systemd.service.GetEnvironment", varlink_method_get_environment);
+                        "io.systemd.Import.ListTransfers",        vl_method_list_transfers,
+                        "io.systemd.Import.Pull",                 vl_method_pull,
+                        "io.systemd.service.Ping",                varlink_method_ping,
+                        "io.systemd.service.SetLogLevel",         varlink_method_set_log_level,
+                        "io.systemd.service.GetEnvironment",      varlink_method_get_environment,
+                        "io.systemd.service.GetMemoryStatistics", varlink_method_get_memory_statistics);
         if (r < 0)
                 return log_error_errno(r, "Failed to bind Varlink method calls: %m");
 
@@ -20,6 +20,8 @@
 #include "sync-util.h"
 #include "xattr-util.h"
 
+static int pull_job_write_uncompressed(const void *p, size_t sz, void *userdata);
+
 void pull_job_close_disk_fd(PullJob *j) {
         if (!j)
                 return;
@@ -208,6 +210,12 @@ void pull_job_curl_on_finished(CurlGlue *g, CURL *curl, CURLcode result) {
                 goto finish;
         }
 
+        r = import_uncompress_finish(&j->compress, pull_job_write_uncompressed, j);
+        if (r < 0) {
+                log_error_errno(r, "Failed to finish decompression: %m");
+                goto finish;
+        }
+
         if (j->checksum_ctx) {
                 unsigned checksum_len;
 #if PREFER_OPENSSL
@@ -39,6 +39,10 @@
 
 #define JOURNAL_WAIT_TIMEOUT (10*USEC_PER_SEC)
 
+/* Entries and fields larger than this are serialized into a temporary file rather than into memory, so that
+ * the memory used per connection stays bounded. */
+#define SERIALIZE_IN_MEMORY_MAX (256U*1024U)
+
 static char *arg_key_pem = NULL;
 static char *arg_cert_pem = NULL;
 static char *arg_trust_pem = NULL;
@@ -64,7 +68,12 @@ typedef struct RequestMeta {
         uint64_t n_entries;
         bool n_entries_set, since_set, until_set;
 
+        /* The currently serialized entry or field. Points to either of the two streams below. */
         FILE *tmp;
+        FILE *tmp_memory;
+        char *tmp_buf;
+        size_t tmp_size;
+        FILE *tmp_file;
         uint64_t delta, size;
 
         int argument_parse_error;
@@ -109,7 +118,9 @@ static void request_meta_free(
 
         sd_journal_close(m->journal);
 
-        safe_fclose(m->tmp);
+        safe_fclose(m->tmp_memory);
+        free(m->tmp_buf);
+        safe_fclose(m->tmp_file);
 
         free(m->cursor);
         free(m);
@@ -132,23 +143,97 @@ static int open_journal(RequestMeta *m) {
 static int request_meta_ensure_tmp(RequestMeta *m) {
         assert(m);
 
-        if (m->tmp)
-                rewind(m->tmp);
+        /* We serialize into memory rather than into a temporary file, so that handing out the data to
+         * microhttpd is a simple memcpy() instead of a write() + seek + read() cycle per entry. Large items
+         * are moved to a temporary file afterwards, see request_meta_finish_tmp(). */
+
+        if (m->tmp_memory)
+                rewind(m->tmp_memory);
+        else {
+                m->tmp_memory = open_memstream_unlocked(&m->tmp_buf, &m->tmp_size);
+                if (!m->tmp_memory)
+                        return log_oom();
+        }
+
+        m->tmp = m->tmp_memory;
+        return 0;
+}
+
+static int request_meta_finish_tmp(RequestMeta *m) {
+        off_t sz;
+
+        assert(m);
+        assert(m->tmp == m->tmp_memory);
+
+        if (fflush(m->tmp_memory) != 0)
+                return log_error_errno(errno, "Failed to flush serialized item: %m");
+
+        sz = ftello(m->tmp_memory);
+        if (sz < 0)
+                return log_error_errno(errno, "Failed to retrieve file position: %m");
+
+        m->size = (uint64_t) sz;
+
+        if (m->size <= SERIALIZE_IN_MEMORY_MAX)
+                return 0;
+
+        /* Many clients requesting large items could otherwise make us keep unbounded amounts of memory
+         * allocated, hence move them to a temporary file and release the memory. */
+
+        if (m->tmp_file)
+                rewind(m->tmp_file);
         else {
                 _cleanup_close_ int fd = -EBADF;
 
                 fd = open_tmpfile_unlinkable("/tmp", O_RDWR|O_CLOEXEC);
                 if (fd < 0)
-                        return fd;
+                        return log_error_errno(fd, "Failed to create temporary file: %m");
 
-                m->tmp = take_fdopen(&fd, "w+");
-                if (!m->tmp)
-                        return -errno;
+                m->tmp_file = take_fdopen(&fd, "w+");
+                if (!m->tmp_file)
+                        return log_error_errno(errno, "Failed to open temporary file: %m");
         }
 
+        errno = 0;
+        if (fwrite(m->tmp_buf, 1, m->size, m->tmp_file) != m->size || fflush(m->tmp_file) != 0)
+                return log_error_errno(errno_or_else(EIO), "Failed to write serialized item to temporary file: %m");
+
+        m->tmp = m->tmp_file;
+
+        m->tmp_memory = safe_fclose(m->tmp_memory);
+        m->tmp_buf = mfree(m->tmp_buf);
+        m->tmp_size = 0;
+
         return 0;
 }
 
+static ssize_t request_meta_read_tmp(RequestMeta *m, uint64_t pos, char *buf, size_t n) {
+        size_t k;
+
+        assert(m);
+        assert(m->tmp);
+        assert(buf || n == 0);
+
+        if (m->tmp == m->tmp_memory) {
+                memcpy_safe(buf, m->tmp_buf + pos, n);
+                return (ssize_t) n;
+        }
+
+        if (fseeko(m->tmp, pos, SEEK_SET) < 0) {
+                log_error_errno(errno, "Failed to seek to position: %m");
+                return MHD_CONTENT_READER_END_WITH_ERROR;
+        }
+
+        errno = 0;
+        k = fread(buf, 1, n, m->tmp);
+        if (k != n) {
+                log_error("Failed to read from file: %s", STRERROR_OR_EOF(errno));
+                return MHD_CONTENT_READER_END_WITH_ERROR;
+        }
+
+        return (ssize_t) k;
+}
+
 static ssize_t request_reader_entries(
                 void *cls,
                 uint64_t pos,
@@ -159,7 +244,7 @@ static ssize_t request_reader_entries(
         dual_timestamp previous_ts = DUAL_TIMESTAMP_NULL;
         sd_id128_t previous_boot_id = SD_ID128_NULL;
         int r;
-        size_t n, k;
+        size_t n;
 
         assert(buf);
         assert(max > 0);
@@ -168,8 +253,6 @@ static ssize_t request_reader_entries(
         pos -= m->delta;
 
         while (pos >= m->size) {
-                off_t sz;
-
                 /* End of this entry, so let's serialize the next
                  * one */
 
@@ -237,10 +320,8 @@ static ssize_t request_reader_entries(
                 m->n_skip = 0;
 
                 r = request_meta_ensure_tmp(m);
-                if (r < 0) {
-                        log_error_errno(r, "Failed to create temporary file: %m");
+                if (r < 0)
                         return MHD_CONTENT_READER_END_WITH_ERROR;
-                }
 
                 r = show_journal_entry(m->tmp, m->journal, m->mode, 0, OUTPUT_FULL_WIDTH,
                                    NULL, NULL, NULL, &previous_ts, &previous_boot_id);
@@ -249,37 +330,21 @@ static ssize_t request_reader_entries(
                         return MHD_CONTENT_READER_END_WITH_ERROR;
                 }
 
-                sz = ftello(m->tmp);
-                if (sz < 0) {
-                        log_error_errno(errno, "Failed to retrieve file position: %m");
+                r = request_meta_finish_tmp(m);
+                if (r < 0)
                         return MHD_CONTENT_READER_END_WITH_ERROR;
-                }
-
-                m->size = (uint64_t) sz;
         }
 
         if (m->tmp == NULL && m->follow)
                 return 0;
 
-        if (fseeko(m->tmp, pos, SEEK_SET) < 0) {
-                log_error_errno(errno, "Failed to seek to position: %m");
-                return MHD_CONTENT_READER_END_WITH_ERROR;
-        }
-
         n = m->size - pos;
         if (n < 1)
                 return 0;
         if (n > max)
                 n = max;
 
-        errno = 0;
-        k = fread(buf, 1, n, m->tmp);
-        if (k != n) {
-                log_error("Failed to read from file: %s", STRERROR_OR_EOF(errno));
-                return MHD_CONTENT_READER_END_WITH_ERROR;
-        }
-
-        return (ssize_t) k;
+        return request_meta_read_tmp(m, pos, buf, n);
 }
 
 static int request_parse_accept(
@@ -634,7 +699,7 @@ static ssize_t request_reader_fields(
 
         RequestMeta *m = ASSERT_PTR(cls);
         int r;
-        size_t n, k;
+        size_t n;
 
         assert(buf);
         assert(max > 0);
@@ -643,7 +708,6 @@ static ssize_t request_reader_fields(
         pos -= m->delta;
 
         while (pos >= m->size) {
-                off_t sz;
                 const void *d;
                 size_t l;
 
@@ -661,10 +725,8 @@ static ssize_t request_reader_fields(
                 m->delta += m->size;
 
                 r = request_meta_ensure_tmp(m);
-                if (r < 0) {
-                        log_error_errno(r, "Failed to create temporary file: %m");
+                if (r < 0)
                         return MHD_CONTENT_READER_END_WITH_ERROR;
-                }
 
                 r = output_field(m->tmp, m->mode, d, l);
                 if (r < 0) {
@@ -672,32 +734,16 @@ static ssize_t request_reader_fields(
                         return MHD_CONTENT_READER_END_WITH_ERROR;
                 }
 
-                sz = ftello(m->tmp);
-                if (sz < 0) {
-                        log_error_errno(errno, "Failed to retrieve file position: %m");
+                r = request_meta_finish_tmp(m);
+                if (r < 0)
                         return MHD_CONTENT_READER_END_WITH_ERROR;
-                }
-
-                m->size = (uint64_t) sz;
-        }
-
-        if (fseeko(m->tmp, pos, SEEK_SET) < 0) {
-                log_error_errno(errno, "Failed to seek to position: %m");
-                return MHD_CONTENT_READER_END_WITH_ERROR;
         }
 
         n = m->size - pos;
         if (n > max)
                 n = max;
 
-        errno = 0;
-        k = fread(buf, 1, n, m->tmp);
-        if (k != n) {
-                log_error("Failed to read from file: %s", STRERROR_OR_EOF(errno));
-                return MHD_CONTENT_READER_END_WITH_ERROR;
-        }
-
-        return (ssize_t) k;
+        return request_meta_read_tmp(m, pos, buf, n);
 }
 
 static int request_handler_fields(
@@ -8,17 +8,40 @@
 #include "path-util.h"
 #include "stat-util.h"
 
-static int do_rotate(JournalFile **f, MMapCache *m, JournalFileFlags file_flags) {
+/* Coalesce the change notifications (an ftruncate() call) done for each written entry, like journald does. */
+#define POST_CHANGE_TIMER_INTERVAL_USEC (250*USEC_PER_MSEC)
+
+int writer_enable_post_change_timer(Writer *w) {
         int r;
 
-        r = journal_file_rotate(f, m, file_flags, UINT64_MAX, NULL);
+        assert(w);
+        assert(w->journal);
+
+        if (!w->server || !w->server->event)
+                return 0;
+
+        r = journal_file_enable_post_change_timer(w->journal, w->server->event, POST_CHANGE_TIMER_INTERVAL_USEC);
+        if (r < 0)
+                return log_warning_errno(r, "Failed to enable post change timer for %s, ignoring: %m", w->journal->path);
+
+        return r;
+}
+
+static int do_rotate(Writer *w, JournalFileFlags file_flags) {
+        int r;
+
+        assert(w);
+
+        r = journal_file_rotate(&w->journal, w->mmap, file_flags, UINT64_MAX, NULL);
         if (r < 0) {
-                if (*f)
-                        log_error_errno(r, "Failed to rotate %s: %m", (*f)->path);
+                if (w->journal)
+                        log_error_errno(r, "Failed to rotate %s: %m", w->journal->path);
                 else
                         log_error_errno(r, "Failed to create rotated journal: %m");
+                return r;
         }
 
+        (void) writer_enable_post_change_timer(w);
         return r;
 }
 
@@ -94,7 +117,7 @@ int writer_write(Writer *w,
         if (journal_file_rotate_suggested(w->journal, 0, LOG_DEBUG)) {
                 log_info("%s: Journal header limits reached or header out-of-date, rotating",
                          w->journal->path);
-                r = do_rotate(&w->journal, w->mmap, file_flags);
+                r = do_rotate(w, file_flags);
                 if (r < 0)
                         return r;
                 r = journal_directory_vacuum(w->output, w->metrics.max_use, w->metrics.n_max_files, 0, NULL, /* verbose = */ true);
@@ -120,7 +143,7 @@ int writer_write(Writer *w,
                 return r;
 
         log_debug_errno(r, "%s: Write failed, rotating: %m", w->journal->path);
-        r = do_rotate(&w->journal, w->mmap, file_flags);
+        r = do_rotate(w, file_flags);
         if (r < 0)
                 return r;
         else
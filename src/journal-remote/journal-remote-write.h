@@ -26,6 +26,8 @@ Writer* writer_unref(Writer *w);
 
 DEFINE_TRIVIAL_CLEANUP_FUNC(Writer*, writer_unref);
 
+int writer_enable_post_change_timer(Writer *w);
+
 int writer_write(Writer *s,
                  const struct iovec_wrapper *iovw,
                  const dual_timestamp *ts,
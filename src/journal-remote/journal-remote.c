@@ -91,6 +91,8 @@ static int open_output(RemoteServer *s, Writer *w, const char *host) {
                 return log_error_errno(r, "Failed to open output journal %s: %m", filename);
 
         log_debug("Opened output file %s", w->journal->path);
+
+        (void) writer_enable_post_change_timer(w);
         return 0;
 }
 
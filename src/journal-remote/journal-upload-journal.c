@@ -251,7 +251,7 @@ static void check_update_watchdog(Uploader *u) {
 
 static size_t journal_input_callback(void *buf, size_t size, size_t nmemb, void *userp) {
         Uploader *u = ASSERT_PTR(userp);
-        _cleanup_free_ char *compression_buffer = NULL;
+        char *compression_buffer = NULL;
         int r;
         sd_journal *j;
         size_t filled = 0;
@@ -264,11 +264,12 @@ static size_t journal_input_callback(void *buf, size_t size, size_t nmemb, void
         j = u->journal;
 
         if (u->compression) {
-                compression_buffer = malloc_multiply(nmemb, size);
-                if (!compression_buffer) {
+                if (!GREEDY_REALLOC(u->compression_buffer, size * nmemb)) {
                         log_oom();
                         return CURL_READFUNC_ABORT;
                 }
+
+                compression_buffer = u->compression_buffer;
         }
 
         while (j && filled < size * nmemb) {
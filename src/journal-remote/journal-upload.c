@@ -290,6 +290,12 @@ int start_upload(Uploader *u,
                 easy_setopt(curl, CURLOPT_READDATA, data,
                             LOG_ERR, return -EXFULL);
 
+#if LIBCURL_VERSION_NUM >= 0x073e00
+                /* read larger chunks per callback, so that entries are batched and compressed together */
+                easy_setopt(curl, CURLOPT_UPLOAD_BUFFERSIZE, (long) JOURNAL_UPLOAD_BUFFER_SIZE,
+                            LOG_WARNING, );
+#endif
+
                 /* use our special own mime type and chunked transfer */
                 easy_setopt(curl, CURLOPT_HTTPHEADER, u->header,
                             LOG_ERR, return -EXFULL);
@@ -341,7 +347,7 @@ int start_upload(Uploader *u,
 }
 
 static size_t fd_input_callback(void *buf, size_t size, size_t nmemb, void *userp) {
-        _cleanup_free_ char *compression_buffer = NULL;
+        char *compression_buffer = NULL;
         Uploader *u = ASSERT_PTR(userp);
         ssize_t n;
         int r;
@@ -354,11 +360,12 @@ static size_t fd_input_callback(void *buf, size_t size, size_t nmemb, void *user
         assert(!size_multiply_overflow(size, nmemb));
 
         if (u->compression) {
-                compression_buffer = malloc_multiply(nmemb, size);
-                if (!compression_buffer) {
+                if (!GREEDY_REALLOC(u->compression_buffer, size * nmemb)) {
                         log_oom();
                         return CURL_READFUNC_ABORT;
                 }
+
+                compression_buffer = u->compression_buffer;
         }
 
         n = read(u->input, compression_buffer ?: buf, size * nmemb);
@@ -506,6 +513,7 @@ static void destroy_uploader(Uploader *u) {
         curl_easy_cleanup(u->easy);
         curl_slist_free_all(u->header);
         free(u->answer);
+        free(u->compression_buffer);
 
         free(u->last_cursor);
         free(u->current_cursor);
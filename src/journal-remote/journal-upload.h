@@ -55,10 +55,15 @@ typedef struct Uploader {
         usec_t watchdog_timestamp;
         usec_t watchdog_usec;
         const CompressionConfig *compression;
+        /* Staging area for the uncompressed payload, reused between read callbacks */
+        char *compression_buffer;
 } Uploader;
 
 #define JOURNAL_UPLOAD_POLL_TIMEOUT (10 * USEC_PER_SEC)
 
+/* Let curl ask for large chunks, so that many entries are batched into one write and are compressed together */
+#define JOURNAL_UPLOAD_BUFFER_SIZE (1024U * 1024U)
+
 int start_upload(Uploader *u,
                  size_t (*input_callback)(void *ptr,
                                           size_t size,
@@ -4,9 +4,22 @@
 #include "fuzz-journald.h"
 #include "journald-native.h"
 
+static void process_native_message(
+                Server *s,
+                const char *buf,
+                size_t raw_len,
+                const struct ucred *ucred,
+                const struct timeval *tv,
+                const char *label,
+                size_t label_len) {
+
+        /* The buffer is the writable s->buffer, which native message processing unpacks binary fields in */
+        server_process_native_message(s, (char*) buf, raw_len, ucred, tv, label, label_len);
+}
+
 int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
         fuzz_setup_logging();
 
-        fuzz_journald_processing_function(data, size, server_process_native_message);
+        fuzz_journald_processing_function(data, size, process_native_message);
         return 0;
 }
@@ -68,7 +68,7 @@
 #define CACHE_MAX_MAX (16*1024U)
 #define CACHE_MAX_MIN 64U
 
-static size_t cache_max(void) {
+size_t client_context_cache_max(void) {
         static size_t cached = -1;
 
         if (cached == SIZE_MAX) {
@@ -523,6 +523,8 @@ static void client_context_really_refresh(
         if (timestamp == USEC_INFINITY)
                 timestamp = now(CLOCK_MONOTONIC);
 
+        s->n_client_context_refreshes++;
+
         client_context_read_uid_gid(c, ucred);
         client_context_read_basic(c);
         (void) client_context_read_label(c, label, label_size);
@@ -634,6 +636,7 @@ static void client_context_try_shrink_to(Server *s, size_t limit) {
                 c->in_lru = false;
 
                 client_context_free(s, c);
+                s->n_client_context_evicted++;
         }
 }
 
@@ -678,6 +681,7 @@ static int client_context_get_internal(
 
         c = hashmap_get(s->client_contexts, PID_TO_PTR(pid));
         if (c) {
+                s->n_client_context_hits++;
 
                 if (add_ref) {
                         if (c->in_lru) {
@@ -696,7 +700,9 @@ static int client_context_get_internal(
                 return 0;
         }
 
-        client_context_try_shrink_to(s, cache_max()-1);
+        s->n_client_context_misses++;
+
+        client_context_try_shrink_to(s, client_context_cache_max()-1);
 
         r = client_context_new(s, pid, &c);
         if (r < 0)
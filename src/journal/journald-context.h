@@ -88,6 +88,8 @@ void client_context_maybe_refresh(
                 const char *unit_id,
                 usec_t tstamp);
 
+size_t client_context_cache_max(void);
+
 void client_context_acquire_default(Server *s);
 void client_context_flush_all(Server *s);
 void client_context_flush_regular(Server *s);
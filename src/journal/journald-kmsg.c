@@ -26,6 +26,9 @@
 #include "stdio-util.h"
 #include "string-util.h"
 
+/* How many records to read from /dev/kmsg per wakeup, before returning to the event loop */
+#define DEV_KMSG_RECORDS_PER_ITERATION 64U
+
 void server_forward_kmsg(
                 Server *s,
                 int priority,
@@ -381,7 +384,18 @@ static int dispatch_dev_kmsg(sd_event_source *es, int fd, uint32_t revents, void
         if (!(revents & EPOLLIN))
                 log_error("Got invalid event from epoll for /dev/kmsg: %"PRIx32, revents);
 
-        return server_read_dev_kmsg(s);
+        /* /dev/kmsg hands out exactly one record per read(), hence during log floods we'd go through
+         * epoll_wait() once for each record. Read a bunch of them in one go instead, but not too many, so
+         * that other event sources still get their turn. */
+        for (unsigned i = 0; i < DEV_KMSG_RECORDS_PER_ITERATION; i++) {
+                int r;
+
+                r = server_read_dev_kmsg(s);
+                if (r <= 0)
+                        return r;
+        }
+
+        return 0;
 }
 
 int server_open_dev_kmsg(Server *s) {
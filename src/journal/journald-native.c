@@ -92,7 +92,7 @@ static void server_process_entry_meta(
 
 static int server_process_entry(
                 Server *s,
-                const void *buffer, size_t *remaining,
+                void *buffer, size_t *remaining,
                 ClientContext *context,
                 const struct ucred *ucred,
                 const struct timeval *tv,
@@ -103,18 +103,18 @@ static int server_process_entry(
          *
          * Note that *remaining is altered on both success and failure. */
 
-        size_t n = 0, j, tn = SIZE_MAX, entry_size = 0;
+        size_t n = 0, entry_size = 0;
         char *identifier = NULL, *message = NULL;
         struct iovec *iovec = NULL;
         int priority = LOG_INFO;
         pid_t object_pid = 0;
-        const char *p;
+        char *p;
         int r = 1;
 
         p = buffer;
 
         while (*remaining > 0) {
-                const char *e, *q;
+                char *e, *q;
 
                 e = memchr(p, '\n', *remaining);
 
@@ -212,17 +212,13 @@ static int server_process_entry(
                                 break;
                         }
 
-                        k = malloc(total);
-                        if (!k) {
-                                log_oom();
-                                break;
-                        }
-
-                        memcpy(k, p, e - p);
-                        k[e - p] = '=';
-                        memcpy(k + (e - p) + 1, e + 1 + sizeof(uint64_t), l);
-
                         if (journal_field_valid(p, e - p, false)) {
+                                /* Turn "FIELD\n<le64 size><data>" into "FIELD=<data>" in place, by moving the
+                                 * field name right in front of the data, overwriting the already parsed size.
+                                 * This way large binary fields (e.g. core dumps) are not copied around. */
+                                k = memmove(p + sizeof(uint64_t), p, e - p);
+                                k[e - p] = '=';
+
                                 iovec[n] = IOVEC_MAKE(k, (e - p) + 1 + l);
                                 entry_size += iovec[n].iov_len;
                                 n++;
@@ -232,8 +228,7 @@ static int server_process_entry(
                                                           &identifier,
                                                           &message,
                                                           &object_pid);
-                        } else
-                                free(k);
+                        }
 
                         *remaining -= (e - p) + 1 + sizeof(uint64_t) + l + 1;
                         p = e + 1 + sizeof(uint64_t) + l + 1;
@@ -243,8 +238,7 @@ static int server_process_entry(
         if (n <= 0)
                 goto finish;
 
-        tn = n++;
-        iovec[tn] = IOVEC_MAKE_STRING("_TRANSPORT=journal");
+        iovec[n++] = IOVEC_MAKE_STRING("_TRANSPORT=journal");
         entry_size += STRLEN("_TRANSPORT=journal");
 
         if (entry_size + n + 1 > ENTRY_SIZE_MAX) { /* data + separators + trailer */
@@ -281,15 +275,6 @@ static int server_process_entry(
         server_dispatch_message(s, iovec, n, MALLOC_ELEMENTSOF(iovec), context, tv, priority, object_pid);
 
 finish:
-        for (j = 0; j < n; j++)  {
-                if (j == tn)
-                        continue;
-
-                if (iovec[j].iov_base < buffer ||
-                    (const char*) iovec[j].iov_base >= p + *remaining)
-                        free(iovec[j].iov_base);
-        }
-
         free(iovec);
         free(identifier);
         free(message);
@@ -299,7 +284,7 @@ finish:
 
 void server_process_native_message(
                 Server *s,
-                const char *buffer, size_t buffer_size,
+                char *buffer, size_t buffer_size,
                 const struct ucred *ucred,
                 const struct timeval *tv,
                 const char *label, size_t label_len) {
@@ -321,7 +306,7 @@ void server_process_native_message(
 
         do {
                 r = server_process_entry(s,
-                                         (const uint8_t*) buffer + (buffer_size - remaining), &remaining,
+                                         (uint8_t*) buffer + (buffer_size - remaining), &remaining,
                                          context, ucred, tv, label, label_len);
         } while (r == 0);
 }
@@ -399,11 +384,12 @@ int server_process_native_file(
                 void *p;
                 size_t ps;
 
-                /* The file is sealed, we can just map it and use it. */
+                /* The file is sealed, we can just map it and use it. The mapping is private and writable, since
+                 * binary fields are unpacked in place. Only the pages touched by that are copied. */
 
                 ps = PAGE_ALIGN(st.st_size);
                 assert(ps < SIZE_MAX);
-                p = mmap(NULL, ps, PROT_READ, MAP_PRIVATE, fd, 0);
+                p = mmap(NULL, ps, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
                 if (p == MAP_FAILED)
                         return log_ratelimit_error_errno(errno, JOURNAL_LOG_RATELIMIT,
                                                          "Failed to map memfd: %m");
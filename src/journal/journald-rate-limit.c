@@ -8,7 +8,6 @@
 #include "time-util.h"
 
 #define POOLS_MAX 5
-#define GROUPS_MAX 2047
 
 static const int priority_map[] = {
         [LOG_EMERG]   = 0,
@@ -71,20 +70,34 @@ static bool journal_ratelimit_group_expired(JournalRateLimitGroup *g, usec_t ts)
         return true;
 }
 
-static void journal_ratelimit_vacuum(OrderedHashmap *groups_by_id, usec_t ts) {
+void journal_ratelimit_done(JournalRateLimit *rl) {
+        assert(rl);
 
-        /* Makes room for at least one new item, but drop all expired items too. */
-
-        while (ordered_hashmap_size(groups_by_id) >= GROUPS_MAX)
-                journal_ratelimit_group_free(ordered_hashmap_first(groups_by_id));
+        rl->groups_by_id = ordered_hashmap_free(rl->groups_by_id);
+}
 
+static void journal_ratelimit_vacuum(JournalRateLimit *rl, usec_t ts) {
         JournalRateLimitGroup *g;
-        while ((g = ordered_hashmap_first(groups_by_id)) && journal_ratelimit_group_expired(g, ts))
+        unsigned groups_max;
+
+        assert(rl);
+
+        /* Makes room for at least one new item, but drop all expired items too. As groups are ordered by
+         * last use, the expired ones are all found at the beginning. */
+
+        groups_max = MAX(rl->groups_max ?: JOURNAL_RATELIMIT_GROUPS_MAX_DEFAULT, 1U);
+
+        while ((g = ordered_hashmap_first(rl->groups_by_id)) && journal_ratelimit_group_expired(g, ts))
                 journal_ratelimit_group_free(g);
+
+        while (ordered_hashmap_size(rl->groups_by_id) >= groups_max) {
+                journal_ratelimit_group_free(ordered_hashmap_first(rl->groups_by_id));
+                rl->n_evicted++;
+        }
 }
 
 static int journal_ratelimit_group_new(
-                OrderedHashmap **groups_by_id,
+                JournalRateLimit *rl,
                 const char *id,
                 usec_t interval,
                 usec_t ts,
@@ -93,7 +106,7 @@ static int journal_ratelimit_group_new(
         _cleanup_(journal_ratelimit_group_freep) JournalRateLimitGroup *g = NULL;
         int r;
 
-        assert(groups_by_id);
+        assert(rl);
         assert(id);
         assert(ret);
 
@@ -108,35 +121,51 @@ static int journal_ratelimit_group_new(
         if (!g->id)
                 return -ENOMEM;
 
-        journal_ratelimit_vacuum(*groups_by_id, ts);
+        journal_ratelimit_vacuum(rl, ts);
 
-        r = ordered_hashmap_ensure_put(groups_by_id, &journal_ratelimit_group_hash_ops, g->id, g);
+        r = ordered_hashmap_ensure_put(&rl->groups_by_id, &journal_ratelimit_group_hash_ops, g->id, g);
         if (r < 0)
                 return r;
         assert(r > 0);
 
-        g->groups_by_id = *groups_by_id;
+        g->groups_by_id = rl->groups_by_id;
 
         *ret = TAKE_PTR(g);
         return 0;
 }
 
 static int journal_ratelimit_group_acquire(
-                OrderedHashmap **groups_by_id,
+                JournalRateLimit *rl,
                 const char *id,
                 usec_t interval,
                 usec_t ts,
                 JournalRateLimitGroup **ret) {
 
         JournalRateLimitGroup *g;
+        int r;
 
-        assert(groups_by_id);
+        assert(rl);
         assert(id);
         assert(ret);
 
-        g = ordered_hashmap_get(*groups_by_id, id);
-        if (!g)
-                return journal_ratelimit_group_new(groups_by_id, id, interval, ts, ret);
+        g = ordered_hashmap_get(rl->groups_by_id, id);
+        if (!g) {
+                rl->n_misses++;
+                return journal_ratelimit_group_new(rl, id, interval, ts, ret);
+        }
+
+        rl->n_hits++;
+
+        /* Move the group to the end, so that the actively logging groups are not the ones evicted first
+         * once the table is full. The entry stays allocated, hence re-adding it cannot fail for lack of
+         * memory in practice, but let's handle that gracefully anyway. */
+        assert_se(ordered_hashmap_remove(rl->groups_by_id, g->id) == g);
+        r = ordered_hashmap_put(rl->groups_by_id, g->id, g);
+        if (r < 0) {
+                g->groups_by_id = NULL;
+                journal_ratelimit_group_free(g);
+                return r;
+        }
 
         g->interval = interval;
 
@@ -173,7 +202,7 @@ static unsigned burst_modulate(unsigned burst, uint64_t available) {
 }
 
 int journal_ratelimit_test(
-                OrderedHashmap **groups_by_id,
+                JournalRateLimit *rl,
                 const char *id,
                 usec_t rl_interval,
                 unsigned rl_burst,
@@ -186,7 +215,7 @@ int journal_ratelimit_test(
         usec_t ts;
         int r;
 
-        assert(groups_by_id);
+        assert(rl);
         assert(id);
 
         /* Returns:
@@ -198,7 +227,7 @@ int journal_ratelimit_test(
 
         ts = now(CLOCK_MONOTONIC);
 
-        r = journal_ratelimit_group_acquire(groups_by_id, id, rl_interval, ts, &g);
+        r = journal_ratelimit_group_acquire(rl, id, rl_interval, ts, &g);
         if (r < 0)
                 return r;
 
@@ -6,8 +6,23 @@
 #include "hashmap.h"
 #include "time-util.h"
 
+#define JOURNAL_RATELIMIT_GROUPS_MAX_DEFAULT 2047U
+
+typedef struct JournalRateLimit {
+        /* Groups ordered by last use, the least recently used one comes first */
+        OrderedHashmap *groups_by_id;
+        unsigned groups_max;
+
+        /* Lookup statistics, useful to size groups_max */
+        uint64_t n_hits;
+        uint64_t n_misses;
+        uint64_t n_evicted;
+} JournalRateLimit;
+
+void journal_ratelimit_done(JournalRateLimit *rl);
+
 int journal_ratelimit_test(
-                OrderedHashmap **groups_by_id,
+                JournalRateLimit *rl,
                 const char *id,
                 usec_t rl_interval,
                 unsigned rl_burst,
@@ -3,6 +3,7 @@
 #if HAVE_SELINUX
 #include <selinux/selinux.h>
 #endif
+#include <sys/inotify.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/signalfd.h>
@@ -93,53 +94,213 @@
 
 #define IDLE_TIMEOUT_USEC (30*USEC_PER_SEC)
 
+/* How many datagrams to process per socket wakeup before going back to the event loop */
+#define SERVER_DATAGRAM_BATCH_MAX 32U
+
+/* Upper limits on the number and total size of entries collected before writing them out in one go */
+#define SERVER_WRITE_BATCH_MAX 64U
+#define SERVER_WRITE_BATCH_SIZE_MAX (256U*1024U)
+
 #define FAILED_TO_WRITE_ENTRY_RATELIMIT ((const RateLimit) { .interval = 1 * USEC_PER_SEC, .burst = 1 })
 
 static int server_schedule_sync(Server *s, int priority);
 static int server_refresh_idle_timer(Server *s);
 
+static bool journal_file_name_is_archived(const char *fn) {
+        assert(fn);
+
+        /* Archived and corrupted files carry an '@' in their name and are not written to anymore, hence
+         * their disk usage only needs to be determined once. */
+        return strchr(fn, '@');
+}
+
+static bool journal_file_name_is_valid(const char *fn) {
+        assert(fn);
+
+        return endswith(fn, ".journal") || endswith(fn, ".journal~");
+}
+
+static void storage_forget_files(JournalStorage *storage) {
+        assert(storage);
+
+        storage->inotify_event_source = sd_event_source_disable_unref(storage->inotify_event_source);
+        hashmap_clear(storage->files);
+}
+
+static int storage_mark_file(JournalStorage *storage, const char *fn) {
+        _cleanup_free_ uint64_t *usage = NULL;
+        _cleanup_free_ char *k = NULL;
+        uint64_t *u;
+        int r;
+
+        assert(storage);
+        assert(fn);
+
+        /* UINT64_MAX means the file still needs to be stat()ed */
+
+        u = hashmap_get(storage->files, fn);
+        if (u) {
+                *u = UINT64_MAX;
+                return 0;
+        }
+
+        k = strdup(fn);
+        if (!k)
+                return -ENOMEM;
+
+        usage = new(uint64_t, 1);
+        if (!usage)
+                return -ENOMEM;
+
+        *usage = UINT64_MAX;
+
+        r = hashmap_ensure_put(&storage->files, &string_hash_ops_free_free, k, usage);
+        if (r < 0)
+                return r;
+
+        TAKE_PTR(k);
+        TAKE_PTR(usage);
+        return 0;
+}
+
+static void storage_unmark_file(JournalStorage *storage, const char *fn) {
+        _cleanup_free_ char *k = NULL;
+
+        assert(storage);
+        assert(fn);
+
+        free(hashmap_remove2(storage->files, fn, (void**) &k));
+}
+
+static int storage_dispatch_inotify(sd_event_source *es, const struct inotify_event *event, void *userdata) {
+        JournalStorage *storage = ASSERT_PTR(userdata);
+        int r;
+
+        assert(event);
+
+        if (event->mask & (IN_Q_OVERFLOW|IN_DELETE_SELF|IN_MOVE_SELF|IN_IGNORED)) {
+                log_debug("Journal directory %s changed underneath us, rescanning it on next space check.", storage->path);
+                storage_forget_files(storage);
+                return 0;
+        }
+
+        if (event->len == 0 || !journal_file_name_is_valid(event->name))
+                return 0;
+
+        if (event->mask & (IN_DELETE|IN_MOVED_FROM)) {
+                storage_unmark_file(storage, event->name);
+                return 0;
+        }
+
+        r = storage_mark_file(storage, event->name);
+        if (r < 0) {
+                log_oom_debug();
+                storage_forget_files(storage);
+        }
+
+        return 0;
+}
+
+static int server_watch_storage(Server *s, JournalStorage *storage) {
+        int r;
+
+        assert(s);
+        assert(storage);
+
+        r = sd_event_add_inotify(s->event, &storage->inotify_event_source, storage->path,
+                                 IN_CREATE|IN_CLOSE_WRITE|IN_MOVED_TO|IN_MOVED_FROM|IN_DELETE|IN_DELETE_SELF|IN_MOVE_SELF|IN_ONLYDIR,
+                                 storage_dispatch_inotify, storage);
+        if (r < 0)
+                return log_debug_errno(r, "Failed to watch %s, will rescan it on every space check: %m", storage->path);
+
+        (void) sd_event_source_set_description(storage->inotify_event_source, "journal-storage-inotify");
+        return 0;
+}
+
+static int storage_update_file(JournalStorage *storage, int dir_fd, const char *fn, uint64_t *usage) {
+        struct stat st;
+
+        assert(storage);
+        assert(dir_fd >= 0);
+        assert(fn);
+        assert(usage);
+
+        if (fstatat(dir_fd, fn, &st, AT_SYMLINK_NOFOLLOW) < 0) {
+                if (errno == ENOENT) {
+                        storage_unmark_file(storage, fn);
+                        return 0;
+                }
+
+                return log_debug_errno(errno, "Failed to stat %s/%s, ignoring: %m", storage->path, fn);
+        }
+
+        if (!S_ISREG(st.st_mode)) {
+                storage_unmark_file(storage, fn);
+                return 0;
+        }
+
+        *usage = (uint64_t) st.st_blocks * 512UL;
+        return 0;
+}
+
 static int server_determine_path_usage(
                 Server *s,
-                const char *path,
+                JournalStorage *storage,
                 uint64_t *ret_used,
                 uint64_t *ret_free) {
 
         _cleanup_closedir_ DIR *d = NULL;
         struct statvfs ss;
+        const char *fn;
+        uint64_t *usage;
+        int r;
 
         assert(s);
-        assert(path);
+        assert(storage);
+        assert(storage->path);
         assert(ret_used);
         assert(ret_free);
 
-        d = opendir(path);
+        d = opendir(storage->path);
         if (!d)
                 return log_ratelimit_full_errno(errno == ENOENT ? LOG_DEBUG : LOG_ERR,
-                                                errno, JOURNAL_LOG_RATELIMIT, "Failed to open %s: %m", path);
+                                                errno, JOURNAL_LOG_RATELIMIT, "Failed to open %s: %m", storage->path);
 
         if (fstatvfs(dirfd(d), &ss) < 0)
                 return log_ratelimit_error_errno(errno, JOURNAL_LOG_RATELIMIT,
-                                                 "Failed to fstatvfs(%s): %m", path);
+                                                 "Failed to fstatvfs(%s): %m", storage->path);
 
-        *ret_free = ss.f_bsize * ss.f_bavail;
-        *ret_used = 0;
-        FOREACH_DIRENT_ALL(de, d, break) {
-                struct stat st;
+        if (!storage->inotify_event_source) {
+                /* No valid index of the directory, start watching it first, so that we don't miss any changes,
+                 * and then enumerate it once. If the watch cannot be established we stay in this branch, and
+                 * rescan the directory each time, as before. */
 
-                if (!endswith(de->d_name, ".journal") &&
-                    !endswith(de->d_name, ".journal~"))
-                        continue;
+                hashmap_clear(storage->files);
+                (void) server_watch_storage(s, storage);
 
-                if (fstatat(dirfd(d), de->d_name, &st, AT_SYMLINK_NOFOLLOW) < 0) {
-                        log_debug_errno(errno, "Failed to stat %s/%s, ignoring: %m", path, de->d_name);
-                        continue;
+                FOREACH_DIRENT_ALL(de, d, storage_forget_files(storage)) {
+                        if (!journal_file_name_is_valid(de->d_name))
+                                continue;
+
+                        r = storage_mark_file(storage, de->d_name);
+                        if (r < 0) {
+                                storage_forget_files(storage);
+                                return log_oom();
+                        }
                 }
+        }
 
-                if (!S_ISREG(st.st_mode))
-                        continue;
+        /* Active files grow while we write to them, hence refresh them each time, and all files we got
+         * notified about since the last check. Archived files don't change, use the cached value for them. */
+        HASHMAP_FOREACH_KEY(usage, fn, storage->files)
+                if (*usage == UINT64_MAX || !journal_file_name_is_archived(fn))
+                        (void) storage_update_file(storage, dirfd(d), fn, usage);
 
-                *ret_used += (uint64_t) st.st_blocks * 512UL;
-        }
+        *ret_free = ss.f_bsize * ss.f_bavail;
+        *ret_used = 0;
+        HASHMAP_FOREACH(usage, storage->files)
+                if (*usage != UINT64_MAX)
+                        *ret_used += *usage;
 
         return 0;
 }
@@ -165,7 +326,7 @@ static int cache_space_refresh(Server *s, JournalStorage *storage) {
         if (space->timestamp != 0 && usec_add(space->timestamp, RECHECK_SPACE_USEC) > ts)
                 return 0;
 
-        r = server_determine_path_usage(s, storage->path, &vfs_used, &vfs_avail);
+        r = server_determine_path_usage(s, storage, &vfs_used, &vfs_avail);
         if (r < 0)
                 return r;
 
@@ -813,6 +974,9 @@ static void server_do_vacuum(Server *s, JournalStorage *storage, bool verbose) {
                 log_ratelimit_warning_errno(r, JOURNAL_LOG_RATELIMIT,
                                             "Failed to vacuum %s, ignoring: %m", storage->path);
 
+        /* The notifications about the files we just removed are not dispatched yet, hence drop the index
+         * and enumerate the directory again on the next space check. */
+        storage_forget_files(storage);
         cache_space_invalidate(&storage->space);
 }
 
@@ -943,24 +1107,24 @@ static bool shall_try_append_again(JournalFile *f, int r) {
         }
 }
 
-static void server_write_to_journal(
+static void server_write_entries_to_journal(
                 Server *s,
                 uid_t uid,
-                const struct iovec *iovec,
-                size_t n,
-                const dual_timestamp *ts,
+                const JournalEntryBatchItem *items,
+                size_t n_items,
                 int priority) {
 
         bool vacuumed = false;
         JournalFile *f;
+        size_t n_appended = 0;
         int r;
 
         assert(s);
-        assert(iovec);
-        assert(n > 0);
-        assert(ts);
+        assert(items);
+        assert(n_items > 0);
 
-        if (ts->realtime < s->last_realtime_clock) {
+        /* Entries are in chronological order, hence checking the first one is sufficient */
+        if (items[0].ts->realtime < s->last_realtime_clock) {
                 /* When the time jumps backwards, let's immediately rotate. Of course, this should not happen during
                  * regular operation. However, when it does happen, then we should make sure that we start fresh files
                  * to ensure that the entries in the journal files are strictly ordered by time, in order to ensure
@@ -994,23 +1158,30 @@ static void server_write_to_journal(
                         return;
         }
 
-        s->last_realtime_clock = ts->realtime;
+        s->last_realtime_clock = items[n_items - 1].ts->realtime;
 
-        r = journal_file_append_entry(
+        r = journal_file_append_entries(
                         f,
-                        ts,
-                        /* boot_id= */ NULL,
-                        iovec, n,
+                        items, n_items,
                         &s->seqnum->seqnum,
                         &s->seqnum->id,
-                        /* ret_object= */ NULL,
-                        /* ret_offset= */ NULL);
+                        &n_appended);
         if (r >= 0) {
                 server_schedule_sync(s, priority);
                 return;
         }
 
-        log_debug_errno(r, "Failed to write entry to %s (%zu items, %zu bytes): %m", f->path, n, iovec_total_size(iovec, n));
+        /* Continue with the first entry that didn't make it. If the failure was only noticed after all
+         * entries were written (i.e. SIGBUS), there's nothing left to retry, but we still rotate. */
+        assert(n_appended <= n_items);
+        items += n_appended;
+        n_items -= n_appended;
+
+        if (n_items > 0)
+                log_debug_errno(r, "Failed to write entry to %s (%zu items, %zu bytes): %m",
+                                f->path, items[0].n_iovec, iovec_total_size(items[0].iovec, items[0].n_iovec));
+        else
+                log_debug_errno(r, "Failed to write entries to %s: %m", f->path);
 
         if (!shall_try_append_again(f, r))
                 return;
@@ -1023,28 +1194,176 @@ static void server_write_to_journal(
         server_rotate_journal(s, TAKE_PTR(f), uid);
         server_vacuum(s, /* verbose = */ false);
 
+        if (n_items == 0)
+                return;
+
         f = server_find_journal(s, uid);
         if (!f)
                 return;
 
         log_debug_errno(r, "Retrying write.");
-        r = journal_file_append_entry(
+        r = journal_file_append_entries(
                         f,
-                        ts,
-                        /* boot_id= */ NULL,
-                        iovec, n,
+                        items, n_items,
                         &s->seqnum->seqnum,
                         &s->seqnum->id,
-                        /* ret_object= */ NULL,
-                        /* ret_offset= */ NULL);
-        if (r < 0)
-                log_ratelimit_error_errno(r, FAILED_TO_WRITE_ENTRY_RATELIMIT,
-                                          "Failed to write entry to %s (%zu items, %zu bytes) despite vacuuming, ignoring: %m",
-                                          f->path, n, iovec_total_size(iovec, n));
-        else
+                        &n_appended);
+        if (r < 0) {
+                assert(n_appended <= n_items);
+
+                if (n_appended < n_items)
+                        log_ratelimit_error_errno(r, FAILED_TO_WRITE_ENTRY_RATELIMIT,
+                                                  "Failed to write entry to %s (%zu items, %zu bytes) despite vacuuming, ignoring: %m",
+                                                  f->path, items[n_appended].n_iovec,
+                                                  iovec_total_size(items[n_appended].iovec, items[n_appended].n_iovec));
+                else
+                        log_ratelimit_error_errno(r, FAILED_TO_WRITE_ENTRY_RATELIMIT,
+                                                  "Failed to write entries to %s despite vacuuming, ignoring: %m",
+                                                  f->path);
+        } else
                 server_schedule_sync(s, priority);
 }
 
+static void server_batch_flush(Server *s) {
+        JournalEntryBatchItem items[SERVER_WRITE_BATCH_MAX];
+
+        assert(s);
+        assert(s->n_batch <= SERVER_WRITE_BATCH_MAX);
+
+        if (s->n_batch == 0)
+                return;
+
+        for (size_t i = 0; i < s->n_batch; i++)
+                items[i] = (JournalEntryBatchItem) {
+                        .ts = &s->batch[i].ts,
+                        .iovec = s->batch[i].iovec,
+                        .n_iovec = s->batch[i].n_iovec,
+                };
+
+        server_write_entries_to_journal(s, s->batch_uid, items, s->n_batch, s->batch_priority);
+
+        FOREACH_ARRAY(e, s->batch, s->n_batch)
+                free(e->iovec);
+
+        s->n_batch = 0;
+        s->batch_size = 0;
+}
+
+static bool server_batch_add(
+                Server *s,
+                uid_t uid,
+                const struct iovec *iovec,
+                size_t n,
+                const dual_timestamp *ts,
+                int priority) {
+
+        struct iovec *copy;
+        size_t size;
+        uint8_t *p;
+
+        assert(s);
+        assert(s->batching);
+        assert(iovec);
+        assert(n > 0);
+        assert(ts);
+
+        /* Queues a copy of the entry for writing at the end of the batch. Returns false if the entry was not
+         * queued, in which case the caller shall write it directly, after flushing what is queued. */
+
+        size = iovec_total_size(iovec, n);
+        if (size > SERVER_WRITE_BATCH_SIZE_MAX)
+                return false;
+
+        /* Entries of a batch go to the same file and need to be in chronological order */
+        if (s->n_batch > 0 &&
+            (s->n_batch >= SERVER_WRITE_BATCH_MAX ||
+             s->batch_size + size > SERVER_WRITE_BATCH_SIZE_MAX ||
+             s->batch_uid != uid ||
+             ts->realtime < s->batch[s->n_batch - 1].ts.realtime))
+                server_batch_flush(s);
+
+        if (!GREEDY_REALLOC(s->batch, s->n_batch + 1))
+                return false;
+
+        copy = malloc(sizeof(struct iovec) * n + size);
+        if (!copy)
+                return false;
+
+        p = (uint8_t*) (copy + n);
+        for (size_t i = 0; i < n; i++) {
+                copy[i] = IOVEC_MAKE(p, iovec[i].iov_len);
+                p = mempcpy_safe(p, iovec[i].iov_base, iovec[i].iov_len);
+        }
+
+        if (s->n_batch == 0) {
+                s->batch_uid = uid;
+                s->batch_priority = priority;
+        } else
+                s->batch_priority = MIN(s->batch_priority, priority);
+
+        s->batch[s->n_batch++] = (ServerBatchEntry) {
+                .ts = *ts,
+                .iovec = copy,
+                .n_iovec = n,
+        };
+        s->batch_size += size;
+
+        return true;
+}
+
+void server_batch_begin(Server *s) {
+        assert(s);
+        assert(!s->batching);
+        assert(s->n_batch == 0);
+
+        /* Between server_batch_begin() and server_batch_end() entries are not written to the journal right
+         * away, but collected and then appended in one go, which saves repeated lookups of the data objects
+         * shared between them (e.g. the metadata fields of the same client) and the change notifications. */
+
+        s->batching = true;
+}
+
+void server_batch_end(Server *s) {
+        assert(s);
+        assert(s->batching);
+
+        server_batch_flush(s);
+        s->batching = false;
+}
+
+static void server_write_to_journal(
+                Server *s,
+                uid_t uid,
+                const struct iovec *iovec,
+                size_t n,
+                const dual_timestamp *ts,
+                int priority) {
+
+        assert(s);
+        assert(iovec);
+        assert(n > 0);
+        assert(ts);
+
+        if (s->batching) {
+                if (server_batch_add(s, uid, iovec, n, ts, priority))
+                        return;
+
+                /* Keep the order of entries, if we couldn't queue this one */
+                server_batch_flush(s);
+        }
+
+        server_write_entries_to_journal(
+                        s,
+                        uid,
+                        &(const JournalEntryBatchItem) {
+                                .ts = ts,
+                                .iovec = iovec,
+                                .n_iovec = n,
+                        },
+                        /* n_items= */ 1,
+                        priority);
+}
+
 #define IOVEC_ADD_NUMERIC_FIELD(iovec, n, value, type, isset, format, field)  \
         if (isset(value)) {                                             \
                 char *k;                                                \
@@ -1288,7 +1607,7 @@ void server_dispatch_message(
                 (void) server_determine_space(s, &available, /* limit= */ NULL);
 
                 rl = journal_ratelimit_test(
-                                &s->ratelimit_groups_by_id,
+                                &s->ratelimit_groups,
                                 c->unit,
                                 c->log_ratelimit_interval,
                                 c->log_ratelimit_burst,
@@ -1486,14 +1805,8 @@ static int server_relinquish_var(Server *s) {
         return 0;
 }
 
-int server_process_datagram(
-                sd_event_source *es,
-                int fd,
-                uint32_t revents,
-                void *userdata) {
-
+static int server_process_one_datagram(Server *s, int fd) {
         size_t label_len = 0, m;
-        Server *s = ASSERT_PTR(userdata);
         struct ucred *ucred = NULL;
         struct timeval tv_buf, *tv = NULL;
         struct cmsghdr *cmsg;
@@ -1526,12 +1839,11 @@ int server_process_datagram(
                 .msg_namelen = sizeof(sa),
         };
 
+        assert(s);
         assert(fd == s->native_fd || fd == s->syslog_fd || fd == s->audit_fd);
 
-        if (revents != EPOLLIN)
-                return log_error_errno(SYNTHETIC_ERRNO(EIO),
-                                       "Got invalid event from epoll for datagram fd: %" PRIx32,
-                                       revents);
+        /* Returns 0 if there was nothing to read, and 1 if a datagram was consumed (regardless if it could
+         * be processed successfully or not). */
 
         /* Try to get the right size, if we can. (Not all sockets support SIOCINQ, hence we just try, but don't rely on
          * it.) */
@@ -1553,11 +1865,11 @@ int server_process_datagram(
         if (n == -ECHRNG) {
                 log_ratelimit_warning_errno(n, JOURNAL_LOG_RATELIMIT,
                                             "Got message with truncated control data (too many fds sent?), ignoring.");
-                return 0;
+                return 1;
         }
         if (n == -EXFULL) {
                 log_ratelimit_warning_errno(n, JOURNAL_LOG_RATELIMIT, "Got message with truncated payload data, ignoring.");
-                return 0;
+                return 1;
         }
         if (n < 0)
                 return log_ratelimit_error_errno(n, JOURNAL_LOG_RATELIMIT, "Failed to receive message: %m");
@@ -1616,8 +1928,39 @@ int server_process_datagram(
 
         close_many(fds, n_fds);
 
+        return 1;
+}
+
+int server_process_datagram(
+                sd_event_source *es,
+                int fd,
+                uint32_t revents,
+                void *userdata) {
+
+        Server *s = ASSERT_PTR(userdata);
+        int r = 0;
+
+        if (revents != EPOLLIN)
+                return log_error_errno(SYNTHETIC_ERRNO(EIO),
+                                       "Got invalid event from epoll for datagram fd: %" PRIx32,
+                                       revents);
+
+        /* A stream connection hands us up to LineMax= worth of log lines per dispatch, while a datagram is a
+         * single message. Process a bounded number of datagrams per dispatch, so that a flood of stdout
+         * stream output cannot starve the datagram sockets, while still returning to the event loop often
+         * enough for other sources to get their turn. */
+        server_batch_begin(s);
+
+        for (unsigned i = 0; i < SERVER_DATAGRAM_BATCH_MAX; i++) {
+                r = server_process_one_datagram(s, fd);
+                if (r <= 0)
+                        break;
+        }
+
+        server_batch_end(s);
+
         server_refresh_idle_timer(s);
-        return 0;
+        return r < 0 ? r : 0;
 }
 
 static void server_full_flush(Server *s) {
@@ -2255,6 +2598,33 @@ static int vl_method_synchronize(sd_varlink *link, sd_json_variant *parameters,
         return 0;
 }
 
+static int vl_method_dump_statistics(sd_varlink *link, sd_json_variant *parameters, sd_varlink_method_flags_t flags, void *userdata) {
+        Server *s = ASSERT_PTR(userdata);
+        int r;
+
+        assert(link);
+
+        r = sd_varlink_dispatch(link, parameters, /* dispatch_table = */ NULL, /* userdata = */ NULL);
+        if (r != 0)
+                return r;
+
+        return sd_varlink_replybo(
+                        link,
+                        SD_JSON_BUILD_PAIR("clientContextCache", SD_JSON_BUILD_OBJECT(
+                                                           SD_JSON_BUILD_PAIR_UNSIGNED("size", hashmap_size(s->client_contexts)),
+                                                           SD_JSON_BUILD_PAIR_UNSIGNED("maxSize", client_context_cache_max()),
+                                                           SD_JSON_BUILD_PAIR_UNSIGNED("hits", s->n_client_context_hits),
+                                                           SD_JSON_BUILD_PAIR_UNSIGNED("misses", s->n_client_context_misses),
+                                                           SD_JSON_BUILD_PAIR_UNSIGNED("evictions", s->n_client_context_evicted),
+                                                           SD_JSON_BUILD_PAIR_UNSIGNED("refreshes", s->n_client_context_refreshes))),
+                        SD_JSON_BUILD_PAIR("rateLimitGroups", SD_JSON_BUILD_OBJECT(
+                                                           SD_JSON_BUILD_PAIR_UNSIGNED("size", ordered_hashmap_size(s->ratelimit_groups.groups_by_id)),
+                                                           SD_JSON_BUILD_PAIR_UNSIGNED("maxSize", s->ratelimit_groups.groups_max),
+                                                           SD_JSON_BUILD_PAIR_UNSIGNED("hits", s->ratelimit_groups.n_hits),
+                                                           SD_JSON_BUILD_PAIR_UNSIGNED("misses", s->ratelimit_groups.n_misses),
+                                                           SD_JSON_BUILD_PAIR_UNSIGNED("evictions", s->ratelimit_groups.n_evicted))));
+}
+
 static int vl_method_rotate(sd_varlink *link, sd_json_variant *parameters, sd_varlink_method_flags_t flags, void *userdata) {
         Server *s = ASSERT_PTR(userdata);
         int r;
@@ -2350,13 +2720,15 @@ static int server_open_varlink(Server *s, const char *socket, int fd) {
 
         r = sd_varlink_server_bind_method_many(
                         s->varlink_server,
-                        "io.systemd.Journal.Synchronize",    vl_method_synchronize,
-                        "io.systemd.Journal.Rotate",         vl_method_rotate,
-                        "io.systemd.Journal.FlushToVar",     vl_method_flush_to_var,
-                        "io.systemd.Journal.RelinquishVar",  vl_method_relinquish_var,
-                        "io.systemd.service.Ping",           varlink_method_ping,
-                        "io.systemd.service.SetLogLevel",    varlink_method_set_log_level,
-                        "io.systemd.service.GetEnvironment", varlink_method_get_environment);
+                        "io.systemd.Journal.Synchronize",         vl_method_synchronize,
+                        "io.systemd.Journal.Rotate",              vl_method_rotate,
+                        "io.systemd.Journal.FlushToVar",          vl_method_flush_to_var,
+                        "io.systemd.Journal.RelinquishVar",       vl_method_relinquish_var,
+                        "io.systemd.Journal.DumpStatistics",      vl_method_dump_statistics,
+                        "io.systemd.service.Ping",                varlink_method_ping,
+                        "io.systemd.service.SetLogLevel",         varlink_method_set_log_level,
+                        "io.systemd.service.GetEnvironment",      varlink_method_get_environment,
+                        "io.systemd.service.GetMemoryStatistics", varlink_method_get_memory_statistics);
         if (r < 0)
                 return r;
 
@@ -2620,6 +2992,7 @@ int server_new(Server **ret) {
 
                 .ratelimit_interval = DEFAULT_RATE_LIMIT_INTERVAL,
                 .ratelimit_burst = DEFAULT_RATE_LIMIT_BURST,
+                .ratelimit_groups.groups_max = JOURNAL_RATELIMIT_GROUPS_MAX_DEFAULT,
 
                 .forward_to_wall = true,
                 .forward_to_socket = { .sockaddr.sa.sa_family = AF_UNSPEC },
@@ -2714,6 +3087,9 @@ int server_init(Server *s, const char *namespace) {
         if (r < 0)
                 return log_error_errno(r, "Failed to create event loop: %m");
 
+        /* Many stdout streams and sockets typically become readable at once, handle them in one go */
+        (void) sd_event_set_batch_dispatch(s->event, true);
+
         n = sd_listen_fds(true);
         if (n < 0)
                 return log_error_errno(n, "Failed to read listening file descriptors from environment: %m");
@@ -2932,6 +3308,8 @@ Server* server_free(Server *s) {
         sd_event_source_unref(s->notify_event_source);
         sd_event_source_unref(s->watchdog_event_source);
         sd_event_source_unref(s->idle_event_source);
+        sd_event_source_unref(s->runtime_storage.inotify_event_source);
+        sd_event_source_unref(s->system_storage.inotify_event_source);
         sd_event_unref(s->event);
 
         safe_close(s->syslog_fd);
@@ -2943,15 +3321,21 @@ Server* server_free(Server *s) {
         safe_close(s->notify_fd);
         safe_close(s->forward_socket_fd);
 
-        ordered_hashmap_free(s->ratelimit_groups_by_id);
+        log_debug("Rate limit groups: %u in use, %" PRIu64 " hits, %" PRIu64 " misses, %" PRIu64 " evicted.",
+                  ordered_hashmap_size(s->ratelimit_groups.groups_by_id),
+                  s->ratelimit_groups.n_hits, s->ratelimit_groups.n_misses, s->ratelimit_groups.n_evicted);
+        journal_ratelimit_done(&s->ratelimit_groups);
 
         server_unmap_seqnum_file(s->seqnum, sizeof(*s->seqnum));
         server_unmap_seqnum_file(s->kernel_seqnum, sizeof(*s->kernel_seqnum));
 
         free(s->buffer);
+        free(s->batch);
         free(s->tty_path);
         free(s->cgroup_root);
         free(s->hostname_field);
+        hashmap_free(s->runtime_storage.files);
+        hashmap_free(s->system_storage.files);
         free(s->runtime_storage.path);
         free(s->system_storage.path);
         free(s->runtime_directory);
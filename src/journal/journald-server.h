@@ -14,6 +14,7 @@ typedef struct Server Server;
 #include "hashmap.h"
 #include "journal-file.h"
 #include "journald-context.h"
+#include "journald-rate-limit.h"
 #include "journald-stream.h"
 #include "list.h"
 #include "prioq.h"
@@ -59,6 +60,11 @@ typedef struct JournalStorage {
 
         JournalMetrics metrics;
         JournalStorageSpace space;
+
+        /* Disk usage of each journal file in 'path', keyed by file name. Kept up to date via inotify while
+         * the watch is active, so that the space accounting doesn't need to rescan the whole directory. */
+        Hashmap *files;
+        sd_event_source *inotify_event_source;
 } JournalStorage;
 
 /* This structure will be kept in $RUNTIME_DIRECTORY/seqnum and is mapped by journald, and is used to
@@ -68,6 +74,14 @@ typedef struct SeqnumData {
         uint64_t seqnum;
 } SeqnumData;
 
+/* A copy of an entry whose write to the journal has been deferred, so that it can be written together with
+ * the entries following it. The iovec array and the data it references are a single allocation. */
+typedef struct ServerBatchEntry {
+        dual_timestamp ts;
+        struct iovec *iovec;
+        size_t n_iovec;
+} ServerBatchEntry;
+
 struct Server {
         char *namespace;
 
@@ -107,7 +121,7 @@ struct Server {
 
         char *buffer;
 
-        OrderedHashmap *ratelimit_groups_by_id;
+        JournalRateLimit ratelimit_groups;
         usec_t sync_interval_usec;
         usec_t ratelimit_interval;
         unsigned ratelimit_burst;
@@ -174,6 +188,14 @@ struct Server {
 
         usec_t last_realtime_clock;
 
+        /* Entries collected while processing a burst of messages, see server_batch_begin() */
+        ServerBatchEntry *batch;
+        size_t n_batch;
+        size_t batch_size;
+        uid_t batch_uid;
+        int batch_priority;
+        bool batching;
+
         size_t line_max;
 
         /* Caching of client metadata */
@@ -182,6 +204,11 @@ struct Server {
 
         usec_t last_cache_pid_flush;
 
+        uint64_t n_client_context_hits;
+        uint64_t n_client_context_misses;
+        uint64_t n_client_context_evicted;
+        uint64_t n_client_context_refreshes;
+
         ClientContext *my_context; /* the context of journald itself */
         ClientContext *pid1_context; /* the context of PID 1 */
 
@@ -237,6 +264,8 @@ void server_rotate(Server *s);
 int server_flush_to_var(Server *s, bool require_flag_file);
 void server_maybe_append_tags(Server *s);
 int server_process_datagram(sd_event_source *es, int fd, uint32_t revents, void *userdata);
+void server_batch_begin(Server *s);
+void server_batch_end(Server *s);
 void server_space_usage_message(Server *s, JournalStorage *storage);
 
 int server_start_or_stop_idle_timer(Server *s);
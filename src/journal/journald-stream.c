@@ -81,6 +81,7 @@ struct StdoutStream {
         struct ucred ucred;
         char *label;
         char *identifier;
+        char *syslog_identifier_field; /* "SYSLOG_IDENTIFIER=" + identifier, built on first use */
         char *unit_id;
         int priority;
         bool level_prefix:1;
@@ -128,6 +129,7 @@ StdoutStream* stdout_stream_free(StdoutStream *s) {
         safe_close(s->fd);
         free(s->label);
         free(s->identifier);
+        free(s->syslog_identifier_field);
         free(s->unit_id);
         free(s->state_file);
         free(s->buffer);
@@ -255,7 +257,7 @@ static int stdout_stream_log(
         int priority;
         char syslog_priority[] = "PRIORITY=\0";
         char syslog_facility[STRLEN("SYSLOG_FACILITY=") + DECIMAL_STR_MAX(int) + 1];
-        _cleanup_free_ char *message = NULL, *syslog_identifier = NULL;
+        _cleanup_free_ char *message = NULL;
         size_t n = 0, m;
         int r;
 
@@ -316,9 +318,12 @@ static int stdout_stream_log(
         }
 
         if (s->identifier) {
-                syslog_identifier = strjoin("SYSLOG_IDENTIFIER=", s->identifier);
-                if (syslog_identifier)
-                        iovec[n++] = IOVEC_MAKE_STRING(syslog_identifier);
+                /* The identifier never changes during the lifetime of a stream, hence build the field
+                 * only once instead of for each line. */
+                if (!s->syslog_identifier_field)
+                        s->syslog_identifier_field = strjoin("SYSLOG_IDENTIFIER=", s->identifier);
+                if (s->syslog_identifier_field)
+                        iovec[n++] = IOVEC_MAKE_STRING(s->syslog_identifier_field);
         }
 
         static const char * const line_break_field_table[_LINE_BREAK_MAX] = {
@@ -560,10 +565,9 @@ static int stdout_stream_scan(
         return 0;
 }
 
-static int stdout_stream_process(sd_event_source *es, int fd, uint32_t revents, void *userdata) {
+static int stdout_stream_process_one(StdoutStream *s, uint32_t revents) {
         CMSG_BUFFER_TYPE(CMSG_SPACE(sizeof(struct ucred))) control;
         size_t limit, consumed, allocated;
-        StdoutStream *s = ASSERT_PTR(userdata);
         struct ucred *ucred;
         struct iovec iovec;
         ssize_t l;
@@ -577,6 +581,8 @@ static int stdout_stream_process(sd_event_source *es, int fd, uint32_t revents,
                 .msg_controllen = sizeof(control),
         };
 
+        assert(s);
+
         if ((revents|EPOLLIN|EPOLLHUP) != (EPOLLIN|EPOLLHUP)) {
                 log_error("Got invalid event from epoll for stdout stream: %"PRIx32, revents);
                 goto terminate;
@@ -653,6 +659,20 @@ terminate:
         return 0;
 }
 
+static int stdout_stream_process(sd_event_source *es, int fd, uint32_t revents, void *userdata) {
+        StdoutStream *s = ASSERT_PTR(userdata);
+        Server *server = ASSERT_PTR(s->server);
+        int r;
+
+        /* A single read may yield many lines, write them to the journal in one go. Note that the stream
+         * might be destroyed while processing it, hence hold on to the server object. */
+        server_batch_begin(server);
+        r = stdout_stream_process_one(s, revents);
+        server_batch_end(server);
+
+        return r;
+}
+
 int stdout_stream_install(Server *s, int fd, StdoutStream **ret) {
         _cleanup_(stdout_stream_freep) StdoutStream *stream = NULL;
         sd_id128_t id;
@@ -4,7 +4,7 @@
 #include "tests.h"
 
 TEST(journal_ratelimit_test) {
-        _cleanup_ordered_hashmap_free_ OrderedHashmap *rl = NULL;
+        _cleanup_(journal_ratelimit_done) JournalRateLimit rl = {};
         int r;
 
         for (unsigned i = 0; i < 20; i++) {
@@ -37,4 +37,26 @@ TEST(journal_ratelimit_test) {
         assert_se(journal_ratelimit_test(&rl, "quux", USEC_PER_SEC, 10, LOG_DEBUG, 0) == 1);
 }
 
+TEST(journal_ratelimit_groups_max) {
+        _cleanup_(journal_ratelimit_done) JournalRateLimit rl = {
+                .groups_max = 2,
+        };
+
+        for (unsigned i = 0; i < 10; i++)
+                assert_se(journal_ratelimit_test(&rl, "hoge", 10 * USEC_PER_SEC, 10, LOG_DEBUG, 0) == 1);
+        assert_se(journal_ratelimit_test(&rl, "foo", 10 * USEC_PER_SEC, 10, LOG_DEBUG, 0) == 1);
+
+        /* Using "hoge" again makes "foo" the least recently used group. */
+        assert_se(journal_ratelimit_test(&rl, "hoge", 10 * USEC_PER_SEC, 10, LOG_DEBUG, 0) == 0);
+
+        /* Adding a third group evicts "foo", but "hoge" is kept and still ratelimited. */
+        assert_se(journal_ratelimit_test(&rl, "quux", 10 * USEC_PER_SEC, 10, LOG_DEBUG, 0) == 1);
+        assert_se(journal_ratelimit_test(&rl, "hoge", 10 * USEC_PER_SEC, 10, LOG_DEBUG, 0) == 0);
+        assert_se(ordered_hashmap_size(rl.groups_by_id) == 2);
+
+        assert_se(rl.n_misses == 3);
+        assert_se(rl.n_hits == 11);
+        assert_se(rl.n_evicted == 1);
+}
+
 DEFINE_TEST_MAIN(LOG_INFO);
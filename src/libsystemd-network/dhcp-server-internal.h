@@ -78,6 +78,7 @@ struct sd_dhcp_server {
 
         int lease_dir_fd;
         char *lease_file;
+        sd_event_source *save_leases;
 };
 
 typedef struct DHCPRequest {
@@ -31,7 +31,10 @@
 #define DHCP_DEFAULT_LEASE_TIME_USEC USEC_PER_HOUR
 #define DHCP_MAX_LEASE_TIME_USEC (USEC_PER_HOUR*12)
 
-static void server_on_lease_change(sd_dhcp_server *server) {
+/* Maximum number of messages we read from a socket per event loop iteration */
+#define DHCP_SERVER_MESSAGES_PER_WAKEUP 16U
+
+static void server_save_leases(sd_dhcp_server *server) {
         int r;
 
         assert(server);
@@ -39,6 +42,42 @@ static void server_on_lease_change(sd_dhcp_server *server) {
         r = dhcp_server_save_leases(server);
         if (r < 0)
                 log_dhcp_server_errno(server, r, "Failed to save leases, ignoring: %m");
+}
+
+static void server_flush_leases(sd_dhcp_server *server) {
+        assert(server);
+
+        if (!server->save_leases)
+                return;
+
+        server->save_leases = sd_event_source_disable_unref(server->save_leases);
+        server_save_leases(server);
+}
+
+static int on_save_leases(sd_event_source *s, void *userdata) {
+        server_flush_leases(ASSERT_PTR(userdata));
+        return 0;
+}
+
+static void server_on_lease_change(sd_dhcp_server *server) {
+        int r;
+
+        assert(server);
+
+        /* The whole lease file is rewritten on each save. Hence, when many leases change in a short time,
+         * e.g. because many clients request an address at the same time, coalesce the writes into one per
+         * event loop iteration. */
+        if (server->save_leases)
+                ; /* Already scheduled. */
+        else if (server->lease_file && server->event) {
+                r = sd_event_add_defer(server->event, &server->save_leases, on_save_leases, server);
+                if (r < 0) {
+                        log_dhcp_server_errno(server, r, "Failed to schedule saving leases, saving them now: %m");
+                        server_save_leases(server);
+                } else
+                        (void) sd_event_source_set_description(server->save_leases, "dhcp-server-save-leases");
+        } else
+                server_save_leases(server);
 
         if (server->callback)
                 server->callback(server, SD_DHCP_SERVER_EVENT_LEASE_CHANGED, server->callback_userdata);
@@ -230,6 +269,8 @@ int sd_dhcp_server_attach_event(sd_dhcp_server *server, sd_event *event, int64_t
 int sd_dhcp_server_detach_event(sd_dhcp_server *server) {
         assert_return(server, -EINVAL);
 
+        server_flush_leases(server);
+
         server->event = sd_event_unref(server->event);
 
         return 0;
@@ -292,6 +333,9 @@ int sd_dhcp_server_stop(sd_dhcp_server *server) {
         server->fd = safe_close(server->fd);
         server->fd_broadcast = safe_close(server->fd_broadcast);
 
+        /* Do not lose lease changes that were not written yet. */
+        server_flush_leases(server);
+
         if (running)
                 log_dhcp_server(server, "STOPPED");
 
@@ -1222,13 +1266,12 @@ static size_t relay_agent_information_length(const char* agent_circuit_id, const
         return sum;
 }
 
-static int server_receive_message(sd_event_source *s, int fd,
-                                  uint32_t revents, void *userdata) {
+/* Returns 0 if there was nothing to read, 1 if a message was read (and possibly processed or ignored). */
+static int server_receive_one(sd_dhcp_server *server, int fd) {
         _cleanup_free_ DHCPMessage *message = NULL;
         /* This needs to be initialized with zero. See #20741. */
         CMSG_BUFFER_TYPE(CMSG_SPACE_TIMEVAL +
                          CMSG_SPACE(sizeof(struct in_pktinfo))) control = {};
-        sd_dhcp_server *server = ASSERT_PTR(userdata);
         struct iovec iov = {};
         struct msghdr msg = {
                 .msg_iov = &iov,
@@ -1239,6 +1282,9 @@ static int server_receive_message(sd_event_source *s, int fd,
         ssize_t datagram_size, len;
         int r;
 
+        assert(server);
+        assert(fd >= 0);
+
         datagram_size = next_datagram_size_fd(fd);
         if (ERRNO_IS_NEG_TRANSIENT(datagram_size) || ERRNO_IS_NEG_DISCONNECT(datagram_size))
                 return 0;
@@ -1267,12 +1313,12 @@ static int server_receive_message(sd_event_source *s, int fd,
         }
 
         if ((size_t) len < sizeof(DHCPMessage))
-                return 0;
+                return 1;
 
         /* TODO figure out if this can be done as a filter on the socket, like for IPv6 */
         struct in_pktinfo *info = CMSG_FIND_DATA(&msg, IPPROTO_IP, IP_PKTINFO, struct in_pktinfo);
         if (info && info->ipi_ifindex != server->ifindex)
-                return 0;
+                return 1;
 
         if (sd_dhcp_server_is_in_relay_mode(server)) {
                 r = dhcp_server_relay_message(server, message, len - sizeof(DHCPMessage), buflen);
@@ -1283,6 +1329,29 @@ static int server_receive_message(sd_event_source *s, int fd,
                 if (r < 0)
                         log_dhcp_server_errno(server, r, "Couldn't process incoming message, ignoring: %m");
         }
+        return 1;
+}
+
+static int server_receive_message(sd_event_source *s, int fd,
+                                  uint32_t revents, void *userdata) {
+        sd_dhcp_server *server = ASSERT_PTR(userdata);
+        int r;
+
+        /* When many clients talk to us at the same time, read a few messages per wakeup, rather than going
+         * through the event loop for each single one. */
+
+        _unused_ _cleanup_(sd_dhcp_server_unrefp) sd_dhcp_server *ref = sd_dhcp_server_ref(server);
+
+        for (unsigned i = 0; i < DHCP_SERVER_MESSAGES_PER_WAKEUP; i++) {
+                r = server_receive_one(server, fd);
+                if (r <= 0)
+                        return r;
+
+                /* The server might have been stopped while processing the message. */
+                if (s != server->receive_message && s != server->receive_broadcast)
+                        break;
+        }
+
         return 0;
 }
 
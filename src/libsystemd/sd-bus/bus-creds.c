@@ -850,13 +850,13 @@ int bus_creds_add_more(sd_bus_creds *c, uint64_t mask, PidRef *pidref, pid_t tid
                 c->mask |= SD_BUS_CREDS_PIDFD;
         }
 
-        if (missing & (SD_BUS_CREDS_PPID |
-                       SD_BUS_CREDS_UID | SD_BUS_CREDS_EUID | SD_BUS_CREDS_SUID | SD_BUS_CREDS_FSUID |
-                       SD_BUS_CREDS_GID | SD_BUS_CREDS_EGID | SD_BUS_CREDS_SGID | SD_BUS_CREDS_FSGID |
-                       SD_BUS_CREDS_SUPPLEMENTARY_GIDS |
-                       SD_BUS_CREDS_EFFECTIVE_CAPS | SD_BUS_CREDS_INHERITABLE_CAPS |
-                       SD_BUS_CREDS_PERMITTED_CAPS | SD_BUS_CREDS_BOUNDING_CAPS)) {
-
+        uint64_t missing_status = missing & (SD_BUS_CREDS_PPID |
+                                             SD_BUS_CREDS_UID | SD_BUS_CREDS_EUID | SD_BUS_CREDS_SUID | SD_BUS_CREDS_FSUID |
+                                             SD_BUS_CREDS_GID | SD_BUS_CREDS_EGID | SD_BUS_CREDS_SGID | SD_BUS_CREDS_FSGID |
+                                             SD_BUS_CREDS_SUPPLEMENTARY_GIDS |
+                                             SD_BUS_CREDS_EFFECTIVE_CAPS | SD_BUS_CREDS_INHERITABLE_CAPS |
+                                             SD_BUS_CREDS_PERMITTED_CAPS | SD_BUS_CREDS_BOUNDING_CAPS);
+        if (missing_status != 0) {
                 _cleanup_fclose_ FILE *f = NULL;
                 const char *p;
 
@@ -873,6 +873,11 @@ int bus_creds_add_more(sd_bus_creds *c, uint64_t mask, PidRef *pidref, pid_t tid
                         for (;;) {
                                 _cleanup_free_ char *line = NULL;
 
+                                /* Most callers only want the (effective) UID/GID, which are near the top
+                                 * of the file, hence stop reading as soon as we have everything. */
+                                if (FLAGS_SET(c->mask, missing_status))
+                                        break;
+
                                 r = read_line(f, LONG_LINE_MAX, &line);
                                 if (r < 0)
                                         return r;
@@ -52,9 +52,15 @@ static bool BUS_MATCH_IS_COMPARE(enum bus_match_node_type t) {
         return t >= BUS_MATCH_SENDER && t <= BUS_MATCH_ARG_HAS_LAST;
 }
 
+static bool BUS_MATCH_IS_NAMESPACE(enum bus_match_node_type t) {
+        return t == BUS_MATCH_PATH_NAMESPACE ||
+                (t >= BUS_MATCH_ARG_NAMESPACE && t <= BUS_MATCH_ARG_NAMESPACE_LAST);
+}
+
 static bool BUS_MATCH_CAN_HASH(enum bus_match_node_type t) {
         return (t >= BUS_MATCH_MESSAGE_TYPE && t <= BUS_MATCH_PATH) ||
                 (t >= BUS_MATCH_ARG && t <= BUS_MATCH_ARG_LAST) ||
+                BUS_MATCH_IS_NAMESPACE(t) ||
                 (t >= BUS_MATCH_ARG_HAS && t <= BUS_MATCH_ARG_HAS_LAST);
 }
 
@@ -235,6 +241,65 @@ static bool value_node_same(
         }
 }
 
+static int bus_match_run_namespace(
+                sd_bus *bus,
+                struct bus_match_node *node,
+                sd_bus_message *m,
+                char separator,
+                const char *test_str) {
+
+        _cleanup_free_ char *allocated = NULL;
+        char stack_buf[256], *buf;
+        size_t l;
+        int r;
+
+        assert(node);
+        assert(test_str);
+
+        /* Instead of testing each namespace value against the string, look up every prefix of the string
+         * that could be a matching namespace in the hash table. See simple_pattern_check() for the
+         * rules: the prefix must either be the whole string, be followed by a separator, or end in one.
+         *
+         * The prefixes are terminated in a copy of the string. Bus names are at most 255 characters, and
+         * object paths are typically short too, hence only allocate the copy for longer strings. */
+
+        l = strlen(test_str);
+        if (l < sizeof(stack_buf))
+                buf = memcpy(stack_buf, test_str, l + 1);
+        else {
+                allocated = strdup(test_str);
+                if (!allocated)
+                        return -ENOMEM;
+
+                buf = allocated;
+        }
+
+        for (size_t k = 0; k <= l; k++) {
+                struct bus_match_node *found;
+                char c;
+
+                if (k < l && buf[k] != separator && (k == 0 || buf[k-1] != separator))
+                        continue;
+
+                c = buf[k];
+                buf[k] = 0;
+                found = hashmap_get(node->compare.children, buf);
+                buf[k] = c;
+
+                if (!found)
+                        continue;
+
+                r = bus_match_run(bus, found, m);
+                if (r != 0)
+                        return r;
+
+                if (bus && bus->match_callbacks_modified)
+                        return 0;
+        }
+
+        return 0;
+}
+
 int bus_match_run(
                 sd_bus *bus,
                 struct bus_match_node *node,
@@ -375,7 +440,18 @@ int bus_match_run(
                 assert_not_reached();
         }
 
-        if (BUS_MATCH_CAN_HASH(node->type)) {
+        if (BUS_MATCH_IS_NAMESPACE(node->type)) {
+
+                /* Namespace matches are hashed too, but need a lookup for each candidate prefix. */
+
+                if (test_str) {
+                        r = bus_match_run_namespace(bus, node, m,
+                                                    node->type == BUS_MATCH_PATH_NAMESPACE ? '/' : '.',
+                                                    test_str);
+                        if (r != 0)
+                                return r;
+                }
+        } else if (BUS_MATCH_CAN_HASH(node->type)) {
                 struct bus_match_node *found;
 
                 /* Lookup via hash table, nice! So let's jump directly. */
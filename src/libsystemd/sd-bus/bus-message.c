@@ -141,6 +141,7 @@ static sd_bus_message* message_free(sd_bus_message *m) {
         message_reset_containers(m);
         assert(m->n_containers == 0);
         message_free_last_container(m);
+        free(m->spare_signature);
 
         bus_creds_done(&m->creds);
         return mfree(m);
@@ -1765,10 +1766,16 @@ _public_ int sd_bus_message_open_container(
 
         c = message_get_last_container(m);
 
-        signature = strdup(contents);
-        if (!signature) {
-                m->poisoned = true;
-                return -ENOMEM;
+        /* Arrays of structs or dict entries open a container with the same contents for each element, hence
+         * avoid a strdup() by taking over the signature of the one closed last. */
+        if (streq_ptr(m->spare_signature, contents))
+                signature = TAKE_PTR(m->spare_signature);
+        else {
+                signature = strdup(contents);
+                if (!signature) {
+                        m->poisoned = true;
+                        return -ENOMEM;
+                }
         }
 
         /* Save old index in the parent container, in case we have to
@@ -1817,7 +1824,7 @@ _public_ int sd_bus_message_close_container(sd_bus_message *m) {
 
         m->n_containers--;
 
-        free(c->signature);
+        free_and_replace(m->spare_signature, c->signature);
 
         return 0;
 }
@@ -102,6 +102,9 @@ struct sd_bus_message {
         struct bus_container root_container, *containers;
         size_t n_containers;
 
+        /* Signature of the most recently closed container, reused if the next one has the same contents */
+        char *spare_signature;
+
         struct iovec *iovec;
         struct iovec iovec_fixed[2];
         unsigned n_iovec;
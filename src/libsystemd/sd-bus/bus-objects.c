@@ -1309,12 +1309,14 @@ static int object_find_and_run(
         if (!m->interface || !m->member)
                 return 0;
 
-        /* Then, look for a known method */
+        /* Then, look for a known method. The vtable members are keyed by the path of the node they were
+         * registered on, so there's no point in hashing the key if this node has no vtables at all, which
+         * is the case for most intermediary nodes of fallback paths. */
         vtable_key.path = (char*) p;
         vtable_key.interface = m->interface;
         vtable_key.member = m->member;
 
-        v = set_get(bus->vtable_methods, &vtable_key);
+        v = n->vtables ? set_get(bus->vtable_methods, &vtable_key) : NULL;
         if (v) {
                 r = method_callbacks_run(bus, m, v, require_fallback, found_object);
                 if (r != 0)
@@ -1341,7 +1343,7 @@ static int object_find_and_run(
                         if (r < 0)
                                 return sd_bus_reply_method_errorf(m, SD_BUS_ERROR_INVALID_ARGS, "Expected interface and member parameters");
 
-                        v = set_get(bus->vtable_properties, &vtable_key);
+                        v = n->vtables ? set_get(bus->vtable_properties, &vtable_key) : NULL;
                         if (v) {
                                 r = property_get_set_callbacks_run(bus, m, v, require_fallback, get, found_object);
                                 if (r != 0)
@@ -1233,19 +1233,29 @@ int bus_socket_write_message(sd_bus *bus, sd_bus_message *m, size_t *idx) {
         if (r < 0)
                 return r;
 
-        n = m->n_iovec * sizeof(struct iovec);
-        iov = newa(struct iovec, n);
-        memcpy_safe(iov, m->iovec, n);
+        /* Large messages typically consist of many body parts and are written in several steps. Only
+         * copy the iovec array if we need to skip over what has already been written, and in that case
+         * don't pass the consumed entries to the kernel again. */
+        if (*idx == 0) {
+                iov = m->iovec;
+                n = m->n_iovec;
+        } else {
+                iov = newa(struct iovec, m->n_iovec);
+                memcpy_safe(iov, m->iovec, m->n_iovec * sizeof(struct iovec));
+
+                j = 0;
+                iovec_advance(iov, &j, *idx);
 
-        j = 0;
-        iovec_advance(iov, &j, *idx);
+                iov += j;
+                n = m->n_iovec - j;
+        }
 
         if (bus->prefer_writev)
-                k = writev(bus->output_fd, iov, m->n_iovec);
+                k = writev(bus->output_fd, iov, n);
         else {
                 struct msghdr mh = {
                         .msg_iov = iov,
-                        .msg_iovlen = m->n_iovec,
+                        .msg_iovlen = n,
                 };
 
                 if (m->n_fds > 0 && *idx == 0) {
@@ -1263,7 +1273,7 @@ int bus_socket_write_message(sd_bus *bus, sd_bus_message *m, size_t *idx) {
                 k = sendmsg(bus->output_fd, &mh, MSG_DONTWAIT|MSG_NOSIGNAL);
                 if (k < 0 && errno == ENOTSOCK) {
                         bus->prefer_writev = true;
-                        k = writev(bus->output_fd, iov, m->n_iovec);
+                        k = writev(bus->output_fd, iov, n);
                 }
         }
 
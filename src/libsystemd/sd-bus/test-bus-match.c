@@ -1,5 +1,6 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 
+#include "alloc-util.h"
 #include "bus-match.h"
 #include "bus-message.h"
 #include "bus-slot.h"
@@ -7,6 +8,7 @@
 #include "macro.h"
 #include "memory-util.h"
 #include "tests.h"
+#include "time-util.h"
 
 static bool mask[32];
 
@@ -66,6 +68,56 @@ static void test_match_scope(const char *match, enum bus_match_scope scope) {
         assert_se(bus_match_get_scope(components, n_components) == scope);
 }
 
+#define N_MANY_MATCHES 10000U
+
+static unsigned n_many_hits = 0;
+
+static int filter_count(sd_bus_message *m, void *userdata, sd_bus_error *ret_error) {
+        n_many_hits++;
+        return 0;
+}
+
+static void test_many_matches(sd_bus *bus) {
+        struct bus_match_node root = {
+                .type = BUS_MATCH_ROOT,
+        };
+        _cleanup_(sd_bus_message_unrefp) sd_bus_message *m = NULL;
+        _cleanup_free_ sd_bus_slot *slots = NULL;
+        usec_t t;
+
+        assert_se(slots = new0(sd_bus_slot, N_MANY_MATCHES));
+
+        for (unsigned i = 0; i < N_MANY_MATCHES; i++) {
+                struct bus_match_component *components;
+                _cleanup_free_ char *match = NULL;
+                size_t n_components;
+
+                assert_se(asprintf(&match, "type='signal',path_namespace='/org/test/%u',arg0namespace='org.test.i%u'", i, i) >= 0);
+                assert_se(bus_match_parse(match, &components, &n_components) >= 0);
+                CLEANUP_ARRAY(components, n_components, bus_match_parse_free);
+
+                slots[i].match_callback.callback = filter_count;
+                assert_se(bus_match_add(&root, components, n_components, &slots[i].match_callback) >= 0);
+        }
+
+        assert_se(sd_bus_message_new_signal(bus, &m, "/org/test/4242/sub", "org.test.x", "Changed") >= 0);
+        assert_se(sd_bus_message_append(m, "s", "org.test.i4242.foo") >= 0);
+        assert_se(sd_bus_message_seal(m, 1, 0) >= 0);
+
+        t = now(CLOCK_MONOTONIC);
+
+        for (unsigned i = 0; i < 1000; i++) {
+                n_many_hits = 0;
+                assert_se(bus_match_run(NULL, &root, m) == 0);
+                assert_se(n_many_hits == 1);
+        }
+
+        log_info("Ran 1000 messages against %u matches in %s.",
+                 N_MANY_MATCHES, FORMAT_TIMESPAN(usec_sub_unsigned(now(CLOCK_MONOTONIC), t), 1));
+
+        bus_match_free(&root);
+}
+
 int main(int argc, char *argv[]) {
         struct bus_match_node root = {
                 .type = BUS_MATCH_ROOT,
@@ -141,5 +193,7 @@ int main(int argc, char *argv[]) {
         test_match_scope("member='gurke',path='/org/freedesktop/DBus/Local'", BUS_MATCH_LOCAL);
         test_match_scope("arg2='piep',sender='org.freedesktop.DBus',member='waldo'", BUS_MATCH_DRIVER);
 
+        test_many_matches(bus);
+
         return 0;
 }
@@ -8,6 +8,7 @@
 #include "alloc-util.h"
 #include "device-enumerator-private.h"
 #include "device-filter.h"
+#include "device-internal.h"
 #include "device-util.h"
 #include "dirent-util.h"
 #include "fd-util.h"
@@ -385,50 +386,60 @@ static int enumerator_sort_devices(sd_device_enumerator *enumerator) {
                 return -ENOMEM;
 
         STRV_FOREACH(prioritized_subsystem, enumerator->prioritized_subsystems) {
+                _cleanup_set_free_ Set *picked = NULL;
+                const char *syspath;
+                size_t m = n;
 
-                for (;;) {
-                        const char *syspath;
-                        size_t m = n;
+                /* Pick all devices of the subsystem and their parents in a single pass. We cannot remove
+                 * multiple entries in the loop HASHMAP_FOREACH_KEY() below, hence track the devices picked
+                 * so far in a set, rather than restarting the iteration after each picked device, which
+                 * would make this quadratic in the number of devices. */
 
-                        HASHMAP_FOREACH_KEY(device, syspath, enumerator->devices_by_syspath) {
-                                _cleanup_free_ char *p = NULL;
+                HASHMAP_FOREACH_KEY(device, syspath, enumerator->devices_by_syspath) {
+                        _cleanup_free_ char *p = NULL;
 
-                                if (!device_in_subsystem(device, *prioritized_subsystem))
-                                        continue;
+                        if (!device_in_subsystem(device, *prioritized_subsystem))
+                                continue;
 
-                                devices[n++] = sd_device_ref(device);
+                        r = set_ensure_put(&picked, &string_hash_ops, syspath);
+                        if (r < 0)
+                                goto failed;
+                        if (r == 0) /* already picked as parent of another device */
+                                continue;
 
-                                for (;;) {
-                                        _cleanup_free_ char *q = NULL;
+                        devices[n++] = sd_device_ref(device);
 
-                                        r = path_extract_directory(p ?: syspath, &q);
-                                        if (r == -EADDRNOTAVAIL)
-                                                break;
-                                        if (r < 0)
-                                                goto failed;
+                        for (;;) {
+                                _cleanup_free_ char *q = NULL;
+                                sd_device *parent;
+                                const char *parent_syspath;
 
-                                        device = hashmap_get(enumerator->devices_by_syspath, q);
-                                        if (device)
-                                                devices[n++] = sd_device_ref(device);
+                                r = path_extract_directory(p ?: syspath, &q);
+                                if (r == -EADDRNOTAVAIL)
+                                        break;
+                                if (r < 0)
+                                        goto failed;
 
-                                        free_and_replace(p, q);
+                                parent = hashmap_get2(enumerator->devices_by_syspath, q, (void**) &parent_syspath);
+                                if (parent) {
+                                        r = set_ensure_put(&picked, &string_hash_ops, parent_syspath);
+                                        if (r < 0)
+                                                goto failed;
+                                        if (r > 0)
+                                                devices[n++] = sd_device_ref(parent);
                                 }
 
-                                break;
+                                free_and_replace(p, q);
                         }
+                }
 
-                        /* We cannot remove multiple entries in the loop HASHMAP_FOREACH_KEY() above. */
-                        for (size_t i = m; i < n; i++) {
-                                r = sd_device_get_syspath(devices[i], &syspath);
-                                if (r < 0)
-                                        goto failed;
-
-                                assert_se(hashmap_remove(enumerator->devices_by_syspath, syspath) == devices[i]);
-                                sd_device_unref(devices[i]);
-                        }
+                for (size_t i = m; i < n; i++) {
+                        r = sd_device_get_syspath(devices[i], &syspath);
+                        if (r < 0)
+                                goto failed;
 
-                        if (m == n)
-                                break;
+                        assert_se(hashmap_remove(enumerator->devices_by_syspath, syspath) == devices[i]);
+                        sd_device_unref(devices[i]);
                 }
 
                 typesafe_qsort(devices + n_sorted, n - n_sorted, device_compare);
@@ -697,9 +708,11 @@ static int enumerator_scan_dir_and_add_devices(
                 sd_device_enumerator *enumerator,
                 const char *basedir,
                 const char *subdir1,
-                const char *subdir2) {
+                const char *subdir2,
+                const char *subsystem) {
 
         _cleanup_closedir_ DIR *dir = NULL;
+        MatchFlag flags = MATCH_ALL & (~MATCH_SYSNAME); /* sysname is already tested. */
         char *path;
         int k, r = 0;
 
@@ -714,6 +727,11 @@ static int enumerator_scan_dir_and_add_devices(
         if (subdir2)
                 path = strjoina(path, subdir2, "/");
 
+        /* If the caller knows the subsystem of all devices in the directory, it has been tested already, and
+         * we can save reading the 'subsystem' symlink of each device. */
+        if (subsystem)
+                flags &= ~MATCH_SUBSYSTEM;
+
         dir = opendir(path);
         if (!dir) {
                 /* This is necessarily racey, so ignore missing directories */
@@ -744,7 +762,15 @@ static int enumerator_scan_dir_and_add_devices(
                         continue;
                 }
 
-                k = test_matches(enumerator, device, MATCH_ALL & (~MATCH_SYSNAME)); /* sysname is already tested. */
+                if (subsystem) {
+                        k = device_set_subsystem(device, subsystem);
+                        if (k < 0) {
+                                r = k;
+                                continue;
+                        }
+                }
+
+                k = test_matches(enumerator, device, flags);
                 if (k <= 0) {
                         if (k < 0)
                                 r = k;
@@ -795,7 +821,9 @@ static int enumerator_scan_dir(
                 if (!match_subsystem(enumerator, subsystem ?: de->d_name))
                         continue;
 
-                k = enumerator_scan_dir_and_add_devices(enumerator, basedir, de->d_name, subdir);
+                /* Devices in /sys/bus/X/devices/ and /sys/class/X/ are in subsystem X. */
+                k = enumerator_scan_dir_and_add_devices(enumerator, basedir, de->d_name, subdir,
+                                                        subsystem ? NULL : de->d_name);
                 if (k < 0)
                         r = k;
         }
@@ -1054,14 +1082,14 @@ int device_enumerator_scan_subsystems(sd_device_enumerator *enumerator) {
 
         /* modules */
         if (match_subsystem(enumerator, "module")) {
-                k = enumerator_scan_dir_and_add_devices(enumerator, "module", NULL, NULL);
+                k = enumerator_scan_dir_and_add_devices(enumerator, "module", NULL, NULL, "module");
                 if (k < 0)
                         r = log_debug_errno(k, "sd-device-enumerator: Failed to scan modules: %m");
         }
 
         /* subsystems (only buses support coldplug) */
         if (match_subsystem(enumerator, "subsystem")) {
-                k = enumerator_scan_dir_and_add_devices(enumerator, "bus", NULL, NULL);
+                k = enumerator_scan_dir_and_add_devices(enumerator, "bus", NULL, NULL, "subsystem");
                 if (k < 0)
                         r = log_debug_errno(k, "sd-device-enumerator: Failed to scan subsystems: %m");
         }
@@ -1129,12 +1157,12 @@ int device_enumerator_scan_devices_and_subsystems(sd_device_enumerator *enumerat
                 r = enumerator_scan_devices_all(enumerator);
 
                 if (match_subsystem(enumerator, "module")) {
-                        k = enumerator_scan_dir_and_add_devices(enumerator, "module", NULL, NULL);
+                        k = enumerator_scan_dir_and_add_devices(enumerator, "module", NULL, NULL, "module");
                         if (k < 0)
                                 r = log_debug_errno(k, "sd-device-enumerator: Failed to scan modules: %m");
                 }
                 if (match_subsystem(enumerator, "subsystem")) {
-                        k = enumerator_scan_dir_and_add_devices(enumerator, "bus", NULL, NULL);
+                        k = enumerator_scan_dir_and_add_devices(enumerator, "bus", NULL, NULL, "subsystem");
                         if (k < 0)
                                 r = log_debug_errno(k, "sd-device-enumerator: Failed to scan subsystems: %m");
                 }
@@ -519,10 +519,12 @@ static int passes_filter(sd_device_monitor *m, sd_device *device) {
         if (!check_tag_filter(m, device))
                 return false;
 
-        if (!device_match_sysattr(device, m->match_sysattr_filter, m->nomatch_sysattr_filter))
+        /* Check the parent filter before the sysattr filter, as the former only compares syspaths, while
+         * the latter needs to read the attributes from sysfs. */
+        if (!device_match_parent(device, m->match_parent_filter, m->nomatch_parent_filter))
                 return false;
 
-        return device_match_parent(device, m->match_parent_filter, m->nomatch_parent_filter);
+        return device_match_sysattr(device, m->match_sysattr_filter, m->nomatch_sysattr_filter);
 }
 
 static bool check_sender_uid(sd_device_monitor *m, uid_t uid) {
@@ -831,6 +833,10 @@ _public_ int sd_device_monitor_filter_update(sd_device_monitor *m) {
         if (!set_isempty(m->tag_filter)) {
                 int tag_matches = set_size(m->tag_filter);
 
+                /* The jump offsets below are 8-bit wide. */
+                if (tag_matches * 6 > UINT8_MAX)
+                        return -E2BIG;
+
                 /* add all tags matches */
                 SET_FOREACH(tag, m->tag_filter) {
                         uint64_t tag_bloom_bits = string_bloom64(tag);
@@ -851,6 +857,9 @@ _public_ int sd_device_monitor_filter_update(sd_device_monitor *m) {
                         /* jump behind end of tag match block if tag matches */
                         tag_matches--;
                         bpf_jmp(ins, &i, BPF_JMP|BPF_JEQ|BPF_K, tag_bloom_lo, 1 + (tag_matches * 6), 0);
+
+                        if (i+1 >= ELEMENTSOF(ins))
+                                return -E2BIG;
                 }
 
                 /* nothing matched, drop packet */
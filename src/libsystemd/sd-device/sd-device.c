@@ -1607,17 +1607,15 @@ bool device_has_devlink(sd_device *device, const char *devlink) {
         return set_contains(device->devlinks, devlink);
 }
 
-static int device_add_property_internal_from_string(sd_device *device, const char *str) {
-        _cleanup_free_ char *key = NULL;
+static int device_add_property_internal_from_string(sd_device *device, char *key) {
         char *value;
         int r;
 
         assert(device);
-        assert(str);
+        assert(key);
 
-        key = strdup(str);
-        if (!key)
-                return -ENOMEM;
+        /* The string is split in place, as the caller passes in a line of the db buffer, which is not used
+         * afterwards anyway. Both the key and the value are copied when stored. */
 
         value = strchr(key, '=');
         if (!value)
@@ -1653,7 +1651,7 @@ int device_set_usec_initialized(sd_device *device, usec_t when) {
         return 0;
 }
 
-static int handle_db_line(sd_device *device, char key, const char *value) {
+static int handle_db_line(sd_device *device, char key, char *value) {
         int r;
 
         assert(device);
@@ -1759,7 +1757,7 @@ _public_ int sd_device_get_device_id(sd_device *device, const char **ret) {
 
 int device_read_db_internal_filename(sd_device *device, const char *filename) {
         _cleanup_free_ char *db = NULL;
-        const char *value;
+        char *value;
         size_t db_len;
         char key = '\0';  /* Unnecessary initialization to appease gcc-12.0.0-0.4.fc36 */
         int r;
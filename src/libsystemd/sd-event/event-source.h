@@ -46,6 +46,16 @@ typedef enum WakeupType {
 
 struct inode_data;
 
+typedef struct EventSourceProfile {
+        uint64_t n_dispatch;
+        usec_t total_usec;
+        usec_t max_usec;
+        usec_t max_latency_usec;
+
+        /* Logarithmic histogram of the callback durations in µs */
+        unsigned durations[sizeof(usec_t) * 8];
+} EventSourceProfile;
+
 struct sd_event_source {
         WakeupType wakeup;
 
@@ -78,6 +88,9 @@ struct sd_event_source {
 
         RateLimit rate_limit;
 
+        /* Only allocated if SD_EVENT_PROFILE_DELAYS is set */
+        EventSourceProfile *profile;
+
         /* These are primarily fields relevant for time event sources, but since any event source can
          * effectively become one when rate-limited, this is part of the common fields. */
         unsigned earliest_index;
@@ -160,6 +173,7 @@ struct clock_data {
         usec_t next;
 
         bool needs_rearm:1;
+        bool needs_flush:1; /* timerfd elapsed, but its expiration counter was not read yet */
 };
 
 struct signal_data {
@@ -156,6 +156,7 @@ struct sd_event {
         bool need_process_child:1;
         bool watchdog:1;
         bool profile_delays:1;
+        bool batch_dispatch:1;
 
         int exit_code;
 
@@ -430,7 +431,7 @@ _public_ int sd_event_new(sd_event** ret) {
         e->epoll_fd = fd_move_above_stdio(e->epoll_fd);
 
         if (secure_getenv("SD_EVENT_PROFILE_DELAYS")) {
-                log_debug("Event loop profiling enabled. Logarithmic histogram of event loop iterations in the range 2^0 %s 2^63 us will be logged every 5s.",
+                log_debug("Event loop profiling enabled. Logarithmic histograms of event loop iterations and of event source callback durations in the range 2^0 %s 2^63 us will be logged every 5s.",
                           glyph(GLYPH_ELLIPSIS));
                 e->profile_delays = true;
         }
@@ -1118,6 +1119,7 @@ static sd_event_source* source_free(sd_event_source *s) {
                 s->destroy_callback(s->userdata);
 
         free(s->description);
+        free(s->profile);
         return mfree(s);
 }
 DEFINE_TRIVIAL_CLEANUP_FUNC(sd_event_source*, source_free);
@@ -3104,6 +3106,10 @@ _public_ int sd_event_source_set_time(sd_event_source *s, uint64_t usec) {
         assert_return(s->event->state != SD_EVENT_FINISHED, -ESTALE);
         assert_return(!event_origin_changed(s->event), -ECHILD);
 
+        /* Timers are frequently reset to the same time again, avoid reordering the prioqs in that case */
+        if (s->time.next == usec && !s->pending)
+                return 0;
+
         r = source_set_pending(s, false);
         if (r < 0)
                 return r;
@@ -3155,13 +3161,16 @@ _public_ int sd_event_source_set_time_accuracy(sd_event_source *s, uint64_t usec
         assert_return(s->event->state != SD_EVENT_FINISHED, -ESTALE);
         assert_return(!event_origin_changed(s->event), -ECHILD);
 
+        if (usec == 0)
+                usec = DEFAULT_ACCURACY_USEC;
+
+        if (s->time.accuracy == usec && !s->pending)
+                return 0;
+
         r = source_set_pending(s, false);
         if (r < 0)
                 return r;
 
-        if (usec == 0)
-                usec = DEFAULT_ACCURACY_USEC;
-
         s->time.accuracy = usec;
 
         event_source_time_prioq_reshuffle(s);
@@ -3523,6 +3532,57 @@ static usec_t sleep_between(sd_event *e, usec_t a, usec_t b) {
         return b;
 }
 
+static int flush_timer(sd_event *e, int fd, uint32_t events) {
+        uint64_t x;
+        ssize_t ss;
+
+        assert(e);
+        assert(fd >= 0);
+
+        assert_return(events == EPOLLIN, -EIO);
+
+        ss = read(fd, &x, sizeof(x));
+        if (ss < 0) {
+                if (ERRNO_IS_TRANSIENT(errno))
+                        return 0;
+
+                return -errno;
+        }
+
+        if (_unlikely_(ss != sizeof(x)))
+                return -EIO;
+
+        return 0;
+}
+
+static int event_settime_timer(sd_event *e, struct clock_data *d, const struct itimerspec *its) {
+        int r;
+
+        assert(e);
+        assert(d);
+        assert(d->fd >= 0);
+        assert(its);
+
+        if (timerfd_settime(d->fd, TFD_TIMER_ABSTIME, its, NULL) >= 0) {
+                d->needs_flush = false;
+                return 0;
+        }
+
+        r = -errno;
+        log_debug_errno(r, "Failed to arm timerfd, retrying on next iteration: %m");
+
+        /* If the timer elapsed, we rely on timerfd_settime() to reset its expiration counter. Since that
+         * failed, read the counter now, so that the fd doesn't keep waking us up, which would make the loop
+         * spin. The timer is armed again only on the next iteration. */
+        if (d->needs_flush) {
+                (void) flush_timer(e, d->fd, EPOLLIN);
+                d->needs_flush = false;
+        }
+        d->needs_rearm = true;
+
+        return r;
+}
+
 static int event_arm_timer(
                 sd_event *e,
                 struct clock_data *d) {
@@ -3530,6 +3590,7 @@ static int event_arm_timer(
         struct itimerspec its = {};
         sd_event_source *a, *b;
         usec_t t;
+        int r;
 
         assert(e);
         assert(d);
@@ -3546,12 +3607,13 @@ static int event_arm_timer(
                 if (d->fd < 0)
                         return 0;
 
-                if (d->next == USEC_INFINITY)
+                if (d->next == USEC_INFINITY && !d->needs_flush)
                         return 0;
 
                 /* disarm */
-                if (timerfd_settime(d->fd, TFD_TIMER_ABSTIME, &its, NULL) < 0)
-                        return -errno;
+                r = event_settime_timer(e, d, &its);
+                if (r < 0)
+                        return r;
 
                 d->next = USEC_INFINITY;
                 return 0;
@@ -3562,7 +3624,7 @@ static int event_arm_timer(
         assert(b && b->enabled != SD_EVENT_OFF);
 
         t = sleep_between(e, time_event_source_next(a), time_event_source_latest(b));
-        if (d->next == t)
+        if (d->next == t && !d->needs_flush)
                 return 0;
 
         assert_se(d->fd >= 0);
@@ -3574,8 +3636,9 @@ static int event_arm_timer(
         } else
                 timespec_store(&its.it_value, t);
 
-        if (timerfd_settime(d->fd, TFD_TIMER_ABSTIME, &its, NULL) < 0)
-                return -errno;
+        r = event_settime_timer(e, d, &its);
+        if (r < 0)
+                return r;
 
         d->next = t;
         return 0;
@@ -3600,28 +3663,21 @@ static int process_io(sd_event *e, sd_event_source *s, uint32_t revents) {
         return source_set_pending(s, true);
 }
 
-static int flush_timer(sd_event *e, int fd, uint32_t events, usec_t *next) {
-        uint64_t x;
-        ssize_t ss;
-
+static int flush_clock_data(sd_event *e, struct clock_data *d, uint32_t events) {
         assert(e);
-        assert(fd >= 0);
+        assert(d);
+        assert(d->fd >= 0);
 
         assert_return(events == EPOLLIN, -EIO);
 
-        ss = read(fd, &x, sizeof(x));
-        if (ss < 0) {
-                if (ERRNO_IS_TRANSIENT(errno))
-                        return 0;
-
-                return -errno;
-        }
-
-        if (_unlikely_(ss != sizeof(x)))
-                return -EIO;
+        /* The timerfd is re-armed or disarmed with timerfd_settime() before we wait again anyway, which
+         * also resets its expiration counter. Hence, instead of reading the counter right away, only note
+         * that the timer elapsed, and let event_arm_timer() take care of it. This saves a read() on every
+         * timer wakeup. */
 
-        if (next)
-                *next = USEC_INFINITY;
+        d->next = USEC_INFINITY;
+        d->needs_flush = true;
+        d->needs_rearm = true;
 
         return 0;
 }
@@ -4107,9 +4163,33 @@ static int source_memory_pressure_initiate_dispatch(sd_event_source *s) {
         return 0; /* go on, dispatch to user callback */
 }
 
+static void source_profile_record(sd_event_source *s, sd_event *e, usec_t begin) {
+        usec_t n, d;
+
+        assert(s);
+        assert(e);
+
+        if (!s->profile) {
+                s->profile = new0(EventSourceProfile, 1);
+                if (!s->profile)
+                        return;
+        }
+
+        n = now(CLOCK_MONOTONIC);
+        d = usec_sub_unsigned(n, begin);
+
+        s->profile->n_dispatch++;
+        s->profile->total_usec = usec_add(s->profile->total_usec, d);
+        s->profile->max_usec = MAX(s->profile->max_usec, d);
+        s->profile->max_latency_usec = MAX(s->profile->max_latency_usec,
+                                           usec_sub_unsigned(begin, e->timestamp.monotonic));
+        s->profile->durations[log2u64(d)]++;
+}
+
 static int source_dispatch(sd_event_source *s) {
         EventSourceType saved_type;
         sd_event *saved_event;
+        usec_t begin = 0;
         int r = 0;
 
         assert(s);
@@ -4171,6 +4251,9 @@ static int source_dispatch(sd_event_source *s) {
                         return r;
         }
 
+        if (saved_event->profile_delays)
+                begin = now(CLOCK_MONOTONIC);
+
         s->dispatching = true;
 
         switch (s->type) {
@@ -4261,6 +4344,10 @@ static int source_dispatch(sd_event_source *s) {
 
         s->dispatching = false;
 
+        /* The callback might have disconnected the source, hence use our own reference to the event loop */
+        if (begin > 0)
+                source_profile_record(s, saved_event, begin);
+
 finish:
         if (r < 0) {
                 log_debug_errno(r, "Event source %s (type %s) returned error, %s: %m",
@@ -4607,7 +4694,7 @@ static int process_epoll(sd_event *e, usec_t timeout, int64_t threshold, int64_t
         for (size_t i = 0; i < m; i++) {
 
                 if (e->event_queue[i].data.ptr == INT_TO_PTR(SOURCE_WATCHDOG))
-                        r = flush_timer(e, e->watchdog_fd, e->event_queue[i].events, NULL);
+                        r = flush_timer(e, e->watchdog_fd, e->event_queue[i].events);
                 else {
                         WakeupType *t = e->event_queue[i].data.ptr;
 
@@ -4649,7 +4736,7 @@ static int process_epoll(sd_event *e, usec_t timeout, int64_t threshold, int64_t
 
                                 assert(d);
 
-                                r = flush_timer(e, d->fd, e->event_queue[i].events, &d->next);
+                                r = flush_clock_data(e, d, e->event_queue[i].events);
                                 break;
                         }
 
@@ -4794,8 +4881,24 @@ _public_ int sd_event_dispatch(sd_event *e) {
         if (p) {
                 PROTECT_EVENT(e);
 
+                /* The event source might be gone after dispatching it, save what we need. */
+                EventSourceType type = p->type;
+                int64_t priority = p->priority;
+
                 e->state = SD_EVENT_RUNNING;
                 r = source_dispatch(p);
+
+                /* If requested, dispatch all other IO sources that are pending at the same priority right
+                 * away, instead of going through another prepare and wait cycle for each of them. */
+                if (e->batch_dispatch && type == SOURCE_IO)
+                        while (r >= 0 && !e->exit_requested) {
+                                p = event_next_pending(e);
+                                if (!p || p->type != SOURCE_IO || p->priority != priority)
+                                        break;
+
+                                r = source_dispatch(p);
+                        }
+
                 e->state = SD_EVENT_INITIAL;
                 return r;
         }
@@ -4816,6 +4919,36 @@ static void event_log_delays(sd_event *e) {
                 *delay = 0;
         }
         log_debug("Event loop iterations: %s", b);
+
+        /* Callback durations of the event sources dispatched since the last time, the histogram is truncated
+         * after the last non-empty bucket. */
+        LIST_FOREACH(sources, s, e->sources) {
+                EventSourceProfile *pr = s->profile;
+                size_t n = 0;
+
+                if (!pr || pr->n_dispatch == 0)
+                        continue;
+
+                for (size_t i = 0; i < ELEMENTSOF(pr->durations); i++)
+                        if (pr->durations[i] > 0)
+                                n = i + 1;
+
+                p = b;
+                l = sizeof(b);
+                FOREACH_ARRAY(d, pr->durations, n)
+                        l = strpcpyf(&p, l, "%u ", *d);
+
+                log_debug("Event source %s (type %s): %" PRIu64 " dispatches, %s total, %s max, %s max latency, durations: %s",
+                          strna(s->description),
+                          event_source_type_to_string(s->type),
+                          pr->n_dispatch,
+                          FORMAT_TIMESPAN(pr->total_usec, 1),
+                          FORMAT_TIMESPAN(pr->max_usec, 1),
+                          FORMAT_TIMESPAN(pr->max_latency_usec, 1),
+                          b);
+
+                zero(*pr);
+        }
 }
 
 _public_ int sd_event_run(sd_event *e, uint64_t timeout) {
@@ -4982,6 +5115,27 @@ _public_ int sd_event_get_tid(sd_event *e, pid_t *ret) {
         return 0;
 }
 
+_public_ int sd_event_set_batch_dispatch(sd_event *e, int b) {
+        assert_return(e, -EINVAL);
+        assert_return(e = event_resolve(e), -ENOPKG);
+        assert_return(e->state != SD_EVENT_FINISHED, -ESTALE);
+        assert_return(!event_origin_changed(e), -ECHILD);
+
+        if (e->batch_dispatch == !!b)
+                return 0;
+
+        e->batch_dispatch = b;
+        return 1;
+}
+
+_public_ int sd_event_get_batch_dispatch(sd_event *e) {
+        assert_return(e, -EINVAL);
+        assert_return(e = event_resolve(e), -ENOPKG);
+        assert_return(!event_origin_changed(e), -ECHILD);
+
+        return e->batch_dispatch;
+}
+
 _public_ int sd_event_set_watchdog(sd_event *e, int b) {
         int r;
 
@@ -724,6 +724,55 @@ TEST(simple_timeout) {
         assert_se(t >= usec_add(f, some_time));
 }
 
+static int time_many_handler(sd_event_source *s, uint64_t usec, void *userdata) {
+        unsigned *n = ASSERT_PTR(userdata);
+
+        (*n)++;
+        return 0;
+}
+
+TEST(time_many) {
+        _cleanup_(sd_event_unrefp) sd_event *e = NULL;
+        sd_event_source *sources[1000];
+        unsigned n = 0;
+        usec_t base;
+
+        assert_se(sd_event_new(&e) >= 0);
+
+        base = now(CLOCK_MONOTONIC);
+
+        FOREACH_ELEMENT(s, sources) {
+                usec_t t = usec_add(base, random_u64_range(100 * USEC_PER_MSEC));
+
+                assert_se(sd_event_add_time(e, s, CLOCK_MONOTONIC, t, 1, time_many_handler, &n) >= 0);
+
+                /* Setting the same time and accuracy again must not change anything */
+                assert_se(sd_event_source_set_time(*s, t) >= 0);
+                assert_se(sd_event_source_set_time_accuracy(*s, 1) >= 0);
+        }
+
+        /* Move every second source a bit into the future */
+        for (size_t i = 0; i < ELEMENTSOF(sources); i += 2) {
+                usec_t t;
+
+                assert_se(sd_event_source_get_time(sources[i], &t) >= 0);
+                assert_se(sd_event_source_set_time(sources[i], usec_add(t, 10 * USEC_PER_MSEC)) >= 0);
+        }
+
+        while (n < ELEMENTSOF(sources))
+                assert_se(sd_event_run(e, UINT64_MAX) >= 0);
+
+        assert_se(n == ELEMENTSOF(sources));
+
+        FOREACH_ELEMENT(s, sources) {
+                int enabled;
+
+                assert_se(sd_event_source_get_enabled(*s, &enabled) >= 0);
+                assert_se(enabled == SD_EVENT_OFF);
+                sd_event_source_unref(*s);
+        }
+}
+
 static int inotify_self_destroy_handler(sd_event_source *s, const struct inotify_event *ev, void *userdata) {
         sd_event_source **p = userdata;
 
@@ -847,6 +896,57 @@ TEST(sd_event_source_set_io_fd) {
         TAKE_FD(pfd_b[0]);
 }
 
+static int batch_dispatch_handler(sd_event_source *s, int fd, uint32_t revents, void *userdata) {
+        unsigned *c = ASSERT_PTR(userdata);
+        char x;
+
+        assert_se(read(fd, &x, 1) == 1);
+
+        (*c)++;
+        return 0;
+}
+
+TEST(batch_dispatch) {
+        _cleanup_(sd_event_unrefp) sd_event *e = NULL;
+        sd_event_source *s[3] = {}, *low = NULL;
+        int pfd[4][2];
+        unsigned c = 0, c_low = 0;
+
+        assert_se(sd_event_new(&e) >= 0);
+        assert_se(sd_event_get_batch_dispatch(e) == 0);
+        assert_se(sd_event_set_batch_dispatch(e, true) == 1);
+        assert_se(sd_event_set_batch_dispatch(e, true) == 0);
+        assert_se(sd_event_get_batch_dispatch(e) == 1);
+
+        for (size_t i = 0; i < ELEMENTSOF(pfd); i++) {
+                assert_se(pipe2(pfd[i], O_CLOEXEC|O_NONBLOCK) >= 0);
+                assert_se(write(pfd[i][1], "x", 1) == 1);
+        }
+
+        for (size_t i = 0; i < ELEMENTSOF(s); i++)
+                assert_se(sd_event_add_io(e, &s[i], pfd[i][0], EPOLLIN, batch_dispatch_handler, &c) >= 0);
+
+        /* A source with a lower priority is not part of the batch */
+        assert_se(sd_event_add_io(e, &low, pfd[3][0], EPOLLIN, batch_dispatch_handler, &c_low) >= 0);
+        assert_se(sd_event_source_set_priority(low, SD_EVENT_PRIORITY_IDLE) >= 0);
+
+        /* All three sources of the same priority are dispatched in a single iteration */
+        assert_se(sd_event_run(e, 0) > 0);
+        assert_se(c == 3);
+        assert_se(c_low == 0);
+
+        assert_se(sd_event_run(e, 0) > 0);
+        assert_se(c == 3);
+        assert_se(c_low == 1);
+
+        FOREACH_ELEMENT(i, s)
+                sd_event_source_unref(*i);
+        sd_event_source_unref(low);
+
+        FOREACH_ELEMENT(i, pfd)
+                safe_close_pair(*i);
+}
+
 static int hup_callback(sd_event_source *s, int fd, uint32_t revents, void *userdata) {
         unsigned *c = userdata;
 
@@ -918,4 +1018,31 @@ TEST(leave_ratelimit) {
         assert_se(manually_left_ratelimit);
 }
 
+static int profile_self_unref_handler(sd_event_source *s, void *userdata) {
+        sd_event_source **p = ASSERT_PTR(userdata);
+        sd_event *e = sd_event_source_get_event(s);
+
+        assert_se(*p == s);
+
+        /* Disable and drop the last reference to the source from its own handler, which disconnects it
+         * from the event loop before the dispatch profile is recorded */
+        assert_se(sd_event_source_set_enabled(s, SD_EVENT_OFF) >= 0);
+        *p = sd_event_source_unref(*p);
+
+        return sd_event_exit(e, 0);
+}
+
+TEST(profile_delays_self_unref) {
+        _cleanup_(sd_event_unrefp) sd_event *e = NULL;
+        sd_event_source *s = NULL;
+
+        assert_se(setenv("SD_EVENT_PROFILE_DELAYS", "1", /* overwrite= */ true) >= 0);
+        assert_se(sd_event_new(&e) >= 0);
+        assert_se(unsetenv("SD_EVENT_PROFILE_DELAYS") >= 0);
+
+        assert_se(sd_event_add_defer(e, &s, profile_self_unref_handler, &s) >= 0);
+        assert_se(sd_event_loop(e) >= 0);
+        assert_se(!s);
+}
+
 DEFINE_TEST_MAIN(LOG_DEBUG);
@@ -89,22 +89,31 @@ static const char *trie_string(sd_hwdb *hwdb, le64_t off) {
         return hwdb->map + le64toh(off);
 }
 
-static int trie_children_cmp_f(const void *v1, const void *v2) {
-        const struct trie_child_entry_f *n1 = v1;
-        const struct trie_child_entry_f *n2 = v2;
+static const struct trie_node_f *node_lookup_f(sd_hwdb *hwdb, const struct trie_node_f *node, uint8_t c) {
+        size_t lo = 0, hi = node->children_count;
 
-        return n1->c - n2->c;
-}
+        /* Children are sorted by their character. This is called for each character of the search string,
+         * and additionally three times per node for the glob characters, which most nodes do not have as a
+         * child, hence do the binary search inline rather than via bsearch() with a comparison callback,
+         * and check the bounds first, so that glob lookups usually terminate right away. */
+
+        if (hi == 0 ||
+            c < trie_node_child(hwdb, node, 0)->c ||
+            c > trie_node_child(hwdb, node, hi - 1)->c)
+                return NULL;
+
+        while (lo < hi) {
+                size_t mid = lo + (hi - lo) / 2;
+                const struct trie_child_entry_f *child = trie_node_child(hwdb, node, mid);
+
+                if (child->c == c)
+                        return trie_node_from_off(hwdb, child->child_off);
+                if (child->c < c)
+                        lo = mid + 1;
+                else
+                        hi = mid;
+        }
 
-static const struct trie_node_f *node_lookup_f(sd_hwdb *hwdb, const struct trie_node_f *node, uint8_t c) {
-        struct trie_child_entry_f *child;
-        struct trie_child_entry_f search;
-
-        search.c = c;
-        child = bsearch(&search, (const char *)node + le64toh(hwdb->head->node_size), node->children_count,
-                        le64toh(hwdb->head->child_entry_size), trie_children_cmp_f);
-        if (child)
-                return trie_node_from_off(hwdb, child->child_off);
         return NULL;
 }
 
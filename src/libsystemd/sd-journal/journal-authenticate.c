@@ -269,37 +269,41 @@ int journal_file_hmac_put_object(JournalFile *f, ObjectType type, Object *o, uin
         } else if (type > OBJECT_UNUSED && o->object.type != type)
                 return -EBADMSG;
 
-        sym_gcry_md_write(f->hmac, o, offsetof(ObjectHeader, payload));
+        /* The immutable parts of each object directly follow the object header, hence feed them to the HMAC
+         * together with the header in a single call where possible. The HMAC is computed over the
+         * concatenation anyway, and this saves a good number of calls per appended entry. */
 
         switch (o->object.type) {
 
         case OBJECT_DATA:
                 /* All but hash and payload are mutable */
-                sym_gcry_md_write(f->hmac, &o->data.hash, sizeof(o->data.hash));
+                sym_gcry_md_write(f->hmac, o, offsetof(Object, data.hash) + sizeof(o->data.hash));
                 sym_gcry_md_write(f->hmac, journal_file_data_payload_field(f, o), le64toh(o->object.size) - journal_file_data_payload_offset(f));
                 break;
 
         case OBJECT_FIELD:
                 /* Same here */
-                sym_gcry_md_write(f->hmac, &o->field.hash, sizeof(o->field.hash));
+                sym_gcry_md_write(f->hmac, o, offsetof(Object, field.hash) + sizeof(o->field.hash));
                 sym_gcry_md_write(f->hmac, o->field.payload, le64toh(o->object.size) - offsetof(Object, field.payload));
                 break;
 
         case OBJECT_ENTRY:
                 /* All */
-                sym_gcry_md_write(f->hmac, &o->entry.seqnum, le64toh(o->object.size) - offsetof(Object, entry.seqnum));
+                assert_cc(offsetof(Object, entry.seqnum) == offsetof(ObjectHeader, payload));
+                sym_gcry_md_write(f->hmac, o, le64toh(o->object.size));
                 break;
 
         case OBJECT_FIELD_HASH_TABLE:
         case OBJECT_DATA_HASH_TABLE:
         case OBJECT_ENTRY_ARRAY:
                 /* Nothing: everything is mutable */
+                sym_gcry_md_write(f->hmac, o, offsetof(ObjectHeader, payload));
                 break;
 
         case OBJECT_TAG:
                 /* All but the tag itself */
-                sym_gcry_md_write(f->hmac, &o->tag.seqnum, sizeof(o->tag.seqnum));
-                sym_gcry_md_write(f->hmac, &o->tag.epoch, sizeof(o->tag.epoch));
+                assert_cc(offsetof(Object, tag.epoch) == offsetof(Object, tag.seqnum) + sizeof(o->tag.seqnum));
+                sym_gcry_md_write(f->hmac, o, offsetof(Object, tag.epoch) + sizeof(o->tag.epoch));
                 break;
         default:
                 return -EINVAL;
@@ -81,6 +81,8 @@ struct ObjectHeader {
 struct DataObject DataObject__contents;
 struct DataObject__packed DataObject__contents _packed_;
 assert_cc(sizeof(struct DataObject) == sizeof(struct DataObject__packed));
+/* journal_file_hmac_put_object() hashes the object header and the fields directly following it in one go */
+assert_cc(offsetof(struct DataObject, hash) == offsetof(struct ObjectHeader, payload));
 
 #define FieldObject__contents {                 \
         ObjectHeader object;                    \
@@ -93,6 +95,7 @@ assert_cc(sizeof(struct DataObject) == sizeof(struct DataObject__packed));
 struct FieldObject FieldObject__contents;
 struct FieldObject__packed FieldObject__contents _packed_;
 assert_cc(sizeof(struct FieldObject) == sizeof(struct FieldObject__packed));
+assert_cc(offsetof(struct FieldObject, hash) == offsetof(struct ObjectHeader, payload));
 
 #define EntryObject__contents {                        \
         ObjectHeader object;                           \
@@ -150,6 +153,8 @@ struct TagObject {
         uint8_t tag[TAG_LENGTH]; /* SHA-256 HMAC */
 } _packed_;
 
+assert_cc(offsetof(struct TagObject, seqnum) == offsetof(struct ObjectHeader, payload));
+
 union Object {
         ObjectHeader object;
         DataObject data;
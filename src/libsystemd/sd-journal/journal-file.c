@@ -22,6 +22,7 @@
 #include "fs-util.h"
 #include "gcrypt-util.h"
 #include "id128-util.h"
+#include "iovec-util.h"
 #include "journal-authenticate.h"
 #include "journal-def.h"
 #include "journal-file.h"
@@ -33,6 +34,7 @@
 #include "prioq.h"
 #include "random-util.h"
 #include "set.h"
+#include "siphash24.h"
 #include "sort-util.h"
 #include "stat-util.h"
 #include "string-table.h"
@@ -2499,14 +2501,115 @@ static size_t remove_duplicate_entry_items(EntryItem items[], size_t n) {
         return j;
 }
 
-int journal_file_append_entry(
+typedef struct DataCacheItem {
+        struct iovec iovec;
+        EntryItem item;
+        uint64_t xor_hash;
+} DataCacheItem;
+
+static void data_cache_item_hash_func(const DataCacheItem *i, struct siphash *state) {
+        assert(i);
+        assert(state);
+
+        siphash24_compress_safe(i->iovec.iov_base, i->iovec.iov_len, state);
+}
+
+static int data_cache_item_compare_func(const DataCacheItem *a, const DataCacheItem *b) {
+        return iovec_memcmp(&ASSERT_PTR(a)->iovec, &ASSERT_PTR(b)->iovec);
+}
+
+DEFINE_PRIVATE_HASH_OPS_WITH_KEY_DESTRUCTOR(
+                data_cache_item_hash_ops,
+                DataCacheItem,
+                data_cache_item_hash_func,
+                data_cache_item_compare_func,
+                free);
+
+static int journal_file_append_entry_data(
+                JournalFile *f,
+                const struct iovec *iovec,
+                Set **data_cache,
+                EntryItem *ret_item,
+                uint64_t *ret_xor_hash) {
+
+        _cleanup_free_ DataCacheItem *c = NULL;
+        uint64_t p, xor_hash;
+        Object *o;
+        int r;
+
+        assert(f);
+        assert(iovec);
+        assert(ret_item);
+        assert(ret_xor_hash);
+
+        /* When appending a batch of entries, most of them will share a good chunk of their fields (_HOSTNAME=,
+         * _BOOT_ID=, _TRANSPORT=, …). Remember the DATA objects we already resolved within the batch, so that
+         * we don't have to hash the payload and walk the on-disk hash chain again for each entry. */
+        if (data_cache) {
+                DataCacheItem *found;
+
+                found = set_get(*data_cache, &(const DataCacheItem) { .iovec = *iovec });
+                if (found) {
+                        *ret_item = found->item;
+                        *ret_xor_hash = found->xor_hash;
+                        return 0;
+                }
+        }
+
+        r = journal_file_append_data(f, iovec->iov_base, iovec->iov_len, &o, &p);
+        if (r < 0)
+                return r;
+
+        /* When calculating the XOR hash field, we need to take special care if the "keyed-hash"
+         * journal file flag is on. We use the XOR hash field to quickly determine the identity of a
+         * specific record, and give records with otherwise identical position (i.e. match in seqno,
+         * timestamp, …) a stable ordering. But for that we can't have it that the hash of the
+         * objects in each file is different since they are keyed. Hence let's calculate the Jenkins
+         * hash here for that. This also has the benefit that cursors for old and new journal files
+         * are completely identical (they include the XOR hash after all). For classic Jenkins-hash
+         * files things are easier, we can just take the value from the stored record directly. */
+
+        if (JOURNAL_HEADER_KEYED_HASH(f->header))
+                xor_hash = jenkins_hash64(iovec->iov_base, iovec->iov_len);
+        else
+                xor_hash = le64toh(o->data.hash);
+
+        *ret_item = (EntryItem) {
+                .object_offset = p,
+                .hash = le64toh(o->data.hash),
+        };
+        *ret_xor_hash = xor_hash;
+
+        if (!data_cache)
+                return 0;
+
+        /* The cache is only an optimization, hence don't fail if we can't add to it. */
+        c = new(DataCacheItem, 1);
+        if (!c)
+                return 0;
+
+        *c = (DataCacheItem) {
+                .iovec = *iovec,
+                .item = *ret_item,
+                .xor_hash = xor_hash,
+        };
+
+        if (set_ensure_consume(data_cache, &data_cache_item_hash_ops, TAKE_PTR(c)) < 0)
+                log_debug("Failed to cache DATA object, ignoring.");
+
+        return 0;
+}
+
+static int journal_file_append_entry_one(
                 JournalFile *f,
                 const dual_timestamp *ts,
                 const sd_id128_t *boot_id,
+                const sd_id128_t *machine_id,
                 const struct iovec iovec[],
                 size_t n_iovec,
                 uint64_t *seqnum,
                 sd_id128_t *seqnum_id,
+                Set **data_cache,
                 Object **ret_object,
                 uint64_t *ret_offset) {
 
@@ -2514,7 +2617,7 @@ int journal_file_append_entry(
         EntryItem *items;
         uint64_t xor_hash = 0;
         struct dual_timestamp _ts;
-        sd_id128_t _boot_id, _machine_id, *machine_id;
+        sd_id128_t _boot_id;
         int r;
 
         assert(f);
@@ -2547,15 +2650,6 @@ int journal_file_append_entry(
                 boot_id = &_boot_id;
         }
 
-        r = sd_id128_get_machine(&_machine_id);
-        if (ERRNO_IS_NEG_MACHINE_ID_UNSET(r))
-                /* Gracefully handle the machine ID not being initialized yet */
-                machine_id = NULL;
-        else if (r < 0)
-                return r;
-        else
-                machine_id = &_machine_id;
-
 #if HAVE_GCRYPT
         r = journal_file_maybe_append_tag(f, ts->realtime);
         if (r < 0)
@@ -2573,31 +2667,13 @@ int journal_file_append_entry(
         }
 
         for (size_t i = 0; i < n_iovec; i++) {
-                uint64_t p;
-                Object *o;
+                uint64_t h;
 
-                r = journal_file_append_data(f, iovec[i].iov_base, iovec[i].iov_len, &o, &p);
+                r = journal_file_append_entry_data(f, &iovec[i], data_cache, &items[i], &h);
                 if (r < 0)
                         return r;
 
-                /* When calculating the XOR hash field, we need to take special care if the "keyed-hash"
-                 * journal file flag is on. We use the XOR hash field to quickly determine the identity of a
-                 * specific record, and give records with otherwise identical position (i.e. match in seqno,
-                 * timestamp, …) a stable ordering. But for that we can't have it that the hash of the
-                 * objects in each file is different since they are keyed. Hence let's calculate the Jenkins
-                 * hash here for that. This also has the benefit that cursors for old and new journal files
-                 * are completely identical (they include the XOR hash after all). For classic Jenkins-hash
-                 * files things are easier, we can just take the value from the stored record directly. */
-
-                if (JOURNAL_HEADER_KEYED_HASH(f->header))
-                        xor_hash ^= jenkins_hash64(iovec[i].iov_base, iovec[i].iov_len);
-                else
-                        xor_hash ^= le64toh(o->data.hash);
-
-                items[i] = (EntryItem) {
-                        .object_offset = p,
-                        .hash = le64toh(o->data.hash),
-                };
+                xor_hash ^= h;
         }
 
         /* Order by the position on disk, in order to improve seek
@@ -2605,7 +2681,7 @@ int journal_file_append_entry(
         typesafe_qsort(items, n_iovec, entry_item_cmp);
         n_iovec = remove_duplicate_entry_items(items, n_iovec);
 
-        r = journal_file_append_entry_internal(
+        return journal_file_append_entry_internal(
                         f,
                         ts,
                         boot_id,
@@ -2617,6 +2693,25 @@ int journal_file_append_entry(
                         seqnum_id,
                         ret_object,
                         ret_offset);
+}
+
+static int journal_file_get_machine_id(sd_id128_t *ret) {
+        int r;
+
+        assert(ret);
+
+        r = sd_id128_get_machine(ret);
+        if (ERRNO_IS_NEG_MACHINE_ID_UNSET(r))
+                /* Gracefully handle the machine ID not being initialized yet */
+                return 0;
+        if (r < 0)
+                return r;
+
+        return 1;
+}
+
+static int journal_file_append_finish(JournalFile *f, int r) {
+        assert(f);
 
         /* If the memory mapping triggered a SIGBUS then we return an
          * IO error and ignore the error code passed down to us, since
@@ -2634,6 +2729,120 @@ int journal_file_append_entry(
         return r;
 }
 
+int journal_file_append_entry(
+                JournalFile *f,
+                const dual_timestamp *ts,
+                const sd_id128_t *boot_id,
+                const struct iovec iovec[],
+                size_t n_iovec,
+                uint64_t *seqnum,
+                sd_id128_t *seqnum_id,
+                Object **ret_object,
+                uint64_t *ret_offset) {
+
+        sd_id128_t machine_id;
+        int r;
+
+        assert(f);
+        assert(f->header);
+        assert(iovec);
+        assert(n_iovec > 0);
+
+        r = journal_file_get_machine_id(&machine_id);
+        if (r < 0)
+                return r;
+
+        r = journal_file_append_entry_one(
+                        f,
+                        ts,
+                        boot_id,
+                        r > 0 ? &machine_id : NULL,
+                        iovec,
+                        n_iovec,
+                        seqnum,
+                        seqnum_id,
+                        /* data_cache= */ NULL,
+                        ret_object,
+                        ret_offset);
+
+        return journal_file_append_finish(f, r);
+}
+
+int journal_file_append_entries(
+                JournalFile *f,
+                const JournalEntryBatchItem entries[],
+                size_t n_entries,
+                uint64_t *seqnum,
+                sd_id128_t *seqnum_id,
+                size_t *ret_n_appended) {
+
+        _cleanup_set_free_ Set *data_cache = NULL;
+        sd_id128_t machine_id, boot_id;
+        bool have_machine_id, have_boot_id = false;
+        size_t n = 0;
+        int r;
+
+        assert(f);
+        assert(f->header);
+        assert(entries || n_entries == 0);
+
+        /* Appends a number of entries in one go. This is equivalent to calling journal_file_append_entry()
+         * for each entry, but the machine ID and boot ID are only acquired once, DATA objects shared between
+         * the entries are only looked up once, and the change notification is only triggered once for the
+         * whole batch. On failure, processing stops at the first entry that could not be appended, and the
+         * number of entries that were successfully written is returned in ret_n_appended, so that the caller
+         * can e.g. rotate the file and retry with the remaining entries. */
+
+        if (ret_n_appended)
+                *ret_n_appended = 0;
+
+        if (n_entries == 0)
+                return 0;
+
+        r = journal_file_get_machine_id(&machine_id);
+        if (r < 0)
+                return r;
+        have_machine_id = r > 0;
+
+        FOREACH_ARRAY(e, entries, n_entries) {
+                const sd_id128_t *b = e->boot_id;
+
+                if (!b) {
+                        if (!have_boot_id) {
+                                r = sd_id128_get_boot(&boot_id);
+                                if (r < 0)
+                                        break;
+
+                                have_boot_id = true;
+                        }
+
+                        b = &boot_id;
+                }
+
+                r = journal_file_append_entry_one(
+                                f,
+                                e->ts,
+                                b,
+                                have_machine_id ? &machine_id : NULL,
+                                e->iovec,
+                                e->n_iovec,
+                                seqnum,
+                                seqnum_id,
+                                &data_cache,
+                                /* ret_object= */ NULL,
+                                /* ret_offset= */ NULL);
+                if (r < 0)
+                        break;
+
+                n++;
+        }
+
+        if (ret_n_appended)
+                *ret_n_appended = n;
+
+        return journal_file_append_finish(f, r);
+}
+
 typedef struct ChainCacheItem {
         uint64_t first; /* The offset of the entry array object at the beginning of the chain,
                          * i.e., le64toh(f->header->entry_array_offset), or le64toh(o->data.entry_offset). */
@@ -3090,6 +3299,39 @@ static int generic_array_bisect(
                                         goto previous;
                         }
 
+                        /* If the needle is still not next to the last index, gallop away from it with
+                         * exponentially growing steps, before falling back to the plain bisection below. Lookups
+                         * are often close to each other (e.g. when following a match), and this way we only touch
+                         * O(log(distance)) entries instead of O(log(size of the array)). */
+                        if (last_index < UINT64_MAX)
+                                for (uint64_t step = 2; left < right; step *= 2) {
+                                        uint64_t probe;
+
+                                        if (left > last_index) {
+                                                /* The needle is right of the last index. */
+                                                if (step >= right - last_index)
+                                                        break;
+                                                probe = last_index + step;
+                                        } else if (right < last_index) {
+                                                /* The needle is left of the last index. */
+                                                if (step >= last_index - left)
+                                                        break;
+                                                probe = last_index - step;
+                                        } else
+                                                break;
+
+                                        if (probe < left || probe > right)
+                                                break;
+
+                                        r = generic_array_bisect_step(f, array, probe, needle, test_object, direction, &m, &left, &right);
+                                        if (r < 0)
+                                                return r;
+                                        if (r == TEST_GOTO_PREVIOUS)
+                                                goto previous;
+                                        if (r == TEST_GOTO_NEXT)
+                                                return 0; /* Found a corrupt entry, and the array was cut short. */
+                                }
+
                         for (;;) {
                                 if (left == right) {
                                         /* We found one or more corrupted entries in generic_array_bisect_step().
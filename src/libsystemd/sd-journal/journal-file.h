@@ -281,6 +281,21 @@ int journal_file_append_entry(
                 Object **ret_object,
                 uint64_t *ret_offset);
 
+typedef struct JournalEntryBatchItem {
+        const dual_timestamp *ts;       /* NULL: use the current time */
+        const sd_id128_t *boot_id;      /* NULL: use the current boot ID */
+        const struct iovec *iovec;
+        size_t n_iovec;
+} JournalEntryBatchItem;
+
+int journal_file_append_entries(
+                JournalFile *f,
+                const JournalEntryBatchItem entries[],
+                size_t n_entries,
+                uint64_t *seqnum,
+                sd_id128_t *seqnum_id,
+                size_t *ret_n_appended);
+
 int journal_file_find_data_object(JournalFile *f, const void *data, uint64_t size, Object **ret_object, uint64_t *ret_offset);
 int journal_file_find_data_object_with_hash(JournalFile *f, const void *data, uint64_t size, uint64_t hash, Object **ret_object, uint64_t *ret_offset);
 
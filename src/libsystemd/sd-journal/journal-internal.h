@@ -37,6 +37,7 @@ struct Match {
         char *data;
         size_t size;
         uint64_t hash; /* old-style jenkins hash. New-style siphash is different per file, hence won't be cached here */
+        Hashmap *data_by_file; /* JournalFile* → MatchFileData, memorizes the DATA object lookup per file */
 
         /* For terms */
         LIST_HEAD(Match, matches);
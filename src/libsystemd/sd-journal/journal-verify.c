@@ -532,9 +532,10 @@ static int verify_data_hash_table(
                 MMapFileDescriptor *cache_entry_fd, uint64_t n_entries,
                 MMapFileDescriptor *cache_entry_array_fd, uint64_t n_entry_arrays,
                 usec_t *last_usec,
-                bool show_progress) {
+                bool show_progress,
+                uint64_t *ret_n_hashed) {
 
-        uint64_t i, n;
+        uint64_t i, n, n_hashed = 0;
         int r;
 
         assert(f);
@@ -542,10 +543,13 @@ static int verify_data_hash_table(
         assert(cache_entry_fd);
         assert(cache_entry_array_fd);
         assert(last_usec);
+        assert(ret_n_hashed);
 
         n = le64toh(f->header->data_hash_table_size) / sizeof(HashItem);
-        if (n <= 0)
+        if (n <= 0) {
+                *ret_n_hashed = 0;
                 return 0;
+        }
 
         r = journal_file_map_data_hash_table(f);
         if (r < 0)
@@ -555,7 +559,7 @@ static int verify_data_hash_table(
                 uint64_t last = 0, p;
 
                 if (show_progress)
-                        draw_progress(0xC000 + scale_progress(0x3FFF, i, n), last_usec);
+                        draw_progress(0x8000 + scale_progress(0x3FFF, i, n), last_usec);
 
                 p = le64toh(f->data_hash_table[i].head_hash_offset);
                 while (p != 0) {
@@ -586,6 +590,7 @@ static int verify_data_hash_table(
                         if (r < 0)
                                 return r;
 
+                        n_hashed++;
                         last = p;
                         p = next;
                 }
@@ -599,6 +604,10 @@ static int verify_data_hash_table(
                 }
         }
 
+        /* Objects within a chain are strictly ordered and each object's hash determines its chain, hence no
+         * object was counted twice. If we have seen as many objects as there are data objects, then every
+         * data object is linked into the hash table. */
+        *ret_n_hashed = n_hashed;
         return 0;
 }
 
@@ -638,6 +647,7 @@ static int verify_entry(
                 JournalFile *f,
                 Object *o, uint64_t p,
                 MMapFileDescriptor *cache_data_fd, uint64_t n_data,
+                bool all_data_hashed,
                 bool last) {
 
         uint64_t i, n;
@@ -663,18 +673,23 @@ static int verify_entry(
                 if (r < 0)
                         return r;
 
-                r = data_object_in_hash_table(f, le64toh(u->data.hash), q);
-                if (r < 0)
-                        return r;
-                if (r == 0) {
-                        error(p, "Data object missing from hash table");
-                        return -EBADMSG;
-                }
+                /* Walking the hash chain for each entry item is expensive, as popular data objects are
+                 * referenced by almost every entry. Skip it if the hash table check already showed that all
+                 * data objects are linked into the hash table. */
+                if (!all_data_hashed) {
+                        r = data_object_in_hash_table(f, le64toh(u->data.hash), q);
+                        if (r < 0)
+                                return r;
+                        if (r == 0) {
+                                error(p, "Data object missing from hash table");
+                                return -EBADMSG;
+                        }
 
-                /* Pointer might have moved, reposition */
-                r = journal_file_move_to_object(f, OBJECT_DATA, q, &u);
-                if (r < 0)
-                        return r;
+                        /* Pointer might have moved, reposition */
+                        r = journal_file_move_to_object(f, OBJECT_DATA, q, &u);
+                        if (r < 0)
+                                return r;
+                }
 
                 r = journal_file_move_to_entry_by_offset_for_data(f, u, p, DIRECTION_DOWN, NULL, NULL);
                 if (r < 0)
@@ -697,6 +712,7 @@ static int verify_entry_array(
                 MMapFileDescriptor *cache_data_fd, uint64_t n_data,
                 MMapFileDescriptor *cache_entry_fd, uint64_t n_entries,
                 MMapFileDescriptor *cache_entry_array_fd, uint64_t n_entry_arrays,
+                bool all_data_hashed,
                 usec_t *last_usec,
                 bool show_progress) {
 
@@ -716,7 +732,7 @@ static int verify_entry_array(
                 Object *o;
 
                 if (show_progress)
-                        draw_progress(0x8000 + scale_progress(0x3FFF, i, n), last_usec);
+                        draw_progress(0xC000 + scale_progress(0x3FFF, i, n), last_usec);
 
                 if (a == 0) {
                         error(a, "Array chain too short at %"PRIu64" of %"PRIu64, i, n);
@@ -758,7 +774,7 @@ static int verify_entry_array(
                         if (r < 0)
                                 return r;
 
-                        r = verify_entry(f, o, p, cache_data_fd, n_data, /*last=*/ i + 1 == n);
+                        r = verify_entry(f, o, p, cache_data_fd, n_data, all_data_hashed, /*last=*/ i + 1 == n);
                         if (r < 0)
                                 return r;
 
@@ -825,6 +841,7 @@ int journal_file_verify(
         sd_id128_t entry_boot_id = {};  /* Unnecessary initialization to appease gcc */
         bool entry_seqnum_set = false, entry_monotonic_set = false, entry_realtime_set = false, found_main_entry_array = false;
         uint64_t n_objects = 0, n_entries = 0, n_data = 0, n_fields = 0, n_data_hash_tables = 0, n_field_hash_tables = 0, n_entry_arrays = 0, n_tags = 0;
+        uint64_t n_hashed = 0;
         usec_t last_usec = 0;
         _cleanup_close_ int data_fd = -EBADF, entry_fd = -EBADF, entry_array_fd = -EBADF;
         _cleanup_fclose_ FILE *data_fp = NULL, *entry_fp = NULL, *entry_array_fp = NULL;
@@ -1377,26 +1394,29 @@ int journal_file_verify(
          * or indirectly) in the data hash table also exists in the
          * entry array, and vice versa. Note that we do not care for
          * unreferenced objects. We only care that everything that is
-         * referenced is consistent. */
+         * referenced is consistent. The data hash table is checked first, so that the entry checks can
+         * skip the hash table lookups if it turns out that all data objects are linked into it. */
+
+        r = verify_data_hash_table(f,
+                                   cache_data_fd, n_data,
+                                   cache_entry_fd, n_entries,
+                                   cache_entry_array_fd, n_entry_arrays,
+                                   &last_usec,
+                                   show_progress,
+                                   &n_hashed);
+        if (r < 0)
+                goto fail;
 
         r = verify_entry_array(f,
                                cache_data_fd, n_data,
                                cache_entry_fd, n_entries,
                                cache_entry_array_fd, n_entry_arrays,
+                               /* all_data_hashed= */ n_hashed == n_data,
                                &last_usec,
                                show_progress);
         if (r < 0)
                 goto fail;
 
-        r = verify_data_hash_table(f,
-                                   cache_data_fd, n_data,
-                                   cache_entry_fd, n_entries,
-                                   cache_entry_array_fd, n_entry_arrays,
-                                   &last_usec,
-                                   show_progress);
-        if (r < 0)
-                goto fail;
-
         if (show_progress)
                 flush_progress();
 
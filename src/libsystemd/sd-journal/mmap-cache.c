@@ -53,6 +53,15 @@ struct MMapFileDescriptor {
         LIST_HEAD(Window, windows);
 };
 
+typedef struct CategoryAccess {
+        /* The file and range of the window created by the last miss of the category, used to detect
+         * streaming access patterns. The fd pointer is only compared, never dereferenced. */
+        MMapFileDescriptor *fd;
+        uint64_t offset;
+        size_t size;
+        unsigned n_sequential;
+} CategoryAccess;
+
 struct MMapCache {
         unsigned n_ref;
         unsigned n_windows;
@@ -60,6 +69,7 @@ struct MMapCache {
         unsigned n_category_cache_hit;
         unsigned n_window_list_hit;
         unsigned n_missed;
+        unsigned n_sequential_missed;
 
         Hashmap *fds;
 
@@ -68,6 +78,7 @@ struct MMapCache {
         unsigned n_unused;
 
         Window *windows_by_category[_MMAP_CACHE_CATEGORY_MAX];
+        CategoryAccess access_by_category[_MMAP_CACHE_CATEGORY_MAX];
 };
 
 #define WINDOWS_MIN 64
@@ -80,6 +91,12 @@ struct MMapCache {
 # define WINDOW_SIZE ((size_t) (UINT64_C(8) * UINT64_C(1024) * UINT64_C(1024)))
 #endif
 
+/* When a category keeps missing right next to its previous window (e.g. when exporting or uploading the whole
+ * journal, or when journald appends), the window size is doubled on each consecutive miss, up to this
+ * limit, so that streaming readers don't spend their time in mmap()/munmap(). Random probes (bisection)
+ * keep using WINDOW_SIZE. */
+#define WINDOW_SIZE_MAX (WINDOW_SIZE * 8)
+
 MMapCache* mmap_cache_new(void) {
         MMapCache *m;
 
@@ -278,18 +295,42 @@ static int mmap_try_harder(MMapFileDescriptor *f, void *addr, int flags, uint64_
         }
 }
 
+static int category_access_direction(CategoryAccess *a, MMapFileDescriptor *f, uint64_t offset, size_t size) {
+        assert(a);
+        assert(f);
+
+        /* Returns > 0 if the requested range directly follows the window the category mapped last, < 0 if it
+         * directly precedes it, and 0 if the access looks random. */
+
+        if (a->fd != f || a->size == 0)
+                return 0;
+
+        if (offset >= a->offset + a->size && offset - (a->offset + a->size) < a->size)
+                return 1;
+
+        if (offset + size <= a->offset && a->offset - (offset + size) < a->size)
+                return -1;
+
+        return 0;
+}
+
 static int add_mmap(
                 MMapFileDescriptor *f,
+                MMapCacheCategory c,
                 uint64_t offset,
                 size_t size,
                 struct stat *st,
                 Window **ret) {
 
+        MMapCache *m = mmap_cache_fd_cache(f);
+        CategoryAccess *a;
+        size_t window_size;
         Window *w;
         void *d;
-        int r;
+        int r, dir;
 
         assert(f);
+        assert(c >= 0 && c < _MMAP_CACHE_CATEGORY_MAX);
         assert(size > 0);
         assert(ret);
 
@@ -300,12 +341,32 @@ static int add_mmap(
         size = PAGE_ALIGN(size + PAGE_OFFSET_U64(offset));
         offset = PAGE_ALIGN_DOWN_U64(offset);
 
-        if (size < WINDOW_SIZE) {
+        a = m->access_by_category + c;
+        dir = category_access_direction(a, f, offset, size);
+        if (dir != 0) {
+                a->n_sequential++;
+                m->n_sequential_missed++;
+        } else
+                a->n_sequential = 0;
+
+        window_size = WINDOW_SIZE;
+        for (unsigned i = 0; i < a->n_sequential && window_size < WINDOW_SIZE_MAX; i++)
+                window_size *= 2;
+
+        if (size < window_size) {
                 uint64_t delta;
 
-                delta = PAGE_ALIGN((WINDOW_SIZE - size) / 2);
+                if (dir > 0)
+                        /* Streaming forward, map ahead of the cursor. */
+                        delta = 0;
+                else if (dir < 0)
+                        /* Streaming backward (e.g. 'journalctl -r'), map behind the cursor. */
+                        delta = window_size - size;
+                else
+                        delta = PAGE_ALIGN((window_size - size) / 2);
+
                 offset = LESS_BY(offset, delta);
-                size = WINDOW_SIZE;
+                size = window_size;
         }
 
         if (st) {
@@ -326,12 +387,24 @@ static int add_mmap(
         if (r < 0)
                 return r;
 
+        /* For readers streaming through a file, tell the kernel to read ahead aggressively. We don't bother
+         * for writable maps: journald appends to freshly allocated space anyway. */
+        if (dir != 0 && f->prot == PROT_READ)
+                (void) madvise(d, size, MADV_SEQUENTIAL);
+
         w = window_add(f, offset, size, d);
         if (!w) {
                 (void) munmap(d, size);
                 return -ENOMEM;
         }
 
+        *a = (CategoryAccess) {
+                .fd = f,
+                .offset = offset,
+                .size = size,
+                .n_sequential = a->n_sequential,
+        };
+
         *ret = w;
         return 0;
 }
@@ -377,7 +450,7 @@ int mmap_cache_fd_get(
         m->n_missed++;
 
         /* Create a new mmap */
-        r = add_mmap(f, offset, size, st, &w);
+        r = add_mmap(f, c, offset, size, st, &w);
         if (r < 0)
                 return r;
 
@@ -436,8 +509,9 @@ found:
 void mmap_cache_stats_log_debug(MMapCache *m) {
         assert(m);
 
-        log_debug("mmap cache statistics: %u category cache hit, %u window list hit, %u miss, %u files, %u windows, %u unused",
-                  m->n_category_cache_hit, m->n_window_list_hit, m->n_missed, hashmap_size(m->fds), m->n_windows, m->n_unused);
+        log_debug("mmap cache statistics: %u category cache hit, %u window list hit, %u miss (%u sequential), %u files, %u windows, %u unused",
+                  m->n_category_cache_hit, m->n_window_list_hit, m->n_missed, m->n_sequential_missed,
+                  hashmap_size(m->fds), m->n_windows, m->n_unused);
 }
 
 static void mmap_cache_process_sigbus(MMapCache *m) {
@@ -554,6 +628,10 @@ MMapFileDescriptor* mmap_cache_fd_free(MMapFileDescriptor *f) {
         while (f->windows)
                 window_free(f->windows);
 
+        FOREACH_ELEMENT(a, f->cache->access_by_category)
+                if (a->fd == f)
+                        *a = (CategoryAccess) {};
+
         assert_se(hashmap_remove(f->cache->fds, FD_TO_PTR(f->fd)) == f);
 
         /* Unref the cache at the end. Otherwise, the assertions in mmap_cache_free() may be triggered. */
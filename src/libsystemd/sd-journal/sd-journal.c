@@ -211,10 +211,26 @@ static Match *match_free(Match *m) {
         if (m->parent)
                 LIST_REMOVE(matches, m->parent->matches, m);
 
+        hashmap_free(m->data_by_file);
         free(m->data);
         return mfree(m);
 }
 
+static void match_forget_file(Match *m, JournalFile *f) {
+        assert(f);
+
+        if (!m)
+                return;
+
+        if (m->type == MATCH_DISCRETE) {
+                free(hashmap_remove(m->data_by_file, f));
+                return;
+        }
+
+        LIST_FOREACH(matches, i, m->matches)
+                match_forget_file(i, f);
+}
+
 static Match *match_free_if_empty(Match *m) {
         if (!m || m->matches)
                 return m;
@@ -665,6 +681,95 @@ static int compare_with_location(
         return 0;
 }
 
+typedef struct MatchFileData {
+        uint64_t offset;   /* 0 if the file has no matching DATA object */
+        uint64_t n_data;   /* number of DATA objects in the file when the lookup was done */
+} MatchFileData;
+
+static int match_find_data_object(
+                Match *m,
+                JournalFile *f,
+                Object **ret,
+                uint64_t *ret_offset) {
+
+        _cleanup_free_ MatchFileData *c = NULL;
+        MatchFileData *cached;
+        uint64_t hash, p, n_data;
+        Object *d;
+        int r;
+
+        assert(m);
+        assert(m->type == MATCH_DISCRETE);
+        assert(f);
+
+        /* Matches are looked up again for every step through the journal, and once per file. DATA objects
+         * are never moved or removed once written, hence a successful lookup stays valid for the lifetime of
+         * the file, and a failed lookup stays valid until new DATA objects are added. Memorize both, so that
+         * iterating through large numbers of (archived) files doesn't require rehashing and probing the
+         * data hash table of each file each time. */
+
+        n_data = JOURNAL_HEADER_CONTAINS(f->header, n_data) ? le64toh(f->header->n_data) : UINT64_MAX;
+
+        cached = hashmap_get(m->data_by_file, f);
+        if (cached) {
+                if (cached->offset > 0) {
+                        if (ret) {
+                                r = journal_file_move_to_object(f, OBJECT_DATA, cached->offset, ret);
+                                if (r < 0)
+                                        return r;
+                        }
+                        if (ret_offset)
+                                *ret_offset = cached->offset;
+                        return 1;
+                }
+
+                if (n_data != UINT64_MAX && cached->n_data == n_data)
+                        return 0;
+        }
+
+        /* If the keyed hash logic is used, we need to calculate the hash fresh per file. Otherwise
+         * we can use what we pre-calculated. */
+        if (JOURNAL_HEADER_KEYED_HASH(f->header))
+                hash = journal_file_hash_data(f, m->data, m->size);
+        else
+                hash = m->hash;
+
+        r = journal_file_find_data_object_with_hash(f, m->data, m->size, hash, &d, &p);
+        if (r < 0)
+                return r;
+        if (r == 0)
+                p = 0;
+
+        if (cached)
+                *cached = (MatchFileData) {
+                        .offset = p,
+                        .n_data = n_data,
+                };
+        else {
+                /* The cache is an optimization only, don't fail if we can't allocate it. */
+                c = new(MatchFileData, 1);
+                if (c) {
+                        *c = (MatchFileData) {
+                                .offset = p,
+                                .n_data = n_data,
+                        };
+
+                        if (hashmap_ensure_put(&m->data_by_file, &trivial_hash_ops_value_free, f, c) >= 0)
+                                TAKE_PTR(c);
+                }
+        }
+
+        if (r == 0)
+                return 0;
+
+        if (ret)
+                *ret = d;
+        if (ret_offset)
+                *ret_offset = p;
+
+        return 1;
+}
+
 static int next_for_match(
                 sd_journal *j,
                 Match *m,
@@ -683,16 +788,8 @@ static int next_for_match(
 
         if (m->type == MATCH_DISCRETE) {
                 Object *d;
-                uint64_t hash;
 
-                /* If the keyed hash logic is used, we need to calculate the hash fresh per file. Otherwise
-                 * we can use what we pre-calculated. */
-                if (JOURNAL_HEADER_KEYED_HASH(f->header))
-                        hash = journal_file_hash_data(f, m->data, m->size);
-                else
-                        hash = m->hash;
-
-                r = journal_file_find_data_object_with_hash(f, m->data, m->size, hash, &d, NULL);
+                r = match_find_data_object(m, f, &d, NULL);
                 if (r <= 0)
                         return r;
 
@@ -828,14 +925,9 @@ static int find_location_for_match(
 
         if (m->type == MATCH_DISCRETE) {
                 Object *d;
-                uint64_t dp, hash;
-
-                if (JOURNAL_HEADER_KEYED_HASH(f->header))
-                        hash = journal_file_hash_data(f, m->data, m->size);
-                else
-                        hash = m->hash;
+                uint64_t dp;
 
-                r = journal_file_find_data_object_with_hash(f, m->data, m->size, hash, &d, &dp);
+                r = match_find_data_object(m, f, &d, &dp);
                 if (r <= 0)
                         return r;
 
@@ -1743,6 +1835,42 @@ static int add_file_by_name(
         return add_any_file(j, -1, path);
 }
 
+static int refresh_file_by_name(
+                sd_journal *j,
+                const char *prefix,
+                const char *filename) {
+
+        _cleanup_free_ char *path = NULL;
+        JournalFile *f;
+
+        assert(j);
+        assert(prefix);
+        assert(filename);
+
+        /* Called when a journal file got modified. If we already track it there's no need to open and
+         * fstat() it again: the inode behind the name can't have changed without us seeing a
+         * IN_CREATE/IN_MOVED_TO event for it first. This matters, since we get this for every single write
+         * the journal daemon does. */
+
+        if (j->no_new_files)
+                return 0;
+
+        if (!file_type_wanted(j->flags, filename))
+                return 0;
+
+        path = path_join(prefix, filename);
+        if (!path)
+                return -ENOMEM;
+
+        f = ordered_hashmap_get(j->files, path);
+        if (!f)
+                return add_any_file(j, -1, path);
+
+        f->last_seen_generation = j->generation;
+        (void) journal_file_read_tail_timestamp(j, f);
+        return 0;
+}
+
 static int remove_file_by_name(
                 sd_journal *j,
                 const char *prefix,
@@ -1795,6 +1923,7 @@ static void remove_file_real(sd_journal *j, JournalFile *f) {
                         j->fields_file_lost = true;
         }
 
+        match_forget_file(j->level0, f);
         journal_file_unlink_newest_by_boot_id(j, f);
         (void) journal_file_close(f);
 
@@ -2609,11 +2738,18 @@ static int journal_file_read_tail_timestamp(sd_journal *j, JournalFile *f) {
          * be). If we lack the "tail_entry_offset" field in the header, we specify the type as OBJECT_UNUSED
          * here, since we cannot be sure what the last object will be, and want no noisy logging if it isn't
          * an entry. We instead check after figuring out the pointer. */
-        r = journal_file_move_to_object(f, type, offset, &o);
-        if (r < 0) {
-                log_debug_errno(r, "Failed to move to last object in journal file, ignoring: %m");
+        if (f->header->state == STATE_ARCHIVED && JOURNAL_HEADER_TAIL_ENTRY_BOOT_ID(f->header))
+                /* Archived files carry reliable timestamps of their last entry in the header, use them
+                 * below instead of mapping the tail of the file. This way adding a file only touches its
+                 * header, and the rest is only mapped once the iterator actually looks into the file. */
                 o = NULL;
-                offset = 0;
+        else {
+                r = journal_file_move_to_object(f, type, offset, &o);
+                if (r < 0) {
+                        log_debug_errno(r, "Failed to move to last object in journal file, ignoring: %m");
+                        o = NULL;
+                        offset = 0;
+                }
         }
         if (o && o->object.type == OBJECT_ENTRY) {
                 /* Yay, last object is an entry, let's use the data. */
@@ -3066,8 +3202,10 @@ static void process_inotify_event(sd_journal *j, const struct inotify_event *e)
 
                         /* Event for a journal file */
 
-                        if (e->mask & (IN_CREATE|IN_MOVED_TO|IN_MODIFY|IN_ATTRIB))
+                        if (e->mask & (IN_CREATE|IN_MOVED_TO|IN_ATTRIB))
                                 (void) add_file_by_name(j, d->path, e->name);
+                        else if (e->mask & IN_MODIFY)
+                                (void) refresh_file_by_name(j, d->path, e->name);
                         else if (e->mask & (IN_DELETE|IN_MOVED_FROM|IN_UNMOUNT))
                                 (void) remove_file_by_name(j, d->path, e->name);
 
@@ -126,6 +126,78 @@ TEST(non_empty) {
         test_non_empty_one();
 }
 
+static void test_append_entries_one(void) {
+        _cleanup_(mmap_cache_unrefp) MMapCache *m = NULL;
+        dual_timestamp ts;
+        JournalFile *f;
+        struct iovec a[] = {
+                IOVEC_MAKE_STRING("MESSAGE=one"),
+                IOVEC_MAKE_STRING("COMMON=x"),
+        }, b[] = {
+                IOVEC_MAKE_STRING("MESSAGE=two"),
+                IOVEC_MAKE_STRING("COMMON=x"),
+                IOVEC_MAKE_STRING("COMMON=x"),
+        };
+        JournalEntryBatchItem entries[] = {
+                { .ts = &ts, .iovec = a, .n_iovec = ELEMENTSOF(a) },
+                { .ts = &ts, .iovec = b, .n_iovec = ELEMENTSOF(b) },
+                { .ts = &ts, .iovec = a, .n_iovec = ELEMENTSOF(a) },
+        };
+        uint64_t seqnum = 0, p, q;
+        size_t n = SIZE_MAX;
+        Object *o, *d;
+        char t[] = "/var/tmp/journal-XXXXXX";
+
+        m = mmap_cache_new();
+        assert_se(m != NULL);
+
+        mkdtemp_chdir_chattr(t);
+
+        assert_se(journal_file_open(-EBADF, "test.journal", O_RDWR|O_CREAT, JOURNAL_COMPRESS, 0666, UINT64_MAX, NULL, m, NULL, &f) == 0);
+
+        assert_se(dual_timestamp_now(&ts));
+
+        assert_se(journal_file_append_entries(f, entries, 0, &seqnum, NULL, &n) == 0);
+        assert_se(n == 0);
+
+        assert_se(journal_file_append_entries(f, entries, ELEMENTSOF(entries), &seqnum, NULL, &n) == 0);
+        assert_se(n == ELEMENTSOF(entries));
+        assert_se(seqnum == 3);
+        assert_se(le64toh(f->header->n_entries) == 3);
+
+        /* The shared field must have resulted in a single DATA object linked to all three entries */
+        assert_se(journal_file_find_data_object(f, "COMMON=x", STRLEN("COMMON=x"), &d, NULL) == 1);
+        assert_se(le64toh(d->data.n_entries) == 3);
+
+        assert_se(journal_file_find_data_object(f, "MESSAGE=one", STRLEN("MESSAGE=one"), &d, NULL) == 1);
+        assert_se(le64toh(d->data.n_entries) == 2);
+
+        /* Duplicate items within one entry are still collapsed, and the XOR hash matches the one of the
+         * same entry appended through the regular path */
+        assert_se(journal_file_move_to_entry_by_seqnum(f, 2, DIRECTION_DOWN, &o, &p) == 1);
+        assert_se(journal_file_entry_n_items(f, o) == 2);
+        uint64_t xor_hash = le64toh(o->entry.xor_hash);
+
+        assert_se(journal_file_append_entry(f, &ts, NULL, b, ELEMENTSOF(b), &seqnum, NULL, &o, &q) == 0);
+        assert_se(le64toh(o->entry.xor_hash) == xor_hash);
+        assert_se(seqnum == 4);
+
+        (void) journal_file_offline_close(f);
+
+        if (arg_keep)
+                log_info("Not removing %s", t);
+        else
+                assert_se(rm_rf(t, REMOVE_ROOT|REMOVE_PHYSICAL) >= 0);
+}
+
+TEST(append_entries) {
+        assert_se(setenv("SYSTEMD_JOURNAL_COMPACT", "0", 1) >= 0);
+        test_append_entries_one();
+
+        assert_se(setenv("SYSTEMD_JOURNAL_COMPACT", "1", 1) >= 0);
+        test_append_entries_one();
+}
+
 static void test_empty_one(void) {
         _cleanup_(mmap_cache_unrefp) MMapCache *m = NULL;
         JournalFile *f1, *f2, *f3, *f4;
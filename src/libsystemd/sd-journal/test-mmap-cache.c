@@ -57,6 +57,26 @@ int main(int argc, char *argv[]) {
 
         assert_se((uint8_t*) p + 1 == (uint8_t*) q);
 
+#if !ENABLE_DEBUG_MMAP_CACHE
+        /* Consecutive misses right after the previous window of a category should grow the window, so that
+         * after a few of them a request 20M ahead is still served from the same mapping. */
+        r = mmap_cache_fd_get(fx, 2, false, 0, 2, NULL, &p);
+        assert_se(r >= 0);
+
+        r = mmap_cache_fd_get(fx, 2, false, 8ULL*1024ULL*1024ULL, 2, NULL, &p);
+        assert_se(r >= 0);
+
+        r = mmap_cache_fd_get(fx, 2, false, 24ULL*1024ULL*1024ULL, 2, NULL, &p);
+        assert_se(r >= 0);
+
+        r = mmap_cache_fd_get(fx, 2, false, 44ULL*1024ULL*1024ULL, 2, NULL, &q);
+        assert_se(r >= 0);
+
+        assert_se((uint8_t*) p + 20ULL*1024ULL*1024ULL == (uint8_t*) q);
+#endif
+
+        mmap_cache_stats_log_debug(m);
+
         mmap_cache_fd_free(fx);
         mmap_cache_unref(m);
 
@@ -1607,6 +1607,12 @@ static int print_source(FILE *f, sd_json_variant *v, sd_json_format_flags_t flag
 }
 
 static void json_format_string(FILE *f, const char *q, sd_json_format_flags_t flags) {
+        /* All characters we need to escape: the quote, the backslash and all control characters */
+        static const char escape_chars[] =
+                "\"\\"
+                "\001\002\003\004\005\006\007\010\011\012\013\014\015\016\017"
+                "\020\021\022\023\024\025\026\027\030\031\032\033\034\035\036\037";
+
         assert(q);
 
         fputc('"', f);
@@ -1614,7 +1620,19 @@ static void json_format_string(FILE *f, const char *q, sd_json_format_flags_t fl
         if (flags & SD_JSON_FORMAT_COLOR)
                 fputs(ansi_green(), f);
 
-        for (; *q; q++)
+        for (;;) {
+                size_t n;
+
+                /* Write out everything up to the next character that needs escaping in one go */
+                n = strcspn(q, escape_chars);
+                if (n > 0) {
+                        fwrite(q, 1, n, f);
+                        q += n;
+                }
+
+                if (*q == 0)
+                        break;
+
                 switch (*q) {
                 case '"':
                         fputs("\\\"", f);
@@ -1645,12 +1663,12 @@ static void json_format_string(FILE *f, const char *q, sd_json_format_flags_t fl
                         break;
 
                 default:
-                        if ((signed char) *q >= 0 && *q < ' ')
-                                fprintf(f, "\\u%04x", (unsigned) *q);
-                        else
-                                fputc(*q, f);
+                        fprintf(f, "\\u%04x", (unsigned) *q);
                 }
 
+                q++;
+        }
+
         if (flags & SD_JSON_FORMAT_COLOR)
                 fputs(ANSI_NORMAL, f);
 
@@ -2604,8 +2622,22 @@ static int json_parse_string(const char **p, char **ret) {
         c++;
 
         for (;;) {
+                const char *e;
                 int len;
 
+                /* Fast path: copy runs of printable ASCII characters that need no unescaping or UTF-8
+                 * validation in one go, instead of growing the buffer for each character. */
+                for (e = c; *e >= ' ' && *e < 0x7f && !IN_SET(*e, '"', '\\'); e++)
+                        ;
+                if (e > c) {
+                        if (!GREEDY_REALLOC(s, n + (e - c) + 1))
+                                return -ENOMEM;
+
+                        memcpy(s + n, c, e - c);
+                        n += e - c;
+                        c = e;
+                }
+
                 /* Check for EOF */
                 if (*c == 0)
                         return -EINVAL;
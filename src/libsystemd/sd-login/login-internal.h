@@ -0,0 +1,13 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+#pragma once
+
+#include <sys/types.h>
+
+typedef struct CGroupRootCache {
+        /* Fixed size, so that nothing needs to be freed when the thread exits. Roots that don't fit are not
+         * cached. */
+        char root[256];
+        ino_t cgroupns_ino; /* The cgroup namespace the root was determined in, 0 if nothing is cached */
+} CGroupRootCache;
+
+int cgroup_root_cache_get(CGroupRootCache *c, const char **ret);
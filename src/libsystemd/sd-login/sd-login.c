@@ -3,6 +3,8 @@
 #include <errno.h>
 #include <poll.h>
 #include <sys/inotify.h>
+#include <sys/stat.h>
+#include <threads.h>
 #include <unistd.h>
 
 #include "sd-login.h"
@@ -18,6 +20,7 @@
 #include "fs-util.h"
 #include "hostname-util.h"
 #include "io-util.h"
+#include "login-internal.h"
 #include "login-util.h"
 #include "macro.h"
 #include "parse-util.h"
@@ -40,13 +43,65 @@
  *    requested metadata on object is missing → -ENODATA
  */
 
+int cgroup_root_cache_get(CGroupRootCache *c, const char **ret) {
+        _cleanup_free_ char *root = NULL;
+        struct stat st;
+        int r;
+
+        assert(c);
+        assert(ret);
+
+        /* cg_pid_get_path_shifted() reads /proc/1/cgroup on every call to determine the root to shift paths
+         * by, if none is specified. PID 1 doesn't change cgroups once it has moved itself into init.scope,
+         * but the path we see for it depends on our cgroup namespace, hence cache the root per namespace.
+         * Note that the root is the empty string on the host. If we can't tell which namespace we are in,
+         * don't cache anything. Returns 1 if the root was looked up, 0 if the cached one was used. */
+
+        if (stat("/proc/self/ns/cgroup", &st) < 0)
+                return -errno;
+
+        if (c->cgroupns_ino != 0 && st.st_ino == c->cgroupns_ino) {
+                *ret = c->root;
+                return 0;
+        }
+
+        c->cgroupns_ino = 0;
+
+        r = cg_get_root_path(&root);
+        if (r < 0)
+                return r;
+
+        if (strlen(root) >= sizeof(c->root))
+                return -ENAMETOOLONG;
+
+        strcpy(c->root, root);
+        c->cgroupns_ino = st.st_ino;
+
+        *ret = c->root;
+        return 1;
+}
+
+static int pid_get_cgroup_shifted(pid_t pid, char **ret) {
+        static thread_local CGroupRootCache cache = {};
+        const char *root;
+
+        /* If the root can't be cached, let cg_pid_get_path_shifted() determine it itself */
+        if (cgroup_root_cache_get(&cache, &root) < 0)
+                root = NULL;
+
+        return cg_pid_get_path_shifted(pid, root, ret);
+}
+
 _public_ int sd_pid_get_session(pid_t pid, char **session) {
         int r;
 
         assert_return(pid >= 0, -EINVAL);
         assert_return(session, -EINVAL);
 
-        r = cg_pid_get_session(pid, session);
+        _cleanup_free_ char *cgroup = NULL;
+        r = pid_get_cgroup_shifted(pid, &cgroup);
+        if (r >= 0)
+                r = cg_path_get_session(cgroup, session);
         return IN_SET(r, -ENXIO, -ENOMEDIUM) ? -ENODATA : r;
 }
 
@@ -56,7 +111,10 @@ _public_ int sd_pid_get_unit(pid_t pid, char **unit) {
         assert_return(pid >= 0, -EINVAL);
         assert_return(unit, -EINVAL);
 
-        r = cg_pid_get_unit(pid, unit);
+        _cleanup_free_ char *cgroup = NULL;
+        r = pid_get_cgroup_shifted(pid, &cgroup);
+        if (r >= 0)
+                r = cg_path_get_unit(cgroup, unit);
         return IN_SET(r, -ENXIO, -ENOMEDIUM) ? -ENODATA : r;
 }
 
@@ -66,7 +124,10 @@ _public_ int sd_pid_get_user_unit(pid_t pid, char **unit) {
         assert_return(pid >= 0, -EINVAL);
         assert_return(unit, -EINVAL);
 
-        r = cg_pid_get_user_unit(pid, unit);
+        _cleanup_free_ char *cgroup = NULL;
+        r = pid_get_cgroup_shifted(pid, &cgroup);
+        if (r >= 0)
+                r = cg_path_get_user_unit(cgroup, unit);
         return IN_SET(r, -ENXIO, -ENOMEDIUM) ? -ENODATA : r;
 }
 
@@ -76,7 +137,10 @@ _public_ int sd_pid_get_machine_name(pid_t pid, char **name) {
         assert_return(pid >= 0, -EINVAL);
         assert_return(name, -EINVAL);
 
-        r = cg_pid_get_machine_name(pid, name);
+        _cleanup_free_ char *cgroup = NULL;
+        r = pid_get_cgroup_shifted(pid, &cgroup);
+        if (r >= 0)
+                r = cg_path_get_machine_name(cgroup, name);
         return IN_SET(r, -ENXIO, -ENOMEDIUM) ? -ENODATA : r;
 }
 
@@ -86,7 +150,10 @@ _public_ int sd_pid_get_slice(pid_t pid, char **slice) {
         assert_return(pid >= 0, -EINVAL);
         assert_return(slice, -EINVAL);
 
-        r = cg_pid_get_slice(pid, slice);
+        _cleanup_free_ char *cgroup = NULL;
+        r = pid_get_cgroup_shifted(pid, &cgroup);
+        if (r >= 0)
+                r = cg_path_get_slice(cgroup, slice);
         return IN_SET(r, -ENXIO, -ENOMEDIUM) ? -ENODATA : r;
 }
 
@@ -96,7 +163,10 @@ _public_ int sd_pid_get_user_slice(pid_t pid, char **slice) {
         assert_return(pid >= 0, -EINVAL);
         assert_return(slice, -EINVAL);
 
-        r = cg_pid_get_user_slice(pid, slice);
+        _cleanup_free_ char *cgroup = NULL;
+        r = pid_get_cgroup_shifted(pid, &cgroup);
+        if (r >= 0)
+                r = cg_path_get_user_slice(cgroup, slice);
         return IN_SET(r, -ENXIO, -ENOMEDIUM) ? -ENODATA : r;
 }
 
@@ -106,7 +176,10 @@ _public_ int sd_pid_get_owner_uid(pid_t pid, uid_t *uid) {
         assert_return(pid >= 0, -EINVAL);
         assert_return(uid, -EINVAL);
 
-        r = cg_pid_get_owner_uid(pid, uid);
+        _cleanup_free_ char *cgroup = NULL;
+        r = pid_get_cgroup_shifted(pid, &cgroup);
+        if (r >= 0)
+                r = cg_path_get_owner_uid(cgroup, uid);
         return IN_SET(r, -ENXIO, -ENOMEDIUM) ? -ENODATA : r;
 }
 
@@ -12,6 +12,7 @@
 #include "fd-util.h"
 #include "format-util.h"
 #include "log.h"
+#include "login-internal.h"
 #include "missing_syscall.h"
 #include "mountpoint-util.h"
 #include "process-util.h"
@@ -330,6 +331,23 @@ TEST(monitor) {
         sd_login_monitor_unref(m);
 }
 
+TEST(cgroup_root_cache) {
+        CGroupRootCache cache = {};
+        _cleanup_free_ char *root = NULL;
+        const char *a, *b;
+        int r;
+
+        r = cgroup_root_cache_get(&cache, &a);
+        if (r < 0)
+                return (void) log_tests_skipped_errno(r, "Failed to determine cgroup root");
+        ASSERT_EQ(r, 1);
+        ASSERT_NOT_NULL(root = strdup(a));
+
+        /* The second call must use the cached root, including the empty one of the host */
+        ASSERT_OK_ZERO(cgroup_root_cache_get(&cache, &b));
+        ASSERT_STREQ(b, root);
+}
+
 static int intro(void) {
         if (IN_SET(cg_unified(), -ENOENT, -ENOMEDIUM))
                 return log_tests_skipped("cgroupfs is not mounted");
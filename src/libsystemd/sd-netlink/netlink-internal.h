@@ -15,6 +15,9 @@
 
 #define NETLINK_RQUEUE_MAX 64*1024
 
+/* The kernel caps the size of the skbs of dumps at 32K, see netlink_recvmsg() */
+#define NETLINK_RBUFFER_MIN_SIZE ((size_t) (32U * 1024U))
+
 #define NETLINK_CONTAINER_DEPTH 32
 
 struct reply_callback {
@@ -60,6 +60,10 @@ static bool rtnl_message_type_is_nsid(uint16_t type) {
         return IN_SET(type, RTM_NEWNSID, RTM_DELNSID, RTM_GETNSID);
 }
 
+static bool rtnl_message_type_is_stats(uint16_t type) {
+        return IN_SET(type, RTM_NEWSTATS, RTM_GETSTATS);
+}
+
 #define DEFINE_RTNL_MESSAGE_SETTER(class, header_type, element, name, value_type) \
         int sd_rtnl_message_##class##_set_##name(sd_netlink_message *m, value_type value) { \
                 assert_return(m, -EINVAL);                              \
@@ -555,3 +559,46 @@ int sd_rtnl_message_new_nsid(
 
         return 0;
 }
+
+int sd_rtnl_message_new_stats(
+                sd_netlink *rtnl,
+                sd_netlink_message **ret,
+                uint16_t nlmsg_type,
+                int ifindex,
+                uint32_t filter_mask) {
+
+        struct if_stats_msg *ifsm;
+        int r;
+
+        assert_return(rtnl_message_type_is_stats(nlmsg_type), -EINVAL);
+        assert_return(ifindex >= 0, -EINVAL);
+        assert_return(filter_mask != 0, -EINVAL);
+        assert_return(ret, -EINVAL);
+
+        r = message_new(rtnl, ret, nlmsg_type);
+        if (r < 0)
+                return r;
+
+        ifsm = NLMSG_DATA((*ret)->hdr);
+        ifsm->family = AF_UNSPEC;
+        ifsm->ifindex = ifindex;
+        ifsm->filter_mask = filter_mask;
+
+        return 0;
+}
+
+int sd_rtnl_message_stats_get_ifindex(sd_netlink_message *m, int *ret) {
+        struct if_stats_msg *ifsm;
+
+        assert_return(m, -EINVAL);
+        assert_return(m->hdr, -EINVAL);
+        assert_return(rtnl_message_type_is_stats(m->hdr->nlmsg_type), -EINVAL);
+        assert_return(ret, -EINVAL);
+
+        ifsm = NLMSG_DATA(m->hdr);
+        if (ifsm->ifindex <= 0 || ifsm->ifindex > INT_MAX)
+                return -EINVAL;
+
+        *ret = (int) ifsm->ifindex;
+        return 0;
+}
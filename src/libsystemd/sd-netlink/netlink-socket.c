@@ -368,8 +368,10 @@ int socket_read_message(sd_netlink *nl) {
                 return r;
         len = (size_t) r;
 
-        /* make room for the pending message */
-        if (!greedy_realloc((void**) &nl->rbuffer, len, sizeof(uint8_t)))
+        /* make room for the pending message. The kernel sizes the skbs of dumps according to the largest
+         * buffer we passed to recvmsg() so far, hence always offer a reasonably large buffer, so that
+         * large dumps are not delivered in tiny chunks, each requiring two syscalls. */
+        if (!greedy_realloc((void**) &nl->rbuffer, MAX(len, NETLINK_RBUFFER_MIN_SIZE), sizeof(uint8_t)))
                 return -ENOMEM;
 
         /* read the pending message */
@@ -1200,6 +1200,12 @@ static const NLAPolicy rtnl_nsid_policies[] = {
 
 DEFINE_POLICY_SET(rtnl_nsid);
 
+static const NLAPolicy rtnl_stats_policies[] = {
+        [IFLA_STATS_LINK_64]       = BUILD_POLICY_WITH_SIZE(BINARY, sizeof(struct rtnl_link_stats64)),
+};
+
+DEFINE_POLICY_SET(rtnl_stats);
+
 static const NLAPolicy rtnl_policies[] = {
         [RTM_NEWLINK]      = BUILD_POLICY_NESTED_WITH_SIZE(rtnl_link, sizeof(struct ifinfomsg)),
         [RTM_DELLINK]      = BUILD_POLICY_NESTED_WITH_SIZE(rtnl_link, sizeof(struct ifinfomsg)),
@@ -1238,6 +1244,8 @@ static const NLAPolicy rtnl_policies[] = {
         [RTM_NEWNSID]      = BUILD_POLICY_NESTED_WITH_SIZE(rtnl_nsid, sizeof(struct rtgenmsg)),
         [RTM_DELNSID]      = BUILD_POLICY_NESTED_WITH_SIZE(rtnl_nsid, sizeof(struct rtgenmsg)),
         [RTM_GETNSID]      = BUILD_POLICY_NESTED_WITH_SIZE(rtnl_nsid, sizeof(struct rtgenmsg)),
+        [RTM_NEWSTATS]     = BUILD_POLICY_NESTED_WITH_SIZE(rtnl_stats, sizeof(struct if_stats_msg)),
+        [RTM_GETSTATS]     = BUILD_POLICY_NESTED_WITH_SIZE(rtnl_stats, sizeof(struct if_stats_msg)),
 };
 
 DEFINE_POLICY_SET(rtnl);
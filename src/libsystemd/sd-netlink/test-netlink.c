@@ -6,6 +6,7 @@
 #include <netinet/in.h>
 #include <linux/fou.h>
 #include <linux/genetlink.h>
+#include <linux/if_link.h>
 #include <linux/if_macsec.h>
 #include <linux/l2tp.h>
 #include <linux/nl80211.h>
@@ -85,6 +86,36 @@ TEST(message_getlink) {
         ASSERT_OK(sd_netlink_message_read_ether_addr(reply, IFLA_ADDRESS, &eth_data));
 }
 
+TEST(message_getstats) {
+        _cleanup_(sd_netlink_unrefp) sd_netlink *rtnl = NULL;
+        _cleanup_(sd_netlink_message_unrefp) sd_netlink_message *message = NULL, *reply = NULL;
+        struct rtnl_link_stats64 stats;
+        uint16_t type;
+        int ifindex, r;
+
+        ASSERT_OK(sd_netlink_open(&rtnl));
+        ifindex = (int) if_nametoindex("lo");
+
+        ASSERT_ERROR(sd_rtnl_message_new_stats(rtnl, &message, RTM_GETSTATS, ifindex, 0), EINVAL);
+        ASSERT_OK(sd_rtnl_message_new_stats(rtnl, &message, RTM_GETSTATS, 0, IFLA_STATS_FILTER_BIT(IFLA_STATS_LINK_64)));
+        ASSERT_OK(sd_netlink_message_set_request_dump(message, true));
+
+        r = sd_netlink_call(rtnl, message, 0, &reply);
+        if (ERRNO_IS_NEG_NOT_SUPPORTED(r))
+                return (void) log_tests_skipped_errno(r, "RTM_GETSTATS is not supported");
+        ASSERT_OK(r);
+
+        for (sd_netlink_message *m = reply; m; m = sd_netlink_message_next(m)) {
+                int i;
+
+                ASSERT_OK(sd_netlink_message_get_type(m, &type));
+                ASSERT_EQ(type, RTM_NEWSTATS);
+                ASSERT_OK(sd_rtnl_message_stats_get_ifindex(m, &i));
+                ASSERT_GT(i, 0);
+                ASSERT_OK(sd_netlink_message_read(m, IFLA_STATS_LINK_64, sizeof(stats), &stats));
+        }
+}
+
 TEST(message_address) {
         _cleanup_(sd_netlink_unrefp) sd_netlink *rtnl = NULL;
         _cleanup_(sd_netlink_message_unrefp) sd_netlink_message *message = NULL, *reply = NULL;
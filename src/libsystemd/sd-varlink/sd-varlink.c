@@ -825,23 +825,19 @@ static int varlink_read(sd_varlink *v) {
 
                 add = MIN(VARLINK_BUFFER_MAX - v->input_buffer_size, VARLINK_READ_SIZE);
 
-                if (v->input_buffer_index == 0) {
-
-                        if (!GREEDY_REALLOC(v->input_buffer, v->input_buffer_size + add))
-                                return -ENOMEM;
-
-                } else {
-                        char *b;
-
-                        b = new(char, v->input_buffer_size + add);
-                        if (!b)
-                                return -ENOMEM;
-
-                        memcpy(b, v->input_buffer + v->input_buffer_index, v->input_buffer_size);
-
-                        free_and_replace(v->input_buffer, b);
+                if (v->input_buffer_index > 0) {
+                        /* Move the unprocessed data to the front of the buffer. When messages are streamed
+                         * to us, the leftover is usually just the beginning of the next message, and we can
+                         * keep reusing the buffer we already have instead of allocating a new one each time
+                         * we hit its end. */
+                        memmove(v->input_buffer, v->input_buffer + v->input_buffer_index, v->input_buffer_size);
+                        if (v->input_sensitive)
+                                explicit_bzero_safe(v->input_buffer + v->input_buffer_size, v->input_buffer_index);
                         v->input_buffer_index = 0;
                 }
+
+                if (!GREEDY_REALLOC(v->input_buffer, v->input_buffer_size + add))
+                        return -ENOMEM;
         }
 
         p = v->input_buffer + v->input_buffer_index + v->input_buffer_size;
@@ -1904,26 +1900,23 @@ static int varlink_format_json(sd_varlink *v, sd_json_variant *m) {
                 v->output_buffer_size = sz + 1;
                 v->output_buffer_index = 0;
 
-        } else if (v->output_buffer_index == 0) {
-
-                if (!GREEDY_REALLOC(v->output_buffer, v->output_buffer_size + sz + 1))
-                        return -ENOMEM;
-
-                memcpy(v->output_buffer + v->output_buffer_size, text, sz + 1);
-                v->output_buffer_size += sz + 1;
         } else {
-                char *n;
-                const size_t new_size = v->output_buffer_size + sz + 1;
+                if (v->output_buffer_index > 0 &&
+                    v->output_buffer_index + v->output_buffer_size + sz + 1 > MALLOC_SIZEOF_SAFE(v->output_buffer)) {
+                        /* The peer is not keeping up with us and we ran out of room at the end of the buffer:
+                         * move what is still unwritten to the front, so that we can keep growing the buffer
+                         * we have instead of allocating and copying a new one for each enqueued message. */
+                        memmove(v->output_buffer, v->output_buffer + v->output_buffer_index, v->output_buffer_size);
+                        if (v->output_buffer_sensitive)
+                                explicit_bzero_safe(v->output_buffer + v->output_buffer_size, v->output_buffer_index);
+                        v->output_buffer_index = 0;
+                }
 
-                n = new(char, new_size);
-                if (!n)
+                if (!GREEDY_REALLOC(v->output_buffer, v->output_buffer_index + v->output_buffer_size + sz + 1))
                         return -ENOMEM;
 
-                memcpy(mempcpy(n, v->output_buffer + v->output_buffer_index, v->output_buffer_size), text, sz + 1);
-
-                free_and_replace(v->output_buffer, n);
-                v->output_buffer_size = new_size;
-                v->output_buffer_index = 0;
+                memcpy(v->output_buffer + v->output_buffer_index + v->output_buffer_size, text, sz + 1);
+                v->output_buffer_size += sz + 1;
         }
 
         if (sd_json_variant_is_sensitive_recursive(m))
@@ -730,6 +730,7 @@ static int print_session_status_info(sd_bus *bus, const char *path) {
                 if (arg_transport == BUS_TRANSPORT_LOCAL)
                         show_journal_by_unit(
                                         stdout,
+                                        /* journal = */ NULL,
                                         i.scope,
                                         /* namespace = */ NULL,
                                         arg_output,
@@ -835,6 +836,7 @@ static int print_user_status_info(sd_bus *bus, const char *path) {
                 if (arg_transport == BUS_TRANSPORT_LOCAL)
                         show_journal_by_unit(
                                         stdout,
+                                        /* journal = */ NULL,
                                         i.slice,
                                         /* namespace = */ NULL,
                                         arg_output,
@@ -4398,7 +4398,7 @@ int match_job_removed(sd_bus_message *message, void *userdata, sd_bus_error *err
                         session_jobs_reply(session, id, unit, result);
 
                         session_save(session);
-                        user_save(session->user);
+                        user_add_to_save_queue(session->user);
                 }
 
                 session_add_to_gc_queue(session);
@@ -4417,7 +4417,7 @@ int match_job_removed(sd_bus_message *message, void *userdata, sd_bus_error *err
                                                 /* Don't propagate user service failures to the client */
                                                 session_jobs_reply(s, id, unit, /* error = */ NULL);
 
-                                        user_save(user);
+                                        user_add_to_save_queue(user);
                                         break;
                                 }
                 }
@@ -261,13 +261,12 @@ int seat_set_active(Seat *s, Session *session) {
 
         if (session) {
                 session_save(session);
-                user_save(session->user);
+                user_add_to_save_queue(session->user);
         }
 
         if (old_active) {
                 session_save(old_active);
-                if (!session || session->user != old_active->user)
-                        user_save(old_active->user);
+                user_add_to_save_queue(old_active->user);
         }
 
         return 0;
@@ -884,7 +884,7 @@ int session_start(Session *s, sd_bus_message *properties, sd_bus_error *error) {
 
         /* Save data */
         (void) session_save(s);
-        (void) user_save(s->user);
+        user_add_to_save_queue(s->user);
         if (s->seat)
                 (void) seat_save(s->seat);
 
@@ -979,7 +979,7 @@ int session_stop(Session *s, bool force) {
         user_elect_display(s->user);
 
         (void) session_save(s);
-        (void) user_save(s->user);
+        user_add_to_save_queue(s->user);
 
         return r;
 }
@@ -1027,7 +1027,7 @@ int session_finalize(Session *s) {
 
         session_reset_leader(s, /* keep_fdstore = */ false);
 
-        (void) user_save(s->user);
+        user_add_to_save_queue(s->user);
         (void) user_send_changed(s->user, "Display", NULL);
 
         return 0;
@@ -1669,11 +1669,15 @@ bool session_job_pending(Session *s) {
 
         /* Check if we have some jobs enqueued and not finished yet. Each time we get JobRemoved signal about
          * relevant units, session_send_create_reply and hence us is called (see match_job_removed).
-         * Note that we don't care about job result here. */
+         * Note that we don't care about job result here. If WaitForUserServiceManager=no is set, the
+         * session is handed out as soon as its scope and runtime directory are set up, and the per-user
+         * service manager finishes starting up asynchronously. */
 
         return s->scope_job ||
                s->user->runtime_dir_job ||
-               (SESSION_CLASS_WANTS_SERVICE_MANAGER(s->class) && s->user->service_manager_job);
+               (s->manager->wait_for_user_service_manager &&
+                SESSION_CLASS_WANTS_SERVICE_MANAGER(s->class) &&
+                s->user->service_manager_job);
 }
 
 int session_send_create_reply(Session *s, const sd_bus_error *error) {
@@ -109,6 +109,9 @@ User *user_free(User *u) {
         if (u->in_gc_queue)
                 LIST_REMOVE(gc_queue, u->manager->user_gc_queue, u);
 
+        if (u->in_save_queue)
+                LIST_REMOVE(save_queue, u->manager->user_save_queue, u);
+
         while (u->sessions)
                 session_free(u->sessions);
 
@@ -304,9 +307,29 @@ int user_save(User *u) {
         if (!u->started)
                 return 0;
 
+        /* We are writing the file out right now, hence any queued write is redundant */
+        if (u->in_save_queue) {
+                LIST_REMOVE(save_queue, u->manager->user_save_queue, u);
+                u->in_save_queue = false;
+        }
+
         return user_save_internal(u);
 }
 
+void user_add_to_save_queue(User *u) {
+        assert(u);
+
+        /* The user state file lists all sessions of the user, hence rewriting it for every single session
+         * change is quadratic for users with many sessions. Coalesce the writes instead: they are flushed
+         * once per event loop iteration by the manager. */
+
+        if (!u->started || u->in_save_queue)
+                return;
+
+        LIST_PREPEND(save_queue, u->manager->user_save_queue, u);
+        u->in_save_queue = true;
+}
+
 int user_load(User *u) {
         _cleanup_free_ char *realtime = NULL, *monotonic = NULL, *stopping = NULL, *last_session_timestamp = NULL, *gc_mode = NULL;
         int r;
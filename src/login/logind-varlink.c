@@ -365,11 +365,12 @@ int manager_varlink_init(Manager *m) {
 
         r = sd_varlink_server_bind_method_many(
                         s,
-                        "io.systemd.Login.CreateSession",    vl_method_create_session,
-                        "io.systemd.Login.ReleaseSession",   vl_method_release_session,
-                        "io.systemd.service.Ping",           varlink_method_ping,
-                        "io.systemd.service.SetLogLevel",    varlink_method_set_log_level,
-                        "io.systemd.service.GetEnvironment", varlink_method_get_environment);
+                        "io.systemd.Login.CreateSession",         vl_method_create_session,
+                        "io.systemd.Login.ReleaseSession",        vl_method_release_session,
+                        "io.systemd.service.Ping",                varlink_method_ping,
+                        "io.systemd.service.SetLogLevel",         varlink_method_set_log_level,
+                        "io.systemd.service.GetEnvironment",      varlink_method_get_environment,
+                        "io.systemd.service.GetMemoryStatistics", varlink_method_get_memory_statistics);
         if (r < 0)
                 return log_error_errno(r, "Failed to register varlink methods: %m");
 
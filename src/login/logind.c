@@ -996,6 +996,17 @@ static void manager_gc(Manager *m, bool drop_not_started) {
         }
 }
 
+static void manager_flush_save_queue(Manager *m) {
+        User *user;
+
+        assert(m);
+
+        while ((user = LIST_POP(save_queue, m->user_save_queue))) {
+                user->in_save_queue = false;
+                (void) user_save(user);
+        }
+}
+
 static int manager_dispatch_idle_action(sd_event_source *s, uint64_t t, void *userdata) {
         Manager *m = ASSERT_PTR(userdata);
         struct dual_timestamp since;
@@ -1204,10 +1215,13 @@ static int manager_run(Manager *m) {
                 r = sd_event_get_state(m->event);
                 if (r < 0)
                         return r;
-                if (r == SD_EVENT_FINISHED)
+                if (r == SD_EVENT_FINISHED) {
+                        manager_flush_save_queue(m);
                         return 0;
+                }
 
                 manager_gc(m, true);
+                manager_flush_save_queue(m);
 
                 r = manager_dispatch_delayed(m, false);
                 if (r < 0)
@@ -40,6 +40,7 @@ struct Manager {
         LIST_HEAD(Seat, seat_gc_queue);
         LIST_HEAD(Session, session_gc_queue);
         LIST_HEAD(User, user_gc_queue);
+        LIST_HEAD(User, user_save_queue);
 
         sd_device_monitor *device_seat_monitor, *device_monitor, *device_vcsa_monitor, *device_button_monitor;
 
@@ -123,6 +124,7 @@ struct Manager {
         bool reboot_key_ignore_inhibited;
 
         bool remove_ipc;
+        bool wait_for_user_service_manager;
 
         Hashmap *polkit_registry;
 
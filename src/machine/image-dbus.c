@@ -413,7 +413,7 @@ static int image_node_enumerator(sd_bus *bus, const char *path, void *userdata,
         if (!images)
                 return -ENOMEM;
 
-        r = image_discover(m->runtime_scope, IMAGE_MACHINE, NULL, images);
+        r = manager_discover_images(m, images);
         if (r < 0)
                 return r;
 
@@ -607,6 +607,7 @@ static void print_machine_status_info(sd_bus *bus, MachineStatusInfo *i) {
 
                         show_journal_by_unit(
                                         stdout,
+                                        /* journal = */ NULL,
                                         i->unit,
                                         /* namespace = */ NULL,
                                         arg_output,
@@ -413,18 +413,10 @@ static int image_flush_cache(sd_event_source *s, void *userdata) {
         return 0;
 }
 
-int manager_acquire_image(Manager *m, const char *name, Image **ret) {
+static int image_cache_schedule_flush(Manager *m) {
         int r;
 
         assert(m);
-        assert(name);
-
-        Image *existing = hashmap_get(m->image_cache, name);
-        if (existing) {
-                if (ret)
-                        *ret = existing;
-                return 0;
-        }
 
         if (!m->image_cache_defer_event) {
                 r = sd_event_add_defer(m->event, &m->image_cache_defer_event, image_flush_cache, m);
@@ -440,6 +432,26 @@ int manager_acquire_image(Manager *m, const char *name, Image **ret) {
         if (r < 0)
                 return log_debug_errno(r, "Failed to enable source: %m") ;
 
+        return 0;
+}
+
+int manager_acquire_image(Manager *m, const char *name, Image **ret) {
+        int r;
+
+        assert(m);
+        assert(name);
+
+        Image *existing = hashmap_get(m->image_cache, name);
+        if (existing) {
+                if (ret)
+                        *ret = existing;
+                return 0;
+        }
+
+        r = image_cache_schedule_flush(m);
+        if (r < 0)
+                return r;
+
         _cleanup_(image_unrefp) Image *image = NULL;
         r = image_find(m->runtime_scope, IMAGE_MACHINE, name, NULL, &image);
         if (r < 0)
@@ -458,6 +470,41 @@ int manager_acquire_image(Manager *m, const char *name, Image **ret) {
         return 0;
 }
 
+int manager_discover_images(Manager *m, Hashmap *images) {
+        Image *image;
+        int r;
+
+        assert(m);
+        assert(images);
+
+        r = image_discover(m->runtime_scope, IMAGE_MACHINE, /* root = */ NULL, images);
+        if (r < 0)
+                return r;
+
+        /* Clients that enumerate images usually look at each of them right after (e.g. the bus object
+         * manager does so for every enumerated node), hence seed the cache with what we just found, so
+         * that we don't have to search for each image again. Failures are not fatal here, the cache is
+         * only an optimization. */
+        if (hashmap_isempty(images) || image_cache_schedule_flush(m) < 0)
+                return 0;
+
+        HASHMAP_FOREACH(image, images) {
+                if (hashmap_contains(m->image_cache, image->name))
+                        continue;
+
+                r = hashmap_ensure_put(&m->image_cache, &image_hash_ops, image->name, image);
+                if (r < 0) {
+                        log_debug_errno(r, "Failed to add image '%s' to cache, ignoring: %m", image->name);
+                        break;
+                }
+
+                image_ref(image);
+                image->userdata = m;
+        }
+
+        return 0;
+}
+
 int rename_image_and_update_cache(Manager *m, Image *image, const char* new_name) {
         int r;
 
@@ -467,7 +467,7 @@ static int method_get_machine_os_release(sd_bus_message *message, void *userdata
 static int method_list_images(sd_bus_message *message, void *userdata, sd_bus_error *error) {
         _cleanup_(sd_bus_message_unrefp) sd_bus_message *reply = NULL;
         _cleanup_hashmap_free_ Hashmap *images = NULL;
-        _unused_ Manager *m = ASSERT_PTR(userdata);
+        Manager *m = ASSERT_PTR(userdata);
         Image *image;
         int r;
 
@@ -477,7 +477,7 @@ static int method_list_images(sd_bus_message *message, void *userdata, sd_bus_er
         if (!images)
                 return -ENOMEM;
 
-        r = image_discover(m->runtime_scope, IMAGE_MACHINE, NULL, images);
+        r = manager_discover_images(m, images);
         if (r < 0)
                 return r;
 
@@ -697,7 +697,7 @@ static int vl_method_list_images(sd_varlink *link, sd_json_variant *parameters,
         if (!images)
                 return -ENOMEM;
 
-        r = image_discover(m->runtime_scope, IMAGE_MACHINE, /* root = */ NULL, images);
+        r = manager_discover_images(m, images);
         if (r < 0)
                 return log_debug_errno(r, "Failed to discover images: %m");
 
@@ -802,7 +802,8 @@ static int manager_varlink_init_machine(Manager *m) {
                         "io.systemd.MachineImage.CleanPool",    vl_method_clean_pool,
                         "io.systemd.service.Ping",              varlink_method_ping,
                         "io.systemd.service.SetLogLevel",       varlink_method_set_log_level,
-                        "io.systemd.service.GetEnvironment",    varlink_method_get_environment);
+                        "io.systemd.service.GetEnvironment",    varlink_method_get_environment,
+                        "io.systemd.service.GetMemoryStatistics", varlink_method_get_memory_statistics);
         if (r < 0)
                 return log_error_errno(r, "Failed to register varlink methods: %m");
 
@@ -1674,6 +1674,7 @@ int link_request_address(
 
         _cleanup_(address_unrefp) Address *tmp = NULL;
         Address *existing = NULL;
+        Request *req;
         int r;
 
         assert(link);
@@ -1707,12 +1708,19 @@ int link_request_address(
                                     address_hash_func,
                                     address_compare_func,
                                     address_process_request,
-                                    message_counter, netlink_handler, ret);
+                                    message_counter, netlink_handler, &req);
         if (r < 0)
                 return log_link_warning_errno(link, r, "Failed to request address: %m");
+        if (ret)
+                *ret = req;
         if (r == 0)
                 return 0;
 
+        /* When e.g. a DHCP lease is renewed, the lifetime of the existing address needs to be extended
+         * before it expires. Do not let that wait behind the requests of other interfaces. */
+        if (existing && address_exists(existing) && existing->lifetime_valid_usec != USEC_INFINITY)
+                (void) request_prioritize(req);
+
         address_enter_requesting(tmp);
         if (existing)
                 address_enter_requesting(existing);
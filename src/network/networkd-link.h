@@ -140,6 +140,7 @@ typedef struct Link {
 
         sd_dhcp_client *dhcp_client;
         sd_dhcp_lease *dhcp_lease;
+        sd_dhcp_lease *dhcp_lease_saved; /* The lease last written to lease_file */
         char *lease_file;
         unsigned dhcp4_messages;
         bool dhcp4_configured;
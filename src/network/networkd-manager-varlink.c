@@ -9,8 +9,12 @@
 #include "json-util.h"
 #include "lldp-rx-internal.h"
 #include "networkd-dhcp-server.h"
+#include "networkd-link.h"
 #include "networkd-manager-varlink.h"
+#include "networkd-network.h"
+#include "set.h"
 #include "stat-util.h"
+#include "string-util.h"
 #include "varlink-io.systemd.Network.h"
 #include "varlink-io.systemd.service.h"
 #include "varlink-util.h"
@@ -254,6 +258,116 @@ static int vl_method_set_persistent_storage(sd_varlink *vlink, sd_json_variant *
         return sd_varlink_reply(vlink, NULL);
 }
 
+static int link_build_state_json(Link *link, sd_json_variant **ret) {
+        const char *required_operstate = NULL, *required_family = NULL;
+
+        assert(link);
+        assert(ret);
+
+        /* This mirrors the online related parts of the link state file, see link_save(). */
+
+        if (link->network) {
+                LinkOperationalStateRange st;
+
+                link_required_operstate_for_online(link, &st);
+                required_operstate = strjoina(link_operstate_to_string(st.min), ":", link_operstate_to_string(st.max));
+                required_family = link_required_address_family_to_string(link_required_family_for_online(link));
+        }
+
+        return sd_json_buildo(
+                        ret,
+                        SD_JSON_BUILD_PAIR_INTEGER("InterfaceIndex", link->ifindex),
+                        SD_JSON_BUILD_PAIR_STRING("InterfaceName", link->ifname),
+                        SD_JSON_BUILD_PAIR_STRING("SetupState", link_state_to_string(link->state)),
+                        SD_JSON_BUILD_PAIR_STRING("OperationalState", link_operstate_to_string(link->operstate)),
+                        SD_JSON_BUILD_PAIR_STRING("IPv4AddressState", link_address_state_to_string(link->ipv4_address_state)),
+                        SD_JSON_BUILD_PAIR_STRING("IPv6AddressState", link_address_state_to_string(link->ipv6_address_state)),
+                        SD_JSON_BUILD_PAIR_CONDITION(!!link->network, "RequiredForOnline",
+                                                     SD_JSON_BUILD_BOOLEAN(link->network && link->network->required_for_online)),
+                        SD_JSON_BUILD_PAIR_CONDITION(!!required_operstate, "RequiredOperationalStateForOnline",
+                                                     SD_JSON_BUILD_STRING(required_operstate)),
+                        SD_JSON_BUILD_PAIR_CONDITION(!!required_family, "RequiredFamilyForOnline",
+                                                     SD_JSON_BUILD_STRING(required_family)));
+}
+
+static int link_notify_state(Link *link, sd_varlink *vlink) {
+        _cleanup_(sd_json_variant_unrefp) sd_json_variant *v = NULL;
+        int r;
+
+        assert(link);
+
+        r = link_build_state_json(link, &v);
+        if (r < 0)
+                return r;
+
+        if (vlink)
+                return sd_varlink_notifybo(vlink, SD_JSON_BUILD_PAIR_VARIANT("Link", v));
+
+        return varlink_many_notifybo(link->manager->varlink_link_state_subscription, SD_JSON_BUILD_PAIR_VARIANT("Link", v));
+}
+
+int link_send_varlink_state_changed(Link *link) {
+        int r;
+
+        assert(link);
+        assert(link->manager);
+
+        if (set_isempty(link->manager->varlink_link_state_subscription))
+                return 0;
+
+        if (link->state == LINK_STATE_LINGER)
+                return 0;
+
+        r = link_notify_state(link, /* vlink = */ NULL);
+        if (r < 0)
+                return log_link_debug_errno(link, r, "Failed to send link state change to varlink subscribers: %m");
+
+        return 0;
+}
+
+static int vl_method_subscribe_link_states(sd_varlink *vlink, sd_json_variant *parameters, sd_varlink_method_flags_t flags, void *userdata) {
+        Manager *manager = ASSERT_PTR(userdata);
+        Link *link;
+        int r;
+
+        assert(vlink);
+
+        if (!FLAGS_SET(flags, SD_VARLINK_METHOD_MORE))
+                return sd_varlink_error(vlink, SD_VARLINK_ERROR_EXPECTED_MORE, NULL);
+
+        r = sd_varlink_dispatch(vlink, parameters, /* dispatch_table = */ NULL, /* userdata = */ NULL);
+        if (r != 0)
+                return r;
+
+        HASHMAP_FOREACH(link, manager->links_by_index) {
+                if (link->state == LINK_STATE_LINGER)
+                        continue;
+
+                r = link_notify_state(link, vlink);
+                if (r < 0)
+                        return log_debug_errno(r, "Failed to send link states to varlink subscriber: %m");
+        }
+
+        r = set_ensure_put(&manager->varlink_link_state_subscription, NULL, vlink);
+        if (r < 0)
+                return log_debug_errno(r, "Failed to subscribe client to link state changes: %m");
+        sd_varlink_ref(vlink);
+
+        log_debug("%u clients now attached for link state varlink notifications",
+                  set_size(manager->varlink_link_state_subscription));
+
+        return 1;
+}
+
+static void vl_on_disconnect(sd_varlink_server *s, sd_varlink *vlink, void *userdata) {
+        Manager *manager = ASSERT_PTR(userdata);
+
+        assert(s);
+        assert(vlink);
+
+        sd_varlink_unref(set_remove(manager->varlink_link_state_subscription, vlink));
+}
+
 int manager_connect_varlink(Manager *m) {
         _cleanup_(sd_varlink_server_unrefp) sd_varlink_server *s = NULL;
         int r;
@@ -286,12 +400,18 @@ int manager_connect_varlink(Manager *m) {
                         "io.systemd.Network.GetNamespaceId",       vl_method_get_namespace_id,
                         "io.systemd.Network.GetLLDPNeighbors",     vl_method_get_lldp_neighbors,
                         "io.systemd.Network.SetPersistentStorage", vl_method_set_persistent_storage,
+                        "io.systemd.Network.SubscribeLinkStates",  vl_method_subscribe_link_states,
                         "io.systemd.service.Ping",                 varlink_method_ping,
                         "io.systemd.service.SetLogLevel",          varlink_method_set_log_level,
-                        "io.systemd.service.GetEnvironment",       varlink_method_get_environment);
+                        "io.systemd.service.GetEnvironment",       varlink_method_get_environment,
+                        "io.systemd.service.GetMemoryStatistics",  varlink_method_get_memory_statistics);
         if (r < 0)
                 return log_error_errno(r, "Failed to register varlink methods: %m");
 
+        r = sd_varlink_server_bind_disconnect(s, vl_on_disconnect);
+        if (r < 0)
+                return log_error_errno(r, "Failed to register varlink disconnect handler: %m");
+
         r = sd_varlink_server_listen_address(s, "/run/systemd/netif/io.systemd.Network", 0666);
         if (r < 0)
                 return log_error_errno(r, "Failed to bind to varlink socket: %m");
@@ -308,5 +428,6 @@ void manager_varlink_done(Manager *m) {
         assert(m);
 
         m->varlink_server = sd_varlink_server_unref(m->varlink_server);
+        m->varlink_link_state_subscription = set_free_with_destructor(m->varlink_link_state_subscription, sd_varlink_unref);
         (void) unlink("/run/systemd/netif/io.systemd.Network");
 }
@@ -5,3 +5,5 @@
 
 int manager_connect_varlink(Manager *m);
 void manager_varlink_done(Manager *m);
+
+int link_send_varlink_state_changed(Link *link);
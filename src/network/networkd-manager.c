@@ -669,6 +669,7 @@ Manager* manager_free(Manager *m) {
 
         free(m->state_file);
 
+        m->prioritized_request_queue = ordered_set_free(m->prioritized_request_queue);
         m->request_queue = ordered_set_free(m->request_queue);
         m->remove_request_queue = ordered_set_free(m->remove_request_queue);
 
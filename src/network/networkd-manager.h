@@ -36,6 +36,7 @@ struct Manager {
         sd_resolve *resolve;
         sd_bus *bus;
         sd_varlink_server *varlink_server;
+        Set *varlink_link_state_subscription;
         sd_device_monitor *device_monitor;
         Hashmap *polkit_registry;
         int ethtool_fd;
@@ -122,6 +123,7 @@ struct Manager {
 
         bool request_queued;
         OrderedSet *request_queue;
+        OrderedSet *prioritized_request_queue;
         OrderedSet *remove_request_queue;
 
         Hashmap *tuntap_fds_by_name;
@@ -9,12 +9,24 @@
 
 #define REPLY_CALLBACK_COUNT_THRESHOLD 128
 
+static void request_unprioritize(Request *req) {
+        assert(req);
+
+        if (!req->prioritized)
+                return;
+
+        assert(req->manager);
+        ordered_set_remove(req->manager->prioritized_request_queue, req);
+        req->prioritized = false;
+}
+
 static Request* request_detach_impl(Request *req) {
         assert(req);
 
         if (!req->manager)
                 return NULL;
 
+        request_unprioritize(req);
         ordered_set_remove(req->manager->request_queue, req);
         req->manager = NULL;
         return req;
@@ -24,6 +36,23 @@ void request_detach(Request *req) {
         request_unref(request_detach_impl(req));
 }
 
+int request_prioritize(Request *req) {
+        int r;
+
+        assert(req);
+
+        if (!req->manager || req->prioritized || req->waiting_reply)
+                return 0;
+
+        /* The request is owned by the main queue, hence this set does not take a reference. */
+        r = ordered_set_ensure_put(&req->manager->prioritized_request_queue, &trivial_hash_ops, req);
+        if (r < 0)
+                return r;
+
+        req->prioritized = true;
+        return 1;
+}
+
 static Request *request_free(Request *req) {
         if (!req)
                 return NULL;
@@ -268,35 +297,37 @@ int link_requeue_request(Link *link, Request *req, void *userdata, Request **ret
                         ret);
 }
 
-int manager_process_requests(Manager *manager) {
+static bool manager_reply_callbacks_full(Manager *manager) {
+        assert(manager);
+
+        /* Typically, requests send netlink message asynchronously. If there are many requests queued, then
+         * processing them may make reply callback queue in sd-netlink full. */
+        return netlink_get_reply_callback_count(manager->rtnl) >= REPLY_CALLBACK_COUNT_THRESHOLD ||
+                netlink_get_reply_callback_count(manager->genl) >= REPLY_CALLBACK_COUNT_THRESHOLD ||
+                fw_ctx_get_reply_callback_count(manager->fw_ctx) >= REPLY_CALLBACK_COUNT_THRESHOLD;
+}
+
+static int manager_process_requests_internal(Manager *manager, bool prioritized_only) {
         Request *req;
         int r;
 
         assert(manager);
 
-        /* Process only when no remove request is queued. */
-        if (!ordered_set_isempty(manager->remove_request_queue))
-                return 0;
-
-        manager->request_queued = false;
-
-        ORDERED_SET_FOREACH(req, manager->request_queue) {
+        /* Prioritized requests are kept in their own queue, so that the first pass does not need to walk
+         * all other requests. */
+        ORDERED_SET_FOREACH(req, prioritized_only ? manager->prioritized_request_queue : manager->request_queue) {
                 if (req->waiting_reply)
                         continue; /* Already processed, and waiting for netlink reply. */
 
-                /* Typically, requests send netlink message asynchronously. If there are many requests
-                 * queued, then this event may make reply callback queue in sd-netlink full. */
-                if (netlink_get_reply_callback_count(manager->rtnl) >= REPLY_CALLBACK_COUNT_THRESHOLD ||
-                    netlink_get_reply_callback_count(manager->genl) >= REPLY_CALLBACK_COUNT_THRESHOLD ||
-                    fw_ctx_get_reply_callback_count(manager->fw_ctx) >= REPLY_CALLBACK_COUNT_THRESHOLD)
-                        break;
-
                 /* Avoid the request and link freed by req->process() and request_detach(). */
                 _unused_ _cleanup_(request_unrefp) Request *req_unref = request_ref(req);
                 _cleanup_(link_unrefp) Link *link = link_ref(req->link);
 
                 assert(req->process);
                 r = req->process(req, link, req->userdata);
+                if (r != 0)
+                        /* Processed or failed. Either way, it must not be selected by the next pass. */
+                        request_unprioritize(req);
                 if (r < 0) {
                         request_detach(req);
 
@@ -304,7 +335,7 @@ int manager_process_requests(Manager *manager) {
                                 link_enter_failed(link);
                                 /* link_enter_failed() may detach multiple requests from the queue.
                                  * Hence, we need to exit from the loop. */
-                                break;
+                                return 0;
                         }
                 }
                 if (r > 0 && !req->waiting_reply)
@@ -314,9 +345,35 @@ int manager_process_requests(Manager *manager) {
                         request_detach(req);
 
                 if (manager->request_queued)
-                        break; /* New request is queued. Exit from the loop. */
+                        return 0; /* New request is queued. Exit from the loop. */
+
+                /* The number of pending replies only grows when a request has been processed. */
+                if (r > 0 && manager_reply_callbacks_full(manager))
+                        return 0;
         }
 
+        return 1; /* The whole queue has been processed. */
+}
+
+int manager_process_requests(Manager *manager) {
+        assert(manager);
+
+        /* Process only when no remove request is queued. */
+        if (!ordered_set_isempty(manager->remove_request_queue))
+                return 0;
+
+        /* This is called on every event loop iteration. When many requests are in flight, do not walk the
+         * whole queue only to find out that we cannot send anything anyway. */
+        if (manager_reply_callbacks_full(manager))
+                return 0;
+
+        manager->request_queued = false;
+
+        if (!ordered_set_isempty(manager->prioritized_request_queue) &&
+            manager_process_requests_internal(manager, /* prioritized_only = */ true) == 0)
+                return 0;
+
+        (void) manager_process_requests_internal(manager, /* prioritized_only = */ false);
         return 0;
 }
 
@@ -82,6 +82,10 @@ struct Request {
         request_netlink_handler_t netlink_handler;
 
         bool waiting_reply;
+
+        /* Processed before all other requests, e.g. for refreshing the lifetime of a leased address,
+         * which may otherwise expire while waiting behind many other requests in the queue. */
+        bool prioritized;
 };
 
 Request *request_ref(Request *req);
@@ -89,6 +93,7 @@ Request *request_unref(Request *req);
 DEFINE_TRIVIAL_CLEANUP_FUNC(Request*, request_unref);
 
 void request_detach(Request *req);
+int request_prioritize(Request *req);
 
 int netdev_queue_request(
                 NetDev *netdev,
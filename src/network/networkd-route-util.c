@@ -150,16 +150,20 @@ bool gateway_is_ready(Link *link, bool onlink, int family, const union in_addr_u
         SET_FOREACH(route, link->manager->routes) {
                 if (route->nexthop.ifindex != link->ifindex)
                         continue;
-                if (!route_exists(route))
-                        continue;
-                if (!route_lifetime_is_valid(route))
-                        continue;
                 if (route->family != family)
                         continue;
                 if (!in_addr_is_set(route->family, &route->dst) && route->dst_prefixlen == 0)
                         continue;
-                if (in_addr_prefix_covers(family, &route->dst, route->dst_prefixlen, gw) > 0)
-                        return true;
+                if (in_addr_prefix_covers(family, &route->dst, route->dst_prefixlen, gw) <= 0)
+                        continue;
+                /* Check these last, only for the few matching routes, as route_lifetime_is_valid() needs
+                 * to query the clock. */
+                if (!route_exists(route))
+                        continue;
+                if (!route_lifetime_is_valid(route))
+                        continue;
+
+                return true;
         }
 
         if (link->manager->manage_foreign_routes)
@@ -201,19 +205,20 @@ static int link_address_is_reachable_internal(
                 if (route->nexthop.ifindex != link->ifindex)
                         continue;
 
-                if (!route_exists(route))
+                if (route->type != RTN_UNICAST)
                         continue;
 
-                if (!route_lifetime_is_valid(route))
+                if (route->family != family)
                         continue;
 
-                if (route->type != RTN_UNICAST)
+                if (in_addr_prefix_covers(family, &route->dst, route->dst_prefixlen, address) <= 0)
                         continue;
 
-                if (route->family != family)
+                /* See gateway_is_ready() */
+                if (!route_exists(route))
                         continue;
 
-                if (in_addr_prefix_covers(family, &route->dst, route->dst_prefixlen, address) <= 0)
+                if (!route_lifetime_is_valid(route))
                         continue;
 
                 if (prefsrc &&
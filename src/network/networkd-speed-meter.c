@@ -1,6 +1,7 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 
 #include <errno.h>
+#include <linux/if_link.h>
 
 #include "sd-event.h"
 #include "sd-netlink.h"
@@ -19,10 +20,10 @@ static int process_message(Manager *manager, sd_netlink_message *message) {
         if (r < 0)
                 return r;
 
-        if (type != RTM_NEWLINK)
+        if (type != RTM_NEWSTATS)
                 return 0;
 
-        r = sd_rtnl_message_link_get_ifindex(message, &ifindex);
+        r = sd_rtnl_message_stats_get_ifindex(message, &ifindex);
         if (r < 0)
                 return r;
 
@@ -32,7 +33,7 @@ static int process_message(Manager *manager, sd_netlink_message *message) {
 
         link->stats_old = link->stats_new;
 
-        r = sd_netlink_message_read(message, IFLA_STATS64, sizeof link->stats_new, &link->stats_new);
+        r = sd_netlink_message_read(message, IFLA_STATS_LINK_64, sizeof link->stats_new, &link->stats_new);
         if (r < 0)
                 return r;
 
@@ -64,9 +65,10 @@ static int speed_meter_handler(sd_event_source *s, uint64_t usec, void *userdata
         HASHMAP_FOREACH(link, manager->links_by_index)
                 link->stats_updated = false;
 
-        r = sd_rtnl_message_new_link(manager->rtnl, &req, RTM_GETLINK, 0);
+        /* Only request the 64-bit counters, rather than dumping the full link information every time. */
+        r = sd_rtnl_message_new_stats(manager->rtnl, &req, RTM_GETSTATS, 0, IFLA_STATS_FILTER_BIT(IFLA_STATS_LINK_64));
         if (r < 0) {
-                log_warning_errno(r, "Failed to allocate RTM_GETLINK netlink message, ignoring: %m");
+                log_warning_errno(r, "Failed to allocate RTM_GETSTATS netlink message, ignoring: %m");
                 return 0;
         }
 
@@ -78,7 +80,7 @@ static int speed_meter_handler(sd_event_source *s, uint64_t usec, void *userdata
 
         r = sd_netlink_call(manager->rtnl, req, 0, &reply);
         if (r < 0) {
-                log_warning_errno(r, "Failed to call RTM_GETLINK, ignoring: %m");
+                log_warning_errno(r, "Failed to call RTM_GETSTATS, ignoring: %m");
                 return 0;
         }
 
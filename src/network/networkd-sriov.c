@@ -9,7 +9,7 @@
 #include "networkd-queue.h"
 #include "networkd-sriov.h"
 
-static int sr_iov_handler(sd_netlink *rtnl, sd_netlink_message *m, Request *req, Link *link, SRIOV *sr_iov) {
+static int sr_iov_handler(sd_netlink *rtnl, sd_netlink_message *m, Request *req, Link *link, void *userdata) {
         int r;
 
         assert(m);
@@ -31,51 +31,48 @@ static int sr_iov_handler(sd_netlink *rtnl, sd_netlink_message *m, Request *req,
         return 1;
 }
 
-static int sr_iov_configure(SRIOV *sr_iov, Link *link, Request *req) {
+static int sr_iov_configure(Link *link, Request *req) {
         _cleanup_(sd_netlink_message_unrefp) sd_netlink_message *m = NULL;
         int r;
 
-        assert(sr_iov);
         assert(link);
+        assert(link->network);
         assert(link->manager);
         assert(link->manager->rtnl);
         assert(link->ifindex > 0);
         assert(req);
 
-        log_link_debug(link, "Setting SR-IOV virtual function %"PRIu32".", sr_iov->vf);
+        log_link_debug(link, "Setting %u SR-IOV virtual function(s).",
+                       ordered_hashmap_size(link->network->sr_iov_by_section));
 
         r = sd_rtnl_message_new_link(link->manager->rtnl, &m, RTM_SETLINK, link->ifindex);
         if (r < 0)
                 return r;
 
-        r = sr_iov_set_netlink_message(sr_iov, m);
+        r = sr_iov_set_netlink_message_many(link->network->sr_iov_by_section, m);
         if (r < 0)
                 return r;
 
         return request_call_netlink_async(link->manager->rtnl, m, req);
 }
 
-static int sr_iov_process_request(Request *req, Link *link, SRIOV *sr_iov) {
+static int sr_iov_process_request(Request *req, Link *link, void *userdata) {
         int r;
 
         assert(req);
         assert(link);
-        assert(sr_iov);
 
         if (!IN_SET(link->state, LINK_STATE_CONFIGURING, LINK_STATE_CONFIGURED))
                 return 0;
 
-        r = sr_iov_configure(sr_iov, link, req);
+        r = sr_iov_configure(link, req);
         if (r < 0)
-                return log_link_warning_errno(link, r,
-                                              "Failed to configure SR-IOV virtual function %"PRIu32": %m",
-                                              sr_iov->vf);
+                return log_link_warning_errno(link, r, "Failed to configure SR-IOV virtual functions: %m");
 
         return 1;
 }
 
 int link_request_sr_iov_vfs(Link *link) {
-        SRIOV *sr_iov;
         int r;
 
         assert(link);
@@ -83,19 +80,16 @@ int link_request_sr_iov_vfs(Link *link) {
 
         link->sr_iov_configured = false;
 
-        ORDERED_HASHMAP_FOREACH(sr_iov, link->network->sr_iov_by_section) {
-                r = link_queue_request_safe(link, REQUEST_TYPE_SRIOV,
-                                            sr_iov, NULL,
-                                            sr_iov_hash_func,
-                                            sr_iov_compare_func,
+        /* Settings of all virtual functions are sent in one message, rather than one per function. */
+        if (!ordered_hashmap_isempty(link->network->sr_iov_by_section)) {
+                r = link_queue_request_full(link, REQUEST_TYPE_SRIOV,
+                                            NULL, NULL, NULL, NULL,
                                             sr_iov_process_request,
                                             &link->sr_iov_messages,
                                             sr_iov_handler,
                                             NULL);
                 if (r < 0)
-                        return log_link_warning_errno(link, r,
-                                                      "Failed to request SR-IOV virtual function %"PRIu32": %m",
-                                                      sr_iov->vf);
+                        return log_link_warning_errno(link, r, "Failed to request SR-IOV virtual functions: %m");
         }
 
         if (link->sr_iov_messages == 0) {
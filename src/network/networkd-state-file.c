@@ -14,6 +14,7 @@
 #include "networkd-dhcp-common.h"
 #include "networkd-link.h"
 #include "networkd-manager-bus.h"
+#include "networkd-manager-varlink.h"
 #include "networkd-manager.h"
 #include "networkd-network.h"
 #include "networkd-ntp.h"
@@ -921,13 +922,22 @@ static int link_save(Link *link) {
         print_link_hashmap(f, "CARRIER_BOUND_BY=", link->bound_by_links);
 
         if (link->dhcp_lease) {
-                r = dhcp_lease_save(link->dhcp_lease, link->lease_file);
-                if (r < 0)
-                        return r;
+                /* Lease objects are never modified once acquired, hence only write the lease file when
+                 * we got a new one, rather than every time something else about the link changes. */
+                if (link->dhcp_lease != link->dhcp_lease_saved) {
+                        r = dhcp_lease_save(link->dhcp_lease, link->lease_file);
+                        if (r < 0)
+                                return r;
+
+                        sd_dhcp_lease_unref(link->dhcp_lease_saved);
+                        link->dhcp_lease_saved = sd_dhcp_lease_ref(link->dhcp_lease);
+                }
 
                 fprintf(f, "DHCP_LEASE=%s\n", link->lease_file);
-        } else
+        } else {
                 (void) unlink(link->lease_file);
+                link->dhcp_lease_saved = sd_dhcp_lease_unref(link->dhcp_lease_saved);
+        }
 
         r = link_serialize_dhcp6_client(link, f);
         if (r < 0)
@@ -992,6 +1002,8 @@ int link_save_and_clean_full(Link *link, bool also_save_manager) {
                 return r;
 
         link_clean(link);
+
+        (void) link_send_varlink_state_changed(link);
         return k;
 }
 
@@ -1,11 +1,13 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 
+#include "sd-json.h"
 #include "sd-network.h"
 
 #include "alloc-util.h"
 #include "dns-configuration.h"
 #include "format-ifname.h"
 #include "hashmap.h"
+#include "json-util.h"
 #include "link.h"
 #include "manager.h"
 #include "string-util.h"
@@ -252,3 +254,84 @@ int link_update_monitor(Link *l) {
 
         return ret;
 }
+
+typedef struct LinkStateParameters {
+        const char *setup_state;
+        const char *operational_state;
+        const char *ipv4_address_state;
+        const char *ipv6_address_state;
+        int required_for_online;
+        const char *required_operstate;
+        const char *required_family;
+} LinkStateParameters;
+
+int link_update_json(Link *l, sd_json_variant *v) {
+        static const sd_json_dispatch_field dispatch_table[] = {
+                { "SetupState",                        SD_JSON_VARIANT_STRING,  sd_json_dispatch_const_string, offsetof(LinkStateParameters, setup_state),        SD_JSON_MANDATORY },
+                { "OperationalState",                  SD_JSON_VARIANT_STRING,  sd_json_dispatch_const_string, offsetof(LinkStateParameters, operational_state),  SD_JSON_MANDATORY },
+                { "IPv4AddressState",                  SD_JSON_VARIANT_STRING,  sd_json_dispatch_const_string, offsetof(LinkStateParameters, ipv4_address_state), SD_JSON_MANDATORY },
+                { "IPv6AddressState",                  SD_JSON_VARIANT_STRING,  sd_json_dispatch_const_string, offsetof(LinkStateParameters, ipv6_address_state), SD_JSON_MANDATORY },
+                { "RequiredForOnline",                 SD_JSON_VARIANT_BOOLEAN, sd_json_dispatch_tristate,     offsetof(LinkStateParameters, required_for_online), 0                },
+                { "RequiredOperationalStateForOnline", SD_JSON_VARIANT_STRING,  sd_json_dispatch_const_string, offsetof(LinkStateParameters, required_operstate), 0                 },
+                { "RequiredFamilyForOnline",           SD_JSON_VARIANT_STRING,  sd_json_dispatch_const_string, offsetof(LinkStateParameters, required_family),    0                 },
+                {}
+        };
+
+        LinkStateParameters p = {
+                .required_for_online = -1,
+        };
+        LinkOperationalStateRange required_operstate = LINK_OPERSTATE_RANGE_DEFAULT;
+        AddressFamily required_family = ADDRESS_FAMILY_NO;
+        LinkOperationalState operstate;
+        LinkAddressState ipv4_address_state, ipv6_address_state;
+        int r;
+
+        assert(l);
+        assert(v);
+
+        /* This is the counterpart of link_update_monitor(), but takes the state from the notification sent
+         * by networkd, rather than reading its state file. */
+
+        r = sd_json_dispatch(v, dispatch_table, SD_JSON_ALLOW_EXTENSIONS, &p);
+        if (r < 0)
+                return log_link_debug_errno(l, r, "Failed to parse link state notification: %m");
+
+        operstate = link_operstate_from_string(p.operational_state);
+        if (operstate < 0)
+                return log_link_debug_errno(l, operstate, "Failed to parse operational state: %m");
+
+        ipv4_address_state = link_address_state_from_string(p.ipv4_address_state);
+        if (ipv4_address_state < 0)
+                return log_link_debug_errno(l, ipv4_address_state, "Failed to parse IPv4 address state: %m");
+
+        ipv6_address_state = link_address_state_from_string(p.ipv6_address_state);
+        if (ipv6_address_state < 0)
+                return log_link_debug_errno(l, ipv6_address_state, "Failed to parse IPv6 address state: %m");
+
+        if (!isempty(p.required_operstate)) {
+                r = parse_operational_state_range(p.required_operstate, &required_operstate);
+                if (r < 0)
+                        return log_link_debug_errno(l, r, "Failed to parse required operational state: %m");
+        }
+
+        if (!isempty(p.required_family)) {
+                required_family = link_required_address_family_from_string(p.required_family);
+                if (required_family < 0)
+                        return log_link_debug_errno(l, required_family, "Failed to parse required address family: %m");
+        }
+
+        r = free_and_strdup(&l->state, p.setup_state);
+        if (r < 0)
+                return log_oom_debug();
+
+        /* Unmanaged links do not carry the settings below, and are assumed to be required, like
+         * link_update_monitor() does when the state file does not have them. */
+        l->required_for_online = p.required_for_online != 0;
+        l->required_operstate = required_operstate;
+        l->required_family = required_family;
+        l->operational_state = operstate;
+        l->ipv4_address_state = ipv4_address_state;
+        l->ipv6_address_state = ipv6_address_state;
+
+        return 0;
+}
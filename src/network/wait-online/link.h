@@ -1,6 +1,7 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 #pragma once
 
+#include "sd-json.h"
 #include "sd-netlink.h"
 
 #include "dns-configuration.h"
@@ -32,5 +33,6 @@ int link_new(Manager *m, Link **ret, int ifindex, const char *ifname);
 Link *link_free(Link *l);
 int link_update_rtnl(Link *l, sd_netlink_message *m);
 int link_update_monitor(Link *l);
+int link_update_json(Link *l, sd_json_variant *v);
 
 DEFINE_TRIVIAL_CLEANUP_FUNC(Link*, link_free);
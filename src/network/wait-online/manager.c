@@ -362,12 +362,11 @@ static int manager_rtnl_listen(Manager *m) {
         return r;
 }
 
-static int on_network_event(sd_event_source *s, int fd, uint32_t revents, void *userdata) {
-        Manager *m = ASSERT_PTR(userdata);
+static void manager_update_links(Manager *m) {
         Link *l;
         int r;
 
-        sd_network_monitor_flush(m->network_monitor);
+        assert(m);
 
         HASHMAP_FOREACH(l, m->links_by_index) {
                 r = link_update_monitor(l);
@@ -375,6 +374,14 @@ static int on_network_event(sd_event_source *s, int fd, uint32_t revents, void *
                         log_link_full_errno(l, IN_SET(r, -ENODATA, -ENOENT) ? LOG_DEBUG : LOG_WARNING, r,
                                             "Failed to update link state, ignoring: %m");
         }
+}
+
+static int on_network_event(sd_event_source *s, int fd, uint32_t revents, void *userdata) {
+        Manager *m = ASSERT_PTR(userdata);
+
+        sd_network_monitor_flush(m->network_monitor);
+
+        manager_update_links(m);
 
         if (manager_configured(m))
                 sd_event_exit(m->event, 0);
@@ -407,6 +414,105 @@ static int manager_network_monitor_listen(Manager *m) {
         return 0;
 }
 
+static int on_link_state_event(
+                sd_varlink *link,
+                sd_json_variant *parameters,
+                const char *error_id,
+                sd_varlink_reply_flags_t flags,
+                void *userdata) {
+
+        static const sd_json_dispatch_field dispatch_table[] = {
+                { "InterfaceIndex", _SD_JSON_VARIANT_TYPE_INVALID, json_dispatch_ifindex, 0, SD_JSON_MANDATORY },
+                {}
+        };
+
+        Manager *m = ASSERT_PTR(userdata);
+        sd_json_variant *v;
+        int ifindex = 0, r;
+        Link *l;
+
+        assert(link);
+
+        if (error_id) {
+                /* networkd is too old to support the subscription, or went away. Let's fall back to
+                 * watching the state files, and catch up with anything we might have missed. */
+                log_debug("Link state event error, monitoring state files instead: %s", error_id);
+
+                if (m->network_monitor)
+                        return 0;
+
+                r = manager_network_monitor_listen(m);
+                if (r < 0)
+                        return log_error_errno(r, "Failed to monitor network state files: %m");
+
+                manager_update_links(m);
+                goto finalize;
+        }
+
+        v = sd_json_variant_by_key(parameters, "Link");
+        if (!sd_json_variant_is_object(v)) {
+                log_warning("Link state JSON data does not have Link key, ignoring.");
+                return 0;
+        }
+
+        r = sd_json_dispatch(v, dispatch_table, SD_JSON_ALLOW_EXTENSIONS, &ifindex);
+        if (r < 0) {
+                log_warning_errno(r, "Failed to get interface index from link state JSON data, ignoring: %m");
+                return 0;
+        }
+
+        /* Links not known yet are read from their state files when RTM_NEWLINK is received. */
+        l = hashmap_get(m->links_by_index, INT_TO_PTR(ifindex));
+        if (!l)
+                return 0;
+
+        r = link_update_json(l, v);
+        if (r < 0)
+                log_link_warning_errno(l, r, "Failed to update link state, ignoring: %m");
+
+finalize:
+        if (manager_configured(m))
+                sd_event_exit(m->event, 0);
+
+        return 0;
+}
+
+static int manager_link_state_listen(Manager *m) {
+        _cleanup_(sd_varlink_unrefp) sd_varlink *vl = NULL;
+        int r;
+
+        assert(m);
+        assert(m->event);
+
+        r = sd_varlink_connect_address(&vl, "/run/systemd/netif/io.systemd.Network");
+        if (r < 0) {
+                log_debug_errno(r, "Failed to connect to io.systemd.Network, monitoring state files instead: %m");
+                return manager_network_monitor_listen(m);
+        }
+
+        r = sd_varlink_set_relative_timeout(vl, USEC_INFINITY);
+        if (r < 0)
+                return log_error_errno(r, "Failed to set varlink timeout: %m");
+
+        r = sd_varlink_attach_event(vl, m->event, SD_EVENT_PRIORITY_NORMAL);
+        if (r < 0)
+                return log_error_errno(r, "Failed to attach varlink connection to event loop: %m");
+
+        (void) sd_varlink_set_userdata(vl, m);
+
+        r = sd_varlink_bind_reply(vl, on_link_state_event);
+        if (r < 0)
+                return log_error_errno(r, "Failed to bind varlink reply callback: %m");
+
+        r = sd_varlink_observe(vl, "io.systemd.Network.SubscribeLinkStates", /* parameters = */ NULL);
+        if (r < 0)
+                return log_error_errno(r, "Failed to issue SubscribeLinkStates: %m");
+
+        m->varlink_network = TAKE_PTR(vl);
+
+        return 0;
+}
+
 static int on_dns_configuration_event(
                 sd_varlink *link,
                 sd_json_variant *parameters,
@@ -551,7 +657,7 @@ int manager_new(Manager **ret,
 
         sd_event_set_watchdog(m->event, true);
 
-        r = manager_network_monitor_listen(m);
+        r = manager_link_state_listen(m);
         if (r < 0)
                 return r;
 
@@ -577,6 +683,7 @@ Manager* manager_free(Manager *m) {
 
         sd_event_source_unref(m->network_monitor_event_source);
         sd_network_monitor_unref(m->network_monitor);
+        sd_varlink_unref(m->varlink_network);
         sd_event_source_unref(m->rtnl_event_source);
         sd_netlink_unref(m->rtnl);
         sd_event_unref(m->event);
@@ -33,6 +33,9 @@ struct Manager {
         sd_network_monitor *network_monitor;
         sd_event_source *network_monitor_event_source;
 
+        /* Link state notifications from networkd. When unavailable, the network monitor above is used. */
+        sd_varlink *varlink_network;
+
         sd_event *event;
 
         sd_varlink *varlink_client;
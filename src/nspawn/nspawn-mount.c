@@ -628,10 +628,15 @@ int mount_all(const char *dest,
         bool tmpfs_tmp = FLAGS_SET(mount_settings, MOUNT_APPLY_TMPFS_TMP);
         bool unmanaged = FLAGS_SET(mount_settings, MOUNT_UNMANAGED);
         bool privileged = FLAGS_SET(mount_settings, MOUNT_PRIVILEGED);
-        int r;
+        /* Many entries come in pairs or groups operating on the same path (bind mount first, then remount
+         * r/o), hence remember the last resolved path, and don't chase() it again for each of them. The
+         * same goes for the usrquota check, which needs a new superblock context each time. */
+        _cleanup_free_ char *where = NULL;
+        const char *where_unresolved = NULL, *usrquota_type = NULL;
+        int usrquota_supported = 0, r;
 
         FOREACH_ELEMENT(m, mount_table) {
-                _cleanup_free_ char *where = NULL, *options = NULL, *prefixed = NULL;
+                _cleanup_free_ char *options = NULL, *prefixed = NULL;
                 bool fatal = FLAGS_SET(m->mount_settings, MOUNT_FATAL);
                 const char *o;
 
@@ -655,9 +660,16 @@ int mount_all(const char *dest,
                 if (!privileged && FLAGS_SET(m->mount_settings, MOUNT_PRIVILEGED))
                         continue;
 
-                r = chase(m->where, dest, CHASE_NONEXISTENT|CHASE_PREFIX_ROOT, &where, NULL);
-                if (r < 0)
-                        return log_error_errno(r, "Failed to resolve %s%s: %m", strempty(dest), m->where);
+                if (!streq_ptr(where_unresolved, m->where)) {
+                        where = mfree(where);
+                        where_unresolved = NULL;
+
+                        r = chase(m->where, dest, CHASE_NONEXISTENT|CHASE_PREFIX_ROOT, &where, NULL);
+                        if (r < 0)
+                                return log_error_errno(r, "Failed to resolve %s%s: %m", strempty(dest), m->where);
+
+                        where_unresolved = m->where;
+                }
 
                 /* Skip this entry if it is not a remount. */
                 if (m->what) {
@@ -710,7 +722,12 @@ int mount_all(const char *dest,
                 }
 
                 if (FLAGS_SET(m->mount_settings, MOUNT_USRQUOTA_GRACEFUL)) {
-                        r = mount_option_supported(m->type, /* key= */ "usrquota", /* value= */ NULL);
+                        if (!streq_ptr(usrquota_type, m->type)) {
+                                usrquota_supported = mount_option_supported(m->type, /* key= */ "usrquota", /* value= */ NULL);
+                                usrquota_type = m->type;
+                        }
+
+                        r = usrquota_supported;
                         if (r < 0)
                                 log_warning_errno(r, "Failed to determine if '%s' supports 'usrquota', assuming it doesn't: %m", m->type);
                         else if (r == 0)
@@ -4238,9 +4238,13 @@ static int outer_child(
         if (r < 0)
                 return r;
 
-        r = base_filesystem_create(directory, chown_uid, (gid_t) chown_uid);
-        if (r < 0)
-                return r;
+        /* With --ephemeral --read-only the origin tree is used directly rather than a snapshot of it, and we
+         * must not modify it. */
+        if (!arg_ephemeral || !arg_read_only || arg_userns_mode != USER_NAMESPACE_NO) {
+                r = base_filesystem_create(directory, chown_uid, (gid_t) chown_uid);
+                if (r < 0)
+                        return r;
+        }
 
         if (arg_read_only && arg_volatile_mode == VOLATILE_NO &&
             !has_custom_root_mount(arg_custom_mounts, arg_n_custom_mounts)) {
@@ -6112,7 +6116,12 @@ static int run(int argc, char *argv[]) {
                         goto finish;
                 }
 
-                if (arg_ephemeral) {
+                /* An ephemeral snapshot that is mounted read-only can never diverge from its origin, hence
+                 * skip creating it and just use the origin directly, under a shared lock. Except for the
+                 * host's root directory, see above, and if a user namespace is used: if idmapped mounts are
+                 * not available, the ownership of the tree is shifted by chown()ing it, which must not
+                 * happen to the origin. */
+                if (arg_ephemeral && (!arg_read_only || path_equal(arg_directory, "/") || arg_userns_mode != USER_NAMESPACE_NO)) {
                         _cleanup_free_ char *np = NULL;
 
                         r = chase_and_update(&arg_directory, 0);
@@ -6291,7 +6300,9 @@ static int run(int argc, char *argv[]) {
                 if (r < 0)
                         goto finish;
 
-                if (arg_ephemeral)  {
+                /* Same as for directories: an ephemeral copy of an image we only open read-only is
+                 * pointless, unless its ownership might have to be shifted. */
+                if (arg_ephemeral && (!arg_read_only || arg_userns_mode != USER_NAMESPACE_NO)) {
                         _cleanup_free_ char *np = NULL;
 
                         r = tempfn_random(arg_image, "machine.", &np);
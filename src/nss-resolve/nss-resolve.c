@@ -183,6 +183,44 @@ static const sd_json_dispatch_field address_parameters_dispatch_table[] = {
         {}
 };
 
+static int dispatch_addresses(sd_json_variant *addresses, int af, AddressParameters **ret, size_t *ret_n) {
+        _cleanup_free_ AddressParameters *a = NULL;
+        sd_json_variant *entry;
+        size_t n = 0;
+        int r;
+
+        assert(ret);
+        assert(ret_n);
+
+        /* Decodes the address array of a reply once, keeping only entries of the requested family (or both
+         * IP families if AF_UNSPEC is specified), so that we don't have to dispatch the JSON objects again
+         * when filling in the result buffer. */
+
+        a = new(AddressParameters, sd_json_variant_elements(addresses));
+        if (!a)
+                return -ENOMEM;
+
+        JSON_VARIANT_ARRAY_FOREACH(entry, addresses) {
+                AddressParameters q = {};
+
+                r = sd_json_dispatch(entry, address_parameters_dispatch_table, json_dispatch_flags, &q);
+                if (r < 0)
+                        return r;
+
+                if (af == AF_UNSPEC ? !IN_SET(q.family, AF_INET, AF_INET6) : q.family != af)
+                        continue;
+
+                if (q.address_size != FAMILY_ADDRESS_SIZE(q.family))
+                        return -EINVAL;
+
+                a[n++] = q;
+        }
+
+        *ret = TAKE_PTR(a);
+        *ret_n = n;
+        return 0;
+}
+
 static uint64_t query_flag(
                 const char *name,
                 const int value,
@@ -219,7 +257,8 @@ enum nss_status _nss_resolve_gethostbyname4_r(
         _cleanup_(sd_varlink_unrefp) sd_varlink *link = NULL;
         _cleanup_(sd_json_variant_unrefp) sd_json_variant *cparams = NULL;
         _cleanup_(resolve_hostname_reply_destroy) ResolveHostnameReply p = {};
-        sd_json_variant *rparams, *entry;
+        _cleanup_free_ AddressParameters *addresses = NULL;
+        sd_json_variant *rparams;
         int r;
 
         PROTECT_ERRNO;
@@ -267,24 +306,10 @@ enum nss_status _nss_resolve_gethostbyname4_r(
         if (sd_json_variant_is_blank_object(p.addresses))
                 goto not_found;
 
-        size_t n_addresses = 0;
-        JSON_VARIANT_ARRAY_FOREACH(entry, p.addresses) {
-                AddressParameters q = {};
-
-                r = sd_json_dispatch(entry, address_parameters_dispatch_table, json_dispatch_flags, &q);
-                if (r < 0)
-                        goto fail;
-
-                if (!IN_SET(q.family, AF_INET, AF_INET6))
-                        continue;
-
-                if (q.address_size != FAMILY_ADDRESS_SIZE(q.family)) {
-                        r = -EINVAL;
-                        goto fail;
-                }
-
-                n_addresses++;
-        }
+        size_t n_addresses;
+        r = dispatch_addresses(p.addresses, AF_UNSPEC, &addresses, &n_addresses);
+        if (r < 0)
+                goto fail;
 
         const char *canonical = p.name ?: name;
         size_t l = strlen(canonical);
@@ -306,22 +331,13 @@ enum nss_status _nss_resolve_gethostbyname4_r(
         struct gaih_addrtuple *r_tuple = NULL,
                 *r_tuple_first = (struct gaih_addrtuple*) (buffer + idx);
 
-        JSON_VARIANT_ARRAY_FOREACH(entry, p.addresses) {
-                AddressParameters q = {};
-
-                r = sd_json_dispatch(entry, address_parameters_dispatch_table, json_dispatch_flags, &q);
-                if (r < 0)
-                        goto fail;
-
-                if (!IN_SET(q.family, AF_INET, AF_INET6))
-                        continue;
-
+        FOREACH_ARRAY(q, addresses, n_addresses) {
                 r_tuple = (struct gaih_addrtuple*) (buffer + idx);
                 r_tuple->next = (struct gaih_addrtuple*) ((char*) r_tuple + ALIGN(sizeof(struct gaih_addrtuple)));
                 r_tuple->name = r_name;
-                r_tuple->family = q.family;
-                r_tuple->scopeid = ifindex_to_scopeid(q.family, &q.address, q.ifindex);
-                memcpy(r_tuple->addr, &q.address, q.address_size);
+                r_tuple->family = q->family;
+                r_tuple->scopeid = ifindex_to_scopeid(q->family, &q->address, q->ifindex);
+                memcpy(r_tuple->addr, &q->address, q->address_size);
 
                 idx += ALIGN(sizeof(struct gaih_addrtuple));
         }
@@ -379,7 +395,8 @@ enum nss_status _nss_resolve_gethostbyname3_r(
         _cleanup_(sd_varlink_unrefp) sd_varlink *link = NULL;
         _cleanup_(sd_json_variant_unrefp) sd_json_variant *cparams = NULL;
         _cleanup_(resolve_hostname_reply_destroy) ResolveHostnameReply p = {};
-        sd_json_variant *rparams, *entry;
+        _cleanup_free_ AddressParameters *addresses = NULL;
+        sd_json_variant *rparams;
         int r;
 
         PROTECT_ERRNO;
@@ -431,24 +448,10 @@ enum nss_status _nss_resolve_gethostbyname3_r(
         if (sd_json_variant_is_blank_object(p.addresses))
                 goto not_found;
 
-        size_t n_addresses = 0;
-        JSON_VARIANT_ARRAY_FOREACH(entry, p.addresses) {
-                AddressParameters q = {};
-
-                r = sd_json_dispatch(entry, address_parameters_dispatch_table, json_dispatch_flags, &q);
-                if (r < 0)
-                        goto fail;
-
-                if (!IN_SET(q.family, AF_INET, AF_INET6))
-                        continue;
-
-                if (q.address_size != FAMILY_ADDRESS_SIZE(q.family)) {
-                        r = -EINVAL;
-                        goto fail;
-                }
-
-                n_addresses++;
-        }
+        size_t n_addresses;
+        r = dispatch_addresses(p.addresses, af, &addresses, &n_addresses);
+        if (r < 0)
+                goto fail;
 
         const char *canonical = p.name ?: name;
 
@@ -477,27 +480,10 @@ enum nss_status _nss_resolve_gethostbyname3_r(
         /* Third, append addresses */
         char *r_addr = buffer + idx;
 
-        size_t i = 0;
-        JSON_VARIANT_ARRAY_FOREACH(entry, p.addresses) {
-                AddressParameters q = {};
-
-                r = sd_json_dispatch(entry, address_parameters_dispatch_table, json_dispatch_flags, &q);
-                if (r < 0)
-                        goto fail;
-
-                if (q.family != af)
-                        continue;
-
-                if (q.address_size != alen) {
-                        r = -EINVAL;
-                        goto fail;
-                }
-
-                memcpy(r_addr + i*ALIGN(alen), &q.address, alen);
-                i++;
-        }
+        size_t i;
+        for (i = 0; i < n_addresses; i++)
+                memcpy(r_addr + i*ALIGN(alen), &addresses[i].address, alen);
 
-        assert(i == n_addresses);
         idx += n_addresses * ALIGN(alen);
 
         /* Fourth, append address pointer array */
@@ -445,7 +445,7 @@ static int monitor_memory_pressure_contexts_handler(sd_event_source *s, uint64_t
          * update the candidate data (in which case clear_candidates will be NULL). */
         _unused_ _cleanup_(clear_candidate_hashmapp) Manager *clear_candidates = userdata;
         _cleanup_set_free_ Set *targets = NULL;
-        bool in_post_action_delay = false;
+        bool in_post_action_delay = false, candidates_updated = false;
         Manager *m = ASSERT_PTR(userdata);
         usec_t usec_now;
         int r;
@@ -512,14 +512,20 @@ static int monitor_memory_pressure_contexts_handler(sd_event_source *s, uint64_t
                                   LOADAVG_INT_SIDE(t->mem_pressure_limit), LOADAVG_DECIMAL_SIDE(t->mem_pressure_limit),
                                   FORMAT_TIMESPAN(t->mem_pressure_duration_usec, USEC_PER_SEC));
 
-                        r = update_monitored_cgroup_contexts_candidates(
-                                        m->monitored_mem_pressure_cgroup_contexts, &m->monitored_mem_pressure_cgroup_contexts_candidates);
-                        if (r == -ENOMEM)
-                                return log_oom();
-                        if (r < 0)
-                                log_debug_errno(r, "Failed to update monitored memory pressure candidate cgroup contexts, ignoring: %m");
-                        else
-                                clear_candidates = NULL;
+                        /* The candidates cover all monitored cgroups, hence walking the cgroup trees once is
+                         * enough, even if we have to go through several targets because killing failed. */
+                        if (!candidates_updated) {
+                                r = update_monitored_cgroup_contexts_candidates(
+                                                m->monitored_mem_pressure_cgroup_contexts, &m->monitored_mem_pressure_cgroup_contexts_candidates);
+                                if (r == -ENOMEM)
+                                        return log_oom();
+                                if (r < 0)
+                                        log_debug_errno(r, "Failed to update monitored memory pressure candidate cgroup contexts, ignoring: %m");
+                                else {
+                                        clear_candidates = NULL;
+                                        candidates_updated = true;
+                                }
+                        }
 
                         r = oomd_kill_by_pgscan_rate(m->monitored_mem_pressure_cgroup_contexts_candidates,
                                                      /* prefix= */ t->path,
@@ -759,7 +765,8 @@ static int manager_varlink_init(Manager *m, int fd) {
                         "io.systemd.oom.ReportManagedOOMCGroups", process_managed_oom_request,
                         "io.systemd.service.Ping",                varlink_method_ping,
                         "io.systemd.service.SetLogLevel",         varlink_method_set_log_level,
-                        "io.systemd.service.GetEnvironment",      varlink_method_get_environment);
+                        "io.systemd.service.GetEnvironment",      varlink_method_get_environment,
+                        "io.systemd.service.GetMemoryStatistics", varlink_method_get_memory_statistics);
         if (r < 0)
                 return log_error_errno(r, "Failed to register varlink methods: %m");
 
@@ -401,7 +401,7 @@ int oomd_kill_by_swap_usage(Hashmap *h, uint64_t threshold_usage, bool dry_run,
         return ret;
 }
 
-int oomd_cgroup_context_acquire(const char *path, OomdCGroupContext **ret) {
+static int cgroup_context_acquire(const char *path, bool full, OomdCGroupContext **ret) {
         _cleanup_(oomd_cgroup_context_freep) OomdCGroupContext *ctx = NULL;
         _cleanup_free_ char *p = NULL, *val = NULL;
         bool is_root;
@@ -434,21 +434,25 @@ int oomd_cgroup_context_acquire(const char *path, OomdCGroupContext **ret) {
                 if (r < 0)
                         return log_debug_errno(r, "Error getting memory.current from %s: %m", path);
 
-                r = cg_get_attribute_as_uint64(SYSTEMD_CGROUP_CONTROLLER, path, "memory.min", &ctx->memory_min);
-                if (r < 0)
-                        return log_debug_errno(r, "Error getting memory.min from %s: %m", path);
-
-                r = cg_get_attribute_as_uint64(SYSTEMD_CGROUP_CONTROLLER, path, "memory.low", &ctx->memory_low);
-                if (r < 0)
-                        return log_debug_errno(r, "Error getting memory.low from %s: %m", path);
-
-                r = cg_get_attribute_as_uint64(SYSTEMD_CGROUP_CONTROLLER, path, "memory.swap.current", &ctx->swap_usage);
-                if (r == -ENODATA)
-                        /* The kernel can be compiled without support for memory.swap.* files,
-                         * or it can be disabled with boot param 'swapaccount=0' */
-                        log_once(LOG_WARNING, "No kernel support for memory.swap.current from %s (try boot param swapaccount=1), ignoring.", path);
-                else if (r < 0)
-                        return log_debug_errno(r, "Error getting memory.swap.current from %s: %m", path);
+                /* The attributes below are not needed for detecting memory pressure, only for selecting kill
+                 * candidates and for dumping the state. Skip them when refreshing a monitored cgroup. */
+                if (full) {
+                        r = cg_get_attribute_as_uint64(SYSTEMD_CGROUP_CONTROLLER, path, "memory.min", &ctx->memory_min);
+                        if (r < 0)
+                                return log_debug_errno(r, "Error getting memory.min from %s: %m", path);
+
+                        r = cg_get_attribute_as_uint64(SYSTEMD_CGROUP_CONTROLLER, path, "memory.low", &ctx->memory_low);
+                        if (r < 0)
+                                return log_debug_errno(r, "Error getting memory.low from %s: %m", path);
+
+                        r = cg_get_attribute_as_uint64(SYSTEMD_CGROUP_CONTROLLER, path, "memory.swap.current", &ctx->swap_usage);
+                        if (r == -ENODATA)
+                                /* The kernel can be compiled without support for memory.swap.* files,
+                                 * or it can be disabled with boot param 'swapaccount=0' */
+                                log_once(LOG_WARNING, "No kernel support for memory.swap.current from %s (try boot param swapaccount=1), ignoring.", path);
+                        else if (r < 0)
+                                return log_debug_errno(r, "Error getting memory.swap.current from %s: %m", path);
+                }
 
                 r = cg_get_keyed_attribute(SYSTEMD_CGROUP_CONTROLLER, path, "memory.stat", STRV_MAKE("pgscan"), &val);
                 if (r < 0)
@@ -467,6 +471,10 @@ int oomd_cgroup_context_acquire(const char *path, OomdCGroupContext **ret) {
         return 0;
 }
 
+int oomd_cgroup_context_acquire(const char *path, OomdCGroupContext **ret) {
+        return cgroup_context_acquire(path, /* full = */ true, ret);
+}
+
 int oomd_system_context_acquire(const char *proc_meminfo_path, OomdSystemContext *ret) {
         _cleanup_fclose_ FILE *f = NULL;
         unsigned field_filled = 0;
@@ -553,14 +561,20 @@ int oomd_insert_cgroup_context(Hashmap *old_h, Hashmap *new_h, const char *path)
 
         path = empty_to_root(path);
 
-        r = oomd_cgroup_context_acquire(path, &curr_ctx);
+        /* When refreshing an already known cgroup, only re-read what is needed to track memory pressure and
+         * reclaim activity, and carry over the rest from the previous context. */
+        old_ctx = hashmap_get(old_h, path);
+
+        r = cgroup_context_acquire(path, /* full = */ !old_ctx, &curr_ctx);
         if (r < 0)
                 return log_debug_errno(r, "Failed to get OomdCGroupContext for %s: %m", path);
 
         assert_se(streq(path, curr_ctx->path));
 
-        old_ctx = hashmap_get(old_h, path);
         if (old_ctx) {
+                curr_ctx->memory_min = old_ctx->memory_min;
+                curr_ctx->memory_low = old_ctx->memory_low;
+                curr_ctx->swap_usage = old_ctx->swap_usage;
                 curr_ctx->last_pgscan = old_ctx->pgscan;
                 curr_ctx->mem_pressure_limit = old_ctx->mem_pressure_limit;
                 curr_ctx->mem_pressure_limit_hit_start = old_ctx->mem_pressure_limit_hit_start;
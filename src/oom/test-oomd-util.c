@@ -140,6 +140,7 @@ static void test_oomd_cgroup_context_acquire_and_insert(void) {
         c1->mem_pressure_limit_hit_start = 42;
         c1->mem_pressure_duration_usec = 1234;
         c1->last_had_mem_reclaim = 888;
+        c1->memory_min = 4242;
         assert_se(h2 = hashmap_new(&oomd_cgroup_ctx_hash_ops));
         assert_se(oomd_insert_cgroup_context(h1, h2, cgroup) == 0);
         c1 = hashmap_get(h1, cgroup);
@@ -152,6 +153,7 @@ static void test_oomd_cgroup_context_acquire_and_insert(void) {
         assert_se(c2->mem_pressure_limit_hit_start == 42);
         assert_se(c2->mem_pressure_duration_usec == 1234);
         assert_se(c2->last_had_mem_reclaim == 888); /* assumes the live pgscan is less than UINT64_MAX */
+        assert_se(c2->memory_min == 4242);
 }
 
 static void test_oomd_update_cgroup_contexts_between_hashmaps(void) {
@@ -4437,7 +4437,7 @@ static int partition_target_sync(Context *context, Partition *p, PartitionTarget
 
         assert_se((whole_fd = fdisk_get_devfd(context->fdisk_context)) >= 0);
 
-        log_info("Syncing future partition %"PRIu64" contents to disk.", p->partno);
+        log_info("Writing out future partition %"PRIu64" contents.", p->partno);
 
         if (t->decrypted && fsync(t->decrypted->fd) < 0)
                 return log_error_errno(errno, "Failed to sync changes to '%s': %m", t->decrypted->volume);
@@ -4463,12 +4463,12 @@ static int partition_target_sync(Context *context, Partition *p, PartitionTarget
                                                "Partition %" PRIu64 "'s contents (%s) don't fit in the partition (%s).",
                                                p->partno, FORMAT_BYTES(st.st_size), FORMAT_BYTES(p->new_size));
 
-                r = copy_bytes(t->fd, whole_fd, UINT64_MAX, COPY_REFLINK|COPY_HOLES|COPY_FSYNC);
+                /* Don't fsync() the whole image here, but only once before the partition table is written
+                 * (see context_write_partition_table()): that way writeback of this partition can proceed
+                 * in the background while the next partitions are being populated. */
+                r = copy_bytes(t->fd, whole_fd, UINT64_MAX, COPY_REFLINK|COPY_HOLES);
                 if (r < 0)
                         return log_error_errno(r, "Failed to copy bytes to partition: %m");
-        } else {
-                if (fsync(t->whole_fd) < 0)
-                        return log_error_errno(errno, "Failed to sync changes: %m");
         }
 
         return 0;
@@ -6772,6 +6772,11 @@ static int context_write_partition_table(Context *context) {
         if (r < 0)
                 return r;
 
+        /* Make sure all partition contents hit the disk before the partition table referencing them does.
+         * partition_target_sync() deliberately leaves this to us, so that we sync only once. */
+        if (fsync(fdisk_get_devfd(context->fdisk_context)) < 0)
+                return log_error_errno(errno, "Failed to sync partition contents to disk: %m");
+
         log_info("Writing new partition table.");
 
         r = fdisk_write_disklabel(context->fdisk_context);
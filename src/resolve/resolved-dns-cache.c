@@ -5,7 +5,12 @@
 #include "af-list.h"
 #include "alloc-util.h"
 #include "dns-domain.h"
+#include "extract-word.h"
+#include "fileio.h"
 #include "format-ifname.h"
+#include "hexdecoct.h"
+#include "in-addr-util.h"
+#include "parse-util.h"
 #include "resolved-dns-answer.h"
 #include "resolved-dns-cache.h"
 #include "resolved-dns-packet.h"
@@ -27,6 +32,12 @@
 
 #define CACHEABLE_QUERY_FLAGS (SD_RESOLVED_AUTHENTICATED|SD_RESOLVED_CONFIDENTIAL)
 
+/* Positive entries that are looked up during the last tenth of their TTL are refreshed in the background, so
+ * that popular names do not expire and block the next lookup on a round trip to the server. Entries with
+ * short TTLs are left alone, the server evidently wants us to ask again soon. */
+#define CACHE_PREFETCH_TTL_MIN_USEC (10 * USEC_PER_SEC)
+#define CACHE_PREFETCH_FRACTION 10U
+
 typedef enum DnsCacheItemType DnsCacheItemType;
 typedef struct DnsCacheItem DnsCacheItem;
 
@@ -47,6 +58,7 @@ struct DnsCacheItem {
 
         usec_t until;            /* If StaleRetentionSec is greater than zero, until is set to a duration of StaleRetentionSec from the time of TTL expiry. If StaleRetentionSec is zero, both until and until_valid will be set to ttl. */
         usec_t until_valid;      /* The key is for storing the time when the TTL set to expire. */
+        usec_t added;            /* When the entry was last added or refreshed, for positive entries */
         uint64_t query_flags;    /* SD_RESOLVED_AUTHENTICATED and/or SD_RESOLVED_CONFIDENTIAL */
         DnssecResult dnssec_result;
 
@@ -185,6 +197,7 @@ static void dns_cache_make_space(DnsCache *c, unsigned add) {
         for (;;) {
                 _cleanup_(dns_resource_key_unrefp) DnsResourceKey *key = NULL;
                 DnsCacheItem *i;
+                unsigned n;
 
                 if (prioq_isempty(c->by_expiry))
                         break;
@@ -198,7 +211,11 @@ static void dns_cache_make_space(DnsCache *c, unsigned add) {
                 /* Take an extra reference to the key so that it
                  * doesn't go away in the middle of the remove call */
                 key = dns_resource_key_ref(i->key);
+                n = prioq_size(c->by_expiry);
                 dns_cache_remove_by_key(c, key);
+
+                /* All items of the key are removed, count each of them. */
+                c->n_evicted += n - prioq_size(c->by_expiry);
         }
 }
 
@@ -416,6 +433,7 @@ static void dns_cache_item_update_positive(
 
         i->until_valid = calculate_until_valid(rr, min_ttl, UINT32_MAX, timestamp, false);
         i->until = calculate_until(i->until_valid, stale_retention_usec);
+        i->added = timestamp;
         i->query_flags = query_flags & CACHEABLE_QUERY_FLAGS;
         i->shared_owner = shared_owner;
         i->dnssec_result = dnssec_result;
@@ -521,6 +539,7 @@ static int dns_cache_put_positive(
                 .full_packet = dns_packet_ref(full_packet),
                 .until = calculate_until(until_valid, stale_retention_usec),
                 .until_valid = until_valid,
+                .added = timestamp,
                 .query_flags = query_flags & CACHEABLE_QUERY_FLAGS,
                 .shared_owner = shared_owner,
                 .dnssec_result = dnssec_result,
@@ -1282,6 +1301,37 @@ miss:
         return 0;
 }
 
+bool dns_cache_needs_prefetch(DnsCache *c, DnsResourceKey *key, usec_t t) {
+        DnsCacheItem *first;
+
+        assert(c);
+        assert(key);
+
+        if (key->type == DNS_TYPE_ANY || key->class == DNS_CLASS_ANY)
+                return false;
+
+        first = dns_cache_get_by_key_follow_cname_dname_nsec(c, key);
+        LIST_FOREACH(by_key, j, first) {
+                usec_t ttl;
+
+                if (j->type != DNS_CACHE_POSITIVE || j->shared_owner)
+                        continue;
+
+                /* Already expired? Then this is a stale answer, and the caller refreshes it anyway. */
+                if (j->until_valid <= t || j->added >= j->until_valid)
+                        continue;
+
+                ttl = j->until_valid - j->added;
+                if (ttl < CACHE_PREFETCH_TTL_MIN_USEC)
+                        continue;
+
+                if (j->until_valid - t <= ttl / CACHE_PREFETCH_FRACTION)
+                        return true;
+        }
+
+        return false;
+}
+
 int dns_cache_check_conflicts(DnsCache *cache, DnsResourceRecord *rr, int owner_family, const union in_addr_union *owner_address) {
         DnsCacheItem *first;
         bool same_owner = true;
@@ -1502,6 +1552,189 @@ int dns_cache_dump_to_json(DnsCache *cache, sd_json_variant **ret) {
         return 0;
 }
 
+int dns_cache_serialize(DnsCache *cache, FILE *f) {
+        DnsCacheItem *i;
+        usec_t t;
+        int r;
+
+        assert(cache);
+        assert(f);
+
+        t = now(CLOCK_BOOTTIME);
+
+        /* Writes out one line per positive unicast cache entry. Negative entries are cheap to acquire
+         * again, and the full answers of primary lookups (with NSEC and friends) are not carried over, hence
+         * restored entries behave like the ones we add as side-effect of other lookups. The timestamps are
+         * in CLOCK_BOOTTIME, hence can be used as is by the next instance, as long as the machine was not
+         * rebooted in between, which is given since we store this in /run/. */
+
+        HASHMAP_FOREACH(i, cache->by_key)
+                LIST_FOREACH(by_key, j, i) {
+                        _cleanup_free_ char *b = NULL;
+                        const char *dnssec;
+
+                        if (j->type != DNS_CACHE_POSITIVE || !j->rr || j->shared_owner)
+                                continue;
+                        if (j->until <= t)
+                                continue;
+                        if (!IN_SET(j->owner_family, AF_INET, AF_INET6))
+                                continue;
+
+                        dnssec = dnssec_result_to_string(j->dnssec_result);
+                        if (!dnssec)
+                                continue;
+
+                        r = dns_resource_record_to_wire_format(j->rr, /* canonical= */ false);
+                        if (r < 0)
+                                return r;
+
+                        if (base64mem(j->rr->wire_format, j->rr->wire_format_size, &b) < 0)
+                                return -ENOMEM;
+
+                        fprintf(f, USEC_FMT " " USEC_FMT " %" PRIu64 " %s %i %s %s\n",
+                                j->until_valid,
+                                j->until,
+                                j->query_flags,
+                                dnssec,
+                                j->ifindex,
+                                IN_ADDR_TO_STRING(j->owner_family, &j->owner_address),
+                                b);
+                }
+
+        return 0;
+}
+
+static int dns_cache_deserialize_item(DnsCache *c, const char *line, usec_t timestamp) {
+        _cleanup_free_ char *until_valid_str = NULL, *until_str = NULL, *flags_str = NULL, *dnssec_str = NULL,
+                *ifindex_str = NULL, *owner_str = NULL, *rr_str = NULL;
+        _cleanup_(dns_resource_record_unrefp) DnsResourceRecord *rr = NULL;
+        _cleanup_free_ void *data = NULL;
+        union in_addr_union owner_address;
+        usec_t until_valid, until;
+        uint64_t query_flags;
+        DnssecResult dnssec_result;
+        int ifindex, owner_family, r;
+        size_t size;
+
+        assert(c);
+        assert(line);
+
+        r = extract_many_words(&line, NULL, 0,
+                               &until_valid_str, &until_str, &flags_str, &dnssec_str,
+                               &ifindex_str, &owner_str, &rr_str);
+        if (r < 0)
+                return r;
+        if (r != 7 || !isempty(line))
+                return -EBADMSG;
+
+        r = safe_atou64(until_valid_str, &until_valid);
+        if (r < 0)
+                return r;
+
+        r = safe_atou64(until_str, &until);
+        if (r < 0)
+                return r;
+        if (until_valid > until)
+                return -EBADMSG;
+
+        /* Drop entries that expired while we were not running. */
+        if (until <= timestamp)
+                return 0;
+
+        r = safe_atou64(flags_str, &query_flags);
+        if (r < 0)
+                return r;
+
+        dnssec_result = dnssec_result_from_string(dnssec_str);
+        if (dnssec_result < 0)
+                return dnssec_result;
+
+        r = safe_atoi(ifindex_str, &ifindex);
+        if (r < 0)
+                return r;
+        if (ifindex < 0)
+                return -EINVAL;
+
+        r = in_addr_from_string_auto(owner_str, &owner_family, &owner_address);
+        if (r < 0)
+                return r;
+
+        r = unbase64mem(rr_str, &data, &size);
+        if (r < 0)
+                return r;
+
+        r = dns_resource_record_new_from_raw(&rr, data, size);
+        if (r < 0)
+                return r;
+
+        if (dns_class_is_pseudo(rr->key->class) || dns_type_is_pseudo(rr->key->type))
+                return -EBADMSG;
+
+        if (dns_cache_get(c, rr))
+                return 0;
+
+        r = dns_cache_init(c);
+        if (r < 0)
+                return r;
+
+        dns_cache_make_space(c, 1);
+
+        _cleanup_(dns_cache_item_freep) DnsCacheItem *i = new(DnsCacheItem, 1);
+        if (!i)
+                return -ENOMEM;
+
+        *i = (DnsCacheItem) {
+                .type = DNS_CACHE_POSITIVE,
+                .key = dns_resource_key_ref(rr->key),
+                .rr = dns_resource_record_ref(rr),
+                .until = until,
+                .until_valid = until_valid,
+                .added = timestamp,
+                .query_flags = query_flags & CACHEABLE_QUERY_FLAGS,
+                .dnssec_result = dnssec_result,
+                .ifindex = ifindex,
+                .owner_family = owner_family,
+                .owner_address = owner_address,
+                .prioq_idx = PRIOQ_IDX_NULL,
+        };
+
+        r = dns_cache_link_item(c, i);
+        if (r < 0)
+                return r;
+
+        TAKE_PTR(i);
+        return 1;
+}
+
+int dns_cache_deserialize(DnsCache *cache, FILE *f) {
+        unsigned n = 0;
+        usec_t t;
+        int r;
+
+        assert(cache);
+        assert(f);
+
+        t = now(CLOCK_BOOTTIME);
+
+        for (;;) {
+                _cleanup_free_ char *line = NULL;
+
+                r = read_line(f, LONG_LINE_MAX, &line);
+                if (r < 0)
+                        return r;
+                if (r == 0)
+                        break;
+
+                r = dns_cache_deserialize_item(cache, line, t);
+                if (r < 0)
+                        log_debug_errno(r, "Failed to deserialize cache entry, ignoring: %m");
+                else if (r > 0)
+                        n++;
+        }
+
+        return (int) n;
+}
+
 bool dns_cache_is_empty(DnsCache *cache) {
         if (!cache)
                 return true;
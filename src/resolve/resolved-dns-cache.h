@@ -13,6 +13,7 @@ typedef struct DnsCache {
         Prioq *by_expiry;
         unsigned n_hit;
         unsigned n_miss;
+        unsigned n_evicted;
 } DnsCache;
 
 #include "resolved-dns-answer.h"
@@ -48,11 +49,16 @@ int dns_cache_lookup(
                 uint64_t *ret_query_flags,
                 DnssecResult *ret_dnssec_result);
 
+bool dns_cache_needs_prefetch(DnsCache *c, DnsResourceKey *key, usec_t t);
+
 int dns_cache_check_conflicts(DnsCache *cache, DnsResourceRecord *rr, int owner_family, const union in_addr_union *owner_address);
 
 void dns_cache_dump(DnsCache *cache, FILE *f);
 int dns_cache_dump_to_json(DnsCache *cache, sd_json_variant **ret);
 
+int dns_cache_serialize(DnsCache *cache, FILE *f);
+int dns_cache_deserialize(DnsCache *cache, FILE *f);
+
 bool dns_cache_is_empty(DnsCache *cache);
 
 unsigned dns_cache_size(DnsCache *cache);
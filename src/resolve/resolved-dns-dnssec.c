@@ -11,6 +11,8 @@
 #include "openssl-util.h"
 #include "resolved-dns-dnssec.h"
 #include "resolved-dns-packet.h"
+#include "set.h"
+#include "siphash24.h"
 #include "sort-util.h"
 #include "string-table.h"
 
@@ -70,6 +72,129 @@ uint16_t dnssec_keytag(DnsResourceRecord *dnskey, bool mask_revoke) {
 
 #if HAVE_OPENSSL_OR_GCRYPT
 
+/* Verifying a signature is by far the most expensive part of validation, and the same RRset is frequently
+ * validated again with the same RRSIG and DNSKEY, for example by several transactions at once or when it is
+ * acquired again after the cache was flushed. Hence remember the signatures that were found valid. The
+ * entries carry the complete signed data, signature and key, and are compared byte by byte, so that a hash
+ * collision can never result in a signature being considered valid. Since remote zones control the size of the
+ * RRsets, the table is bounded both in entries and in bytes, and is emptied when either limit is reached.
+ * RRsets that alone take a sizable part of the budget are not remembered at all. */
+#define VERIFIED_SIGNATURES_MAX 1024U
+#define VERIFIED_SIGNATURES_SIZE_MAX U64_MB
+#define VERIFIED_SIGNATURE_SIZE_MAX (VERIFIED_SIGNATURES_SIZE_MAX / 16)
+
+typedef struct VerifiedSignature {
+        size_t sig_data_size;
+        size_t signature_size;
+        size_t key_size;
+        uint8_t algorithm;
+        uint8_t data[]; /* signed data, followed by the signature, followed by the key */
+} VerifiedSignature;
+
+static Set *verified_signatures = NULL;
+static size_t verified_signatures_size = 0;
+
+static size_t verified_signature_data_size(const VerifiedSignature *v) {
+        return v->sig_data_size + v->signature_size + v->key_size;
+}
+
+static void verified_signature_hash_func(const VerifiedSignature *v, struct siphash *state) {
+        siphash24_compress_typesafe(v->sig_data_size, state);
+        siphash24_compress_typesafe(v->signature_size, state);
+        siphash24_compress_typesafe(v->key_size, state);
+        siphash24_compress_typesafe(v->algorithm, state);
+        siphash24_compress(v->data, verified_signature_data_size(v), state);
+}
+
+static int verified_signature_compare_func(const VerifiedSignature *a, const VerifiedSignature *b) {
+        int r;
+
+        r = CMP(a->sig_data_size, b->sig_data_size);
+        if (r != 0)
+                return r;
+
+        r = CMP(a->signature_size, b->signature_size);
+        if (r != 0)
+                return r;
+
+        r = CMP(a->key_size, b->key_size);
+        if (r != 0)
+                return r;
+
+        r = CMP(a->algorithm, b->algorithm);
+        if (r != 0)
+                return r;
+
+        return memcmp(a->data, b->data, verified_signature_data_size(a));
+}
+
+DEFINE_PRIVATE_HASH_OPS_WITH_KEY_DESTRUCTOR(
+                verified_signature_hash_ops,
+                VerifiedSignature,
+                verified_signature_hash_func,
+                verified_signature_compare_func,
+                free);
+
+static VerifiedSignature* verified_signature_new(
+                DnsResourceRecord *rrsig,
+                DnsResourceRecord *dnskey,
+                const char *sig_data,
+                size_t sig_size) {
+
+        VerifiedSignature *v;
+        uint8_t *p;
+
+        assert(rrsig);
+        assert(dnskey);
+
+        v = malloc(offsetof(VerifiedSignature, data) + sig_size + rrsig->rrsig.signature_size + dnskey->dnskey.key_size);
+        if (!v)
+                return NULL;
+
+        *v = (VerifiedSignature) {
+                .sig_data_size = sig_size,
+                .signature_size = rrsig->rrsig.signature_size,
+                .key_size = dnskey->dnskey.key_size,
+                .algorithm = dnskey->dnskey.algorithm,
+        };
+
+        p = mempcpy_safe(v->data, sig_data, sig_size);
+        p = mempcpy_safe(p, rrsig->rrsig.signature, rrsig->rrsig.signature_size);
+        memcpy_safe(p, dnskey->dnskey.key, dnskey->dnskey.key_size);
+
+        return v;
+}
+
+static void verified_signatures_add(VerifiedSignature *v) {
+        size_t size;
+        int r;
+
+        assert(v);
+
+        size = offsetof(VerifiedSignature, data) + verified_signature_data_size(v);
+        if (size > VERIFIED_SIGNATURE_SIZE_MAX) {
+                free(v);
+                return;
+        }
+
+        if (set_size(verified_signatures) >= VERIFIED_SIGNATURES_MAX ||
+            verified_signatures_size + size > VERIFIED_SIGNATURES_SIZE_MAX) {
+                set_clear(verified_signatures);
+                verified_signatures_size = 0;
+        }
+
+        r = set_ensure_consume(&verified_signatures, &verified_signature_hash_ops, v);
+        if (r < 0)
+                log_debug_errno(r, "Failed to remember verified signature, ignoring: %m");
+        if (r > 0)
+                verified_signatures_size += size;
+}
+
+void dnssec_flush_verified_signatures(void) {
+        verified_signatures = set_free(verified_signatures);
+        verified_signatures_size = 0;
+}
+
 static int rr_compare(DnsResourceRecord * const *a, DnsResourceRecord * const *b) {
         const DnsResourceRecord *x = *a, *y = *b;
         size_t m;
@@ -982,6 +1107,7 @@ int dnssec_verify_rrset(
 
         DnsResourceRecord **list, *rr;
         const char *source, *name;
+        _cleanup_free_ VerifiedSignature *v = NULL;
         _cleanup_free_ char *sig_data = NULL;
         size_t sig_size = 0; /* avoid false maybe-uninitialized warning */
         size_t n = 0;
@@ -1093,13 +1219,23 @@ int dnssec_verify_rrset(
         if (r < 0)
                 return r;
 
-        r = dnssec_rrset_verify_sig(rrsig, dnskey, sig_data, sig_size);
-        if (r == -EOPNOTSUPP) {
-                *result = DNSSEC_UNSUPPORTED_ALGORITHM;
-                return 0;
+        v = verified_signature_new(rrsig, dnskey, sig_data, sig_size);
+        if (!v)
+                return -ENOMEM;
+
+        if (set_contains(verified_signatures, v))
+                r = 1;
+        else {
+                r = dnssec_rrset_verify_sig(rrsig, dnskey, sig_data, sig_size);
+                if (r == -EOPNOTSUPP) {
+                        *result = DNSSEC_UNSUPPORTED_ALGORITHM;
+                        return 0;
+                }
+                if (r < 0)
+                        return r;
+                if (r > 0)
+                        verified_signatures_add(TAKE_PTR(v));
         }
-        if (r < 0)
-                return r;
 
         /* Now, fix the ttl, expiry, and remember the synthesizing source and the signer */
         if (r > 0)
@@ -2503,6 +2639,9 @@ int dnssec_test_positive_wildcard(
 
 #else
 
+void dnssec_flush_verified_signatures(void) {
+}
+
 int dnssec_verify_rrset(
                 DnsAnswer *a,
                 const DnsResourceKey *key,
@@ -209,17 +209,15 @@ DnsPacket *dns_packet_ref(DnsPacket *p) {
 }
 
 static void dns_packet_free(DnsPacket *p) {
-        char *s;
-
         assert(p);
 
         dns_question_unref(p->question);
         dns_answer_unref(p->answer);
         dns_resource_record_unref(p->opt);
 
-        while ((s = hashmap_steal_first_key(p->names)))
-                free(s);
         hashmap_free(p->names);
+        free_many_charp(p->names_storage, p->n_names_storage);
+        free(p->names_storage);
 
         free(p->_data);
 
@@ -408,7 +406,7 @@ static int dns_packet_extend(DnsPacket *p, size_t add, void **ret, size_t *start
 }
 
 void dns_packet_truncate(DnsPacket *p, size_t sz) {
-        char *s;
+        const char *s;
         void *n;
 
         assert(p);
@@ -416,13 +414,13 @@ void dns_packet_truncate(DnsPacket *p, size_t sz) {
         if (p->size <= sz)
                 return;
 
+        /* The names themselves are owned by p->names_storage, and are released together with the packet. */
         HASHMAP_FOREACH_KEY(n, s, p->names) {
 
                 if (PTR_TO_SIZE(n) < sz)
                         continue;
 
                 hashmap_remove(p->names, s);
-                free(s);
         }
 
         p->size = sz;
@@ -557,7 +555,8 @@ int dns_packet_append_name(
                 bool canonical_candidate,
                 size_t *start) {
 
-        _cleanup_free_ char **added_entries = NULL; /* doesn't own the strings! this is just regular pointer array, not a NULL-terminated strv! */
+        const char *added_entries[DNS_N_LABELS_MAX], *original = name;
+        _cleanup_free_ char *copy = NULL;
         size_t n_added_entries = 0, saved_size;
         int r;
 
@@ -603,33 +602,43 @@ int dns_packet_append_name(
                         goto fail;
 
                 if (allow_compression) {
-                        _cleanup_free_ char *s = NULL;
+                        const char *s;
 
-                        if (!GREEDY_REALLOC(added_entries, n_added_entries + 1)) {
-                                r = -ENOMEM;
-                                goto fail;
-                        }
+                        /* All suffixes of the name we add to the compression table point into a single
+                         * copy of it, which is owned by the packet. */
+                        if (!copy) {
+                                if (!GREEDY_REALLOC(p->names_storage, p->n_names_storage + 1)) {
+                                        r = -ENOMEM;
+                                        goto fail;
+                                }
 
-                        s = strdup(z);
-                        if (!s) {
-                                r = -ENOMEM;
-                                goto fail;
+                                copy = strdup(original);
+                                if (!copy) {
+                                        r = -ENOMEM;
+                                        goto fail;
+                                }
                         }
 
+                        s = copy + (z - original);
+
                         r = hashmap_ensure_put(&p->names, &dns_name_hash_ops, s, SIZE_TO_PTR(n));
                         if (r < 0)
                                 goto fail;
 
-                        /* Keep track of the entries we just added (note that the string is owned by the hashtable, not this array!) */
-                        added_entries[n_added_entries++] = TAKE_PTR(s);
+                        /* Keep track of the entries we just added */
+                        assert(n_added_entries < ELEMENTSOF(added_entries));
+                        added_entries[n_added_entries++] = s;
                 }
         }
 
         r = dns_packet_append_uint8(p, 0, NULL);
         if (r < 0)
-                return r;
+                goto fail;
 
 done:
+        if (copy)
+                p->names_storage[p->n_names_storage++] = TAKE_PTR(copy);
+
         if (start)
                 *start = saved_size;
 
@@ -637,10 +646,8 @@ done:
 
 fail:
         /* Remove all label compression names we added again */
-        FOREACH_ARRAY(s, added_entries, n_added_entries) {
+        FOREACH_ARRAY(s, added_entries, n_added_entries)
                 hashmap_remove(p->names, *s);
-                free(*s);
-        }
 
         dns_packet_truncate(p, saved_size);
         return r;
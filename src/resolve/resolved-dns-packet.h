@@ -63,7 +63,9 @@ struct DnsPacket {
         DnsProtocol protocol;
         size_t size, allocated, rindex, max_size, fragsize;
         void *_data; /* don't access directly, use DNS_PACKET_DATA()! */
-        Hashmap *names; /* For name compression */
+        Hashmap *names; /* For name compression, the keys point into names_storage */
+        char **names_storage;
+        size_t n_names_storage;
         size_t opt_start, opt_size;
 
         /* Parsed data */
@@ -9,6 +9,8 @@
 #include "hexdecoct.h"
 #include "json-util.h"
 #include "memory-util.h"
+#include "mempool.h"
+#include "process-util.h"
 #include "resolved-dns-dnssec.h"
 #include "resolved-dns-packet.h"
 #include "resolved-dns-rr.h"
@@ -387,15 +389,22 @@ bool dns_resource_key_reduce(DnsResourceKey **a, DnsResourceKey **b) {
         return true;
 }
 
+/* Resource records are allocated and released for every packet we parse and every cache entry we
+ * add or drop, hence let's keep them in a memory pool, the same way hashmap headers are. */
+DEFINE_MEMPOOL(dns_resource_record_pool, DnsResourceRecord, 64);
+
 DnsResourceRecord* dns_resource_record_new(DnsResourceKey *key) {
         DnsResourceRecord *rr;
 
-        rr = new(DnsResourceRecord, 1);
+        bool use_pool = mempool_enabled && mempool_enabled();  /* mempool_enabled is a weak symbol */
+
+        rr = use_pool ? mempool_alloc_tile(&dns_resource_record_pool) : new(DnsResourceRecord, 1);
         if (!rr)
                 return NULL;
 
         *rr = (DnsResourceRecord) {
                 .n_ref = 1,
+                .from_pool = use_pool,
                 .key = dns_resource_key_ref(key),
                 .expiry = USEC_INFINITY,
                 .n_skip_labels_signer = UINT8_MAX,
@@ -520,9 +529,24 @@ static DnsResourceRecord* dns_resource_record_free(DnsResourceRecord *rr) {
         }
 
         free(rr->to_string);
+
+        if (rr->from_pool) {
+                /* Ensure that the object didn't get migrated between threads. */
+                assert_se(is_main_thread());
+                return mempool_free_tile(&dns_resource_record_pool, rr);
+        }
+
         return mfree(rr);
 }
 
+void dns_resource_record_trim_pool(void) {
+        /* The pool is only allocated from and released into by the main thread */
+        if (!is_main_thread())
+                return;
+
+        mempool_trim(&dns_resource_record_pool);
+}
+
 DEFINE_TRIVIAL_REF_UNREF_FUNC(DnsResourceRecord, dns_resource_record, dns_resource_record_free);
 
 int dns_resource_record_new_reverse(DnsResourceRecord **ret, int family, const union in_addr_union *address, const char *hostname) {
@@ -1146,6 +1146,10 @@ DnsTransaction *dns_scope_find_transaction(
         first = hashmap_get(scope->transactions_by_key, key);
         LIST_FOREACH(transactions_by_key, t, first) {
 
+                /* Background refreshes are not shared, lookups are answered from the cache meanwhile. */
+                if (t->prefetch)
+                        continue;
+
                 /* These four flags must match exactly: we cannot use a validated response for a
                  * non-validating client, and we cannot use a non-validated response for a validating
                  * client. Similar, if the sources don't match things aren't usable either. */
@@ -21,6 +21,9 @@
 /* On the extra stubs, use a more conservative choice */
 #define ADVERTISE_EXTRA_DATAGRAM_SIZE_MAX DNS_PACKET_UNICAST_SIZE_LARGE_MAX
 
+/* How many UDP queries to read from a stub socket per event loop iteration */
+#define STUB_UDP_PACKETS_PER_WAKEUP 16U
+
 static int manager_dns_stub_fd_extra(Manager *m, DnsStubListenerExtra *l, int type);
 static int manager_dns_stub_fd(Manager *m, int family, const union in_addr_union *listen_address, int type);
 
@@ -1038,19 +1041,26 @@ static void dns_stub_process_query(Manager *m, DnsStubListenerExtra *l, DnsStrea
 }
 
 static int on_dns_stub_packet_internal(sd_event_source *s, int fd, uint32_t revents, Manager *m, DnsStubListenerExtra *l) {
-        _cleanup_(dns_packet_unrefp) DnsPacket *p = NULL;
         int r;
 
-        r = manager_recv(m, fd, DNS_PROTOCOL_DNS, &p);
-        if (r <= 0)
-                return r;
+        /* Under load, process a couple of queued datagrams per wakeup instead of going back to the event loop
+         * for each of them. The number is bounded, so that other event sources still get their turn. */
+        for (unsigned n = 0; n < STUB_UDP_PACKETS_PER_WAKEUP; n++) {
+                _cleanup_(dns_packet_unrefp) DnsPacket *p = NULL;
 
-        if (dns_packet_validate_query(p) > 0) {
-                log_debug("Got DNS stub UDP query packet for id %u", DNS_PACKET_ID(p));
+                r = manager_recv(m, fd, DNS_PROTOCOL_DNS, &p);
+                if (r == 0 || ERRNO_IS_NEG_TRANSIENT(r))
+                        break;
+                if (r < 0)
+                        return r;
 
-                dns_stub_process_query(m, l, NULL, p);
-        } else
-                log_debug("Invalid DNS stub UDP packet, ignoring.");
+                if (dns_packet_validate_query(p) > 0) {
+                        log_debug("Got DNS stub UDP query packet for id %u", DNS_PACKET_ID(p));
+
+                        dns_stub_process_query(m, l, NULL, p);
+                } else
+                        log_debug("Invalid DNS stub UDP packet, ignoring.");
+        }
 
         return 0;
 }
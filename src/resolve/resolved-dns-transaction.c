@@ -1674,6 +1674,50 @@ static void dns_transaction_randomize_answer(DnsTransaction *t) {
         dns_answer_randomize(t->answer);
 }
 
+static void dns_transaction_prefetch(DnsTransaction *t, usec_t ts) {
+        _cleanup_(dns_transaction_gcp) DnsTransaction *p = NULL;
+        DnsResourceKey *key;
+        int r;
+
+        assert(t);
+
+        /* The transaction is about to be answered from a cache entry that will expire soon. Start a
+         * transaction nobody waits for, that bypasses the cache, so that the entry is refreshed before it
+         * expires and the next lookup does not have to wait for the server. */
+
+        if (t->scope->protocol != DNS_PROTOCOL_DNS || t->bypass || t->prefetch)
+                return;
+        if (FLAGS_SET(t->query_flags, SD_RESOLVED_NO_NETWORK))
+                return;
+
+        key = dns_transaction_key(t);
+
+        if (!dns_cache_needs_prefetch(&t->scope->cache, key, ts))
+                return;
+
+        /* Already being refreshed? */
+        LIST_FOREACH(transactions_by_key, i, (DnsTransaction*) hashmap_get(t->scope->transactions_by_key, key))
+                if (i->prefetch)
+                        return;
+
+        r = dns_transaction_new(&p, t->scope, key, NULL, t->query_flags | SD_RESOLVED_NO_CACHE);
+        if (r < 0) {
+                log_debug_errno(r, "Failed to allocate prefetch transaction, ignoring: %m");
+                return;
+        }
+
+        p->prefetch = true;
+        p->wait_for_answer = true;
+
+        r = dns_transaction_go(p);
+        if (r < 0)
+                return (void) log_debug_errno(r, "Failed to start prefetch transaction, ignoring: %m");
+
+        /* Either the transaction completed right away and is gone already, or it stays around until the
+         * answer is in, as wait_for_answer is set. */
+        TAKE_PTR(p);
+}
+
 static int dns_transaction_prepare(DnsTransaction *t, usec_t ts) {
         int r;
 
@@ -1829,9 +1873,12 @@ static int dns_transaction_prepare(DnsTransaction *t, usec_t ts) {
                                 }
 
                                 t->answer_source = DNS_TRANSACTION_CACHE;
-                                if (t->answer_rcode == DNS_RCODE_SUCCESS)
+                                if (t->answer_rcode == DNS_RCODE_SUCCESS) {
+                                        if (FLAGS_SET(query_flags, SD_RESOLVED_NO_STALE))
+                                                dns_transaction_prefetch(t, ts);
+
                                         dns_transaction_complete(t, DNS_TRANSACTION_SUCCESS);
-                                else {
+                                } else {
                                         if (t->received)
                                                 (void) dns_packet_ede_rcode(t->received, &t->answer_ede_rcode, &t->answer_ede_msg);
 
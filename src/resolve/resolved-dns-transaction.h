@@ -141,6 +141,10 @@ struct DnsTransaction {
          * answer. */
         bool wait_for_answer;
 
+        /* Set for transactions started in the background to refresh a cache entry shortly before it expires.
+         * Nobody waits for these, and regular lookups are answered from the cache in the meantime. */
+        bool prefetch;
+
         LIST_FIELDS(DnsTransaction, transactions_by_scope);
         LIST_FIELDS(DnsTransaction, transactions_by_stream);
         LIST_FIELDS(DnsTransaction, transactions_by_key);
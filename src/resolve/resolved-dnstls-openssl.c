@@ -86,6 +86,7 @@ int dnstls_stream_connect_tls(DnsStream *stream, DnsServer *server) {
                 return -ENOMEM;
 
         SSL_set_connect_state(s);
+        SSL_set_app_data(s, stream);
         r = SSL_set_session(s, server->dnstls_data.session);
         if (r == 0)
                 return -EIO;
@@ -387,6 +388,24 @@ void dnstls_server_free(DnsServer *server) {
                 SSL_SESSION_free(server->dnstls_data.session);
 }
 
+static int dnstls_new_session(SSL *ssl, SSL_SESSION *session) {
+        DnsStream *stream;
+
+        /* Remember every session (ticket) the server hands us right away, rather than only when the stream
+         * is shut down cleanly. With TLS 1.3 tickets arrive after the handshake, and streams that get torn
+         * down due to errors would otherwise never let us resume the session on the next connection. */
+
+        stream = SSL_get_app_data(ssl);
+        if (!stream || !stream->server)
+                return 0;
+
+        if (stream->server->dnstls_data.session)
+                SSL_SESSION_free(stream->server->dnstls_data.session);
+
+        stream->server->dnstls_data.session = session;
+        return 1; /* We took ownership of the session */
+}
+
 int dnstls_manager_init(Manager *manager) {
         int r;
 
@@ -406,6 +425,11 @@ int dnstls_manager_init(Manager *manager) {
 
         (void) SSL_CTX_set_options(manager->dnstls_data.ctx, SSL_OP_NO_COMPRESSION);
 
+        /* We keep the session per server ourselves, hence disable the internal store and just get notified */
+        (void) SSL_CTX_set_session_cache_mode(manager->dnstls_data.ctx,
+                                              SSL_SESS_CACHE_CLIENT|SSL_SESS_CACHE_NO_INTERNAL_STORE);
+        SSL_CTX_sess_set_new_cb(manager->dnstls_data.ctx, dnstls_new_session);
+
         r = SSL_CTX_set_default_verify_paths(manager->dnstls_data.ctx);
         if (r == 0)
                 return log_warning_errno(SYNTHETIC_ERRNO(EIO),
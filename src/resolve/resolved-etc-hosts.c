@@ -296,6 +296,29 @@ int etc_hosts_parse(EtcHosts *hosts, FILE *f) {
 
         assert(hosts);
 
+        /* When reloading, the new file is most likely about as large as the old one. Size the new tables
+         * accordingly right away, so that large files don't cause the tables to be resized over and over
+         * again while we parse. */
+        if (hashmap_size(hosts->by_address) > 0) {
+                r = hashmap_ensure_allocated(&t.by_address, &by_address_hash_ops);
+                if (r < 0)
+                        return log_oom();
+
+                r = hashmap_reserve(t.by_address, hashmap_size(hosts->by_address));
+                if (r < 0)
+                        return log_oom();
+        }
+
+        if (hashmap_size(hosts->by_name) > 0) {
+                r = hashmap_ensure_allocated(&t.by_name, &by_name_hash_ops);
+                if (r < 0)
+                        return log_oom();
+
+                r = hashmap_reserve(t.by_name, hashmap_size(hosts->by_name));
+                if (r < 0)
+                        return log_oom();
+        }
+
         for (;;) {
                 _cleanup_free_ char *line = NULL;
                 char *l;
@@ -18,6 +18,7 @@
 #include "event-util.h"
 #include "fd-util.h"
 #include "fileio.h"
+#include "fs-util.h"
 #include "hostname-setup.h"
 #include "hostname-util.h"
 #include "idn-util.h"
@@ -45,6 +46,7 @@
 #include "socket-util.h"
 #include "string-table.h"
 #include "string-util.h"
+#include "tmpfile-util.h"
 #include "utf8.h"
 #include "varlink-util.h"
 
@@ -601,6 +603,7 @@ static int manager_memory_pressure(sd_event_source *s, void *userdata) {
         log_info("Under memory pressure, flushing caches.");
 
         manager_flush_caches(m, LOG_INFO);
+        dns_resource_record_trim_pool();
         sd_event_trim_memory();
 
         return 0;
@@ -835,6 +838,7 @@ Manager *manager_free(Manager *m) {
         m->stub_queries_by_packet = hashmap_free(m->stub_queries_by_packet);
 
         dns_scope_free(m->unicast_scope);
+        dnssec_flush_verified_signatures();
 
         /* At this point only orphaned streams should remain. All others should have been freed already by their
          * owners */
@@ -898,6 +902,10 @@ Manager *manager_free(Manager *m) {
 }
 
 int manager_recv(Manager *m, int fd, DnsProtocol protocol, DnsPacket **ret) {
+        /* Datagrams are first received into this buffer, which is large enough for any of them, and then
+         * copied into a packet of the right size. This saves the syscall for peeking at the size of the next
+         * datagram, which is considerably more expensive than copying the few bytes of a typical query. */
+        static uint8_t buffer[DNS_PACKET_SIZE_MAX];
         _cleanup_(dns_packet_unrefp) DnsPacket *p = NULL;
         CMSG_BUFFER_TYPE(CMSG_SPACE(MAXSIZE(struct in_pktinfo, struct in6_pktinfo))
                          + CMSG_SPACE(int) /* ttl/hoplimit */
@@ -913,22 +921,14 @@ int manager_recv(Manager *m, int fd, DnsProtocol protocol, DnsPacket **ret) {
                 .msg_controllen = sizeof(control),
         };
         struct cmsghdr *cmsg;
-        ssize_t ms, l;
+        ssize_t l;
         int r;
 
         assert(m);
         assert(fd >= 0);
         assert(ret);
 
-        ms = next_datagram_size_fd(fd);
-        if (ms < 0)
-                return ms;
-
-        r = dns_packet_new(&p, protocol, ms, DNS_PACKET_SIZE_MAX);
-        if (r < 0)
-                return r;
-
-        iov = IOVEC_MAKE(DNS_PACKET_DATA(p), p->allocated);
+        iov = IOVEC_MAKE(buffer, sizeof(buffer));
 
         l = recvmsg_safe(fd, &mh, 0);
         if (ERRNO_IS_NEG_TRANSIENT(l))
@@ -936,6 +936,11 @@ int manager_recv(Manager *m, int fd, DnsProtocol protocol, DnsPacket **ret) {
         if (l <= 0)
                 return l;
 
+        r = dns_packet_new(&p, protocol, l, DNS_PACKET_SIZE_MAX);
+        if (r < 0)
+                return r;
+
+        memcpy(DNS_PACKET_DATA(p), buffer, l);
         p->size = (size_t) l;
 
         p->family = sa.sa.sa_family;
@@ -1763,6 +1768,101 @@ void manager_flush_caches(Manager *m, int log_level) {
         log_full(log_level, "Flushed all caches.");
 }
 
+#define CACHE_SERIALIZATION_PATH "/run/systemd/resolve/cache"
+
+int manager_save_cache(Manager *m) {
+        _cleanup_(unlink_and_freep) char *temp_path = NULL;
+        _cleanup_fclose_ FILE *f = NULL;
+        int r;
+
+        assert(m);
+
+        /* Stores the global unicast cache on shutdown, so that a restarted instance does not start from
+         * scratch. Only the global cache is covered, the per-link caches are dropped anyway as the links
+         * are reconfigured. The file is tied to the DNS server the entries were acquired from. */
+
+        if (m->enable_cache == DNS_CACHE_MODE_NO ||
+            !m->unicast_scope ||
+            !m->current_dns_server ||
+            dns_cache_is_empty(&m->unicast_scope->cache)) {
+                if (unlink(CACHE_SERIALIZATION_PATH) < 0 && errno != ENOENT)
+                        log_debug_errno(errno, "Failed to remove %s, ignoring: %m", CACHE_SERIALIZATION_PATH);
+                return 0;
+        }
+
+        r = fopen_temporary(CACHE_SERIALIZATION_PATH, &f, &temp_path);
+        if (r < 0)
+                return log_warning_errno(r, "Failed to open %s for writing: %m", CACHE_SERIALIZATION_PATH);
+
+        /* The cache reveals which names were resolved recently, hence don't make this world readable. */
+        (void) fchmod(fileno(f), 0600);
+
+        fprintf(f, "server=%s\n", dns_server_string_full(m->current_dns_server));
+
+        r = dns_cache_serialize(&m->unicast_scope->cache, f);
+        if (r < 0)
+                return log_warning_errno(r, "Failed to serialize DNS cache: %m");
+
+        r = fflush_and_check(f);
+        if (r < 0)
+                return log_warning_errno(r, "Failed to write %s: %m", CACHE_SERIALIZATION_PATH);
+
+        if (rename(temp_path, CACHE_SERIALIZATION_PATH) < 0)
+                return log_warning_errno(errno, "Failed to move %s into place: %m", CACHE_SERIALIZATION_PATH);
+
+        temp_path = mfree(temp_path); /* free the string explicitly, so that we don't unlink anymore */
+        log_debug("Saved DNS cache to %s.", CACHE_SERIALIZATION_PATH);
+        return 1;
+}
+
+int manager_load_cache(Manager *m) {
+        _cleanup_fclose_ FILE *f = NULL;
+        _cleanup_free_ char *line = NULL;
+        const char *server;
+        DnsServer *s;
+        int r;
+
+        assert(m);
+
+        f = fopen(CACHE_SERIALIZATION_PATH, "re");
+        if (!f) {
+                if (errno == ENOENT)
+                        return 0;
+
+                return log_debug_errno(errno, "Failed to open %s, ignoring: %m", CACHE_SERIALIZATION_PATH);
+        }
+
+        /* The data is only useful once, make sure a later restart will not pick up stale entries. */
+        if (unlink(CACHE_SERIALIZATION_PATH) < 0)
+                log_debug_errno(errno, "Failed to remove %s, ignoring: %m", CACHE_SERIALIZATION_PATH);
+
+        if (m->enable_cache == DNS_CACHE_MODE_NO || !m->unicast_scope)
+                return 0;
+
+        r = read_line(f, LONG_LINE_MAX, &line);
+        if (r < 0)
+                return log_debug_errno(r, "Failed to read %s, ignoring: %m", CACHE_SERIALIZATION_PATH);
+
+        server = startswith(line, "server=");
+        if (!server)
+                return log_debug_errno(SYNTHETIC_ERRNO(EBADMSG), "Invalid header in %s, ignoring.", CACHE_SERIALIZATION_PATH);
+
+        /* Pick the DNS server now: switching servers flushes the cache, and we only want to reuse entries
+         * if they were acquired from the same server we are going to talk to. */
+        s = manager_get_dns_server(m);
+        if (!s || !streq(server, dns_server_string_full(s))) {
+                log_debug("DNS server changed since the cache was saved, not restoring it.");
+                return 0;
+        }
+
+        r = dns_cache_deserialize(&m->unicast_scope->cache, f);
+        if (r < 0)
+                return log_debug_errno(r, "Failed to restore DNS cache, ignoring: %m");
+
+        log_debug("Restored %i DNS cache entries from %s.", r, CACHE_SERIALIZATION_PATH);
+        return r;
+}
+
 void manager_reset_server_features(Manager *m) {
         Link *l;
 
@@ -1939,7 +2039,7 @@ int socket_disable_pmtud(int fd, int af) {
 }
 
 int dns_manager_dump_statistics_json(Manager *m, sd_json_variant **ret) {
-        uint64_t size = 0, hit = 0, miss = 0;
+        uint64_t size = 0, hit = 0, miss = 0, evicted = 0;
 
         assert(m);
         assert(ret);
@@ -1948,6 +2048,7 @@ int dns_manager_dump_statistics_json(Manager *m, sd_json_variant **ret) {
                 size += dns_cache_size(&s->cache);
                 hit += s->cache.n_hit;
                 miss += s->cache.n_miss;
+                evicted += s->cache.n_evicted;
         }
 
         return sd_json_buildo(ret,
@@ -1962,7 +2063,8 @@ int dns_manager_dump_statistics_json(Manager *m, sd_json_variant **ret) {
                               SD_JSON_BUILD_PAIR("cache", SD_JSON_BUILD_OBJECT(
                                                                  SD_JSON_BUILD_PAIR_UNSIGNED("size", size),
                                                                  SD_JSON_BUILD_PAIR_UNSIGNED("hits", hit),
-                                                                 SD_JSON_BUILD_PAIR_UNSIGNED("misses", miss)
+                                                                 SD_JSON_BUILD_PAIR_UNSIGNED("misses", miss),
+                                                                 SD_JSON_BUILD_PAIR_UNSIGNED("evictions", evicted)
                                                  )),
                               SD_JSON_BUILD_PAIR("dnssec", SD_JSON_BUILD_OBJECT(
                                                                  SD_JSON_BUILD_PAIR_UNSIGNED("secure", m->n_dnssec_verdict[DNSSEC_SECURE]),
@@ -1977,7 +2079,7 @@ void dns_manager_reset_statistics(Manager *m) {
         assert(m);
 
         LIST_FOREACH(scopes, s, m->dns_scopes)
-                s->cache.n_hit = s->cache.n_miss = 0;
+                s->cache.n_hit = s->cache.n_miss = s->cache.n_evicted = 0;
 
         m->n_transactions_total = 0;
         m->n_timeouts_total = 0;
@@ -221,6 +221,8 @@ void manager_dnssec_verdict(Manager *m, DnssecVerdict verdict, const DnsResource
 bool manager_routable(Manager *m);
 
 void manager_flush_caches(Manager *m, int log_level);
+int manager_save_cache(Manager *m);
+int manager_load_cache(Manager *m);
 void manager_reset_server_features(Manager *m);
 
 void manager_cleanup_saved_user(Manager *m);
@@ -75,6 +75,8 @@ static int run(int argc, char *argv[]) {
         if (r < 0)
                 return log_error_errno(r, "Failed to start manager: %m");
 
+        (void) manager_load_cache(m);
+
         /* Write finish default resolv.conf to avoid a dangling symlink */
         (void) manager_write_resolv_conf(m);
 
@@ -91,6 +93,8 @@ static int run(int argc, char *argv[]) {
         if (r < 0)
                 return log_error_errno(r, "Event loop failed: %m");
 
+        (void) manager_save_cache(m);
+
         return 0;
 }
 
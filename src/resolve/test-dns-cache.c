@@ -1255,4 +1255,123 @@ TEST(dns_cache_dump_json_basic) {
         ASSERT_TRUE(sd_json_variant_is_integer(BY_KEY(item, "until")));
 }
 
+/* ================================================================
+ * dns_cache_serialize() / dns_cache_deserialize()
+ * ================================================================ */
+
+TEST(dns_cache_serialize_roundtrip) {
+        _cleanup_(dns_cache_unrefp) DnsCache cache = new_cache(), restored = new_cache();
+        _cleanup_(put_args_unrefp) PutArgs put_args = mk_put_args();
+        _cleanup_(dns_answer_unrefp) DnsAnswer *ret_answer = NULL;
+        _cleanup_(dns_resource_key_unrefp) DnsResourceKey *key = NULL;
+        int ret_rcode;
+        uint64_t ret_query_flags;
+
+        put_args.key = dns_resource_key_new(DNS_CLASS_IN, DNS_TYPE_A, "www.example.com");
+        ASSERT_NOT_NULL(put_args.key);
+        put_args.rcode = DNS_RCODE_SUCCESS;
+        answer_add_a(&put_args, put_args.key, 0xc0a8017f, 3600, DNS_ANSWER_CACHEABLE);
+        cache_put(&cache, &put_args);
+
+        ASSERT_EQ(dns_cache_size(&cache), 1u);
+
+        _cleanup_(unlink_tempfilep) char p[] = "/tmp/dns-cache-serialize-XXXXXX";
+        _cleanup_fclose_ FILE *f = NULL;
+        fmkostemp_safe(p, "r+", &f);
+        ASSERT_OK(dns_cache_serialize(&cache, f));
+        ASSERT_OK(fflush_and_check(f));
+        rewind(f);
+
+        ASSERT_OK_EQ(dns_cache_deserialize(&restored, f), 1);
+        ASSERT_EQ(dns_cache_size(&restored), 1u);
+
+        key = dns_resource_key_new(DNS_CLASS_IN, DNS_TYPE_A, "www.example.com");
+        ASSERT_NOT_NULL(key);
+        ASSERT_OK_POSITIVE(dns_cache_lookup(&restored, key, 0, &ret_rcode, &ret_answer, NULL, &ret_query_flags, NULL));
+        ASSERT_EQ(ret_rcode, DNS_RCODE_SUCCESS);
+        ASSERT_EQ(dns_answer_size(ret_answer), 1u);
+}
+
+TEST(dns_cache_deserialize_invalid) {
+        _cleanup_(dns_cache_unrefp) DnsCache cache = new_cache();
+
+        _cleanup_(unlink_tempfilep) char p[] = "/tmp/dns-cache-deserialize-invalid-XXXXXX";
+        _cleanup_fclose_ FILE *f = NULL;
+        fmkostemp_safe(p, "r+", &f);
+        fputs("garbage\n"
+              "1 2 3\n"
+              /* already expired */
+              "1 1 0 unsigned 0 1.2.3.4 A3d3dwdleGFtcGxlA2NvbQAAAQABAAAOEAAEwKgBfw==\n", f);
+        ASSERT_OK(fflush_and_check(f));
+        rewind(f);
+
+        ASSERT_OK_ZERO(dns_cache_deserialize(&cache, f));
+        ASSERT_TRUE(dns_cache_is_empty(&cache));
+}
+
+/* ================================================================
+ * dns_cache_needs_prefetch()
+ * ================================================================ */
+
+TEST(dns_cache_needs_prefetch) {
+        _cleanup_(dns_cache_unrefp) DnsCache cache = new_cache();
+        _cleanup_(put_args_unrefp) PutArgs put_args = mk_put_args();
+        _cleanup_(dns_resource_key_unrefp) DnsResourceKey *key = NULL;
+        usec_t t;
+
+        put_args.key = dns_resource_key_new(DNS_CLASS_IN, DNS_TYPE_A, "www.example.com");
+        ASSERT_NOT_NULL(put_args.key);
+        answer_add_a(&put_args, put_args.key, 0xc0a8017f, 3600, DNS_ANSWER_CACHEABLE);
+        cache_put(&cache, &put_args);
+        t = now(CLOCK_BOOTTIME);
+
+        key = dns_resource_key_new(DNS_CLASS_IN, DNS_TYPE_AAAA, "www.example.com");
+        ASSERT_NOT_NULL(key);
+        ASSERT_FALSE(dns_cache_needs_prefetch(&cache, key, t));
+
+        ASSERT_FALSE(dns_cache_needs_prefetch(&cache, put_args.key, t));
+        ASSERT_FALSE(dns_cache_needs_prefetch(&cache, put_args.key, t + 3000 * USEC_PER_SEC));
+        ASSERT_TRUE(dns_cache_needs_prefetch(&cache, put_args.key, t + 3500 * USEC_PER_SEC));
+        ASSERT_FALSE(dns_cache_needs_prefetch(&cache, put_args.key, t + 3700 * USEC_PER_SEC));
+}
+
+TEST(dns_cache_needs_prefetch_short_ttl) {
+        _cleanup_(dns_cache_unrefp) DnsCache cache = new_cache();
+        _cleanup_(put_args_unrefp) PutArgs put_args = mk_put_args();
+        usec_t t;
+
+        put_args.key = dns_resource_key_new(DNS_CLASS_IN, DNS_TYPE_A, "www.example.com");
+        ASSERT_NOT_NULL(put_args.key);
+        answer_add_a(&put_args, put_args.key, 0xc0a8017f, 5, DNS_ANSWER_CACHEABLE);
+        cache_put(&cache, &put_args);
+        t = now(CLOCK_BOOTTIME);
+
+        ASSERT_FALSE(dns_cache_needs_prefetch(&cache, put_args.key, t + 4 * USEC_PER_SEC + 900 * USEC_PER_MSEC));
+}
+
+/* ================================================================
+ * dns_cache_make_space()
+ * ================================================================ */
+
+TEST(dns_cache_evict) {
+        _cleanup_(dns_cache_unrefp) DnsCache cache = new_cache();
+
+        for (unsigned i = 0; i < 4100; i++) {
+                _cleanup_(put_args_unrefp) PutArgs put_args = mk_put_args();
+                _cleanup_free_ char *name = NULL;
+
+                ASSERT_OK(asprintf(&name, "host%u.example.com", i));
+                put_args.key = dns_resource_key_new(DNS_CLASS_IN, DNS_TYPE_A, name);
+                ASSERT_NOT_NULL(put_args.key);
+                answer_add_a(&put_args, put_args.key, 0xc0a80100 + i, 3600, DNS_ANSWER_CACHEABLE);
+                answer_add_a(&put_args, put_args.key, 0xc0a90100 + i, 3600, DNS_ANSWER_CACHEABLE);
+                ASSERT_OK(cache_put(&cache, &put_args));
+        }
+
+        /* Evictions are counted per entry, and each key carries two of them. */
+        ASSERT_LT(dns_cache_size(&cache), 4100u);
+        ASSERT_EQ(cache.n_evicted % 2, 0u);
+        ASSERT_EQ(2 * dns_cache_size(&cache) + cache.n_evicted, 8200u);
+}
+
 DEFINE_TEST_MAIN(LOG_DEBUG);
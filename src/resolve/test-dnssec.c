@@ -529,6 +529,17 @@ TEST(dnssec_verify_rrset) {
         /* Validate the RR as it if was 2015-12-2 today */
         assert_se(dnssec_verify_rrset(answer, a->key, rrsig, dnskey, 1449092754*USEC_PER_SEC, &result) >= 0);
         assert_se(result == DNSSEC_VALIDATED);
+
+        /* The second time the signature is known to be valid already */
+        assert_se(dnssec_verify_rrset(answer, a->key, rrsig, dnskey, 1449092754*USEC_PER_SEC, &result) >= 0);
+        assert_se(result == DNSSEC_VALIDATED);
+
+        /* But that must not apply to a different signature */
+        ((uint8_t*) rrsig->rrsig.signature)[0] ^= 0xff;
+        assert_se(dnssec_verify_rrset(answer, a->key, rrsig, dnskey, 1449092754*USEC_PER_SEC, &result) >= 0);
+        assert_se(result == DNSSEC_INVALID);
+
+        dnssec_flush_verified_signatures();
 }
 
 TEST(dnssec_verify_rrset2) {
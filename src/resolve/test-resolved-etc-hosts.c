@@ -136,6 +136,25 @@ TEST(parse_etc_hosts) {
         assert_se(!set_contains(hosts.no_address, "foobar.foo.foo"));
 }
 
+TEST(parse_etc_hosts_reload) {
+        _cleanup_(etc_hosts_clear) EtcHosts hosts = {};
+        _cleanup_fclose_ FILE *f = NULL, *g = NULL;
+        const char *a = "1.2.3.4 some.where\n1.2.3.5 other.where\n", *b = "1.2.3.6 new.where\n";
+
+        assert_se(f = fmemopen_unlocked((char*) a, strlen(a), "r"));
+        assert_se(etc_hosts_parse(&hosts, f) == 0);
+        assert_se(hashmap_size(hosts.by_address) == 2);
+        assert_se(hashmap_size(hosts.by_name) == 2);
+
+        /* Parsing again into the same object replaces the old data, and starts from pre-sized tables */
+        assert_se(g = fmemopen_unlocked((char*) b, strlen(b), "r"));
+        assert_se(etc_hosts_parse(&hosts, g) == 0);
+        assert_se(hashmap_size(hosts.by_address) == 1);
+        assert_se(hashmap_size(hosts.by_name) == 1);
+        assert_se(hashmap_get(hosts.by_name, "new.where"));
+        assert_se(!hashmap_get(hosts.by_name, "some.where"));
+}
+
 static void test_parse_file_one(const char *fname) {
         _cleanup_(etc_hosts_clear) EtcHosts hosts = {};
         _cleanup_fclose_ FILE *f = NULL;
@@ -64,7 +64,7 @@ BPFProgram *bpf_program_free(BPFProgram *p) {
 
  /* struct bpf_prog_info info must be initialized since its value is both input and output
   * for BPF_OBJ_GET_INFO_BY_FD syscall. */
-static int bpf_program_get_info_by_fd(int prog_fd, struct bpf_prog_info *info, uint32_t info_len) {
+int bpf_program_get_info_by_fd(int prog_fd, struct bpf_prog_info *info, uint32_t info_len) {
         union bpf_attr attr;
 
         /* Explicitly memset to zero since some compilers may produce non-zero-initialized padding when
@@ -374,6 +374,15 @@ int bpf_program_get_id_by_fd(int prog_fd, uint32_t *ret_id) {
         return 0;
 };
 
+int bpf_program_get_fd_by_id(uint32_t prog_id) {
+        union bpf_attr attr;
+
+        zero(attr);
+        attr.prog_id = prog_id;
+
+        return RET_NERRNO(bpf(BPF_PROG_GET_FD_BY_ID, &attr, sizeof(attr)));
+}
+
 int bpf_program_serialize_attachment(
                 FILE *f,
                 FDSet *fds,
@@ -46,6 +46,8 @@ int bpf_program_cgroup_detach(BPFProgram *p);
 
 int bpf_program_pin(int prog_fd, const char *bpffs_path);
 int bpf_program_get_id_by_fd(int prog_fd, uint32_t *ret_id);
+int bpf_program_get_info_by_fd(int prog_fd, struct bpf_prog_info *info, uint32_t info_len);
+int bpf_program_get_fd_by_id(uint32_t prog_id);
 
 int bpf_program_serialize_attachment(FILE *f, FDSet *fds, const char *key, BPFProgram *p);
 int bpf_program_serialize_attachment_set(FILE *f, FDSet *fds, const char *key, Set *set);
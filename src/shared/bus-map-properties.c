@@ -247,3 +247,104 @@ int bus_map_all_properties(
 
         return r;
 }
+
+typedef struct GetAllCall {
+        sd_bus_slot *slot;
+        sd_bus_message *reply;
+} GetAllCall;
+
+static void get_all_call_free_many(GetAllCall *calls, size_t n) {
+        FOREACH_ARRAY(c, calls, n) {
+                sd_bus_slot_unref(c->slot);
+                sd_bus_message_unref(c->reply);
+        }
+
+        free(calls);
+}
+
+static int get_all_call_handler(sd_bus_message *m, void *userdata, sd_bus_error *ret_error) {
+        GetAllCall *c = ASSERT_PTR(userdata);
+
+        c->reply = sd_bus_message_ref(m);
+        return 0;
+}
+
+void bus_message_unref_many(sd_bus_message **messages, size_t n) {
+        FOREACH_ARRAY(m, messages, n)
+                sd_bus_message_unref(*m);
+
+        free(messages);
+}
+
+int bus_get_all_properties_many(
+                sd_bus *bus,
+                const char *destination,
+                char * const *paths,
+                size_t n_paths,
+                sd_bus_message ***ret_replies) {
+
+        GetAllCall *calls = NULL;
+        size_t n_calls = 0, n_done = 0;
+        sd_bus_message **replies;
+        int r;
+
+        assert(bus);
+        assert(destination);
+        assert(paths || n_paths == 0);
+        assert(ret_replies);
+
+        /* Like bus_map_all_properties() without the mapping, but for many objects at once: all GetAll()
+         * calls are enqueued before waiting for the first reply, so that we only pay for one round trip
+         * instead of one per object. The replies are returned in the same order as the paths, and may be
+         * error replies. */
+
+        CLEANUP_ARRAY(calls, n_calls, get_all_call_free_many);
+
+        calls = new0(GetAllCall, n_paths);
+        if (!calls)
+                return -ENOMEM;
+        n_calls = n_paths;
+
+        for (size_t i = 0; i < n_paths; i++) {
+                r = sd_bus_call_method_async(
+                                bus,
+                                &calls[i].slot,
+                                destination,
+                                paths[i],
+                                "org.freedesktop.DBus.Properties",
+                                "GetAll",
+                                get_all_call_handler,
+                                calls + i,
+                                "s", "");
+                if (r < 0)
+                        return r;
+        }
+
+        for (;;) {
+                /* Replies generally arrive in order, hence this is linear overall */
+                while (n_done < n_calls && calls[n_done].reply)
+                        n_done++;
+                if (n_done >= n_calls)
+                        break;
+
+                r = sd_bus_process(bus, NULL);
+                if (r < 0)
+                        return r;
+                if (r > 0)
+                        continue;
+
+                r = sd_bus_wait(bus, UINT64_MAX);
+                if (r < 0)
+                        return r;
+        }
+
+        replies = new(sd_bus_message*, n_calls);
+        if (!replies)
+                return -ENOMEM;
+
+        for (size_t i = 0; i < n_calls; i++)
+                replies[i] = TAKE_PTR(calls[i].reply);
+
+        *ret_replies = replies;
+        return 0;
+}
@@ -2375,6 +2375,13 @@ static int bus_append_path_property(sd_bus_message *m, const char *field, const
         return 0;
 }
 
+static int bus_append_slice_property(sd_bus_message *m, const char *field, const char *eq) {
+        if (streq(field, "JobConcurrencyMax"))
+                return bus_append_safe_atou(m, field, eq);
+
+        return 0;
+}
+
 static int bus_append_scope_property(sd_bus_message *m, const char *field, const char *eq) {
         if (streq(field, "RuntimeMaxSec"))
                 return bus_append_parse_sec_rename(m, field, eq);
@@ -2855,6 +2862,10 @@ int bus_append_unit_property_assignment(sd_bus_message *m, UnitType t, const cha
 
         case UNIT_SLICE:
                 r = bus_append_cgroup_property(m, field, eq);
+                if (r != 0)
+                        return r;
+
+                r = bus_append_slice_property(m, field, eq);
                 if (r != 0)
                         return r;
                 break;
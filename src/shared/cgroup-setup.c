@@ -625,9 +625,10 @@ int cg_enable_everywhere(
                 CGroupMask *ret_result_mask) {
 
         _cleanup_fclose_ FILE *f = NULL;
-        _cleanup_free_ char *fs = NULL;
+        _cleanup_free_ char *fs = NULL, *current = NULL;
         CGroupController c;
-        CGroupMask ret = 0;
+        CGroupMask ret = 0, enabled = 0;
+        bool enabled_known = false;
         int r;
 
         assert(p);
@@ -662,6 +663,20 @@ int cg_enable_everywhere(
         if (r < 0)
                 return r;
 
+        /* Let's first check which controllers are enabled already, so that we only need to write the ones
+         * that actually change. Realizing a freshly created cgroup thus usually needs no write at all. If
+         * this fails for some reason, we just write everything, as before. */
+        r = read_one_line_file(fs, &current);
+        if (r < 0)
+                log_debug_errno(r, "Failed to read cgroup.subtree_control file of %s, ignoring: %m", p);
+        else {
+                r = cg_mask_from_string(current, &enabled);
+                if (r < 0)
+                        log_debug_errno(r, "Failed to parse cgroup.subtree_control file of %s, ignoring: %m", p);
+                else
+                        enabled_known = true;
+        }
+
         for (c = 0; c < _CGROUP_CONTROLLER_MAX; c++) {
                 CGroupMask bit = CGROUP_CONTROLLER_TO_MASK(c);
                 const char *n;
@@ -672,6 +687,13 @@ int cg_enable_everywhere(
                 if (!FLAGS_SET(supported, bit))
                         continue;
 
+                if (enabled_known && FLAGS_SET(enabled, bit) == FLAGS_SET(mask, bit)) {
+                        /* Already in the state we want, nothing to write. */
+                        if (FLAGS_SET(mask, bit))
+                                ret |= bit;
+                        continue;
+                }
+
                 n = cgroup_controller_to_string(c);
                 {
                         char s[1 + strlen(n) + 1];
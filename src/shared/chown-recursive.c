@@ -26,13 +26,24 @@ static int chown_one(
         assert(fd >= 0);
         assert(st);
 
-        /* Drop any ACL if there is one */
+        /* Drop any ACL if there is one. Symlinks cannot carry ACLs, and only directories can carry default
+         * ACLs, hence don't bother with the syscalls for those, they add up on large trees. */
         FOREACH_STRING(n, "system.posix_acl_access", "system.posix_acl_default") {
+                if (S_ISLNK(st->st_mode) ||
+                    (!S_ISDIR(st->st_mode) && streq(n, "system.posix_acl_default")))
+                        break;
+
                 r = xremovexattr(fd, /* path = */ NULL, AT_EMPTY_PATH, n);
                 if (r < 0 && !ERRNO_IS_NEG_XATTR_ABSENT(r))
                         return r;
         }
 
+        /* Skip the chown/chmod (and the fstat() it does first) if the inode is already in order. */
+        if ((!uid_is_valid(uid) || st->st_uid == uid) &&
+            (!gid_is_valid(gid) || st->st_gid == gid) &&
+            (S_ISLNK(st->st_mode) || (st->st_mode & ~mask & 07777) == 0))
+                return 1;
+
         r = fchmod_and_chown(fd, st->st_mode & mask, uid, gid);
         if (r < 0)
                 return r;
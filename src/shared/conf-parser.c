@@ -293,6 +293,7 @@ int config_parse(
 
         _cleanup_free_ char *section = NULL, *continuation = NULL;
         _cleanup_fclose_ FILE *ours = NULL;
+        size_t n_continuation = 0;
         unsigned line = 0, section_line = 0;
         bool section_ignored = false, bom_seen = false;
         struct stat st;
@@ -335,7 +336,7 @@ int config_parse(
         for (;;) {
                 _cleanup_free_ char *buf = NULL;
                 bool escaped = false;
-                char *l, *p, *e;
+                char *l, *p, *e, *s;
 
                 r = read_line(f, LONG_LINE_MAX, &buf);
                 if (r == 0)
@@ -371,23 +372,34 @@ int config_parse(
                 }
 
                 if (continuation) {
-                        if (strlen(continuation) + strlen(l) > LONG_LINE_MAX) {
+                        size_t k = strlen(l);
+
+                        if (n_continuation + k > LONG_LINE_MAX) {
                                 if (flags & CONFIG_PARSE_WARN)
                                         log_error("%s:%u: Continuation line too long", filename, line);
                                 return -ENOBUFS;
                         }
 
-                        if (!strextend(&continuation, l)) {
+                        /* Grow the buffer exponentially, so that long runs of continuation lines don't
+                         * reallocate (and copy) everything accumulated so far for every single line. */
+                        if (!GREEDY_REALLOC(continuation, n_continuation + k + 1)) {
                                 if (flags & CONFIG_PARSE_WARN)
                                         log_oom();
                                 return -ENOMEM;
                         }
 
+                        memcpy(continuation + n_continuation, l, k + 1);
+
+                        /* The part accumulated so far has been checked for a trailing backslash already,
+                         * and that backslash has been replaced by a space. Hence it's sufficient to only
+                         * look at the newly added part. */
                         p = continuation;
+                        s = continuation + n_continuation;
+                        n_continuation += k;
                 } else
-                        p = l;
+                        p = s = l;
 
-                for (e = p; *e; e++) {
+                for (e = s; *e; e++) {
                         if (escaped)
                                 escaped = false;
                         else if (*e == '\\')
@@ -404,6 +416,8 @@ int config_parse(
                                                 log_oom();
                                         return -ENOMEM;
                                 }
+
+                                n_continuation = e - l;
                         }
 
                         continue;
@@ -428,6 +442,7 @@ int config_parse(
                 }
 
                 continuation = mfree(continuation);
+                n_continuation = 0;
         }
 
         if (continuation) {
@@ -828,11 +828,15 @@ static int fd_copy_regular(
                 void *userdata) {
 
         _cleanup_close_ int fdf = -EBADF, fdt = -EBADF;
+        bool reflink_unsupported = false;
         int r, q;
 
         assert(st);
         assert(to);
 
+        /* Returns > 0 if the file was copied, but reflinking turned out not to be supported between the
+         * source and the target file system, so that the caller can skip the attempt for further files. */
+
         r = try_hardlink(hardlink_context, st, dt, to);
         if (r < 0)
                 return r;
@@ -858,9 +862,22 @@ static int fd_copy_regular(
         if (r < 0)
                 return r;
 
-        r = copy_bytes_full(fdf, fdt, UINT64_MAX, copy_flags, NULL, NULL, progress, userdata);
-        if (r < 0)
-                goto fail;
+        /* Try the reflink ourselves rather than leaving it to copy_bytes_full(), so that we learn whether
+         * it is supported at all. For trees with many small files the failing attempt (which costs a few
+         * syscalls each time) otherwise adds up. */
+        r = -EOPNOTSUPP;
+        if (FLAGS_SET(copy_flags, COPY_REFLINK)) {
+                r = reflink(fdf, fdt);
+                if (ERRNO_IS_NEG_NOT_SUPPORTED(r) || r == -EXDEV)
+                        reflink_unsupported = true;
+        }
+        if (r < 0) {
+                r = copy_bytes_full(fdf, fdt, UINT64_MAX, copy_flags & ~COPY_REFLINK, NULL, NULL, progress, userdata);
+                if (r < 0)
+                        goto fail;
+        }
+
+        r = 0;
 
         if (fchown(fdt,
                    uid_is_valid(override_uid) ? override_uid : st->st_uid,
@@ -893,7 +910,7 @@ static int fd_copy_regular(
         }
 
         (void) memorize_hardlink(hardlink_context, st, dt, to);
-        return r;
+        return r < 0 ? r : reflink_unsupported;
 
 fail:
         (void) unlinkat(dt, to, 0);
@@ -1080,6 +1097,7 @@ static int fd_copy_directory(
         if (exists && FLAGS_SET(copy_flags, COPY_RESTORE_DIRECTORY_TIMESTAMPS) && fstat(fdt, &dt_st) < 0)
                 return -errno;
 
+        CopyFlags child_copy_flags = copy_flags & ~COPY_LOCK_BSD;
         int ret = 0;
 
         if (PTR_TO_INT(hashmap_get(denylist, st)) == DENY_CONTENTS) {
@@ -1154,9 +1172,14 @@ static int fd_copy_directory(
                 }
 
                 r = fd_copy_tree_generic(dirfd(d), de->d_name, &buf, fdt, de->d_name, original_device,
-                                         depth_left-1, override_uid, override_gid, copy_flags & ~COPY_LOCK_BSD,
+                                         depth_left-1, override_uid, override_gid, child_copy_flags,
                                          denylist, subvolumes, hardlink_context, child_display_path, progress_path,
                                          progress_bytes, userdata);
+                if (r > 0) {
+                        /* Reflinking didn't work for this file, don't bother for its siblings either */
+                        child_copy_flags &= ~COPY_REFLINK;
+                        r = 0;
+                }
 
                 if (IN_SET(r, -EINTR, -ENOSPC)) /* Propagate SIGINT/SIGTERM and ENOSPC up instantly */
                         return r;
@@ -63,6 +63,7 @@ static int get_pin(
 int acquire_tpm2_key(
                 const char *volume_name,
                 const char *device,
+                Tpm2Context **tpm2_context,
                 uint32_t hash_pcr_mask,
                 uint16_t pcr_bank,
                 const struct iovec *pubkey,
@@ -91,6 +92,7 @@ int acquire_tpm2_key(
         _cleanup_free_ char *auto_device = NULL;
         int r;
 
+        assert(tpm2_context);
         assert(iovec_is_valid(salt));
 
         if (!device) {
@@ -146,13 +148,16 @@ int acquire_tpm2_key(
                 }
         }
 
-        _cleanup_(tpm2_context_unrefp) Tpm2Context *tpm2_context = NULL;
-        r = tpm2_context_new_or_warn(device, &tpm2_context);
-        if (r < 0)
-                return r;
+        /* Reuse the TPM context across calls if the caller has one for us already, so that we don't have to
+         * set up the connection and query the TPM's capabilities again for each token we try. */
+        if (!*tpm2_context) {
+                r = tpm2_context_new_or_warn(device, tpm2_context);
+                if (r < 0)
+                        return r;
+        }
 
         if (!(flags & TPM2_FLAGS_USE_PIN)) {
-                r = tpm2_unseal(tpm2_context,
+                r = tpm2_unseal(*tpm2_context,
                                 hash_pcr_mask,
                                 pcr_bank,
                                 pubkey,
@@ -202,7 +207,7 @@ int acquire_tpm2_key(
                         /* no salting needed, backwards compat with non-salted pins */
                         b64_salted_pin = TAKE_PTR(pin_str);
 
-                r = tpm2_unseal(tpm2_context,
+                r = tpm2_unseal(*tpm2_context,
                                 hash_pcr_mask,
                                 pcr_bank,
                                 pubkey,
@@ -14,6 +14,7 @@
 int acquire_tpm2_key(
                 const char *volume_name,
                 const char *device,
+                Tpm2Context **tpm2_context,
                 uint32_t hash_pcr_mask,
                 uint16_t pcr_bank,
                 const struct iovec *pubkey,
@@ -62,6 +63,7 @@ int find_tpm2_auto_data(
 static inline int acquire_tpm2_key(
                 const char *volume_name,
                 const char *device,
+                Tpm2Context **tpm2_context,
                 uint32_t hash_pcr_mask,
                 uint16_t pcr_bank,
                 const struct iovec *pubkey,
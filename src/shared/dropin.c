@@ -146,7 +146,7 @@ static int unit_file_add_dir(
         return 0;
 }
 
-static int unit_file_find_dirs(
+static int unit_file_find_dir(
                 const char *original_root,
                 Set *unit_path_cache,
                 const char *unit_path,
@@ -154,24 +154,36 @@ static int unit_file_find_dirs(
                 const char *suffix,
                 char ***dirs) {
 
+        char *path;
+
+        assert(unit_path);
+        assert(name);
+        assert(suffix);
+
+        path = strjoina(unit_path, "/", name, suffix);
+        if (unit_path_cache && !set_get(unit_path_cache, path))
+                return 0;
+
+        return unit_file_add_dir(original_root, path, dirs);
+}
+
+static int unit_file_dropin_names(const char *name, char ***names) {
         _cleanup_free_ char *prefix = NULL, *instance = NULL, *built = NULL;
         bool is_instance, chopped;
         const char *dash;
         UnitType type;
-        char *path;
         size_t n;
         int r;
 
-        assert(unit_path);
         assert(name);
-        assert(suffix);
+        assert(names);
 
-        path = strjoina(unit_path, "/", name, suffix);
-        if (!unit_path_cache || set_get(unit_path_cache, path)) {
-                r = unit_file_add_dir(original_root, path, dirs);
-                if (r < 0)
-                        return r;
-        }
+        /* Collects all unit names whose drop-in directories apply to the specified unit name, in the order
+         * they should be searched in. This only depends on the name, not on the search path, hence is
+         * calculated once per unit name rather than for each directory of the search path. */
+
+        if (strv_extend(names, name) < 0)
+                return log_oom();
 
         is_instance = unit_name_is_valid(name, UNIT_NAME_INSTANCE);
         if (is_instance) { /* Also try the template dir */
@@ -181,7 +193,7 @@ static int unit_file_find_dirs(
                 if (r < 0)
                         return log_error_errno(r, "Failed to generate template from unit name: %m");
 
-                r = unit_file_find_dirs(original_root, unit_path_cache, unit_path, template, suffix, dirs);
+                r = unit_file_dropin_names(template, names);
                 if (r < 0)
                         return r;
         }
@@ -240,7 +252,36 @@ static int unit_file_find_dirs(
         if (r < 0)
                 return log_error_errno(r, "Failed to build prefix unit name: %m");
 
-        return unit_file_find_dirs(original_root, unit_path_cache, unit_path, built, suffix, dirs);
+        return unit_file_dropin_names(built, names);
+}
+
+static int unit_file_find_dirs(
+                const char *original_root,
+                Set *unit_path_cache,
+                char **lookup_path,
+                const char *name,
+                const char *suffix,
+                char ***dirs) {
+
+        _cleanup_strv_free_ char **names = NULL;
+        int r;
+
+        assert(name);
+        assert(suffix);
+
+        /* The names are collected even if this fails half-way, hence search for whatever we got */
+        r = unit_file_dropin_names(name, &names);
+
+        STRV_FOREACH(p, lookup_path)
+                STRV_FOREACH(n, names) {
+                        int k;
+
+                        k = unit_file_find_dir(original_root, unit_path_cache, *p, *n, suffix, dirs);
+                        if (k < 0)
+                                return k;
+                }
+
+        return r;
 }
 
 int unit_file_find_dropin_paths(
@@ -260,12 +301,10 @@ int unit_file_find_dropin_paths(
         assert(ret);
 
         if (name)
-                STRV_FOREACH(p, lookup_path)
-                        (void) unit_file_find_dirs(original_root, unit_path_cache, *p, name, dir_suffix, &dirs);
+                (void) unit_file_find_dirs(original_root, unit_path_cache, lookup_path, name, dir_suffix, &dirs);
 
         SET_FOREACH(n, aliases)
-                STRV_FOREACH(p, lookup_path)
-                        (void) unit_file_find_dirs(original_root, unit_path_cache, *p, n, dir_suffix, &dirs);
+                (void) unit_file_find_dirs(original_root, unit_path_cache, lookup_path, n, dir_suffix, &dirs);
 
         /* All the names in the unit are of the same type so just grab one. */
         n = name ?: (const char*) set_first(aliases);
@@ -279,13 +318,12 @@ int unit_file_find_dropin_paths(
 
                 /* Special top level drop in for "<unit type>.<suffix>". Add this last as it's the most generic
                  * and should be able to be overridden by more specific drop-ins. */
-                STRV_FOREACH(p, lookup_path)
-                        (void) unit_file_find_dirs(original_root,
-                                                   unit_path_cache,
-                                                   *p,
-                                                   unit_type_to_string(type),
-                                                   dir_suffix,
-                                                   &dirs);
+                (void) unit_file_find_dirs(original_root,
+                                           unit_path_cache,
+                                           lookup_path,
+                                           unit_type_to_string(type),
+                                           dir_suffix,
+                                           &dirs);
         }
 
         if (strv_isempty(dirs)) {
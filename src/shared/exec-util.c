@@ -10,6 +10,7 @@
 #include "alloc-util.h"
 #include "bitfield.h"
 #include "conf-files.h"
+#include "cpu-set-util.h"
 #include "env-file.h"
 #include "env-util.h"
 #include "errno-util.h"
@@ -88,6 +89,40 @@ static int do_spawn(
         return 1;
 }
 
+/* Upper bound on the number of executables we run in parallel, per CPU. Starting all of them at once on
+ * systems with many generators or hooks only makes them fight over the CPUs and the page cache. */
+#define PARALLEL_EXECUTION_PER_CPU 4U
+#define PARALLEL_EXECUTION_MIN 8U
+
+static unsigned parallel_execution_max(void) {
+        int n;
+
+        n = cpus_in_affinity_mask();
+        if (n <= 0)
+                return PARALLEL_EXECUTION_MIN;
+
+        return MAX((unsigned) n * PARALLEL_EXECUTION_PER_CPU, PARALLEL_EXECUTION_MIN);
+}
+
+static int wait_for_one(Hashmap *pids, ExecDirFlags flags) {
+        _cleanup_free_ char *t = NULL;
+        pid_t pid;
+        void *p;
+        int r;
+
+        t = ASSERT_PTR(hashmap_steal_first_key_and_value(pids, &p));
+        pid = PTR_TO_PID(p);
+        assert(pid > 0);
+
+        r = wait_for_terminate_and_check(t, pid, WAIT_LOG);
+        if (r < 0)
+                return r;
+        if (!FLAGS_SET(flags, EXEC_DIR_IGNORE_ERRORS) && r > 0)
+                return r;
+
+        return 0;
+}
+
 static int do_execute(
                 char * const *paths,
                 const char *root,
@@ -100,6 +135,7 @@ static int do_execute(
                 ExecDirFlags flags) {
 
         _cleanup_hashmap_free_ Hashmap *pids = NULL;
+        unsigned parallel_max = 0;
         bool parallel_execution;
         int r;
 
@@ -113,6 +149,8 @@ static int do_execute(
         assert(!strv_isempty(paths));
 
         parallel_execution = FLAGS_SET(flags, EXEC_DIR_PARALLEL) && !callbacks;
+        if (parallel_execution)
+                parallel_max = parallel_execution_max();
 
         /* Abort execution of this process after the timeout. We simply rely on SIGALRM as
          * default action terminating the process, and turn on alarm(). */
@@ -145,6 +183,13 @@ static int do_execute(
                                 return log_error_errno(fd, "Failed to open serialization file: %m");
                 }
 
+                /* Don't start more executables than we allow to run at the same time, reap one first. */
+                if (parallel_execution && hashmap_size(pids) >= parallel_max) {
+                        r = wait_for_one(pids, flags);
+                        if (r != 0)
+                                return r;
+                }
+
                 if (DEBUG_LOGGING) {
                         _cleanup_free_ char *args = NULL;
                         if (argv)
@@ -214,18 +259,8 @@ static int do_execute(
         }
 
         while (!hashmap_isempty(pids)) {
-                _cleanup_free_ char *t = NULL;
-                pid_t pid;
-                void *p;
-
-                t = ASSERT_PTR(hashmap_steal_first_key_and_value(pids, &p));
-                pid = PTR_TO_PID(p);
-                assert(pid > 0);
-
-                r = wait_for_terminate_and_check(t, pid, WAIT_LOG);
-                if (r < 0)
-                        return r;
-                if (!FLAGS_SET(flags, EXEC_DIR_IGNORE_ERRORS) && r > 0)
+                r = wait_for_one(pids, flags);
+                if (r != 0)
                         return r;
         }
 
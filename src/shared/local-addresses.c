@@ -397,11 +397,25 @@ int local_gateways(
         if (r < 0)
                 return r;
 
+        if (ifindex > 0) {
+                /* With NETLINK_GET_STRICT_CHK the kernel then only dumps routes via the interface, rather
+                 * than all routes of the main table. We still filter below, for kernels that ignore it. */
+                r = sd_netlink_message_append_u32(req, RTA_OIF, ifindex);
+                if (r < 0)
+                        return r;
+        }
+
         r = sd_netlink_message_set_request_dump(req, true);
         if (r < 0)
                 return r;
 
         r = sd_netlink_call(rtnl, req, 0, &reply);
+        if (r == -ENODEV && ifindex > 0) {
+                /* The kernel refuses filtered dumps for non-existing interfaces. */
+                if (ret)
+                        *ret = NULL;
+                return 0;
+        }
         if (r < 0)
                 return r;
 
@@ -1063,7 +1063,8 @@ void json_escape(
 
 typedef struct JsonData {
         sd_json_variant* name;
-        sd_json_variant* values;
+        sd_json_variant* value;  /* The first value of the field */
+        sd_json_variant* values; /* All values, only allocated once a field appears more than once */
 } JsonData;
 
 static JsonData* json_data_free(JsonData *d) {
@@ -1071,6 +1072,7 @@ static JsonData* json_data_free(JsonData *d) {
                 return NULL;
 
         sd_json_variant_unref(d->name);
+        sd_json_variant_unref(d->value);
         sd_json_variant_unref(d->values);
 
         return mfree(d);
@@ -1110,24 +1112,32 @@ static int update_json_data(
 
         d = hashmap_get(h, name);
         if (d) {
+                /* Fields that appear more than once are rare, hence only create the array on demand, and
+                 * keep single values unwrapped. */
+                if (!d->values) {
+                        r = sd_json_variant_append_array(&d->values, d->value);
+                        if (r < 0)
+                                return log_error_errno(r, "Failed to create JSON value array: %m");
+                }
+
                 r = sd_json_variant_append_array(&d->values, v);
                 if (r < 0)
                         return log_error_errno(r, "Failed to append JSON value into array: %m");
         } else {
                 _cleanup_(json_data_freep) JsonData *e = NULL;
 
-                e = new0(JsonData, 1);
+                e = new(JsonData, 1);
                 if (!e)
                         return log_oom();
 
+                *e = (JsonData) {
+                        .value = TAKE_PTR(v),
+                };
+
                 r = sd_json_variant_new_string(&e->name, name);
                 if (r < 0)
                         return log_error_errno(r, "Failed to allocate JSON name variant: %m");
 
-                r = sd_json_variant_append_array(&e->values, v);
-                if (r < 0)
-                        return log_error_errno(r, "Failed to create JSON value array: %m");
-
                 r = hashmap_put(h, sd_json_variant_string(e->name), e);
                 if (r < 0)
                         return log_error_errno(r, "Failed to insert JSON data into hashmap: %m");
@@ -1270,14 +1280,10 @@ static int output_json(
         CLEANUP_ARRAY(array, n, sd_json_variant_unref_many);
 
         HASHMAP_FOREACH(d, h) {
-                assert(sd_json_variant_elements(d->values) > 0);
+                assert(d->value);
 
                 array[n++] = sd_json_variant_ref(d->name);
-
-                if (sd_json_variant_elements(d->values) == 1)
-                        array[n++] = sd_json_variant_ref(sd_json_variant_by_index(d->values, 0));
-                else
-                        array[n++] = sd_json_variant_ref(d->values);
+                array[n++] = sd_json_variant_ref(d->values ?: d->value);
         }
 
         r = sd_json_variant_new_object(&object, array, n);
@@ -1788,6 +1794,7 @@ int add_match_this_boot(sd_journal *j, const char *machine) {
 
 int show_journal_by_unit(
                 FILE *f,
+                sd_journal **journal,
                 const char *unit,
                 const char *log_namespace,
                 OutputMode mode,
@@ -1799,22 +1806,43 @@ int show_journal_by_unit(
                 bool system_unit,
                 bool *ellipsized) {
 
-        _cleanup_(sd_journal_closep) sd_journal *j = NULL;
+        _cleanup_(sd_journal_closep) sd_journal *opened = NULL;
+        sd_journal *j;
         int r;
 
         assert(mode >= 0);
         assert(mode < _OUTPUT_MODE_MAX);
         assert(unit);
 
+        /* If 'journal' is non-NULL, the journal object it points to is reused if there is one, and a newly
+         * opened one is returned in it otherwise. This way callers showing the logs of many units in a row
+         * only have to open and map all journal files once. The caller has to make sure that the same log
+         * namespace and open flags are used for all invocations then. */
+
         if (how_many <= 0)
                 return 0;
 
-        r = sd_journal_open_namespace(&j, log_namespace,
-                                      journal_open_flags |
-                                      SD_JOURNAL_INCLUDE_DEFAULT_NAMESPACE |
-                                      SD_JOURNAL_ASSUME_IMMUTABLE);
-        if (r < 0)
-                return log_error_errno(r, "Failed to open journal: %m");
+        if (journal && *journal) {
+                j = *journal;
+
+                sd_journal_flush_matches(j);
+
+                r = sd_journal_seek_head(j);
+                if (r < 0)
+                        return log_error_errno(r, "Failed to seek to head: %m");
+        } else {
+                r = sd_journal_open_namespace(&opened, log_namespace,
+                                              journal_open_flags |
+                                              SD_JOURNAL_INCLUDE_DEFAULT_NAMESPACE |
+                                              SD_JOURNAL_ASSUME_IMMUTABLE);
+                if (r < 0)
+                        return log_error_errno(r, "Failed to open journal: %m");
+
+                if (journal)
+                        j = *journal = TAKE_PTR(opened);
+                else
+                        j = opened;
+        }
 
         if (system_unit)
                 r = add_matches_for_unit(j, unit);
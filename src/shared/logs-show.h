@@ -75,6 +75,7 @@ static inline int add_matches_for_user_unit(sd_journal *j, const char *unit) {
 
 int show_journal_by_unit(
                 FILE *f,
+                sd_journal **journal,
                 const char *unit,
                 const char *namespace,
                 OutputMode mode,
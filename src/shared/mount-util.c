@@ -140,6 +140,20 @@ static uint64_t ms_flags_to_mount_attr(unsigned long a) {
 
 static bool skip_mount_set_attr = false;
 
+static bool deny_list_has_submounts(char **deny_list, const char *prefix) {
+        assert(prefix);
+
+        /* Returns true if any of the deny-listed paths is located strictly below the prefix, i.e. if it
+         * will actually affect the remount operation. Entries for the prefix itself or outside of it are
+         * ignored by bind_remount_recursive_with_mountinfo() anyway. */
+
+        STRV_FOREACH(i, deny_list)
+                if (!path_equal(*i, prefix) && path_startswith(*i, prefix))
+                        return true;
+
+        return false;
+}
+
 /* Use this function only if you do not have direct access to /proc/self/mountinfo but the caller can open it
  * for you. This is the case when /proc is masked or not mounted. Otherwise, use bind_remount_recursive. */
 int bind_remount_recursive_with_mountinfo(
@@ -156,7 +170,7 @@ int bind_remount_recursive_with_mountinfo(
 
         assert(prefix);
 
-        if ((flags_mask & ~MS_CONVERTIBLE_FLAGS) == 0 && strv_isempty(deny_list) && !skip_mount_set_attr) {
+        if ((flags_mask & ~MS_CONVERTIBLE_FLAGS) == 0 && !deny_list_has_submounts(deny_list, prefix) && !skip_mount_set_attr) {
                 /* Let's take a shortcut for all the flags we know how to convert into mount_setattr() flags */
 
                 if (mount_setattr(AT_FDCWD, prefix, AT_SYMLINK_NOFOLLOW|AT_RECURSIVE,
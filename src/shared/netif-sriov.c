@@ -100,16 +100,12 @@ DEFINE_PRIVATE_HASH_OPS(
         sr_iov_hash_func,
         sr_iov_compare_func);
 
-int sr_iov_set_netlink_message(SRIOV *sr_iov, sd_netlink_message *req) {
+static int sr_iov_append_vf_info(SRIOV *sr_iov, sd_netlink_message *req) {
         int r;
 
         assert(sr_iov);
         assert(req);
 
-        r = sd_netlink_message_open_container(req, IFLA_VFINFO_LIST);
-        if (r < 0)
-                return r;
-
         r = sd_netlink_message_open_container(req, IFLA_VF_INFO);
         if (r < 0)
                 return r;
@@ -190,15 +186,46 @@ int sr_iov_set_netlink_message(SRIOV *sr_iov, sd_netlink_message *req) {
                         return r;
         }
 
-        r = sd_netlink_message_close_container(req);
+        return sd_netlink_message_close_container(req);
+}
+
+int sr_iov_set_netlink_message(SRIOV *sr_iov, sd_netlink_message *req) {
+        int r;
+
+        assert(sr_iov);
+        assert(req);
+
+        r = sd_netlink_message_open_container(req, IFLA_VFINFO_LIST);
         if (r < 0)
                 return r;
 
-        r = sd_netlink_message_close_container(req);
+        r = sr_iov_append_vf_info(sr_iov, req);
         if (r < 0)
                 return r;
 
-        return 0;
+        return sd_netlink_message_close_container(req);
+}
+
+int sr_iov_set_netlink_message_many(OrderedHashmap *sr_iov_by_section, sd_netlink_message *req) {
+        SRIOV *sr_iov;
+        int r;
+
+        assert(req);
+
+        /* The kernel applies all IFLA_VF_INFO attributes in IFLA_VFINFO_LIST in order, hence settings for
+         * all virtual functions can be sent in a single RTM_SETLINK message. */
+
+        r = sd_netlink_message_open_container(req, IFLA_VFINFO_LIST);
+        if (r < 0)
+                return r;
+
+        ORDERED_HASHMAP_FOREACH(sr_iov, sr_iov_by_section) {
+                r = sr_iov_append_vf_info(sr_iov, req);
+                if (r < 0)
+                        return r;
+        }
+
+        return sd_netlink_message_close_container(req);
 }
 
 int sr_iov_get_num_vfs(sd_device *device, uint32_t *ret) {
@@ -3,6 +3,7 @@
 #include "dlfcn-util.h"
 #include "log.h"
 #include "pcre2-util.h"
+#include "process-util.h"
 
 #if HAVE_PCRE2
 static void *pcre2_dl = NULL;
@@ -11,10 +12,34 @@ DLSYM_PROTOTYPE(pcre2_match_data_create) = NULL;
 DLSYM_PROTOTYPE(pcre2_match_data_free) = NULL;
 DLSYM_PROTOTYPE(pcre2_code_free) = NULL;
 DLSYM_PROTOTYPE(pcre2_compile) = NULL;
+DLSYM_PROTOTYPE(pcre2_jit_compile) = NULL;
 DLSYM_PROTOTYPE(pcre2_get_error_message) = NULL;
 DLSYM_PROTOTYPE(pcre2_match) = NULL;
 DLSYM_PROTOTYPE(pcre2_get_ovector_pointer) = NULL;
 
+/* Allocating match data costs about as much as matching a short log message, hence keep one around for the
+ * main thread. A single ovector pair is all we ever use, so it can be shared between patterns. */
+static pcre2_match_data *cached_match_data = NULL;
+
+static pcre2_match_data* match_data_acquire(void) {
+        if (cached_match_data && is_main_thread())
+                return TAKE_PTR(cached_match_data);
+
+        return sym_pcre2_match_data_create(1, NULL);
+}
+
+static void match_data_release(pcre2_match_data *md) {
+        if (!md)
+                return;
+
+        if (!cached_match_data && is_main_thread())
+                cached_match_data = md;
+        else
+                sym_pcre2_match_data_free(md);
+}
+
+DEFINE_TRIVIAL_CLEANUP_FUNC_FULL(pcre2_match_data*, match_data_release, NULL);
+
 DEFINE_HASH_OPS_WITH_KEY_DESTRUCTOR(
         pcre2_code_hash_ops_free,
         pcre2_code,
@@ -46,6 +71,7 @@ int dlopen_pcre2(void) {
                         DLSYM_ARG(pcre2_match_data_free),
                         DLSYM_ARG(pcre2_code_free),
                         DLSYM_ARG(pcre2_compile),
+                        DLSYM_ARG(pcre2_jit_compile),
                         DLSYM_ARG(pcre2_get_error_message),
                         DLSYM_ARG(pcre2_match),
                         DLSYM_ARG(pcre2_get_ovector_pointer));
@@ -104,6 +130,12 @@ int pattern_compile_and_log(const char *pattern, PatternCompileCase case_, pcre2
                                        r < 0 ? "unknown error" : (char *)buf);
         }
 
+        /* Patterns are typically matched against a lot of log messages, hence JIT compile them. If JIT
+         * support is not available, pcre2_match() silently falls back to the interpreter. */
+        r = sym_pcre2_jit_compile(p, PCRE2_JIT_COMPLETE);
+        if (r < 0)
+                log_debug("JIT compilation of pattern \"%s\" failed, using interpreter: %i", pattern, r);
+
         if (ret)
                 *ret = TAKE_PTR(p);
 
@@ -115,7 +147,7 @@ int pattern_compile_and_log(const char *pattern, PatternCompileCase case_, pcre2
 
 int pattern_matches_and_log(pcre2_code *compiled_pattern, const char *message, size_t size, size_t *ret_ovec) {
 #if HAVE_PCRE2
-        _cleanup_(sym_pcre2_match_data_freep) pcre2_match_data *md = NULL;
+        _cleanup_(match_data_releasep) pcre2_match_data *md = NULL;
         int r;
 
         assert(compiled_pattern);
@@ -124,7 +156,7 @@ int pattern_matches_and_log(pcre2_code *compiled_pattern, const char *message, s
          * dlopens pcre2 so we can assert on it being available here. */
         assert(pcre2_dl);
 
-        md = sym_pcre2_match_data_create(1, NULL);
+        md = match_data_acquire();
         if (!md)
                 return log_oom();
 
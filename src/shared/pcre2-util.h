@@ -15,6 +15,7 @@ extern DLSYM_PROTOTYPE(pcre2_match_data_create);
 extern DLSYM_PROTOTYPE(pcre2_match_data_free);
 extern DLSYM_PROTOTYPE(pcre2_code_free);
 extern DLSYM_PROTOTYPE(pcre2_compile);
+extern DLSYM_PROTOTYPE(pcre2_jit_compile);
 extern DLSYM_PROTOTYPE(pcre2_get_error_message);
 extern DLSYM_PROTOTYPE(pcre2_match);
 extern DLSYM_PROTOTYPE(pcre2_get_ovector_pointer);
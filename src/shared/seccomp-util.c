@@ -1109,7 +1109,37 @@ static uint32_t override_default_action(uint32_t default_action) {
         return SCMP_ACT_ERRNO(ENOSYS);
 }
 
+static int resolve_known_syscalls(int **ret, size_t *ret_n) {
+        _cleanup_free_ int *ids = NULL;
+        size_t n = 0;
+
+        assert(ret);
+        assert(ret_n);
+
+        /* Resolves the names in @known once, so that we don't have to do that again for each
+         * architecture we install filters for. */
+
+        NULSTR_FOREACH(name, syscall_filter_sets[SYSCALL_FILTER_SET_KNOWN].value) {
+                int id;
+
+                id = seccomp_syscall_resolve_name(name);
+                if (id < 0)
+                        continue;
+
+                if (!GREEDY_REALLOC(ids, n + 1))
+                        return -ENOMEM;
+
+                ids[n++] = id;
+        }
+
+        *ret = TAKE_PTR(ids);
+        *ret_n = n;
+        return 0;
+}
+
 int seccomp_load_syscall_filter_set(uint32_t default_action, const SyscallFilterSet *set, uint32_t action, bool log_missing) {
+        _cleanup_free_ int *known = NULL;
+        size_t n_known = 0;
         uint32_t arch, default_action_override;
         int r;
 
@@ -1120,8 +1150,15 @@ int seccomp_load_syscall_filter_set(uint32_t default_action, const SyscallFilter
 
         default_action_override = override_default_action(default_action);
 
+        if (default_action != default_action_override) {
+                r = resolve_known_syscalls(&known, &n_known);
+                if (r < 0)
+                        return r;
+        }
+
         SECCOMP_FOREACH_LOCAL_ARCH(arch) {
                 _cleanup_(seccomp_releasep) scmp_filter_ctx seccomp = NULL;
+                _cleanup_set_free_ Set *added_ids = NULL;
                 _cleanup_strv_free_ char **added = NULL;
 
                 log_trace("Operating on architecture: %s", seccomp_arch_to_string(arch));
@@ -1134,23 +1171,33 @@ int seccomp_load_syscall_filter_set(uint32_t default_action, const SyscallFilter
                 if (r < 0)
                         return log_debug_errno(r, "Failed to add filter set: %m");
 
-                if (default_action != default_action_override)
-                        NULSTR_FOREACH(name, syscall_filter_sets[SYSCALL_FILTER_SET_KNOWN].value) {
+                if (default_action != default_action_override) {
+                        /* Turn the list of handled names into a set of IDs, so that we don't have to do a
+                         * string search for each of the known system calls below. */
+                        STRV_FOREACH(name, added) {
                                 int id;
 
-                                id = seccomp_syscall_resolve_name(name);
+                                id = seccomp_syscall_resolve_name(*name);
                                 if (id < 0)
                                         continue;
 
+                                r = set_ensure_put(&added_ids, NULL, INT_TO_PTR(id + 1));
+                                if (r < 0)
+                                        return r;
+                        }
+
+                        FOREACH_ARRAY(id, known, n_known) {
                                 /* Ignore the syscall if it was already handled above */
-                                if (strv_contains(added, name))
+                                if (set_contains(added_ids, INT_TO_PTR(*id + 1)))
                                         continue;
 
-                                r = seccomp_rule_add_exact(seccomp, default_action, id, 0);
-                                if (r < 0 && r != -EDOM)  /* EDOM means that the syscall is not available for arch */
-                                        return log_debug_errno(r, "Failed to add rule for system call %s() / %d: %m",
-                                                               name, id);
+                                r = seccomp_rule_add_exact(seccomp, default_action, *id, 0);
+                                if (r < 0 && r != -EDOM) { /* EDOM means that the syscall is not available for arch */
+                                        _cleanup_free_ char *n = seccomp_syscall_resolve_num_arch(SCMP_ARCH_NATIVE, *id);
+                                        return log_debug_errno(r, "Failed to add rule for system call %s() / %d: %m", strna(n), *id);
+                                }
                         }
+                }
 
 #if (SCMP_VER_MAJOR == 2 && SCMP_VER_MINOR >= 5) || SCMP_VER_MAJOR > 2
                 /* We have a large filter here, so let's turn on the binary tree mode if possible. */
@@ -1171,6 +1218,8 @@ int seccomp_load_syscall_filter_set(uint32_t default_action, const SyscallFilter
 }
 
 int seccomp_load_syscall_filter_set_raw(uint32_t default_action, Hashmap* filter, uint32_t action, bool log_missing) {
+        _cleanup_free_ int *known = NULL;
+        size_t n_known = 0;
         uint32_t arch, default_action_override;
         int r;
 
@@ -1182,6 +1231,12 @@ int seccomp_load_syscall_filter_set_raw(uint32_t default_action, Hashmap* filter
 
         default_action_override = override_default_action(default_action);
 
+        if (default_action != default_action_override) {
+                r = resolve_known_syscalls(&known, &n_known);
+                if (r < 0)
+                        return r;
+        }
+
         SECCOMP_FOREACH_LOCAL_ARCH(arch) {
                 _cleanup_(seccomp_releasep) scmp_filter_ctx seccomp = NULL;
                 void *syscall_id, *val;
@@ -1223,23 +1278,17 @@ int seccomp_load_syscall_filter_set_raw(uint32_t default_action, Hashmap* filter
                         }
                 }
 
-                if (default_action != default_action_override)
-                        NULSTR_FOREACH(name, syscall_filter_sets[SYSCALL_FILTER_SET_KNOWN].value) {
-                                int id;
-
-                                id = seccomp_syscall_resolve_name(name);
-                                if (id < 0)
-                                        continue;
-
-                                /* Ignore the syscall if it was already handled above */
-                                if (hashmap_contains(filter, INT_TO_PTR(id + 1)))
-                                        continue;
+                FOREACH_ARRAY(id, known, n_known) {
+                        /* Ignore the syscall if it was already handled above */
+                        if (hashmap_contains(filter, INT_TO_PTR(*id + 1)))
+                                continue;
 
-                                r = seccomp_rule_add_exact(seccomp, default_action, id, 0);
-                                if (r < 0 && r != -EDOM)  /* EDOM means that the syscall is not available for arch */
-                                        return log_debug_errno(r, "Failed to add rule for system call %s() / %d: %m",
-                                                               name, id);
+                        r = seccomp_rule_add_exact(seccomp, default_action, *id, 0);
+                        if (r < 0 && r != -EDOM) { /* EDOM means that the syscall is not available for arch */
+                                _cleanup_free_ char *n = seccomp_syscall_resolve_num_arch(SCMP_ARCH_NATIVE, *id);
+                                return log_debug_errno(r, "Failed to add rule for system call %s() / %d: %m", strna(n), *id);
                         }
+                }
 
 #if (SCMP_VER_MAJOR == 2 && SCMP_VER_MINOR >= 5) || SCMP_VER_MAJOR > 2
                 /* We have a large filter here, so let's turn on the binary tree mode if possible. */
@@ -329,7 +329,9 @@ int deserialize_read_line(FILE *f, char **ret) {
         assert(f);
         assert(ret);
 
-        r = read_stripped_line(f, LONG_LINE_MAX, &line);
+        /* Serialization data never comes from a TTY, tell read_line_full() so, so that it doesn't have to
+         * check that with an ioctl() for every single line. */
+        r = read_stripped_line_full(f, LONG_LINE_MAX, READ_LINE_NOT_A_TTY, &line);
         if (r < 0)
                 return log_error_errno(r, "Failed to read serialization line: %m");
         if (r == 0) { /* eof */
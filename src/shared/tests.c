@@ -26,8 +26,10 @@
 #include "path-util.h"
 #include "process-util.h"
 #include "random-util.h"
+#include "sort-util.h"
 #include "strv.h"
 #include "tests.h"
+#include "time-util.h"
 #include "tmpfile-util.h"
 #include "uid-range.h"
 
@@ -368,3 +370,40 @@ const char* ci_environment(void) {
 
         return (ans = NULL);
 }
+
+static int usec_compare(const usec_t *a, const usec_t *b) {
+        return CMP(*a, *b);
+}
+
+void benchmark_run(const char *name, unsigned iterations, benchmark_func_t func, void *userdata) {
+        _cleanup_free_ usec_t *samples = NULL;
+        unsigned warmups;
+
+        assert(name);
+        assert(iterations > 0);
+        assert(func);
+
+        samples = new(usec_t, iterations);
+        assert_se(samples);
+
+        /* Populate caches and let the allocator settle before we start measuring. */
+        warmups = MAX(iterations / 10, 1U);
+        for (unsigned i = 0; i < warmups; i++)
+                func(userdata);
+
+        for (unsigned i = 0; i < iterations; i++) {
+                usec_t ts = now(CLOCK_MONOTONIC);
+
+                func(userdata);
+                samples[i] = usec_sub_unsigned(now(CLOCK_MONOTONIC), ts);
+        }
+
+        typesafe_qsort(samples, iterations, usec_compare);
+
+        log_info("%s: %u iterations, min %s, median %s, p95 %s, max %s",
+                 name, iterations,
+                 FORMAT_TIMESPAN(samples[0], 1),
+                 FORMAT_TIMESPAN(samples[iterations / 2], 1),
+                 FORMAT_TIMESPAN(samples[(iterations * 95) / 100], 1),
+                 FORMAT_TIMESPAN(samples[iterations - 1], 1));
+}
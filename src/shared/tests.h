@@ -98,6 +98,12 @@ bool can_memlock(void);
 /* Provide a convenient way to check if we're running in CI. */
 const char* ci_environment(void);
 
+/* Runs func() for a number of warmup rounds, then the specified number of measured rounds, and logs the
+ * minimum, median, 95th percentile and maximum wall clock time of a single round. Meant for keeping an eye
+ * on hot paths across changes, not for gating tests on timing. */
+typedef void (*benchmark_func_t)(void *userdata);
+void benchmark_run(const char *name, unsigned iterations, benchmark_func_t func, void *userdata);
+
 typedef struct TestFunc {
         union f {
                 void (*void_func)(void);
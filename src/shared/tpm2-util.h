@@ -377,6 +377,11 @@ typedef struct {} Tpm2Context;
 typedef struct {} Tpm2Handle;
 typedef struct {} Tpm2PCRValue;
 
+static inline Tpm2Context *tpm2_context_unref(Tpm2Context *context) {
+        return NULL;
+}
+DEFINE_TRIVIAL_CLEANUP_FUNC(Tpm2Context*, tpm2_context_unref);
+
 #define TPM2_PCR_VALUE_MAKE(i, h, v) (Tpm2PCRValue) {}
 
 static inline int tpm2_pcrlock_search_file(const char *path, FILE **ret_file, char **ret_path) {
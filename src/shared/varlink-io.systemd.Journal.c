@@ -7,6 +7,41 @@ static SD_VARLINK_DEFINE_METHOD(Rotate);
 static SD_VARLINK_DEFINE_METHOD(FlushToVar);
 static SD_VARLINK_DEFINE_METHOD(RelinquishVar);
 
+static SD_VARLINK_DEFINE_STRUCT_TYPE(
+                ClientContextCacheStatistics,
+                SD_VARLINK_FIELD_COMMENT("Number of client contexts currently cached."),
+                SD_VARLINK_DEFINE_FIELD(size, SD_VARLINK_INT, 0),
+                SD_VARLINK_FIELD_COMMENT("Number of unpinned client contexts the cache is shrunk to when a new one is added."),
+                SD_VARLINK_DEFINE_FIELD(maxSize, SD_VARLINK_INT, 0),
+                SD_VARLINK_FIELD_COMMENT("Number of lookups that found a cached client context."),
+                SD_VARLINK_DEFINE_FIELD(hits, SD_VARLINK_INT, 0),
+                SD_VARLINK_FIELD_COMMENT("Number of lookups that had to create a new client context."),
+                SD_VARLINK_DEFINE_FIELD(misses, SD_VARLINK_INT, 0),
+                SD_VARLINK_FIELD_COMMENT("Number of client contexts dropped to make room for new ones."),
+                SD_VARLINK_DEFINE_FIELD(evictions, SD_VARLINK_INT, 0),
+                SD_VARLINK_FIELD_COMMENT("Number of times client metadata was read from /proc/ and the cgroup file system."),
+                SD_VARLINK_DEFINE_FIELD(refreshes, SD_VARLINK_INT, 0));
+
+static SD_VARLINK_DEFINE_STRUCT_TYPE(
+                RateLimitGroupStatistics,
+                SD_VARLINK_FIELD_COMMENT("Number of rate limit groups currently tracked."),
+                SD_VARLINK_DEFINE_FIELD(size, SD_VARLINK_INT, 0),
+                SD_VARLINK_FIELD_COMMENT("Maximum number of rate limit groups, as configured with RateLimitGroupsMax=."),
+                SD_VARLINK_DEFINE_FIELD(maxSize, SD_VARLINK_INT, 0),
+                SD_VARLINK_FIELD_COMMENT("Number of lookups that found an existing rate limit group."),
+                SD_VARLINK_DEFINE_FIELD(hits, SD_VARLINK_INT, 0),
+                SD_VARLINK_FIELD_COMMENT("Number of lookups that had to create a new rate limit group."),
+                SD_VARLINK_DEFINE_FIELD(misses, SD_VARLINK_INT, 0),
+                SD_VARLINK_FIELD_COMMENT("Number of rate limit groups dropped while still active, to make room for new ones."),
+                SD_VARLINK_DEFINE_FIELD(evictions, SD_VARLINK_INT, 0));
+
+static SD_VARLINK_DEFINE_METHOD(
+                DumpStatistics,
+                SD_VARLINK_FIELD_COMMENT("Statistics of the client metadata cache."),
+                SD_VARLINK_DEFINE_OUTPUT_BY_TYPE(clientContextCache, ClientContextCacheStatistics, 0),
+                SD_VARLINK_FIELD_COMMENT("Statistics of the per-unit rate limit groups."),
+                SD_VARLINK_DEFINE_OUTPUT_BY_TYPE(rateLimitGroups, RateLimitGroupStatistics, 0));
+
 static SD_VARLINK_DEFINE_ERROR(NotSupportedByNamespaces);
 
 SD_VARLINK_DEFINE_INTERFACE(
@@ -16,4 +51,8 @@ SD_VARLINK_DEFINE_INTERFACE(
                 &vl_method_Rotate,
                 &vl_method_FlushToVar,
                 &vl_method_RelinquishVar,
+                SD_VARLINK_SYMBOL_COMMENT("Returns statistics of the internal caches of the journal daemon."),
+                &vl_method_DumpStatistics,
+                &vl_type_ClientContextCacheStatistics,
+                &vl_type_RateLimitGroupStatistics,
                 &vl_error_NotSupportedByNamespaces);
@@ -44,6 +44,23 @@ static SD_VARLINK_DEFINE_METHOD(
                 SetPersistentStorage,
                 SD_VARLINK_DEFINE_INPUT(Ready, SD_VARLINK_BOOL, 0));
 
+static SD_VARLINK_DEFINE_STRUCT_TYPE(
+                LinkState,
+                SD_VARLINK_DEFINE_FIELD(InterfaceIndex, SD_VARLINK_INT, 0),
+                SD_VARLINK_DEFINE_FIELD(InterfaceName, SD_VARLINK_STRING, 0),
+                SD_VARLINK_DEFINE_FIELD(SetupState, SD_VARLINK_STRING, 0),
+                SD_VARLINK_DEFINE_FIELD(OperationalState, SD_VARLINK_STRING, 0),
+                SD_VARLINK_DEFINE_FIELD(IPv4AddressState, SD_VARLINK_STRING, 0),
+                SD_VARLINK_DEFINE_FIELD(IPv6AddressState, SD_VARLINK_STRING, 0),
+                SD_VARLINK_DEFINE_FIELD(RequiredForOnline, SD_VARLINK_BOOL, SD_VARLINK_NULLABLE),
+                SD_VARLINK_DEFINE_FIELD(RequiredOperationalStateForOnline, SD_VARLINK_STRING, SD_VARLINK_NULLABLE),
+                SD_VARLINK_DEFINE_FIELD(RequiredFamilyForOnline, SD_VARLINK_STRING, SD_VARLINK_NULLABLE));
+
+static SD_VARLINK_DEFINE_METHOD_FULL(
+                SubscribeLinkStates,
+                SD_VARLINK_REQUIRES_MORE,
+                SD_VARLINK_DEFINE_OUTPUT_BY_TYPE(Link, LinkState, 0));
+
 static SD_VARLINK_DEFINE_ERROR(StorageReadOnly);
 
 SD_VARLINK_DEFINE_INTERFACE(
@@ -53,6 +70,9 @@ SD_VARLINK_DEFINE_INTERFACE(
                 &vl_method_GetNamespaceId,
                 &vl_method_GetLLDPNeighbors,
                 &vl_method_SetPersistentStorage,
+                SD_VARLINK_SYMBOL_COMMENT("Sends the state of a link whenever it changes. The current states of all links are sent immediately when this method is invoked."),
+                &vl_method_SubscribeLinkStates,
                 &vl_type_LLDPNeighbor,
                 &vl_type_LLDPNeighborsByInterface,
+                &vl_type_LinkState,
                 &vl_error_StorageReadOnly);
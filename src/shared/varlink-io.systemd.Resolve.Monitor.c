@@ -92,7 +92,9 @@ static SD_VARLINK_DEFINE_STRUCT_TYPE(
                 CacheStatistics,
                 SD_VARLINK_DEFINE_FIELD(size, SD_VARLINK_INT, 0),
                 SD_VARLINK_DEFINE_FIELD(hits, SD_VARLINK_INT, 0),
-                SD_VARLINK_DEFINE_FIELD(misses, SD_VARLINK_INT, 0));
+                SD_VARLINK_DEFINE_FIELD(misses, SD_VARLINK_INT, 0),
+                SD_VARLINK_FIELD_COMMENT("Number of entries removed from the cache to make room for new ones."),
+                SD_VARLINK_DEFINE_FIELD(evictions, SD_VARLINK_INT, SD_VARLINK_NULLABLE));
 
 static SD_VARLINK_DEFINE_STRUCT_TYPE(
                 DnssecStatistics,
@@ -0,0 +1,38 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include "varlink-io.systemd.Unit.h"
+
+static SD_VARLINK_DEFINE_METHOD_FULL(
+                List,
+                SD_VARLINK_SUPPORTS_MORE,
+                SD_VARLINK_FIELD_COMMENT("If non-null, the name of the unit to return. If null, all loaded units are returned, which requires the 'more' flag to be set."),
+                SD_VARLINK_DEFINE_INPUT(name, SD_VARLINK_STRING, SD_VARLINK_NULLABLE),
+                SD_VARLINK_FIELD_COMMENT("The primary name of the unit"),
+                SD_VARLINK_DEFINE_OUTPUT(id, SD_VARLINK_STRING, 0),
+                SD_VARLINK_FIELD_COMMENT("The human readable description of the unit"),
+                SD_VARLINK_DEFINE_OUTPUT(description, SD_VARLINK_STRING, 0),
+                SD_VARLINK_FIELD_COMMENT("The load state of the unit, i.e. whether its configuration was loaded successfully"),
+                SD_VARLINK_DEFINE_OUTPUT(loadState, SD_VARLINK_STRING, 0),
+                SD_VARLINK_FIELD_COMMENT("The high-level activation state of the unit"),
+                SD_VARLINK_DEFINE_OUTPUT(activeState, SD_VARLINK_STRING, 0),
+                SD_VARLINK_FIELD_COMMENT("The freezer state of the unit"),
+                SD_VARLINK_DEFINE_OUTPUT(freezerState, SD_VARLINK_STRING, 0),
+                SD_VARLINK_FIELD_COMMENT("The low-level, unit type specific activation state of the unit"),
+                SD_VARLINK_DEFINE_OUTPUT(subState, SD_VARLINK_STRING, 0),
+                SD_VARLINK_FIELD_COMMENT("If non-null, the name of the unit this unit follows in state"),
+                SD_VARLINK_DEFINE_OUTPUT(following, SD_VARLINK_STRING, SD_VARLINK_NULLABLE),
+                SD_VARLINK_FIELD_COMMENT("If non-null, the ID of the job currently queued for the unit"),
+                SD_VARLINK_DEFINE_OUTPUT(jobId, SD_VARLINK_INT, SD_VARLINK_NULLABLE),
+                SD_VARLINK_FIELD_COMMENT("If non-null, the type of the job currently queued for the unit"),
+                SD_VARLINK_DEFINE_OUTPUT(jobType, SD_VARLINK_STRING, SD_VARLINK_NULLABLE));
+
+static SD_VARLINK_DEFINE_ERROR(NoSuchUnit);
+
+SD_VARLINK_DEFINE_INTERFACE(
+                io_systemd_Unit,
+                "io.systemd.Unit",
+                SD_VARLINK_INTERFACE_COMMENT("An interface for querying units of the service manager"),
+                SD_VARLINK_SYMBOL_COMMENT("List units, in the same way as the ListUnits() D-Bus call does"),
+                &vl_method_List,
+                SD_VARLINK_SYMBOL_COMMENT("No unit by the specified name is loaded"),
+                &vl_error_NoSuchUnit);
@@ -4,6 +4,7 @@
 
 #include "env-util.h"
 #include "json-util.h"
+#include "mallinfo-util.h"
 #include "strv.h"
 #include "varlink-io.systemd.service.h"
 
@@ -21,6 +22,23 @@ static SD_VARLINK_DEFINE_METHOD(
                 SD_VARLINK_FIELD_COMMENT("Returns the current environment block, i.e. the contents of environ[]."),
                 SD_VARLINK_DEFINE_OUTPUT(environment, SD_VARLINK_STRING, SD_VARLINK_NULLABLE|SD_VARLINK_ARRAY));
 
+static SD_VARLINK_DEFINE_METHOD(
+                GetMemoryStatistics,
+                SD_VARLINK_FIELD_COMMENT("Bytes of heap memory allocated via brk()/sbrk(), i.e. not mmap()ed."),
+                SD_VARLINK_DEFINE_OUTPUT(arenaBytes, SD_VARLINK_INT, SD_VARLINK_NULLABLE),
+                SD_VARLINK_FIELD_COMMENT("Bytes of heap memory in use by allocations."),
+                SD_VARLINK_DEFINE_OUTPUT(usedBytes, SD_VARLINK_INT, SD_VARLINK_NULLABLE),
+                SD_VARLINK_FIELD_COMMENT("Bytes of heap memory on free lists, i.e. not in use, but not returned to the kernel either."),
+                SD_VARLINK_DEFINE_OUTPUT(freeBytes, SD_VARLINK_INT, SD_VARLINK_NULLABLE),
+                SD_VARLINK_FIELD_COMMENT("Number of free chunks, an indication of heap fragmentation."),
+                SD_VARLINK_DEFINE_OUTPUT(freeChunks, SD_VARLINK_INT, SD_VARLINK_NULLABLE),
+                SD_VARLINK_FIELD_COMMENT("Bytes at the top of the heap that could be released with malloc_trim()."),
+                SD_VARLINK_DEFINE_OUTPUT(releasableBytes, SD_VARLINK_INT, SD_VARLINK_NULLABLE),
+                SD_VARLINK_FIELD_COMMENT("Number of allocations that are backed by separate mmap()ed regions."),
+                SD_VARLINK_DEFINE_OUTPUT(mappedRegions, SD_VARLINK_INT, SD_VARLINK_NULLABLE),
+                SD_VARLINK_FIELD_COMMENT("Bytes in allocations that are backed by separate mmap()ed regions."),
+                SD_VARLINK_DEFINE_OUTPUT(mappedBytes, SD_VARLINK_INT, SD_VARLINK_NULLABLE));
+
 static SD_VARLINK_DEFINE_ERROR(
                 InconsistentEnvironment);
 
@@ -36,6 +54,8 @@ SD_VARLINK_DEFINE_INTERFACE(
                 &vl_method_SetLogLevel,
                 SD_VARLINK_SYMBOL_COMMENT("Get current environment block."),
                 &vl_method_GetEnvironment,
+                SD_VARLINK_SYMBOL_COMMENT("Get statistics about the heap memory of the service, as reported by the C library's allocator. All fields are unset if the C library doesn't provide this information."),
+                &vl_method_GetMemoryStatistics,
                 SD_VARLINK_SYMBOL_COMMENT("Returned if the environment block is currently not in a valid state."),
                 &vl_error_InconsistentEnvironment);
 
@@ -129,3 +149,35 @@ int varlink_method_get_environment(sd_varlink *link, sd_json_variant *parameters
 invalid:
         return sd_varlink_error(link, "io.systemd.service.InconsistentEnvironment", parameters);
 }
+
+int varlink_method_get_memory_statistics(sd_varlink *link, sd_json_variant *parameters, sd_varlink_method_flags_t flags, void *userdata) {
+        int r;
+
+        assert(link);
+        assert(parameters);
+
+        /* A structured, cheap to query subset of what GetMallocInfo()/malloc_info() reports on D-Bus. This
+         * is intended to be polled regularly to track memory use of long-running services. */
+
+        r = sd_varlink_dispatch(link, parameters, /* dispatch_table= */ NULL, /* userdata= */ NULL);
+        if (r != 0)
+                return r;
+
+        log_debug("Received io.systemd.service.GetMemoryStatistics()");
+
+#if HAVE_GENERIC_MALLINFO
+        generic_mallinfo mi = generic_mallinfo_get();
+
+        return sd_varlink_replybo(
+                        link,
+                        SD_JSON_BUILD_PAIR_UNSIGNED("arenaBytes", (uint64_t) mi.arena),
+                        SD_JSON_BUILD_PAIR_UNSIGNED("usedBytes", (uint64_t) mi.uordblks),
+                        SD_JSON_BUILD_PAIR_UNSIGNED("freeBytes", (uint64_t) mi.fordblks),
+                        SD_JSON_BUILD_PAIR_UNSIGNED("freeChunks", (uint64_t) mi.ordblks),
+                        SD_JSON_BUILD_PAIR_UNSIGNED("releasableBytes", (uint64_t) mi.keepcost),
+                        SD_JSON_BUILD_PAIR_UNSIGNED("mappedRegions", (uint64_t) mi.hblks),
+                        SD_JSON_BUILD_PAIR_UNSIGNED("mappedBytes", (uint64_t) mi.hblkhd));
+#else
+        return sd_varlink_reply(link, NULL);
+#endif
+}
@@ -4,6 +4,7 @@
 #include "detach-swap.h"
 #include "errno-util.h"
 #include "fd-util.h"
+#include "fileio.h"
 #include "log.h"
 #include "path-util.h"
 #include "string-util.h"
@@ -40,6 +41,34 @@ TEST(mount_points_list) {
         test_mount_points_list_one("/test-umount/rhbug-1554943.mountinfo");
 }
 
+TEST(mount_points_list_umount_directly) {
+        _cleanup_(mount_points_list_free) LIST_HEAD(MountPoint, mp_list_head);
+        _cleanup_fclose_ FILE *f = NULL;
+        static const char mountinfo[] =
+                "21 63 0:18 / /mnt/tmp rw,nosuid,nodev shared:19 - tmpfs tmpfs rw\n"
+                "22 63 0:19 / /srv/tmp rw,nosuid,nodev shared:20 - tmpfs tmpfs rw\n"
+                "23 63 0:20 / /mnt/fuse rw,nosuid,nodev shared:21 - fuse.sshfs host: rw,user_id=0,group_id=0\n"
+                "24 23 0:21 / /mnt/fuse/tmp rw,nosuid,nodev shared:22 - tmpfs tmpfs rw\n"
+                "25 63 0:22 / /mnt/nfs rw,relatime shared:23 - nfs4 host:/ rw\n"
+                "26 25 0:23 / /mnt/nfs/tmp rw,nosuid,nodev shared:24 - tmpfs tmpfs rw\n"
+                "27 63 0:24 / /mnt/fuseblk rw,relatime shared:25 - fuseblk /dev/sdb1 rw,user_id=0,group_id=0\n"
+                "28 27 0:25 / /mnt/fuseblk/tmp rw,nosuid,nodev shared:26 - tmpfs tmpfs rw\n"
+                "29 63 0:26 / /mnt/virtiofs rw,relatime shared:27 - virtiofs share rw\n"
+                "30 29 0:27 / /mnt/virtiofs/tmp rw,nosuid,nodev shared:28 - tmpfs tmpfs rw\n"
+                "31 63 0:28 / /mnt/9p rw,relatime shared:29 - 9p share rw,trans=virtio\n"
+                "32 31 0:29 / /mnt/9p/tmp rw,nosuid,nodev shared:30 - tmpfs tmpfs rw\n";
+
+        ASSERT_NOT_NULL(f = fmemopen_unlocked((void*) mountinfo, sizeof(mountinfo) - 1, "r"));
+
+        LIST_HEAD_INIT(mp_list_head);
+        ASSERT_OK(mount_points_list_get(f, &mp_list_head));
+
+        /* Only virtual file systems that are not on or below a network, FUSE, virtiofs or 9p file system
+         * are unmounted without a timeout. */
+        LIST_FOREACH(mount_point, m, mp_list_head)
+                ASSERT_EQ(m->umount_directly, PATH_IN_SET(m->path, "/mnt/tmp", "/srv/tmp"));
+}
+
 static void test_swap_list_one(const char *fname) {
         _cleanup_(swap_devices_list_free) LIST_HEAD(SwapDevice, sd_list_head);
         _cleanup_free_ char *testdata_fname = NULL;
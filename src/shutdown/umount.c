@@ -23,9 +23,11 @@
 #include "mount-util.h"
 #include "mountpoint-util.h"
 #include "parse-util.h"
+#include "path-util.h"
 #include "process-util.h"
 #include "random-util.h"
 #include "signal-util.h"
+#include "strv.h"
 #include "umount.h"
 #include "virt.h"
 
@@ -50,6 +52,7 @@ void mount_points_list_free(MountPoint **head) {
 int mount_points_list_get(FILE *f, MountPoint **head) {
         _cleanup_(mnt_free_tablep) struct libmnt_table *table = NULL;
         _cleanup_(mnt_free_iterp) struct libmnt_iter *iter = NULL;
+        _cleanup_strv_free_ char **blocking_paths = NULL;
         int r;
 
         assert(head);
@@ -101,6 +104,13 @@ int mount_points_list_get(FILE *f, MountPoint **head) {
                 is_network = fstype_is_network(fstype);
                 is_api_vfs = fstype_is_api_vfs(fstype);
 
+                /* Lookups below network file systems may block if the network is down, and lookups below
+                 * FUSE file systems may block forever if the server process hangs. The same applies to
+                 * virtiofs and 9p, which are served by a process on the host or hypervisor side. */
+                if ((is_network || startswith(fstype, "fuse") || STR_IN_SET(fstype, "virtiofs", "9p")) &&
+                    strv_extend(&blocking_paths, path) < 0)
+                        return log_oom();
+
                 /* If we are in a container, don't attempt to read-only mount anything as that brings no real
                  * benefits, but might confuse the host, as we remount the superblock here, not the bind
                  * mount.
@@ -154,6 +164,12 @@ int mount_points_list_get(FILE *f, MountPoint **head) {
                          * something keeps an fd open to it. */
                         .umount_lazily = is_api_vfs,
 
+                        /* Lazily unmounting a virtual file system cannot hang on I/O, hence we can do so
+                         * without forking off a child with a timeout first (see umount_with_timeout()).
+                         * Exceptions are autofs, where the lookup might trigger an automount, and mounts
+                         * on or below network, FUSE, virtiofs and 9p file systems, see below. */
+                        .umount_directly = is_api_vfs && !streq_ptr(fstype, "autofs"),
+
                         /* If a mount point is not a leaf, moving it would invalidate our mount table.
                          * If a mount point is on the network and the network is down, it can hang and block
                          * the shutdown. */
@@ -169,6 +185,13 @@ int mount_points_list_get(FILE *f, MountPoint **head) {
                 LIST_PREPEND(mount_point, *head, TAKE_PTR(m));
         }
 
+        /* Resolving the path of a mount on or below a network or FUSE file system can hang, hence leave these
+         * to umount_with_timeout(). */
+        if (blocking_paths)
+                LIST_FOREACH(mount_point, m, *head)
+                        if (m->umount_directly && path_startswith_strv(m->path, blocking_paths))
+                                m->umount_directly = false;
+
         return 0;
 }
 
@@ -362,6 +385,24 @@ static int umount_with_timeout(MountPoint *m, bool last_try) {
         return r;
 }
 
+static int umount_directly(MountPoint *m, bool last_try) {
+        int r;
+
+        assert(m);
+        assert(m->umount_lazily);
+
+        /* On systems with many mounts, forking off a child for each of them adds up. For those mounts where
+         * the umount cannot hang, skip that. */
+
+        log_info("Unmounting '%s'.", m->path);
+
+        r = RET_NERRNO(umount2(m->path, UMOUNT_NOFOLLOW|MNT_DETACH));
+        if (r < 0)
+                log_full_errno(last_try ? LOG_ERR : LOG_INFO, r, "Failed to unmount %s: %m", m->path);
+
+        return r;
+}
+
 /* This includes remounting readonly, which changes the kernel mount options.  Therefore the list passed to
  * this function is invalidated, and should not be reused. */
 static int mount_points_list_umount(MountPoint **head, bool *changed, bool last_try) {
@@ -401,7 +442,10 @@ static int mount_points_list_umount(MountPoint **head, bool *changed, bool last_
                         continue;
 
                 /* Trying to umount */
-                r = umount_with_timeout(m, last_try);
+                if (m->umount_directly)
+                        r = umount_directly(m, last_try);
+                else
+                        r = umount_with_timeout(m, last_try);
                 if (r < 0)
                         n_failed++;
                 else
@@ -147,8 +147,9 @@ static int connection_create_pipes(Connection *c, int buffer[static 2], size_t *
         if (r < 0)
                 return log_error_errno(errno, "Failed to allocate pipe buffer: %m");
 
-        (void) fcntl(buffer[0], F_SETPIPE_SZ, BUFFER_SIZE);
-
+        /* Start out with the kernel's default pipe size, and only grow it up to BUFFER_SIZE if the
+         * connection actually fills it up, see connection_grow_pipe(). Most connections never need more,
+         * and with many concurrent connections the pinned pipe buffers add up quickly. */
         r = fcntl(buffer[0], F_GETPIPE_SZ);
         if (r < 0)
                 return log_error_errno(errno, "Failed to get pipe buffer size: %m");
@@ -159,6 +160,26 @@ static int connection_create_pipes(Connection *c, int buffer[static 2], size_t *
         return 0;
 }
 
+static void connection_grow_pipe(int buffer[static 2], size_t *sz) {
+        int r;
+
+        assert(buffer);
+        assert(buffer[0] >= 0);
+        assert(sz);
+
+        if (*sz >= BUFFER_SIZE)
+                return;
+
+        /* This may fail if we hit the per-user pipe buffer limits, in which case we just keep going with
+         * what we have. */
+        if (fcntl(buffer[0], F_SETPIPE_SZ, MIN(*sz * 2, (size_t) BUFFER_SIZE)) < 0)
+                return;
+
+        r = fcntl(buffer[0], F_GETPIPE_SZ);
+        if (r > 0)
+                *sz = r;
+}
+
 static int connection_shovel(
                 Connection *c,
                 int *from, int buffer[2], int *to,
@@ -188,6 +209,9 @@ static int connection_shovel(
                         if (z > 0) {
                                 *full += z;
                                 shoveled = true;
+
+                                if (*full >= *sz)
+                                        connection_grow_pipe(buffer, sz);
                         } else if (z == 0 || ERRNO_IS_DISCONNECT(errno)) {
                                 *from_source = sd_event_source_unref(*from_source);
                                 *from = safe_close(*from);
@@ -1838,6 +1838,23 @@ static int merge_subprocess(
                         r = dissected_image_relinquish(m);
                         if (r < 0)
                                 return log_error_errno(r, "Failed to relinquish DM and loopback block devices: %m");
+
+                        /* The extension-release data of images is not read in advance (see
+                         * image_discover_and_read_metadata()), since that would mean dissecting and
+                         * mounting each image twice. Now that it's mounted, pick it up. */
+                        _cleanup_strv_free_ char **extension_release = NULL;
+                        r = load_extension_release_pairs(p, image_class, img->name, /* relax_extension_release_check= */ false, &extension_release);
+                        if (r == -ENOENT)
+                                /* Like image_read_metadata(), treat a missing file as no release data. The
+                                 * image is then skipped by the validation below, unless in force mode. */
+                                log_debug_errno(r, "Extension %s carries no extension-release data.", img->name);
+                        else if (r < 0)
+                                return log_error_errno(r, "Failed to read extension-release data of %s: %m", img->name);
+
+                        if (image_class == IMAGE_SYSEXT)
+                                strv_free_and_replace(img->sysext_release, extension_release);
+                        else
+                                strv_free_and_replace(img->confext_release, extension_release);
                         break;
                 }
                 default:
@@ -2087,6 +2104,12 @@ static int image_discover_and_read_metadata(
                 return log_error_errno(r, "Failed to discover images: %m");
 
         HASHMAP_FOREACH(img, images) {
+                /* For disk images metadata acquisition means setting up a loopback device, dissecting and
+                 * mounting the image in a child process. merge_subprocess() has to do all that anyway, hence
+                 * leave it to that, and only read the metadata of directory trees here. */
+                if (IN_SET(img->type, IMAGE_RAW, IMAGE_BLOCK))
+                        continue;
+
                 r = image_read_metadata(img, image_class_info[image_class].default_image_policy);
                 if (r < 0)
                         return log_error_errno(r, "Failed to read metadata for image %s: %m", img->name);
@@ -33,6 +33,7 @@
 #include "signal-util.h"
 #include "sort-util.h"
 #include "special.h"
+#include "static-destruct.h"
 #include "string-table.h"
 #include "systemctl-list-machines.h"
 #include "systemctl-list-units.h"
@@ -43,6 +44,11 @@
 #include "terminal-util.h"
 #include "utf8.h"
 
+/* When showing the status of many units, open the journal only once and reuse it for all units that log
+ * to the default namespace. */
+static sd_journal *status_journal = NULL;
+STATIC_DESTRUCTOR_REGISTER(status_journal, sd_journal_closep);
+
 static OutputFlags get_output_flags(void) {
         return
                 FLAGS_SET(arg_print_flags, BUS_PRINT_PROPERTY_SHOW_EMPTY) * OUTPUT_SHOW_ALL |
@@ -869,6 +875,7 @@ static void print_status_info(
         if (i->id && arg_transport == BUS_TRANSPORT_LOCAL)
                 show_journal_by_unit(
                                 stdout,
+                                i->log_namespace ? NULL : &status_journal,
                                 i->id,
                                 i->log_namespace,
                                 arg_output,
@@ -2062,6 +2069,7 @@ static int show_one(
                 sd_bus *bus,
                 const char *path,
                 const char *unit,
+                sd_bus_message *properties,
                 SystemctlShowMode show_mode,
                 bool *new_line,
                 bool *ellipsized) {
@@ -2214,15 +2222,29 @@ static int show_one(
 
         log_debug("Showing one %s", path);
 
-        r = bus_map_all_properties(
-                        bus,
-                        "org.freedesktop.systemd1",
-                        path,
-                        show_mode == SYSTEMCTL_SHOW_STATUS ? status_map : property_map,
-                        BUS_MAP_BOOLEAN_AS_BOOL,
-                        &error,
-                        &reply,
-                        &info);
+        if (properties) {
+                /* The GetAll() reply has already been requested by the caller */
+                if (sd_bus_message_is_method_error(properties, NULL))
+                        r = sd_bus_error_copy(&error, sd_bus_message_get_error(properties));
+                else {
+                        reply = sd_bus_message_ref(properties);
+                        r = bus_message_map_all_properties(
+                                        reply,
+                                        show_mode == SYSTEMCTL_SHOW_STATUS ? status_map : property_map,
+                                        BUS_MAP_BOOLEAN_AS_BOOL,
+                                        &error,
+                                        &info);
+                }
+        } else
+                r = bus_map_all_properties(
+                                bus,
+                                "org.freedesktop.systemd1",
+                                path,
+                                show_mode == SYSTEMCTL_SHOW_STATUS ? status_map : property_map,
+                                BUS_MAP_BOOLEAN_AS_BOOL,
+                                &error,
+                                &reply,
+                                &info);
         if (r < 0)
                 return log_error_errno(r, "Failed to get properties: %s", bus_error_message(&error, r));
 
@@ -2269,6 +2291,8 @@ static int show_one(
         return 0;
 }
 
+#define SHOW_ALL_BATCH_SIZE 64U
+
 static int show_all(
                 sd_bus *bus,
                 SystemctlShowMode show_mode,
@@ -2290,18 +2314,37 @@ static int show_all(
 
         typesafe_qsort(unit_infos, c, unit_info_compare);
 
-        for (const UnitInfo *u = unit_infos; u < unit_infos + c; u++) {
-                _cleanup_free_ char *p = NULL;
+        /* Request the properties of a batch of units at once, instead of waiting for a round trip for
+         * each unit. The batch size bounds the number of replies we keep in memory at the same time. */
+        for (unsigned i = 0; i < c; i += SHOW_ALL_BATCH_SIZE) {
+                _cleanup_strv_free_ char **paths = NULL;
+                sd_bus_message **replies = NULL;
+                size_t n = MIN(c - i, SHOW_ALL_BATCH_SIZE), n_replies = 0;
+
+                CLEANUP_ARRAY(replies, n_replies, bus_message_unref_many);
 
-                p = unit_dbus_path_from_name(u->id);
-                if (!p)
+                paths = new0(char*, n + 1);
+                if (!paths)
                         return log_oom();
 
-                r = show_one(bus, p, u->id, show_mode, new_line, ellipsized);
+                for (size_t j = 0; j < n; j++) {
+                        paths[j] = unit_dbus_path_from_name(unit_infos[i + j].id);
+                        if (!paths[j])
+                                return log_oom();
+                }
+
+                r = bus_get_all_properties_many(bus, "org.freedesktop.systemd1", paths, n, &replies);
                 if (r < 0)
-                        return r;
-                if (r > 0 && ret == 0)
-                        ret = r;
+                        return log_error_errno(r, "Failed to get properties: %m");
+                n_replies = n;
+
+                for (size_t j = 0; j < n; j++) {
+                        r = show_one(bus, paths[j], unit_infos[i + j].id, replies[j], show_mode, new_line, ellipsized);
+                        if (r < 0)
+                                return r;
+                        if (r > 0 && ret == 0)
+                                ret = r;
+                }
         }
 
         return ret;
@@ -2410,7 +2453,7 @@ int verb_show(int argc, char *argv[], void *userdata) {
                 if (!arg_states && !arg_types) {
                         if (show_mode == SYSTEMCTL_SHOW_PROPERTIES)
                                 /* systemctl show --all → show properties of the manager */
-                                return show_one(bus, "/org/freedesktop/systemd1", NULL, show_mode, &new_line, &ellipsized);
+                                return show_one(bus, "/org/freedesktop/systemd1", NULL, NULL, show_mode, &new_line, &ellipsized);
 
                         r = show_system_status(bus);
                         if (r < 0)
@@ -2447,7 +2490,7 @@ int verb_show(int argc, char *argv[], void *userdata) {
                                 }
                         }
 
-                        r = show_one(bus, path, unit, show_mode, &new_line, &ellipsized);
+                        r = show_one(bus, path, unit, NULL, show_mode, &new_line, &ellipsized);
                         if (r < 0)
                                 return r;
                         if (r > 0 && ret == 0)
@@ -2472,7 +2515,7 @@ int verb_show(int argc, char *argv[], void *userdata) {
                                 if (!path)
                                         return log_oom();
 
-                                r = show_one(bus, path, *name, show_mode, &new_line, &ellipsized);
+                                r = show_one(bus, path, *name, NULL, show_mode, &new_line, &ellipsized);
                                 if (r < 0)
                                         return r;
                                 if (r > 0 && ret == 0)
@@ -28,7 +28,6 @@
 #include "stat-util.h"
 #include "stdio-util.h"
 #include "strv.h"
-#include "sync-util.h"
 #include "sysupdate.h"
 #include "sysupdate-feature.h"
 #include "sysupdate-pattern.h"
@@ -1210,6 +1209,11 @@ int transfer_acquire_instance(Transfer *t, Instance *i, TransferProgress cb, voi
                         return log_oom();
         }
 
+        /* Note that we invoke the helpers with --sync=no: context_apply() issues a single sync() once all
+         * transfers of the update set have been acquired, which covers all of them at once, instead of
+         * having each helper flush its own output separately. The same applies to the attribute changes
+         * below. */
+
         switch (i->resource->type) { /* Source */
 
         case RESOURCE_REGULAR_FILE:
@@ -1228,7 +1232,7 @@ int transfer_acquire_instance(Transfer *t, Instance *i, TransferProgress cb, voi
                                                SYSTEMD_IMPORT_PATH,
                                                "raw",
                                                "--direct",          /* just copy/unpack the specified file, don't do anything else */
-                                               arg_sync ? "--sync=yes" : "--sync=no",
+                                               "--sync=no",
                                                i->path,
                                                t->temporary_path),
                                         t, i, cb, userdata);
@@ -1245,7 +1249,7 @@ int transfer_acquire_instance(Transfer *t, Instance *i, TransferProgress cb, voi
                                                "--direct",          /* just copy/unpack the specified file, don't do anything else */
                                                "--offset", offset,
                                                "--size-max", max_size,
-                                               arg_sync ? "--sync=yes" : "--sync=no",
+                                               "--sync=no",
                                                i->path,
                                                t->target.path),
                                         t, i, cb, userdata);
@@ -1268,7 +1272,7 @@ int transfer_acquire_instance(Transfer *t, Instance *i, TransferProgress cb, voi
                                        SYSTEMD_IMPORT_FS_PATH,
                                        "run",
                                        "--direct",          /* just untar the specified file, don't do anything else */
-                                       arg_sync ? "--sync=yes" : "--sync=no",
+                                       "--sync=no",
                                        t->target.type == RESOURCE_SUBVOLUME ? "--btrfs-subvol=yes" : "--btrfs-subvol=no",
                                        i->path,
                                        t->temporary_path),
@@ -1285,7 +1289,7 @@ int transfer_acquire_instance(Transfer *t, Instance *i, TransferProgress cb, voi
                                        SYSTEMD_IMPORT_PATH,
                                        "tar",
                                        "--direct",          /* just untar the specified file, don't do anything else */
-                                       arg_sync ? "--sync=yes" : "--sync=no",
+                                       "--sync=no",
                                        t->target.type == RESOURCE_SUBVOLUME ? "--btrfs-subvol=yes" : "--btrfs-subvol=no",
                                        i->path,
                                        t->temporary_path),
@@ -1306,7 +1310,7 @@ int transfer_acquire_instance(Transfer *t, Instance *i, TransferProgress cb, voi
                                                "raw",
                                                "--direct",          /* just download the specified URL, don't download anything else */
                                                "--verify", digest,  /* validate by explicit SHA256 sum */
-                                               arg_sync ? "--sync=yes" : "--sync=no",
+                                               "--sync=no",
                                                i->path,
                                                t->temporary_path),
                                         t, i, cb, userdata);
@@ -1324,7 +1328,7 @@ int transfer_acquire_instance(Transfer *t, Instance *i, TransferProgress cb, voi
                                                "--verify", digest,      /* validate by explicit SHA256 sum */
                                                "--offset", offset,
                                                "--size-max", max_size,
-                                               arg_sync ? "--sync=yes" : "--sync=no",
+                                               "--sync=no",
                                                i->path,
                                                t->target.path),
                                         t, i, cb, userdata);
@@ -1346,7 +1350,7 @@ int transfer_acquire_instance(Transfer *t, Instance *i, TransferProgress cb, voi
                                        "--direct",          /* just download the specified URL, don't download anything else */
                                        "--verify", digest,  /* validate by explicit SHA256 sum */
                                        t->target.type == RESOURCE_SUBVOLUME ? "--btrfs-subvol=yes" : "--btrfs-subvol=no",
-                                       arg_sync ? "--sync=yes" : "--sync=no",
+                                       "--sync=no",
                                        i->path,
                                        t->temporary_path),
                                 t, i, cb, userdata);
@@ -1359,7 +1363,6 @@ int transfer_acquire_instance(Transfer *t, Instance *i, TransferProgress cb, voi
                 return r;
 
         if (RESOURCE_IS_FILESYSTEM(t->target.type)) {
-                bool need_sync = false;
                 assert(t->temporary_path);
 
                 /* Apply file attributes if set */
@@ -1370,8 +1373,6 @@ int transfer_acquire_instance(Transfer *t, Instance *i, TransferProgress cb, voi
 
                         if (utimensat(AT_FDCWD, t->temporary_path, (struct timespec[2]) { ts, ts }, AT_SYMLINK_NOFOLLOW) < 0)
                                 return log_error_errno(errno, "Failed to adjust mtime of '%s': %m", t->temporary_path);
-
-                        need_sync = true;
                 }
 
                 if (f.mode != MODE_INVALID) {
@@ -1381,20 +1382,6 @@ int transfer_acquire_instance(Transfer *t, Instance *i, TransferProgress cb, voi
                         if (fchmodat(AT_FDCWD, t->temporary_path, f.mode, AT_SYMLINK_NOFOLLOW) < 0 &&
                             (!ERRNO_IS_NOT_SUPPORTED(errno) || chmod(t->temporary_path, f.mode) < 0))
                                 return log_error_errno(errno, "Failed to adjust mode of '%s': %m", t->temporary_path);
-
-                        need_sync = true;
-                }
-
-                /* Synchronize */
-                if (arg_sync && need_sync) {
-                        if (t->target.type == RESOURCE_REGULAR_FILE)
-                                r = fsync_path_and_parent_at(AT_FDCWD, t->temporary_path);
-                        else {
-                                assert(IN_SET(t->target.type, RESOURCE_DIRECTORY, RESOURCE_SUBVOLUME));
-                                r = syncfs_path(AT_FDCWD, t->temporary_path);
-                        }
-                        if (r < 0)
-                                return log_error_errno(r, "Failed to synchronize file system backing '%s': %m", t->temporary_path);
                 }
 
                 t->install_read_only = f.read_only;
@@ -120,6 +120,9 @@ typedef struct Context {
         /* A helper set to hold names that are used by database_by_{uid,gid,username,groupname} above. */
         Set *names;
 
+        /* IDs that NSS already reported as neither used by a user nor a group */
+        Set *nss_unused_ids;
+
         uid_t search_uid;
         UIDRange *uid_range;
 
@@ -144,6 +147,7 @@ static void context_done(Context *c) {
         hashmap_free(c->database_by_groupname);
 
         set_free_free(c->names);
+        set_free(c->nss_unused_ids);
         uid_range_free(c->uid_range);
 }
 
@@ -1068,8 +1072,10 @@ static int uid_is_ok(
                         return 0;
         }
 
-        /* Let's also check via NSS, to avoid UID clashes over LDAP and such, just in case */
-        if (!arg_root) {
+        /* Let's also check via NSS, to avoid UID clashes over LDAP and such, just in case. If we already
+         * probed both the user and group database for this ID (typically because we just allocated the
+         * GID of the group of the same name), don't ask again. */
+        if (!arg_root && !(check_with_gid && set_contains(c->nss_unused_ids, UID_TO_PTR(uid)))) {
                 _cleanup_free_ struct group *g = NULL;
 
                 r = getpwuid_malloc(uid, /* ret= */ NULL);
@@ -1301,12 +1307,15 @@ static int gid_is_ok(
                         return 0;
         }
 
-        if (!arg_root) {
+        if (!arg_root && !(check_with_uid && set_contains(c->nss_unused_ids, GID_TO_PTR(gid)))) {
+                bool unused;
+
                 r = getgrgid_malloc(gid, /* ret= */ NULL);
                 if (r >= 0)
                         return 0;
                 if (r != -ESRCH)
                         log_warning_errno(r, "Unexpected failure while looking up GID '" GID_FMT "' via NSS, assuming it doesn't exist: %m", gid);
+                unused = r == -ESRCH;
 
                 if (check_with_uid) {
                         r = getpwuid_malloc(gid, /* ret= */ NULL);
@@ -1314,6 +1323,11 @@ static int gid_is_ok(
                                 return 0;
                         if (r != -ESRCH)
                                 log_warning_errno(r, "Unexpected failure while looking up GID '" GID_FMT "' via NSS, assuming it doesn't exist: %m", gid);
+
+                        /* Remember that neither a user nor a group uses this ID, so that uid_is_ok() can
+                         * skip the same two lookups when the user of the same name reuses this GID. */
+                        if (unused && r == -ESRCH)
+                                (void) set_ensure_put(&c->nss_unused_ids, NULL, GID_TO_PTR(gid));
                 }
         }
 
@@ -248,6 +248,44 @@ static void test_policy_empty(bool add_mismatched, const char *cgroup_path, BPFP
         assert_se(wrong == 0);
 }
 
+static void test_policy_reapply(const char *cgroup_path, BPFProgram **installed_prog) {
+        BPFProgram *first = NULL;
+        int r;
+
+        log_info("/* %s */", __func__);
+
+        /* Applying an unchanged policy again must succeed and keep the already attached program */
+        for (unsigned i = 0; i < 2; i++) {
+                _cleanup_(bpf_program_freep) BPFProgram *prog = NULL;
+                _cleanup_close_ int fd = -EBADF;
+
+                r = bpf_devices_cgroup_init(&prog, CGROUP_DEVICE_POLICY_STRICT, true);
+                ASSERT_OK(r);
+
+                r = bpf_devices_allow_list_device(prog, cgroup_path, "/dev/null", CGROUP_DEVICE_READ);
+                ASSERT_OK(r);
+
+                r = bpf_devices_apply_policy(&prog, CGROUP_DEVICE_POLICY_STRICT, true, cgroup_path, installed_prog);
+                ASSERT_OK(r);
+                ASSERT_NULL(prog);
+                ASSERT_NOT_NULL(*installed_prog);
+
+                if (i == 0)
+                        first = *installed_prog;
+                else
+                        ASSERT_PTR_EQ(*installed_prog, first);
+
+                fd = open("/dev/null", O_CLOEXEC|O_RDONLY|O_NOCTTY);
+                log_debug("open(/dev/null, \"r\") = %d/%s", fd, fd < 0 ? errno_to_name(errno) : "-");
+                ASSERT_OK(fd);
+
+                fd = safe_close(fd);
+                fd = open("/dev/zero", O_CLOEXEC|O_RDONLY|O_NOCTTY);
+                log_debug("open(/dev/zero, \"r\") = %d/%s", fd, fd < 0 ? errno_to_name(errno) : "-");
+                ASSERT_LT(fd, 0);
+        }
+}
+
 int main(int argc, char *argv[]) {
         _cleanup_free_ char *cgroup = NULL, *parent = NULL;
         _cleanup_(rmdir_and_freep) char *controller_path = NULL;
@@ -296,6 +334,8 @@ int main(int argc, char *argv[]) {
         test_policy_empty(false, cgroup, &prog);
         test_policy_empty(true, cgroup, &prog);
 
+        test_policy_reapply(cgroup, &prog);
+
         ASSERT_OK(path_extract_directory(cgroup, &parent));
 
         ASSERT_OK(cg_mask_supported(&supported));
@@ -5,6 +5,7 @@
 #include "env-util.h"
 #include "errno-util.h"
 #include "string-util.h"
+#include "time-util.h"
 #include "tests.h"
 
 static void _test_one(int line, const char *input, const char *output) {
@@ -254,6 +255,90 @@ TEST(calendar_spec_from_string) {
         assert_se(calendar_spec_from_string("*:4,30:*\n", &c) == -EINVAL);
 }
 
+typedef struct CalendarSpecBenchmark {
+        CalendarSpec **specs;
+        unsigned n_specs;
+        usec_t base;
+} CalendarSpecBenchmark;
+
+static const char* const benchmark_specs[] = {
+        "*-*-* *:*:00",
+        "*-*-* *:00/15:00",
+        "hourly",
+        "daily",
+        "weekly",
+        "monthly",
+        "*-*-* 02:30:00",
+        "Mon..Fri *-*-* 08:00:00",
+        "Sat,Sun *-*-* 02,03:10/20:00",
+        "*-*~01 03:00:00",
+        "*-02-29 00:00:00",
+        "2030-*-* 12:00:00",
+        "*-*-* 00:00:00 UTC",
+        "quarterly",
+        "*-*-1,15 23:59:59.500000",
+};
+
+static void benchmark_calendar_spec_parse(void *userdata) {
+        CalendarSpecBenchmark *b = ASSERT_PTR(userdata);
+
+        for (unsigned i = 0; i < b->n_specs; i++) {
+                _cleanup_(calendar_spec_freep) CalendarSpec *c = NULL;
+
+                ASSERT_OK(calendar_spec_from_string(benchmark_specs[i % ELEMENTSOF(benchmark_specs)], &c));
+        }
+}
+
+static void benchmark_calendar_spec_next(void *userdata) {
+        CalendarSpecBenchmark *b = ASSERT_PTR(userdata);
+
+        /* Calculate the next elapse once, and again for every hour of the following day, as happens when the
+         * clock or the timezone changes */
+        for (unsigned h = 0; h <= 24; h++)
+                for (unsigned i = 0; i < b->n_specs; i++) {
+                        usec_t next;
+                        int r;
+
+                        r = calendar_spec_next_usec(b->specs[i], b->base + h * USEC_PER_HOUR, &next);
+                        assert_se(r >= 0 || r == -ENOENT);
+                }
+}
+
+TEST(calendar_spec_benchmark) {
+        bool slow = slow_tests_enabled();
+        CalendarSpecBenchmark b = {
+                /* As many specifications as there are timers on a system with many of them */
+                .n_specs = slow ? 8000 : 500,
+                /* 2024-03-31 00:30:00 UTC, half an hour before the clocks go forward in Europe/Berlin */
+                .base = 1711845000 * USEC_PER_SEC,
+        };
+        bool set_tz;
+
+        /* Use a timezone with DST if it is available, so that the calculation has to deal with the
+         * transition */
+        set_tz = timezone_is_valid("Europe/Berlin", LOG_DEBUG);
+        if (set_tz) {
+                ASSERT_OK_ERRNO(setenv("TZ", ":Europe/Berlin", /* overwrite = */ true));
+                tzset();
+        }
+
+        ASSERT_NOT_NULL(b.specs = new0(CalendarSpec*, b.n_specs));
+        for (unsigned i = 0; i < b.n_specs; i++)
+                ASSERT_OK(calendar_spec_from_string(benchmark_specs[i % ELEMENTSOF(benchmark_specs)], b.specs + i));
+
+        benchmark_run("calendar spec parse", slow ? 100 : 10, benchmark_calendar_spec_parse, &b);
+        benchmark_run("calendar spec next elapse", slow ? 20 : 3, benchmark_calendar_spec_next, &b);
+
+        for (unsigned i = 0; i < b.n_specs; i++)
+                calendar_spec_free(b.specs[i]);
+        free(b.specs);
+
+        if (set_tz) {
+                ASSERT_OK_ERRNO(unsetenv("TZ"));
+                tzset();
+        }
+}
+
 static int intro(void) {
         /* Tests have hard-coded results that do not expect a specific timezone to be set by the caller */
         ASSERT_OK_ERRNO(unsetenv("TZ"));
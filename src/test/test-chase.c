@@ -530,6 +530,15 @@ TEST(chaseat) {
         ASSERT_STREQ(result, "def");
         result = mfree(result);
 
+        /* Same, but only asking for the file descriptor, which may take the openat2() fast path. */
+        ASSERT_OK(chaseat(tfd, "qed", CHASE_AT_RESOLVE_IN_ROOT, NULL, &fd));
+        ASSERT_OK_EQ(inode_same_at(tfd, "def", fd, NULL, AT_EMPTY_PATH), 1);
+        fd = safe_close(fd);
+        ASSERT_OK(chaseat(tfd, "/qed", CHASE_AT_RESOLVE_IN_ROOT|CHASE_NOFOLLOW, NULL, &fd));
+        ASSERT_OK_EQ(inode_same_at(tfd, "qed", fd, NULL, AT_SYMLINK_NOFOLLOW|AT_EMPTY_PATH), 1);
+        fd = safe_close(fd);
+        assert_se(chaseat(tfd, "abc", CHASE_AT_RESOLVE_IN_ROOT, NULL, &fd) == -ENOENT);
+
         /* Valid directory file descriptor without CHASE_AT_RESOLVE_IN_ROOT should resolve symlinks against
          * host's root. */
         assert_se(chaseat(tfd, "/qed", 0, NULL, NULL) == -ENOENT);
@@ -1,5 +1,6 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 
+#include <fcntl.h>
 #include <sys/stat.h>
 
 #if HAVE_LZ4
@@ -11,7 +12,9 @@
 #include "compress.h"
 #include "fd-util.h"
 #include "fs-util.h"
+#include "io-util.h"
 #include "macro.h"
+#include "memfd-util.h"
 #include "memory-util.h"
 #include "path-util.h"
 #include "random-util.h"
@@ -226,6 +229,68 @@ _unused_ static void test_compress_stream(const char *compression,
         r = decompress(dst, dst2, st.st_size - 1);
         assert_se(r == -EFBIG);
 }
+
+#define SPARSE_SIZE (48U*1024U)
+
+static void check_decompressed_sparse(int fd, const char *expected) {
+        _cleanup_free_ char *buf = NULL;
+
+        assert_se(buf = malloc(SPARSE_SIZE + 1));
+        assert_se(loop_read(fd, buf, SPARSE_SIZE + 1, /* do_poll= */ false) == SPARSE_SIZE);
+        assert_se(memcmp(buf, expected, SPARSE_SIZE) == 0);
+}
+
+_unused_ static void test_decompress_stream_sparse(const char *compression,
+                                                   compress_stream_t compress,
+                                                   decompress_stream_t decompress) {
+
+        _cleanup_(unlink_tempfilep) char
+                pattern[] = "/tmp/systemd-test.compressed.XXXXXX",
+                pattern2[] = "/tmp/systemd-test.decompressed.XXXXXX";
+        _cleanup_close_ int src = -EBADF, dst = -EBADF, fd = -EBADF;
+        _cleanup_close_pair_ int pfd[2] = EBADF_PAIR;
+        _cleanup_free_ char *data = NULL;
+        uint64_t uncompressed_size;
+
+        log_debug("/* testing %s sparse decompression */", compression);
+
+        /* Mostly zeros, with a few non-zero islands and a trailing run of zeros, so that decompressing
+         * into a regular file leaves holes */
+        assert_se(data = malloc0(SPARSE_SIZE));
+        for (size_t i = 0; i < SPARSE_SIZE; i += 8192)
+                memset(data + i, 'x', 100);
+
+        assert_se((src = memfd_new("test-compress-sparse")) >= 0);
+        assert_se(loop_write(src, data, SPARSE_SIZE) >= 0);
+        assert_se(lseek(src, 0, SEEK_SET) == 0);
+
+        assert_se((dst = mkostemp_safe(pattern)) >= 0);
+        ASSERT_OK(compress(src, dst, -1, &uncompressed_size));
+        assert_se(uncompressed_size == SPARSE_SIZE);
+
+        /* Fresh regular file */
+        assert_se((fd = mkostemp_safe(pattern2)) >= 0);
+        assert_se(lseek(dst, 0, SEEK_SET) == 0);
+        ASSERT_OK(decompress(dst, fd, SPARSE_SIZE));
+        assert_se(lseek(fd, 0, SEEK_SET) == 0);
+        check_decompressed_sparse(fd, data);
+        fd = safe_close(fd);
+
+        /* Same file opened with O_APPEND, where seeking over zeros has no effect */
+        assert_se((fd = open(pattern2, O_WRONLY|O_TRUNC|O_APPEND|O_CLOEXEC)) >= 0);
+        assert_se(lseek(dst, 0, SEEK_SET) == 0);
+        ASSERT_OK(decompress(dst, fd, SPARSE_SIZE));
+        fd = safe_close(fd);
+        assert_se((fd = open(pattern2, O_RDONLY|O_CLOEXEC)) >= 0);
+        check_decompressed_sparse(fd, data);
+
+        /* Pipe, which cannot have holes at all. The payload fits into the default pipe buffer. */
+        assert_se(pipe2(pfd, O_CLOEXEC) >= 0);
+        assert_se(lseek(dst, 0, SEEK_SET) == 0);
+        ASSERT_OK(decompress(dst, pfd[1], SPARSE_SIZE));
+        pfd[1] = safe_close(pfd[1]);
+        check_decompressed_sparse(pfd[0], data);
+}
 #endif
 
 #if HAVE_LZ4
@@ -309,6 +374,7 @@ int main(int argc, char *argv[]) {
 
         test_compress_stream("XZ", "xzcat",
                              compress_stream_xz, decompress_stream_xz, srcfile);
+        test_decompress_stream_sparse("XZ", compress_stream_xz, decompress_stream_xz);
 
         test_decompress_startswith_short("XZ", compress_blob_xz, decompress_startswith_xz);
 
@@ -335,6 +401,7 @@ int main(int argc, char *argv[]) {
 
                 test_compress_stream("LZ4", "lz4cat",
                                      compress_stream_lz4, decompress_stream_lz4, srcfile);
+                test_decompress_stream_sparse("LZ4", compress_stream_lz4, decompress_stream_lz4);
 
                 test_lz4_decompress_partial();
 
@@ -363,6 +430,7 @@ int main(int argc, char *argv[]) {
 
         test_compress_stream("ZSTD", "zstdcat",
                              compress_stream_zstd, decompress_stream_zstd, srcfile);
+        test_decompress_stream_sparse("ZSTD", compress_stream_zstd, decompress_stream_zstd);
 
         test_decompress_startswith_short("ZSTD", compress_blob_zstd, decompress_startswith_zstd);
 #else
@@ -296,5 +296,97 @@ int main(int argc, char *argv[]) {
         assert_se(!unit_has_dependency(fruit, UNIT_ATOM_REFERENCED_BY, tomato));
         assert_se( unit_has_dependency(zupa, UNIT_ATOM_REFERENCED_BY, tomato));
 
+        /* Test JobConcurrencyMax= of slices */
+        Unit *limited, *held[3];
+        Job *running, *waiting[2];
+
+        assert_se(unit_new_for_name(m, sizeof(Slice), "limited.slice", &limited) >= 0);
+        FOREACH_ARRAY(u, held, ELEMENTSOF(held)) {
+                _cleanup_free_ char *name = NULL;
+
+                assert_se(asprintf(&name, "held%zu.service", (size_t) (u - held)) >= 0);
+                assert_se(unit_new_for_name(m, sizeof(Service), name, u) >= 0);
+                assert_se(unit_set_slice(*u, limited) >= 0);
+        }
+
+        SLICE(limited)->job_concurrency_max = 1;
+
+        /* A start job that is already running takes the only slot */
+        assert_se(running = job_new(held[0], JOB_START));
+        running->state = JOB_RUNNING;
+        assert_se(job_install_deserialized(running) >= 0);
+        assert_se(SLICE(limited)->n_running_start_jobs == 1);
+
+        /* Further start jobs are held back, oldest first */
+        for (size_t k = 0; k < ELEMENTSOF(waiting); k++) {
+                assert_se(waiting[k] = job_new(held[k + 1], JOB_START));
+                assert_se(job_install(waiting[k]) == waiting[k]);
+                job_add_to_run_queue(waiting[k]);
+                assert_se(job_run_and_invalidate(waiting[k]) == -EAGAIN);
+                assert_se(waiting[k]->state == JOB_WAITING);
+                assert_se(waiting[k]->held_by_slice == limited);
+                assert_se(!waiting[k]->in_run_queue);
+        }
+        assert_se(SLICE(limited)->held_jobs_tail == waiting[0]);
+
+        /* Raising the limit releases as many jobs as there are new slots */
+        SLICE(limited)->job_concurrency_max = 2;
+        job_release_held_by_slice(limited);
+        assert_se(waiting[0]->in_run_queue);
+        assert_se(!waiting[0]->held_by_slice);
+        assert_se(!waiting[1]->in_run_queue);
+        assert_se(waiting[1]->held_by_slice == limited);
+
+        /* Finishing the running job frees its slot */
+        assert_se(job_finish_and_invalidate(running, JOB_DONE, false, false) >= 0);
+        assert_se(SLICE(limited)->n_running_start_jobs == 0);
+        assert_se(waiting[1]->in_run_queue);
+        assert_se(!waiting[1]->held_by_slice);
+        assert_se(!SLICE(limited)->held_jobs);
+        assert_se(!SLICE(limited)->held_jobs_tail);
+
+        /* A released job that has to wait for a job ordered before it, which is still held back in the
+         * same slice, passes its slot on, instead of the two waiting for each other */
+        Unit *ordered, *blocking_unit, *first, *second;
+        Job *blocking, *late, *early;
+
+        assert_se(unit_new_for_name(m, sizeof(Slice), "ordered.slice", &ordered) >= 0);
+        assert_se(unit_new_for_name(m, sizeof(Service), "blocking.service", &blocking_unit) >= 0);
+        assert_se(unit_new_for_name(m, sizeof(Service), "first.service", &first) >= 0);
+        assert_se(unit_new_for_name(m, sizeof(Service), "second.service", &second) >= 0);
+        assert_se(unit_set_slice(blocking_unit, ordered) >= 0);
+        assert_se(unit_set_slice(first, ordered) >= 0);
+        assert_se(unit_set_slice(second, ordered) >= 0);
+        assert_se(unit_add_dependency(second, UNIT_AFTER, first, true, UNIT_DEPENDENCY_FILE) >= 0);
+
+        SLICE(ordered)->job_concurrency_max = 1;
+
+        assert_se(blocking = job_new(blocking_unit, JOB_START));
+        blocking->state = JOB_RUNNING;
+        assert_se(job_install_deserialized(blocking) >= 0);
+
+        /* The start job of second.service is held back first, as nothing it is ordered after is queued yet */
+        assert_se(late = job_new(second, JOB_START));
+        assert_se(job_install(late) == late);
+        job_add_to_run_queue(late);
+        assert_se(job_run_and_invalidate(late) == -EAGAIN);
+        assert_se(late->held_by_slice == ordered);
+
+        assert_se(early = job_new(first, JOB_START));
+        assert_se(job_install(early) == early);
+        job_add_to_run_queue(early);
+        assert_se(job_run_and_invalidate(early) == -EAGAIN);
+        assert_se(early->held_by_slice == ordered);
+
+        /* The freed slot goes to the oldest held job, which can't run yet, and hands it on */
+        assert_se(job_finish_and_invalidate(blocking, JOB_DONE, false, false) >= 0);
+        assert_se(late->in_run_queue);
+        assert_se(early->held_by_slice == ordered);
+        assert_se(job_run_and_invalidate(late) == -EAGAIN);
+        assert_se(!late->held_by_slice);
+        assert_se(!early->held_by_slice);
+        assert_se(early->in_run_queue);
+        assert_se(!SLICE(ordered)->held_jobs);
+
         return 0;
 }
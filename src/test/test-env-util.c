@@ -404,6 +404,26 @@ TEST(env_clean) {
         ASSERT_NULL(e[8]);
 }
 
+TEST(env_drop_invalid) {
+        _cleanup_strv_free_ char **e = strv_new("FOOBAR=WALDO",
+                                                "FOOBAR",
+                                                "=F",
+                                                "",
+                                                "X=",
+                                                "xyz\n=xyz",
+                                                "another=one");
+        assert_se(e);
+        assert_se(strv_env_drop_invalid(e) == e);
+        assert_se(strv_env_is_valid(e));
+
+        ASSERT_STREQ(e[0], "FOOBAR=WALDO");
+        ASSERT_STREQ(e[1], "X=");
+        ASSERT_STREQ(e[2], "another=one");
+        ASSERT_NULL(e[3]);
+
+        ASSERT_NULL(strv_env_drop_invalid(NULL));
+}
+
 TEST(env_name_is_valid) {
         assert_se(env_name_is_valid("test"));
 
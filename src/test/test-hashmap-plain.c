@@ -681,6 +681,7 @@ TEST(hashmap_many) {
                 unsigned n_entries;
         } tests[] = {
                 { "trivial_hashmap_ops",  NULL,                  slow ? 1 << 20 : 240 },
+                { "pointer_hash_ops",     &pointer_hash_ops,     slow ? 1 << 20 : 240 },
                 { "crippled_hashmap_ops", &crippled_hashmap_ops, slow ? 1 << 14 : 140 },
         };
 
@@ -764,6 +765,26 @@ TEST(hashmap_free) {
         }
 }
 
+static void benchmark_hashmap_put_get(void *userdata) {
+        unsigned n_entries = *(unsigned*) userdata;
+        _cleanup_hashmap_free_ Hashmap *h = NULL;
+
+        assert_se(h = hashmap_new(NULL));
+
+        for (unsigned i = 1; i <= n_entries; i++)
+                assert_se(hashmap_put(h, UINT_TO_PTR(i), UINT_TO_PTR(i)) > 0);
+
+        for (unsigned i = 1; i <= n_entries; i++)
+                assert_se(PTR_TO_UINT(hashmap_get(h, UINT_TO_PTR(i))) == i);
+}
+
+TEST(hashmap_benchmark) {
+        bool slow = slow_tests_enabled();
+        unsigned n_entries = slow ? 1 << 16 : 240;
+
+        benchmark_run("hashmap put+get", slow ? 200 : 10, benchmark_hashmap_put_get, &n_entries);
+}
+
 typedef struct Item {
         int seen;
 } Item;
@@ -44,6 +44,15 @@ TEST(sparse_write) {
         test_sparse_write_one(fd, test_c, sizeof(test_c));
         test_sparse_write_one(fd, test_d, sizeof(test_d));
         test_sparse_write_one(fd, test_e, sizeof(test_e));
+
+        /* Something large enough to exercise the word-wise and the unaligned code paths */
+        char test_f[4099] = {};
+        memset(test_f + 1, 'x', 7);
+        memset(test_f + 100, 'y', 1000);
+        test_f[3000] = 'z';
+        test_f[4098] = 'w';
+        test_sparse_write_one(fd, test_f, sizeof(test_f));
+        test_sparse_write_one(fd, test_f + 3, sizeof(test_f) - 3);
 }
 
 DEFINE_TEST_MAIN(LOG_INFO);
@@ -0,0 +1,127 @@
+/* SPDX-License-Identifier: LGPL-2.1-or-later */
+
+#include <unistd.h>
+
+#include "sd-json.h"
+
+#include "alloc-util.h"
+#include "fileio.h"
+#include "manager.h"
+#include "mkdir.h"
+#include "parse-util.h"
+#include "path-util.h"
+#include "rm-rf.h"
+#include "stdio-util.h"
+#include "string-util.h"
+#include "tests.h"
+#include "time-util.h"
+#include "tmpfile-util.h"
+#include "unit.h"
+
+/* Generates a synthetic tree of units, loads it into a test manager and builds a start transaction for it.
+ * Prints the time each step took as JSON on stdout, so that results can be compared across builds. Takes
+ * the number of units to generate as optional argument. */
+
+static unsigned arg_n_units;
+
+static void generate_units(const char *dir, unsigned n) {
+        _cleanup_free_ char *wants = NULL;
+
+        ASSERT_NOT_NULL(wants = path_join(dir, "bench.target.wants"));
+        ASSERT_OK(mkdir_p(wants, 0755));
+
+        ASSERT_OK(write_string_filef(
+                        strjoina(dir, "/bench.target"),
+                        WRITE_STRING_FILE_CREATE,
+                        "[Unit]\n"
+                        "Description=Benchmark target\n"));
+
+        for (unsigned i = 0; i < n; i++) {
+                char name[STRLEN("unit-.service") + DECIMAL_STR_MAX(unsigned)];
+                _cleanup_free_ char *p = NULL, *deps = NULL, *l = NULL, *t = NULL;
+
+                /* Every unit pulls in its parent in a binary tree of units, and is ordered after its
+                 * predecessor, so that the transaction has some actual work to do. */
+                if (i > 0)
+                        ASSERT_OK(asprintf(&deps,
+                                           "Wants=unit-%u.service\n"
+                                           "After=unit-%u.service\n",
+                                           (i - 1) / 2, i - 1));
+
+                xsprintf(name, "unit-%u.service", i);
+                ASSERT_NOT_NULL(p = path_join(dir, name));
+                ASSERT_OK(write_string_filef(
+                                p,
+                                WRITE_STRING_FILE_CREATE,
+                                "[Unit]\n"
+                                "Description=Benchmark unit %u\n"
+                                "%s"
+                                "[Service]\n"
+                                "Type=oneshot\n"
+                                "ExecStart=/bin/true\n",
+                                i, strempty(deps)));
+
+                ASSERT_NOT_NULL(l = path_join(wants, name));
+                ASSERT_NOT_NULL(t = path_join("..", name));
+                ASSERT_OK_ERRNO(symlink(t, l));
+        }
+}
+
+int main(int argc, char *argv[]) {
+        _cleanup_(rm_rf_physical_and_freep) char *runtime_dir = NULL, *unit_dir = NULL;
+        _cleanup_(sd_json_variant_unrefp) sd_json_variant *v = NULL;
+        _cleanup_(manager_freep) Manager *m = NULL;
+        usec_t t_generate, t_startup, t_load, t_transaction, t_end;
+        Unit *target = NULL;
+        int r;
+
+        test_setup_logging(LOG_INFO);
+
+        if (argc >= 2)
+                ASSERT_OK(safe_atou(argv[1], &arg_n_units));
+        else
+                arg_n_units = slow_tests_enabled() ? 25000 : 500;
+
+        r = enter_cgroup_subroot(NULL);
+        if (r == -ENOMEDIUM)
+                return log_tests_skipped("cgroupfs not available");
+
+        ASSERT_OK(mkdtemp_malloc("/tmp/test-load-benchmark-XXXXXX", &unit_dir));
+        ASSERT_NOT_NULL(runtime_dir = setup_fake_runtime_dir());
+
+        t_generate = now(CLOCK_MONOTONIC);
+        generate_units(unit_dir, arg_n_units);
+        ASSERT_OK(setenv_unit_path(unit_dir));
+
+        t_startup = now(CLOCK_MONOTONIC);
+        r = manager_new(RUNTIME_SCOPE_USER, MANAGER_TEST_RUN_BASIC, &m);
+        if (manager_errno_skip_test(r))
+                return log_tests_skipped_errno(r, "manager_new");
+        ASSERT_OK(r);
+        ASSERT_OK(manager_startup(m, NULL, NULL, NULL));
+
+        t_load = now(CLOCK_MONOTONIC);
+        ASSERT_OK(manager_load_startable_unit_or_warn(m, "bench.target", NULL, &target));
+
+        t_transaction = now(CLOCK_MONOTONIC);
+        ASSERT_OK(manager_add_job(m, JOB_START, target, JOB_REPLACE, NULL, NULL));
+
+        t_end = now(CLOCK_MONOTONIC);
+
+        ASSERT_OK(sd_json_buildo(
+                        &v,
+                        SD_JSON_BUILD_PAIR_UNSIGNED("units", arg_n_units),
+                        SD_JSON_BUILD_PAIR_UNSIGNED("generateUSec", t_startup - t_generate),
+                        SD_JSON_BUILD_PAIR_UNSIGNED("startupUSec", t_load - t_startup),
+                        SD_JSON_BUILD_PAIR_UNSIGNED("loadUSec", t_transaction - t_load),
+                        SD_JSON_BUILD_PAIR_UNSIGNED("transactionUSec", t_end - t_transaction),
+                        SD_JSON_BUILD_PAIR_UNSIGNED("jobs", hashmap_size(m->jobs))));
+
+        ASSERT_OK(sd_json_variant_dump(v, SD_JSON_FORMAT_NEWLINE, stdout, NULL));
+
+        log_info("Loaded %u units in %s, built transaction with %u jobs in %s.",
+                 arg_n_units, FORMAT_TIMESPAN(t_transaction - t_load, USEC_PER_MSEC),
+                 hashmap_size(m->jobs), FORMAT_TIMESPAN(t_end - t_transaction, USEC_PER_MSEC));
+
+        return 0;
+}
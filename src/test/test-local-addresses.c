@@ -68,6 +68,17 @@ TEST(local_addresses) {
         print_local_addresses(a, n);
         a = mfree(a);
 
+        n = local_gateways(NULL, 1, AF_UNSPEC, &a);
+        assert_se(n >= 0);
+        log_debug("/* Local Gateways(ifindex:1) */");
+        print_local_addresses(a, n);
+        a = mfree(a);
+
+        /* Filtered dumps for non-existing interfaces are refused by the kernel, but that is not an error */
+        n = local_gateways(NULL, INT_MAX, AF_UNSPEC, &a);
+        assert_se(n == 0);
+        assert_se(!a);
+
         n = local_outbounds(NULL, 0, AF_UNSPEC, &a);
         assert_se(n >= 0);
         log_debug("/* Local Outbounds */");
@@ -47,4 +47,28 @@ TEST(sha256) {
                         "9cfe7faff7054298ca87557e15a10262de8d3eee77827417fbdfea1c41b9ec23");
 }
 
+TEST(sha256_long) {
+        _cleanup_free_ char *buf = NULL, *hex_result = NULL;
+        uint8_t result[SHA256_DIGEST_SIZE];
+        struct sha256_ctx ctx;
+
+        /* FIPS 180-2 test vector: one million times 'a'. Feed it in odd-sized pieces, so that both the
+         * buffered and the direct block processing paths are exercised with many blocks. */
+
+        ASSERT_NOT_NULL(buf = new(char, 1000000));
+        memset(buf, 'a', 1000000);
+
+        hex_result = hexmem(SHA256_DIRECT(buf, 1000000), SHA256_DIGEST_SIZE);
+        ASSERT_STREQ(hex_result, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+        hex_result = mfree(hex_result);
+
+        sha256_init_ctx(&ctx);
+        for (size_t i = 0; i < 1000000; i += 999)
+                sha256_process_bytes(buf + i, MIN(999U, 1000000 - i), &ctx);
+        sha256_finish_ctx(&ctx, result);
+
+        hex_result = hexmem(result, SHA256_DIGEST_SIZE);
+        ASSERT_STREQ(hex_result, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
 DEFINE_TEST_MAIN(LOG_INFO);
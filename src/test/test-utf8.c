@@ -55,6 +55,77 @@ TEST(ascii_is_valid_n) {
         assert_se( ascii_is_valid_n("\342\204\242", 0));
 }
 
+TEST(utf8_is_valid_long) {
+        char buf[64];
+
+        /* Exercise the word-at-a-time ASCII fast path, with offending bytes at every offset */
+
+        memset(buf, 'a', sizeof(buf));
+        assert_se(utf8_is_valid_n(buf, sizeof(buf)));
+        assert_se(ascii_is_valid_n(buf, sizeof(buf)));
+
+        for (size_t i = 0; i < sizeof(buf) - 3; i++) {
+                memset(buf, 'a', sizeof(buf));
+                buf[sizeof(buf) - 1] = 0;
+
+                memcpy(buf + i, "\342\204\242", 3);
+                assert_se(utf8_is_valid(buf));
+                assert_se(utf8_is_valid_n(buf, sizeof(buf) - 1));
+                assert_se(!ascii_is_valid(buf));
+                assert_se(!ascii_is_valid_n(buf, sizeof(buf) - 1));
+
+                buf[i + 2] = 'a';
+                assert_se(!utf8_is_valid(buf));
+                assert_se(!utf8_is_valid_n(buf, sizeof(buf) - 1));
+
+                memset(buf, 'a', sizeof(buf));
+                buf[i] = 0;
+                assert_se(utf8_is_valid(buf));
+                assert_se(ascii_is_valid(buf));
+                assert_se(!utf8_is_valid_n(buf, sizeof(buf)));
+                assert_se(!ascii_is_valid_n(buf, sizeof(buf)));
+        }
+}
+
+typedef struct Utf8Benchmark {
+        char *buf;
+        size_t size;
+} Utf8Benchmark;
+
+static void benchmark_utf8_is_valid_n(void *userdata) {
+        Utf8Benchmark *b = ASSERT_PTR(userdata);
+
+        assert_se(utf8_is_valid_n(b->buf, b->size));
+}
+
+static void benchmark_ascii_is_valid_n(void *userdata) {
+        Utf8Benchmark *b = ASSERT_PTR(userdata);
+
+        assert_se(ascii_is_valid_n(b->buf, b->size));
+}
+
+TEST(utf8_is_valid_benchmark) {
+        bool slow = slow_tests_enabled();
+        _cleanup_free_ char *buf = NULL;
+        Utf8Benchmark b = {
+                .size = slow ? 1024 * 1024 : 64 * 1024,
+        };
+        unsigned iterations = slow ? 200 : 20;
+
+        ASSERT_NOT_NULL(buf = malloc(b.size));
+        b.buf = buf;
+
+        /* Plain ASCII, which takes the word-at-a-time fast path all the way */
+        memset(buf, 'a', b.size);
+        benchmark_run("utf8_is_valid_n() ASCII", iterations, benchmark_utf8_is_valid_n, &b);
+        benchmark_run("ascii_is_valid_n() ASCII", iterations, benchmark_ascii_is_valid_n, &b);
+
+        /* Short runs of ASCII interrupted by multi-byte sequences, which leave the fast path often */
+        for (size_t i = 0; i + 8 <= b.size; i += 8)
+                memcpy(buf + i, "abcd\342\204\242e", 8);
+        benchmark_run("utf8_is_valid_n() mixed", iterations, benchmark_utf8_is_valid_n, &b);
+}
+
 static void test_utf8_to_ascii_one(const char *s, int r_expected, const char *expected) {
         _cleanup_free_ char *ans = NULL;
         int r;
@@ -204,6 +275,7 @@ TEST(utf8_console_width) {
         assert_se(utf8_console_width("串") == 2);
         assert_se(utf8_console_width("") == 0);
         assert_se(utf8_console_width("…👊🔪💐…") == 8);
+        assert_se(utf8_console_width("a\tb") == 10);
         assert_se(utf8_console_width("\xF1") == SIZE_MAX);
 }
 
@@ -28,6 +28,7 @@
 #include "varlink-io.systemd.Resolve.h"
 #include "varlink-io.systemd.Resolve.Monitor.h"
 #include "varlink-io.systemd.Udev.h"
+#include "varlink-io.systemd.Unit.h"
 #include "varlink-io.systemd.UserDatabase.h"
 #include "varlink-io.systemd.oom.h"
 #include "varlink-io.systemd.service.h"
@@ -206,6 +207,8 @@ TEST(parse_format) {
         print_separator();
         test_parse_format_one(&vl_interface_io_systemd_FactoryReset);
         print_separator();
+        test_parse_format_one(&vl_interface_io_systemd_Unit);
+        print_separator();
         test_parse_format_one(&vl_interface_xyz_test);
 }
 
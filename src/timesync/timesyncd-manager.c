@@ -57,6 +57,11 @@
 /* Maximum number of missed replies before selecting another source. */
 #define NTP_MAX_MISSED_REPLIES          2
 
+/* The poll timer may fire up to 1/64th of the interval late (but at least 250ms, i.e. sd-event's
+ * default), so that it can be coalesced with other wakeups. */
+#define NTP_TIMER_ACCURACY_DIVISOR      64
+#define NTP_TIMER_ACCURACY_MIN_USEC     (250 * USEC_PER_MSEC)
+
 #define RATELIMIT_INTERVAL_USEC (10*USEC_PER_SEC)
 #define RATELIMIT_BURST 10
 
@@ -178,6 +183,7 @@ static int manager_timer(sd_event_source *source, usec_t usec, void *userdata) {
 }
 
 static int manager_arm_timer(Manager *m, usec_t next) {
+        usec_t accuracy;
         int r;
 
         assert(m);
@@ -187,11 +193,20 @@ static int manager_arm_timer(Manager *m, usec_t next) {
                 return 0;
         }
 
+        /* When exactly we send the next request doesn't matter for the quality of the sample, hence
+         * allow the timer to be coalesced with other wakeups within a small fraction of the interval,
+         * which for the longer poll intervals is much more than the default accuracy. */
+        accuracy = MAX(next / NTP_TIMER_ACCURACY_DIVISOR, NTP_TIMER_ACCURACY_MIN_USEC);
+
         if (m->event_timer) {
                 r = sd_event_source_set_time_relative(m->event_timer, next);
                 if (r < 0)
                         return r;
 
+                r = sd_event_source_set_time_accuracy(m->event_timer, accuracy);
+                if (r < 0)
+                        return r;
+
                 return sd_event_source_set_enabled(m->event_timer, SD_EVENT_ONESHOT);
         }
 
@@ -199,7 +214,7 @@ static int manager_arm_timer(Manager *m, usec_t next) {
                         m->event,
                         &m->event_timer,
                         CLOCK_BOOTTIME,
-                        next, 0,
+                        next, accuracy,
                         manager_timer, m);
 }
 
@@ -176,6 +176,8 @@ typedef struct Item {
 
         bool ignore_if_target_missing:1;
 
+        unsigned config_file; /* The number of the configuration file the item was read from */
+
         OperationMask done;
 } Item;
 
@@ -225,6 +227,7 @@ typedef struct Context {
         Set *unix_sockets;
         Hashmap *uid_cache;
         Hashmap *gid_cache;
+        unsigned n_config_files;
 } Context;
 
 STATIC_DESTRUCTOR_REGISTER(arg_include_prefixes, strv_freep);
@@ -452,9 +455,17 @@ static struct Item* find_glob(OrderedHashmap *h, const char *match) {
         ItemArray *j;
 
         ORDERED_HASHMAP_FOREACH(j, h)
-                FOREACH_ARRAY(item, j->items, j->n_items)
+                FOREACH_ARRAY(item, j->items, j->n_items) {
+                        /* This is called for every single inode dir_cleanup() looks at, so first compare the
+                         * literal prefix of the pattern, which quickly rules out most globs, before invoking
+                         * the much more expensive fnmatch(). */
+                        size_t n = strcspn(item->path, GLOB_CHARS "\\");
+                        if (strncmp(item->path, match, n) != 0)
+                                continue;
+
                         if (fnmatch(item->path, match, FNM_PATHNAME|FNM_PERIOD) == 0)
                                 return item;
+                }
         return NULL;
 }
 
@@ -4114,6 +4125,7 @@ static int parse_line(
         if (!GREEDY_REALLOC(existing->items, existing->n_items + 1))
                 return log_oom();
 
+        i.config_file = c->n_config_files;
         existing->items[existing->n_items++] = TAKE_STRUCT(i);
 
         /* Sort item array, to enforce stable ordering of application */
@@ -4389,60 +4401,107 @@ static int parse_argv(int argc, char *argv[]) {
         return 1;
 }
 
-static int read_config_file(
-                Context *c,
-                char **config_dirs,
-                const char *fn,
-                bool ignore_enoent,
-                bool *invalid_config) {
+static int determine_ignore_directory_age(Context *c, Item *i) {
+        _cleanup_free_ Item **candidates = NULL;
+        size_t n_candidates = 0;
+        ItemArray *ja;
+
+        assert(c);
+        assert(i);
+
+        /* Collect the directory items the X item may inherit its age from: those with the same path, a
+         * parent path, or a path matching the glob. */
+        ORDERED_HASHMAP_FOREACH(ja, c->items)
+                FOREACH_ARRAY(j, ja->items, ja->n_items) {
+                        if (!IN_SET(j->type, CREATE_DIRECTORY,
+                                             TRUNCATE_DIRECTORY,
+                                             CREATE_SUBVOLUME,
+                                             CREATE_SUBVOLUME_INHERIT_QUOTA,
+                                             CREATE_SUBVOLUME_NEW_QUOTA))
+                                continue;
+
+                        if (!path_startswith(i->path, j->path) &&
+                            fnmatch(i->path, j->path, FNM_PATHNAME | FNM_PERIOD) != 0)
+                                continue;
+
+                        if (!GREEDY_REALLOC(candidates, n_candidates + 1))
+                                return log_oom();
+
+                        candidates[n_candidates++] = j;
+                }
+
+        /* The age used to be determined again after each configuration file was read, from the items read so
+         * far, and an age found in one round was kept if the item picked in a later round had none. Replay
+         * these rounds, but only for the configuration files that added a candidate. */
+        for (unsigned k = i->config_file; k != UINT_MAX;) {
+                Item *candidate_item = NULL;
+                unsigned next = UINT_MAX;
+
+                FOREACH_ARRAY(j, candidates, n_candidates)
+                        if ((*j)->config_file > k)
+                                next = MIN(next, (*j)->config_file);
+
+                FOREACH_ARRAY(j, candidates, n_candidates) {
+                        if ((*j)->config_file > k)
+                                continue;
+
+                        if (path_equal((*j)->path, i->path)) {
+                                candidate_item = *j;
+                                break;
+                        }
+
+                        if (candidate_item
+                            ? (path_startswith((*j)->path, candidate_item->path) && fnmatch(i->path, (*j)->path, FNM_PATHNAME | FNM_PERIOD) == 0)
+                            : path_startswith(i->path, (*j)->path) != NULL)
+                                candidate_item = *j;
+                }
+
+                if (candidate_item && candidate_item->age_set) {
+                        i->age = candidate_item->age;
+                        i->age_set = true;
+                }
+
+                k = next;
+        }
 
+        return 0;
+}
+
+static int determine_ignore_directory_ages(Context *c) {
         ItemArray *ia;
-        int r = 0;
+        int r;
 
         assert(c);
-        assert(fn);
-
-        r = conf_file_read(arg_root, (const char**) config_dirs, fn,
-                           parse_line, c, ignore_enoent, invalid_config);
-        if (r <= 0)
-                return r;
 
-        /* we have to determine age parameter for each entry of type X */
+        /* We have to determine the age parameter for each entry of type X. This looks at all items, hence
+         * do it once after all configuration has been read, rather than after each configuration file. */
         ORDERED_HASHMAP_FOREACH(ia, c->globs)
                 FOREACH_ARRAY(i, ia->items, ia->n_items) {
-                        ItemArray *ja;
-                        Item *candidate_item = NULL;
-
                         if (i->type != IGNORE_DIRECTORY_PATH)
                                 continue;
 
-                        ORDERED_HASHMAP_FOREACH(ja, c->items)
-                                FOREACH_ARRAY(j, ja->items, ja->n_items) {
-                                        if (!IN_SET(j->type, CREATE_DIRECTORY,
-                                                             TRUNCATE_DIRECTORY,
-                                                             CREATE_SUBVOLUME,
-                                                             CREATE_SUBVOLUME_INHERIT_QUOTA,
-                                                             CREATE_SUBVOLUME_NEW_QUOTA))
-                                                continue;
-
-                                        if (path_equal(j->path, i->path)) {
-                                                candidate_item = j;
-                                                break;
-                                        }
-
-                                        if (candidate_item
-                                            ? (path_startswith(j->path, candidate_item->path) && fnmatch(i->path, j->path, FNM_PATHNAME | FNM_PERIOD) == 0)
-                                            : path_startswith(i->path, j->path) != NULL)
-                                                candidate_item = j;
-                                }
-
-                        if (candidate_item && candidate_item->age_set) {
-                                i->age = candidate_item->age;
-                                i->age_set = true;
-                        }
+                        r = determine_ignore_directory_age(c, i);
+                        if (r < 0)
+                                return r;
                 }
 
-        return r;
+        return 0;
+}
+
+static int read_config_file(
+                Context *c,
+                char **config_dirs,
+                const char *fn,
+                bool ignore_enoent,
+                bool *invalid_config) {
+
+        assert(c);
+        assert(fn);
+
+        c->n_config_files++;
+
+        return conf_file_read(arg_root, (const char**) config_dirs, fn,
+                              parse_line, c, ignore_enoent, invalid_config);
 }
 
 static int parse_arguments(
@@ -4686,6 +4745,10 @@ static int run(int argc, char *argv[]) {
         if (r < 0)
                 return r;
 
+        r = determine_ignore_directory_ages(&c);
+        if (r < 0)
+                return r;
+
         /* Let's now link up all child/parent relationships */
         ORDERED_HASHMAP_FOREACH(a, c.items) {
                 r = link_parent(&c, a);
@@ -1,7 +1,11 @@
 /* SPDX-License-Identifier: LGPL-2.1-or-later */
 
+#include "fileio.h"
+#include "path-util.h"
+#include "rm-rf.h"
 #include "string-util.h"
 #include "tests.h"
+#include "tmpfile-util.h"
 #include "udev-rules.h"
 
 static void test_udev_rule_parse_value_one(const char *in, const char *expected_value, bool expected_case_insensitive, int expected_retval) {
@@ -92,4 +96,43 @@ TEST(udev_rule_parse_value) {
         test_udev_rule_parse_value_one("a\"\"", NULL, /* case_insensitive = */ false, -EINVAL);
 }
 
+static void test_udev_rules_reuse_one(ResolveNameTiming timing) {
+        _cleanup_(rm_rf_physical_and_freep) char *dir = NULL;
+        _cleanup_(udev_rules_freep) UdevRules *previous = NULL, *rules = NULL;
+        _cleanup_free_ char *owner = NULL, *plain = NULL;
+        UdevRuleFile *owner_file, *plain_file;
+
+        log_info("/* %s(%s) */", __func__, resolve_name_timing_to_string(timing));
+
+        ASSERT_OK(mkdtemp_malloc("/tmp/test-udev-rules-XXXXXX", &dir));
+        ASSERT_NOT_NULL(owner = path_join(dir, "50-owner.rules"));
+        ASSERT_NOT_NULL(plain = path_join(dir, "50-plain.rules"));
+        ASSERT_OK(write_string_file(owner, "KERNEL==\"test-udev-rules-reuse\", OWNER=\"root\", GROUP=\"root\"", WRITE_STRING_FILE_CREATE));
+        ASSERT_OK(write_string_file(plain, "KERNEL==\"test-udev-rules-reuse\", MODE=\"0600\"", WRITE_STRING_FILE_CREATE));
+
+        ASSERT_OK(udev_rules_load(&previous, timing, STRV_MAKE(dir)));
+        ASSERT_NOT_NULL(owner_file = udev_rules_find_file(previous, owner));
+        ASSERT_NOT_NULL(plain_file = udev_rules_find_file(previous, plain));
+
+        ASSERT_OK(udev_rules_load_full(&rules, timing, STRV_MAKE(dir), previous));
+
+        /* Unmodified files are moved over, unless user or group names were resolved while parsing */
+        ASSERT_PTR_EQ(udev_rules_find_file(rules, plain), plain_file);
+        ASSERT_NULL(udev_rules_find_file(previous, plain));
+
+        if (timing == RESOLVE_NAME_EARLY) {
+                ASSERT_PTR_EQ(udev_rules_find_file(previous, owner), owner_file);
+                ASSERT_NOT_NULL(udev_rules_find_file(rules, owner));
+                ASSERT_TRUE(udev_rules_find_file(rules, owner) != owner_file);
+        } else {
+                ASSERT_PTR_EQ(udev_rules_find_file(rules, owner), owner_file);
+                ASSERT_NULL(udev_rules_find_file(previous, owner));
+        }
+}
+
+TEST(udev_rules_reuse) {
+        test_udev_rules_reuse_one(RESOLVE_NAME_EARLY);
+        test_udev_rules_reuse_one(RESOLVE_NAME_LATE);
+}
+
 DEFINE_TEST_MAIN(LOG_DEBUG);
@@ -17,6 +17,7 @@ typedef struct UdevConfig {
         usec_t exec_delay_usec;
         usec_t timeout_usec;
         int timeout_signal;
+        usec_t worker_idle_timeout_usec;
         bool blockdev_read_only;
         bool trace;
 } UdevConfig;
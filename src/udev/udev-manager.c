@@ -96,6 +96,7 @@ static Event *event_free(Event *event) {
         assert(event->manager);
 
         LIST_REMOVE(event, event->manager->events, event);
+        hashmap_remove_value(event->manager->events_by_seqnum, &event->seqnum, event);
         sd_device_unref(event->dev);
 
         sd_event_source_unref(event->retry_event_source);
@@ -144,6 +145,7 @@ Manager* manager_free(Manager *manager) {
 
         hashmap_free(manager->workers);
         event_queue_cleanup(manager, EVENT_UNDEF);
+        hashmap_free(manager->events_by_seqnum);
 
         safe_close(manager->inotify_fd);
         safe_close(manager->worker_notify_fd);
@@ -285,7 +287,9 @@ void manager_reload(Manager *manager, bool force) {
         udev_builtin_reload(flags);
 
         if (FLAGS_SET(flags, UDEV_RELOAD_RULES)) {
-                r = udev_rules_load(&rules, manager->config.resolve_name_timing, /* extra = */ NULL);
+                /* Files that did not change are taken over from the currently loaded rules, so that a
+                 * change to a single file does not require re-parsing all of them. */
+                r = udev_rules_load_full(&rules, manager->config.resolve_name_timing, /* extra = */ NULL, manager->rules);
                 if (r < 0)
                         log_warning_errno(r, "Failed to read udev rules, using the previously loaded rules, ignoring: %m");
                 else
@@ -520,6 +524,13 @@ static int event_is_blocked(Event *event) {
                 /* we have checked previously and no blocker found */
                 return false;
 
+        /* event we checked earlier still exists, no need to walk the queue to find out. With many queued
+         * events this is the common case, and checking it by walking the queue from the start each time
+         * would make every queue run quadratic in the number of queued events. */
+        if (event->blocker_seqnum > 0 &&
+            hashmap_contains(event->manager->events_by_seqnum, &event->blocker_seqnum))
+                return true;
+
         LIST_FOREACH(event, e, event->manager->events) {
                 loop_event = e;
 
@@ -757,6 +768,11 @@ static int event_queue_insert(Manager *manager, sd_device *dev) {
 
         LIST_APPEND(event, manager->events, event);
 
+        /* Only used as a shortcut in event_is_blocked(), hence failure is not fatal. */
+        r = hashmap_ensure_put(&manager->events_by_seqnum, &uint64_hash_ops, &event->seqnum, event);
+        if (r < 0)
+                log_device_debug_errno(dev, r, "Failed to index event by sequence number, ignoring: %m");
+
         log_device_uevent(dev, "Device is queued");
 
         return 0;
@@ -1082,11 +1098,13 @@ static int on_post(sd_event_source *s, void *userdata) {
                 log_debug("No events are queued, removing /run/udev/queue.");
 
         if (!hashmap_isempty(manager->workers)) {
-                /* There are idle workers */
-                (void) event_reset_time_relative(manager->event, &manager->kill_workers_event,
-                                                 CLOCK_MONOTONIC, 3 * USEC_PER_SEC, USEC_PER_SEC,
-                                                 on_kill_workers_event, manager,
-                                                 0, "kill-workers-event", false);
+                /* There are idle workers. Unless configured to keep them around forever, kill them
+                 * after a while, so that they do not pin memory while there is nothing to do. */
+                if (manager->config.worker_idle_timeout_usec != USEC_INFINITY)
+                        (void) event_reset_time_relative(manager->event, &manager->kill_workers_event,
+                                                         CLOCK_MONOTONIC, manager->config.worker_idle_timeout_usec, USEC_PER_SEC,
+                                                         on_kill_workers_event, manager,
+                                                         0, "kill-workers-event", false);
                 return 1;
         }
 
@@ -22,6 +22,7 @@ typedef struct Manager {
         sd_event *event;
         Hashmap *workers;
         LIST_HEAD(Event, events);
+        Hashmap *events_by_seqnum;
         char *cgroup;
 
         UdevRules *rules;
@@ -194,6 +194,7 @@ struct UdevRuleLine {
 struct UdevRuleFile {
         char *filename;
         unsigned issues; /* used by "udevadm verify" */
+        bool resolved_names; /* user or group names were resolved while parsing */
 
         UdevRules *rules;
         LIST_HEAD(UdevRuleLine, rule_lines);
@@ -484,6 +485,9 @@ static int rule_resolve_user(UdevRuleLine *rule_line, const char *name, uid_t *r
         assert(name);
         assert(ret);
 
+        /* The result depends on the user database, hence the file must be parsed again on reload */
+        rule_line->rule_file->resolved_names = true;
+
         val = hashmap_get(*known_users, name);
         if (val) {
                 *ret = PTR_TO_UID(val);
@@ -528,6 +532,8 @@ static int rule_resolve_group(UdevRuleLine *rule_line, const char *name, gid_t *
         assert(name);
         assert(ret);
 
+        rule_line->rule_file->resolved_names = true;
+
         val = hashmap_get(*known_groups, name);
         if (val) {
                 *ret = PTR_TO_GID(val);
@@ -1795,7 +1801,65 @@ UdevRules* udev_rules_new(ResolveNameTiming resolve_name_timing) {
         return rules;
 }
 
-int udev_rules_load(UdevRules **ret_rules, ResolveNameTiming resolve_name_timing, char * const *extra) {
+UdevRuleFile* udev_rules_find_file(UdevRules *rules, const char *filename) {
+        assert(rules);
+        assert(filename);
+
+        LIST_FOREACH(rule_files, i, rules->rule_files)
+                if (streq(i->filename, filename))
+                        return i;
+
+        return NULL;
+}
+
+static int udev_rules_reuse_file(UdevRules *rules, UdevRules *previous, const char *filename) {
+        UdevRuleFile *rule_file = NULL;
+        const struct stat *old;
+        struct stat st;
+        int r;
+
+        assert(rules);
+        assert(previous);
+        assert(filename);
+
+        /* If the file has not been modified since it was parsed into the previous rules object, move the
+         * already parsed lines over instead of parsing the file again. Returns 1 if the file was reused,
+         * 0 if it needs to be parsed. */
+
+        if (previous->resolve_name_timing != rules->resolve_name_timing)
+                return 0;
+
+        old = hashmap_get(previous->stats_by_path, filename);
+        if (!old)
+                return 0;
+
+        if (stat(filename, &st) < 0)
+                return 0;
+
+        if (!stat_inode_unmodified(old, &st))
+                return 0;
+
+        rule_file = udev_rules_find_file(previous, filename);
+        if (!rule_file)
+                return 0;
+
+        /* User and group names resolved at parse time may have changed since, even if the file did not. */
+        if (rule_file->resolved_names)
+                return 0;
+
+        r = hashmap_put_stats_by_path(&rules->stats_by_path, filename, &st);
+        if (r < 0)
+                return r;
+
+        LIST_REMOVE(rule_files, previous->rule_files, rule_file);
+        rule_file->rules = rules;
+        LIST_APPEND(rule_files, rules->rule_files, rule_file);
+
+        log_debug("Reusing unmodified rules file: %s", filename);
+        return 1;
+}
+
+int udev_rules_load_full(UdevRules **ret_rules, ResolveNameTiming resolve_name_timing, char * const *extra, UdevRules *previous) {
         _cleanup_(udev_rules_freep) UdevRules *rules = NULL;
         _cleanup_strv_free_ char **files = NULL, **directories = NULL;
         int r;
@@ -1818,7 +1882,17 @@ int udev_rules_load(UdevRules **ret_rules, ResolveNameTiming resolve_name_timing
         if (r < 0)
                 return log_debug_errno(r, "Failed to enumerate rules files: %m");
 
+        /* Note: once files have been moved over from the previous rules object, this must not fail
+         * anymore, as the caller keeps using the previous rules on failure. */
         STRV_FOREACH(f, files) {
+                if (previous) {
+                        r = udev_rules_reuse_file(rules, previous, *f);
+                        if (r < 0)
+                                log_debug_errno(r, "Failed to reuse previously parsed rules file %s, parsing it again: %m", *f);
+                        if (r > 0)
+                                continue;
+                }
+
                 r = udev_rules_parse_file(rules, *f, /* extra_checks = */ false, NULL);
                 if (r < 0)
                         log_debug_errno(r, "Failed to read rules file %s, ignoring: %m", *f);
@@ -3166,29 +3240,16 @@ static int udev_rule_apply_parent_token_to_event(UdevRuleToken *head_token, Udev
 static int udev_rule_apply_line_to_event(
                 UdevRuleLine *line,
                 UdevEvent *event,
+                UdevRuleLineType mask,
                 UdevRuleLine **next_line) {
 
-        UdevRuleLineType mask = LINE_HAS_GOTO | LINE_UPDATE_SOMETHING;
         bool parents_done = false;
-        sd_device_action_t action;
         int r;
 
         assert(line);
         assert(event);
         assert(next_line);
 
-        r = sd_device_get_action(event->dev, &action);
-        if (r < 0)
-                return r;
-
-        if (action != SD_DEVICE_REMOVE) {
-                if (sd_device_get_devnum(event->dev, NULL) >= 0)
-                        mask |= LINE_HAS_DEVLINK;
-
-                if (sd_device_get_ifindex(event->dev, NULL) >= 0)
-                        mask |= LINE_HAS_NAME;
-        }
-
         if ((line->type & mask) == 0)
                 return 0;
 
@@ -3222,19 +3283,62 @@ static int udev_rule_apply_line_to_event(
         return 0;
 }
 
+static int udev_event_get_line_mask(UdevEvent *event, UdevRuleLineType *ret) {
+        UdevRuleLineType mask = LINE_HAS_GOTO | LINE_UPDATE_SOMETHING;
+        sd_device_action_t action;
+        int r;
+
+        assert(event);
+        assert(ret);
+
+        /* Lines that neither jump nor update anything relevant for this kind of device can be skipped
+         * entirely. None of the properties checked here can be changed by rules, hence this only needs to
+         * be calculated once per event rather than once per line. */
+
+        r = sd_device_get_action(event->dev, &action);
+        if (r < 0)
+                return r;
+
+        if (action != SD_DEVICE_REMOVE) {
+                if (sd_device_get_devnum(event->dev, NULL) >= 0)
+                        mask |= LINE_HAS_DEVLINK;
+
+                if (sd_device_get_ifindex(event->dev, NULL) >= 0)
+                        mask |= LINE_HAS_NAME;
+        }
+
+        *ret = mask;
+        return 0;
+}
+
 int udev_rules_apply_to_event(UdevRules *rules, UdevEvent *event) {
+        UdevRuleLineType mask;
         int r;
 
         assert(rules);
         assert(event);
 
-        LIST_FOREACH(rule_files, file, rules->rule_files)
+        r = udev_event_get_line_mask(event, &mask);
+        if (r < 0)
+                return r;
+
+        LIST_FOREACH(rule_files, file, rules->rule_files) {
+                /* In trace mode, report how long each rules file took, so that slow rules are easy to
+                 * spot. Otherwise do not bother reading the clock. */
+                usec_t begin = event->trace ? now(CLOCK_MONOTONIC) : USEC_INFINITY;
+
                 LIST_FOREACH_WITH_NEXT(rule_lines, line, next_line, file->rule_lines) {
-                        r = udev_rule_apply_line_to_event(line, event, &next_line);
+                        r = udev_rule_apply_line_to_event(line, event, mask, &next_line);
                         if (r < 0)
                                 return r;
                 }
 
+                if (begin != USEC_INFINITY)
+                        log_device_debug(event->dev, "%s: processed in %s.",
+                                         file->filename,
+                                         FORMAT_TIMESPAN(usec_sub_unsigned(now(CLOCK_MONOTONIC), begin), 1));
+        }
+
         return 0;
 }
 
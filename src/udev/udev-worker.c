@@ -173,6 +173,7 @@ static int worker_mark_block_device_read_only(sd_device *dev) {
 static int worker_process_device(UdevWorker *worker, sd_device *dev) {
         _cleanup_(udev_event_unrefp) UdevEvent *udev_event = NULL;
         _cleanup_close_ int fd_lock = -EBADF;
+        usec_t begin = 0, rules_done = 0, run_done = 0;
         int r;
 
         assert(worker);
@@ -180,6 +181,10 @@ static int worker_process_device(UdevWorker *worker, sd_device *dev) {
 
         log_device_uevent(dev, "Processing device");
 
+        /* Only read the clock when the timings are actually logged below. */
+        if (worker->config.trace)
+                begin = now(CLOCK_MONOTONIC);
+
         udev_event = udev_event_new(dev, worker, EVENT_UDEV_WORKER);
         if (!udev_event)
                 return -ENOMEM;
@@ -208,9 +213,13 @@ static int worker_process_device(UdevWorker *worker, sd_device *dev) {
         r = udev_event_execute_rules(udev_event, worker->rules);
         if (r < 0)
                 return r;
+        if (udev_event->trace)
+                rules_done = now(CLOCK_MONOTONIC);
 
         /* Process RUN=. */
         udev_event_execute_run(udev_event);
+        if (udev_event->trace)
+                run_done = now(CLOCK_MONOTONIC);
 
         if (!worker->rtnl)
                 /* in case rtnl was initialized */
@@ -235,6 +244,16 @@ static int worker_process_device(UdevWorker *worker, sd_device *dev) {
                         return log_device_warning_errno(dev, r, "Failed to update database under /run/udev/data/: %m");
         }
 
+        if (udev_event->trace) {
+                usec_t end = now(CLOCK_MONOTONIC);
+
+                log_device_debug(dev, "Processing took %s (rules: %s, RUN: %s, database: %s).",
+                                 FORMAT_TIMESPAN(usec_sub_unsigned(end, begin), 1),
+                                 FORMAT_TIMESPAN(usec_sub_unsigned(rules_done, begin), 1),
+                                 FORMAT_TIMESPAN(usec_sub_unsigned(run_done, rules_done), 1),
+                                 FORMAT_TIMESPAN(usec_sub_unsigned(end, run_done), 1));
+        }
+
         log_device_uevent(dev, "Device processed");
         return 0;
 }
@@ -22,7 +22,7 @@
 #include "varlink-io.systemd.UserDatabase.h"
 #include "varlink-util.h"
 
-#define ITERATIONS_MAX 64U
+#define ITERATIONS_MAX 1024U
 #define RUNTIME_MAX_USEC (5 * USEC_PER_MINUTE)
 #define PRESSURE_SLEEP_TIME_USEC (50 * USEC_PER_MSEC)
 #define CONNECTION_IDLE_USEC (15 * USEC_PER_SEC)
@@ -494,7 +494,7 @@ static int process_connection(sd_varlink_server *server, int _fd) {
 }
 
 static int run(int argc, char *argv[]) {
-        usec_t start_time, listen_idle_usec, last_busy_usec = USEC_INFINITY;
+        usec_t start_time, listen_idle_usec, last_busy_usec = USEC_INFINITY, last_help_usec = 0;
         _cleanup_(sd_varlink_server_unrefp) sd_varlink_server *server = NULL;
         _cleanup_(pidref_done) PidRef parent = PIDREF_NULL;
         unsigned n_iterations = 0;
@@ -587,9 +587,14 @@ static int run(int argc, char *argv[]) {
                 if (fd < 0)
                         return log_error_errno(fd, "Failed to accept() from listening socket: %m");
 
-                if (now(CLOCK_MONOTONIC) <= usec_add(n, PRESSURE_SLEEP_TIME_USEC)) {
+                usec_t k = now(CLOCK_MONOTONIC);
+                if (k <= usec_add(n, PRESSURE_SLEEP_TIME_USEC) &&
+                    k >= usec_add(last_help_usec, PRESSURE_SLEEP_TIME_USEC)) {
                         /* We only slept a very short time? If so, let's see if there are more sockets
-                         * pending, and if so, let's ask our parent for more workers */
+                         * pending, and if so, let's ask our parent for more workers. Don't ask more than
+                         * once per pressure interval though, since the parent forks off one worker per
+                         * request, and during lookup storms every worker would otherwise ask for every
+                         * single connection, resulting in fork bursts. */
 
                         r = fd_wait_for_event(listen_fd, POLLIN, 0);
                         if (r < 0)
@@ -601,6 +606,8 @@ static int run(int argc, char *argv[]) {
                                         return log_error_errno(r, "Parent already died?");
                                 if (r < 0)
                                         return log_error_errno(r, "Failed to send SIGUSR2 signal to parent: %m");
+
+                                last_help_usec = k;
                         }
                 }
 
@@ -0,0 +1,38 @@
+#!/usr/bin/env bash
+# SPDX-License-Identifier: LGPL-2.1-or-later
+#
+# Test which age X lines inherit from directory lines read from multiple configuration files
+set -eux
+
+rm -rf /tmp/xage /tmp/xage-conf
+mkdir -p /tmp/xage/{a,b}/sub /tmp/xage-conf
+
+touch /tmp/xage/{a,b}/sub/f1
+sleep 3
+
+# The age of the parent directory is inherited when the X line is read, and kept even though a later
+# configuration file adds a line for the exact path without an age.
+cat >/tmp/xage-conf/a1.conf <<EOF
+d /tmp/xage/a - - - 2s
+X /tmp/xage/a/s*
+EOF
+cat >/tmp/xage-conf/a2.conf <<EOF
+d /tmp/xage/a/s* - - - -
+EOF
+
+systemd-tmpfiles --clean /tmp/xage-conf/a1.conf /tmp/xage-conf/a2.conf
+test ! -e /tmp/xage/a/sub/f1
+
+# If the line for the exact path is read first, it is picked every time, hence no age is inherited.
+cat >/tmp/xage-conf/b1.conf <<EOF
+d /tmp/xage/b/s* - - - -
+X /tmp/xage/b/s*
+EOF
+cat >/tmp/xage-conf/b2.conf <<EOF
+d /tmp/xage/b - - - 2s
+EOF
+
+systemd-tmpfiles --clean /tmp/xage-conf/b1.conf /tmp/xage-conf/b2.conf
+test -f /tmp/xage/b/sub/f1
+
+rm -rf /tmp/xage /tmp/xage-conf